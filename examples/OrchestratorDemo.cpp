@@ -29,8 +29,8 @@ int main() {
     ethCfg.extra["ws"] = "ws://127.0.0.1:8546";
 
     // 4) Init and start adapters
-    auto* btc = AdapterRegistry::instance().get(Chain::Bitcoin);
-    auto* eth = AdapterRegistry::instance().get(Chain::Ethereum);
+    auto btc = AdapterRegistry::instance().get(Chain::Bitcoin);
+    auto eth = AdapterRegistry::instance().get(Chain::Ethereum);
 
     if (!btc || !eth) {
         std::cerr << "Adapters not found. Exiting." << std::endl;
@@ -316,6 +316,39 @@ public:
         return lastProof_;
     }
 
+    // ================= Epoch Settlement =================
+    // The fields reward and reputation settlement read, taken under one lock
+    // without copying the whole telemetry sample.
+    struct SettlementView {
+        bool hasSample = false;
+        uint64_t instantaneousPower_GFLOPSFp = 0;
+        uint64_t computeEfficiency_GFLOPS_WFp = 0;
+        uint64_t privacyBudgetRemainingFp = 0;
+        uint64_t reputationFp = 0;
+    };
+
+    SettlementView settlementView() const {
+        std::lock_guard<std::mutex> lock(mu_);
+        SettlementView v;
+        v.reputationFp = rep_.scoreFp;
+        if (lastSample_.has_value()) {
+            v.hasSample = true;
+            v.instantaneousPower_GFLOPSFp = lastSample_->compute.instantaneousPower_GFLOPSFp;
+            v.computeEfficiency_GFLOPS_WFp = lastSample_->energy.computeEfficiency_GFLOPS_WFp;
+            v.privacyBudgetRemainingFp = lastSample_->privacy.privacyBudgetRemainingFp;
+        }
+        return v;
+    }
+
+    // Stores a reputation score computed by epoch settlement.
+    void applySettledReputation(uint64_t scoreFp) {
+        std::lock_guard<std::mutex> lock(mu_);
+        rep_.scoreFp = scoreFp;
+        if (db_) {
+            db_->setReputation(id_.pubkey, toJson());
+        }
+    }
+
     // ================= Health Scoring =================
     int64_t healthScoreFp() const {
         std::lock_guard<std::mutex> lock(mu_);
@@ -414,4 +447,61 @@ private:
     std::vector<AmbientNode*> nodes_;
 };
 
+// ================= Reputation & Token Economics =================
+
+// Per-node forms; EpochSettlementEngine computes the same values in bulk.
+uint64_t updateReputationScoreFp(const AmbientNode& node, bool success, uint64_t slaFp, int64_t uptimeMs);
+
+IncentiveRecord calculateTokenReward(const AmbientNode& node, uint64_t baseRateFp);
+
+struct EpochParticipant {
+    AmbientNode* node = nullptr;
+    bool success = false;
+    uint64_t slaFp = 0;
+    int64_t uptimeMs = 0;   // Deterministic, from logical protocol time
+};
+
+// Indexed like the participants. rewardFp[i] is what calculateTokenReward()
+// would put in the record (0 for a node without telemetry); callers that
+// distribute it build the record with node->accrueReward("autoTask", ...).
+struct EpochSettlementResult {
+    std::vector<uint64_t> rewardFp;
+    std::vector<uint64_t> reputationFp;
+};
+
+/**
+ * Settles token rewards and reputation for every participant of an epoch.
+ *
+ * Each node is read once (settlementView) into structure-of-arrays buffers,
+ * rewards and EMA reputation updates are computed over those arrays, and the
+ * new scores are written back in a single pass. For every participant the
+ * reward equals calculateTokenReward() and the new score equals
+ * updateReputationScoreFp(), both evaluated against the reputation the node
+ * held when the epoch closed. A node listed twice is settled twice from the
+ * same snapshot; its last entry's score is the one kept.
+ *
+ * The buffers are reused across epochs, so an engine must not be shared
+ * between threads settling concurrently.
+ */
+class EpochSettlementEngine {
+public:
+    EpochSettlementResult settle(const std::vector<EpochParticipant>& participants, uint64_t baseRateFp);
+
+private:
+    void snapshot(const std::vector<EpochParticipant>& participants);
+    void computeRewards(uint64_t baseRateFp);
+    void computeReputation();
+
+    std::vector<uint8_t> hasSample_;
+    std::vector<uint64_t> powerFp_;
+    std::vector<uint64_t> efficiencyFp_;
+    std::vector<uint64_t> privacyFp_;
+    std::vector<uint64_t> reputationFp_;
+    std::vector<uint8_t> success_;
+    std::vector<uint64_t> slaFp_;
+    std::vector<int64_t> uptimeMs_;
+    std::vector<uint64_t> rewardFp_;
+    std::vector<uint64_t> newReputationFp_;
+};
+
 } // namespace ambient
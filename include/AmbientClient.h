@@ -8,9 +8,11 @@
 #include <mutex>
 #include <condition_variable>
 #include <unordered_map>
-#include <queue>
+#include <set>
 #include <future>
 #include <atomic>
+#include <thread>
+#include <unordered_set>
 
 namespace ailee::net {
 
@@ -102,6 +104,8 @@ struct RequesterOptions {
     bool enableTaskPriority = true;
     bool autoRetryOnFailure = true;
     std::chrono::milliseconds workerDiscoveryInterval = std::chrono::milliseconds(5000);
+    // How long finished tasks stay queryable through getTaskResult/waitForResult.
+    std::chrono::milliseconds resultRetention = std::chrono::milliseconds(60000);
 };
 
 // ============================================================================
@@ -155,6 +159,10 @@ public:
 // Concrete Implementation: AmbientRequesterClient
 // ============================================================================
 
+// Submits up to RequesterOptions::maxConcurrentTasks tasks at once and holds
+// the rest in a priority queue. Results are routed back to the waiting
+// future/condition variable by task id, and per-attempt deadlines, retry
+// backoff and result expiry all run off a single timer wheel.
 class AmbientRequesterClient : public IRequesterClient {
 public:
     explicit AmbientRequesterClient(std::shared_ptr<IPubSub> pubsub,
@@ -202,6 +210,8 @@ public:
     std::size_t getPendingTaskCount() const override;
     std::size_t getCompletedTaskCount() const override;
     std::size_t getFailedTaskCount() const override;
+
+    const std::string& requesterId() const { return requester_id_; }
     
 private:
     struct TaskState {
@@ -212,6 +222,10 @@ private:
         std::uint32_t retryCount;
         std::promise<TaskResult> promise;
         std::shared_ptr<std::condition_variable> cv;
+        std::uint32_t attempt = 0;       // Bumped per dispatch; stale timers/results carry an older one
+        std::uint64_t seq = 0;           // Submission order, FIFO tie-break in the pending queue
+        bool inFlight = false;           // Holds one of the maxConcurrentTasks slots
+        std::optional<std::string> assignedWorker;
         
         TaskState(TaskRequest req)
             : request(std::move(req))
@@ -226,33 +240,86 @@ private:
         WorkerCapabilities capabilities;
         WorkerState state;
         std::uint64_t lastSeen;
+        std::uint32_t freeSlots = 0;     // Last advertised, less tasks sent since
         
         bool isAvailable() const {
-            return state == WorkerState::IDLE;
+            return (state == WorkerState::IDLE || state == WorkerState::WORKING) && freeSlots > 0;
+        }
+    };
+
+    struct PendingEntry {
+        std::uint8_t priority;
+        std::uint64_t seq;
+        std::string taskId;
+
+        bool operator<(const PendingEntry& other) const {
+            if (priority != other.priority) return priority < other.priority;
+            return seq > other.seq;
         }
     };
+
+    struct TimerWheel;
+
+    // Side effects collected under tasks_mutex_ and carried out by flush()
+    // once it is released.
+    struct Outbox {
+        std::vector<std::pair<Message, std::uint8_t>> messages;  // message, priority
+        std::vector<std::pair<std::string, TaskStatus>> progress;
+        std::vector<TaskResult> finished;
+    };
     
+    NetworkError submit(TaskRequest request, std::future<TaskResult>* outFuture);
     void handleTaskResult(const Message& msg);
     void handleWorkerAnnouncement(const Message& msg);
-    void updateTaskStatus(const std::string& taskId, TaskStatus newStatus);
-    void completeTask(const std::string& taskId, const TaskResult& result);
-    void retryTask(const std::string& taskId);
     std::string generateTaskId();
     std::optional<std::string> selectWorker(const WorkerCapabilities& required);
-    void publishTask(const TaskRequest& request);
     void cleanupExpiredTasks();
     void emitProgress(const std::string& taskId, TaskStatus status);
+
+    // The *Locked helpers run with tasks_mutex_ held.
+    // Assigns a worker, arms the attempt deadline and queues the task message.
+    void dispatchLocked(TaskState& state, Outbox& out);
+    // Fills free in-flight slots from pending_ in priority order.
+    void fillSlotsLocked(Outbox& out);
+    // Abandons the current attempt and arms a backoff timer for the next;
+    // returns false once the task has used up its retries.
+    bool retryLocked(TaskState& state, Outbox& out);
+    // Moves a task to a terminal status and wakes its waiters; returns false
+    // if it was already terminal.
+    bool finishLocked(TaskState& state, TaskResult result, Outbox& out);
+    void flush(Outbox& out);
+    void indexWorker(const WorkerInfo& info, bool add);
+    // Hands back slots held by abandoned or finished attempts; takes
+    // workers_mutex_, so call it after tasks_mutex_ is released.
+    void releaseWorkerSlots(const std::vector<std::string>& workerIds);
+    void timerLoop();
     
     std::shared_ptr<IPubSub> pubsub_;
     RequesterOptions options_;
+    std::string requester_id_;
     
     std::atomic<bool> running_{false};
     
     mutable std::mutex tasks_mutex_;
     std::unordered_map<std::string, std::shared_ptr<TaskState>> tasks_;
+    // Ordered rather than a heap so cancelled tasks can be erased in place;
+    // the highest priority entry is the last one.
+    std::set<PendingEntry> pending_;
+    std::size_t in_flight_ = 0;
+    std::size_t active_count_ = 0;       // Tasks not yet in a terminal status
+    std::uint64_t next_seq_ = 0;
+    std::unique_ptr<TimerWheel> wheel_;
     
     mutable std::mutex workers_mutex_;
     std::unordered_map<std::string, WorkerInfo> workers_;
+    // Capability index: attribute value -> workers advertising it.
+    std::unordered_map<std::string, std::unordered_set<std::string>> workers_by_type_;
+    std::unordered_map<std::string, std::unordered_set<std::string>> workers_by_capacity_;
+    std::unordered_map<std::string, std::unordered_set<std::string>> workers_by_format_;
+
+    std::mutex timer_mutex_;
+    std::condition_variable timer_cv_;
+    std::thread timer_thread_;
     
     std::mutex callback_mutex_;
     TaskCompletionCallback completion_callback_;
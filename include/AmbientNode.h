@@ -9,6 +9,9 @@
 #include <unordered_map>
 #include <chrono>
 #include <cstdint>
+#include <condition_variable>
+#include <deque>
+#include <thread>
 
 namespace ailee::net {
 
@@ -239,6 +242,11 @@ public:
 // Concrete Implementation: AmbientWorkerNode
 // ============================================================================
 
+// Runs tasks on a fixed pool of maxConcurrentTasks executor threads with a
+// backlog of the same size; directed tasks beyond that are rejected at once
+// so the requester can retry elsewhere. Heartbeats advertise the slots that
+// are actually free. Handlers cancel cooperatively by polling isCancelled(),
+// and results are published in per-requester batches.
 class AmbientWorkerNode : public IWorkerNode {
 public:
     explicit AmbientWorkerNode(std::shared_ptr<IPubSub> pubsub, 
@@ -278,26 +286,60 @@ public:
     // Heartbeat
     void sendHeartbeat() override;
     std::chrono::milliseconds getUptime() const override;
+
+    // For task handlers: true once `taskId` was cancelled (or is unknown).
+    bool isCancelled(const std::string& taskId) const;
+    const std::string& peerId() const { return worker_id_; }
     
 private:
+    struct ActiveTask {
+        TaskInfo info;
+        std::uint32_t attempt = 0;   // Newest attempt the requester sent us
+        bool running = false;
+        bool cancelled = false;
+        bool reportCancel = false;   // Tell the requester (local cancel) or not (it asked)
+    };
+
+    struct ResultOutbox;
+
     void changeState(WorkerState newState);
-    void handleIncomingTask(const Message& msg);
+    void notifyStateChange(WorkerState oldState, WorkerState newState);
+    void handleIncomingTask(const Message& msg, bool directed);
+    void handleCancel(const Message& msg);
     void processTask(const TaskInfo& taskInfo);
     void reportTaskResult(const std::string& taskId, bool success, 
                          const std::vector<std::uint8_t>& result);
+    void queueResult(const std::string& requesterId, const std::string& taskId,
+                     std::uint32_t attempt, bool success,
+                     std::vector<std::uint8_t> result, std::string error);
+    bool cancel(const std::string& taskId, bool report);
     void emitError(NetworkErrorCode code, const std::string& message);
+    void executorLoop();
+    void reporterLoop();
+    void flushResults();
+    std::uint32_t freeSlotsLocked() const;
     
     std::shared_ptr<IPubSub> pubsub_;
     WorkerCapabilities capabilities_;
+    std::string worker_id_;
     
     mutable std::mutex state_mutex_;
     std::atomic<WorkerState> state_{WorkerState::UNINITIALIZED};
     
     mutable std::mutex tasks_mutex_;
-    std::unordered_map<std::string, TaskInfo> active_tasks_;
+    std::unordered_map<std::string, ActiveTask> active_tasks_;
+    std::deque<std::string> ready_;          // Admitted, not yet started
+    std::condition_variable exec_cv_;
+    std::vector<std::thread> executors_;
+    std::uint32_t slots_ = 0;                // Executor threads; also the backlog bound
+    std::uint32_t running_tasks_ = 0;
+    bool stopping_ = false;
     
     std::uint64_t total_tasks_processed_ = 0;
     std::uint64_t total_tasks_failed_ = 0;
+
+    std::unique_ptr<ResultOutbox> outbox_;
+    std::thread reporter_;
     
     std::mutex callback_mutex_;
     TaskHandler task_handler_;
@@ -308,6 +350,9 @@ private:
     std::atomic<std::uint64_t> last_heartbeat_{0};
     
     SubscriptionId task_subscription_id_ = 0;
+    SubscriptionId broadcast_subscription_id_ = 0;
+    SubscriptionId cancel_subscription_id_ = 0;
+    SubscriptionId discover_subscription_id_ = 0;
 };
 
 } // namespace ailee::net
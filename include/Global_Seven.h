@@ -20,6 +20,12 @@
 #include <memory>
 #include <atomic>
 #include <cmath>
+#include <array>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
 
 namespace ailee::l1 {
 class AILEEMempoolAdapter;
@@ -73,6 +79,8 @@ enum class Chain {
     Custom2
 };
 
+constexpr size_t kChainCount = static_cast<size_t>(Chain::Custom2) + 1;
+
 enum class Severity { Debug, Info, Warn, Error, Critical };
 
 // ---------- Diagnostics ----------
@@ -334,99 +342,122 @@ public:
 
 // ---------- Registry (pluggable adapters) ----------
 
+// Immutable chain -> adapter table. A published table is never modified;
+// registration publishes a new one, and holders of an old table keep its
+// adapters alive.
+using AdapterTable = std::array<std::shared_ptr<IChainAdapter>, kChainCount>;
+
 class AdapterRegistry {
 public:
     static AdapterRegistry& instance();
     void registerAdapter(Chain chain, std::unique_ptr<IChainAdapter> adapter);
-    IChainAdapter* get(Chain chain) const;
+
+    // Reads the currently published table; never waits on registration.
+    // The returned reference keeps the adapter alive even if it is replaced
+    // meanwhile. Out-of-range chains yield nullptr.
+    std::shared_ptr<IChainAdapter> get(Chain chain) const;
+    std::shared_ptr<const AdapterTable> snapshot() const;
 
 private:
-    AdapterRegistry() = default;
-    std::unordered_map<Chain, std::unique_ptr<IChainAdapter>> adapters_;
+    AdapterRegistry();
+    std::shared_ptr<const AdapterTable> table_;
 };
 
 // ---------- Bitcoin‑anchored settlement orchestrator ----------
 
+struct SettlementReceipt {
+    bool        ok{false};
+    std::string targetTxId;
+    RiskFlags   risk;
+    size_t      coalescedIntents{0};    // intents that shared the broadcast
+};
+
+using SettlementCallback = std::function<void(const SettlementReceipt&)>;
+
+// Settles intents either synchronously (execute) or through one bounded
+// queue and worker thread per target chain (submit). Workers drain their
+// queue in batches, apply the risk checks to the whole batch against one
+// snapshot of the risk state, and coalesce intents that share settlement
+// kind, vault and peg tag into one multi-output broadcast, so a slow
+// adapter only delays its own chain. onError may be called from worker
+// threads.
 class SettlementOrchestrator {
 public:
-    explicit SettlementOrchestrator(ErrorCallback onError) : onError_(std::move(onError)) {}
+    static constexpr size_t kDefaultQueueCapacity = 1024;
+    static constexpr size_t kMaxOutputsPerBroadcast = 64;
+
+    explicit SettlementOrchestrator(ErrorCallback onError, size_t queueCapacity = kDefaultQueueCapacity);
+    ~SettlementOrchestrator();
+
+    SettlementOrchestrator(const SettlementOrchestrator&) = delete;
+    SettlementOrchestrator& operator=(const SettlementOrchestrator&) = delete;
 
     // Execute intent with risk controls; returns target chain tx id if broadcast occurs
     bool execute(const SettlementIntent& intent,
                  std::string& outTargetTxId,
-                 RiskFlags& outRisk) {
-
-        outRisk = currentRisk_;
-
-        // Circuit breaker: force BTC settlement only
-        if (currentRisk_.circuitBreakerTripped) {
-            if (intent.targetChain != Chain::Bitcoin) {
-                outRisk.reason = "Circuit breaker: non‑BTC settlement blocked.";
-                return false;
-            }
-        }
-
-        // Oracle confidence check (if provided)
-        if (intent.oracle.has_value() && intent.oracle->confidence < minOracleConfidence_) {
-            outRisk.anomalyDetected = true;
-            outRisk.reason = "Low oracle confidence.";
-            if (enforceOracleConfidence_) return false;
-        }
-
-        // Fee/slippage pre‑check (display‑level validation; exact math in adapters)
-        // Note: actual settlement math must be integer‑safe and done per chain adapter.
-        if (intent.slippagePolicy.enforceHard && intent.slippagePolicy.maxSlippagePct <= 0.0) {
-            outRisk.reason = "Invalid slippage policy.";
-            return false;
-        }
-
-        // Route to target adapter (often BTC for final settlement)
-        IChainAdapter* adapter = AdapterRegistry::instance().get(intent.targetChain);
-        if (!adapter) {
-            outRisk.reason = "No adapter registered for target chain.";
-            return false;
-        }
-
-        // Build outputs (simplified; actual peg logic handled upstream)
-        std::vector<TxOut> outs;
-        TxOut o;
-        o.address = intent.params.count("targetAddress") ? intent.params.at("targetAddress") : "";
-        o.amount  = intent.minReceiveTarget;
-        outs.push_back(o);
-
-        std::unordered_map<std::string, std::string> opts = {
-            {"settlementKind", std::to_string(static_cast<int>(intent.kind))},
-            {"vaultId", intent.params.count("vaultId") ? intent.params.at("vaultId") : ""},
-            {"pegTag", intent.params.count("pegTag") ? intent.params.at("pegTag") : ""}
-        };
+                 RiskFlags& outRisk);
 
-        // Broadcast via target adapter
-        std::string txid;
-        bool ok = adapter->broadcastTransaction(outs, opts, txid);
-        if (!ok) {
-            outRisk.reason = "Broadcast failed at target adapter.";
-            currentRisk_.anomalyDetected = true;
-            onError_(AdapterError{Severity::Error, "Broadcast failure", "Orchestrator", -2});
-            return false;
-        }
-
-        outTargetTxId = txid;
-        return true;
-    }
+    // Queue intent on its target chain. A full queue or stopped orchestrator
+    // yields an immediately ready, failed receipt.
+    std::future<SettlementReceipt> submit(SettlementIntent intent);
 
-    void setRisk(const RiskFlags& r) { currentRisk_ = r; }
-    RiskFlags getRisk() const { return currentRisk_; }
+    // As above, but delivers the receipt to onDone (on a worker thread once
+    // queued). Returns false if the intent was rejected without queueing;
+    // onDone has then already been called.
+    bool submit(SettlementIntent intent, SettlementCallback onDone);
 
-    void setOracleConfidenceFloor(double floor, bool enforce) {
-        minOracleConfidence_ = floor;
-        enforceOracleConfidence_ = enforce;
-    }
+    // Stops accepting intents, settles everything already queued and joins
+    // the workers. Called by the destructor.
+    void shutdown();
+
+    void setRisk(const RiskFlags& r);
+    RiskFlags getRisk() const;
+
+    void setOracleConfidenceFloor(double floor, bool enforce);
 
 private:
+    struct RiskState {
+        RiskFlags risk;
+        double    minOracleConfidence;
+        bool      enforceOracleConfidence;
+    };
+
+    struct Pending {
+        SettlementIntent                  intent;
+        std::promise<SettlementReceipt>   promise;
+        SettlementCallback                callback;
+        bool                              done{false};
+    };
+
+    struct Lane {
+        std::mutex              mutex;
+        std::condition_variable cv;
+        std::deque<Pending>     queue;
+        bool                    stopping{false};
+        std::thread             worker;
+    };
+
+    RiskState riskSnapshot() const;
+    static bool precheck(const SettlementIntent& intent, const RiskState& state, RiskFlags& outRisk);
+    void markBroadcastFailure();
+
+    bool enqueue(Pending pending);
+    void runLane(Chain chain, Lane& lane);
+    void settleBatch(Chain chain, std::vector<Pending>& batch);
+    void complete(Pending& pending, const SettlementReceipt& receipt);
+    void reportError(const std::string& message);
+
     ErrorCallback onError_;
+    size_t        queueCapacity_;
+
+    mutable std::mutex riskMutex_;
     RiskFlags     currentRisk_{};
     double        minOracleConfidence_{0.7};
     bool          enforceOracleConfidence_{true};
+
+    std::mutex    lanesMutex_;
+    bool          stopped_{false};
+    std::array<std::unique_ptr<Lane>, kChainCount> lanes_;
 };
 
 // ---------- Example adapter stubs (names only; implement in .cpp) ----------
@@ -10,6 +10,23 @@ struct GenesisInfo {
     uint8_t genesis_anchor_root[32];
 };
 
+// The three reflection values as read at one point in time. Slices point
+// either into `pinned` (filled by handles that pin storage blocks) or into
+// memory owned by the handle, and stay valid until this object is reused or
+// destroyed. A missing key leaves its slice empty and its has_* flag false.
+struct ReflectionRead {
+    rocksdb::Slice block_height;
+    rocksdb::Slice anchor;
+    rocksdb::Slice reorg;
+    bool has_block_height = false;
+    bool has_anchor = false;
+    bool has_reorg = false;
+    bool has_sequence = false;
+    uint64_t sequence = 0;              // storage sequence number the read observed
+
+    rocksdb::PinnableSlice pinned[3];   // block height, anchor, reorg
+};
+
 class RocksDbHandle {
 public:
     virtual ~RocksDbHandle() = default;
@@ -25,6 +42,26 @@ public:
     virtual bool get_raw_anchor_slice(rocksdb::Slice& /*out_slice*/) const = 0;
     virtual bool get_raw_reorg_slice(rocksdb::Slice& /*out_slice*/) const = 0;
     virtual bool get_raw_block_height_slice(rocksdb::Slice& /*out_slice*/) const = 0;
+
+    // Reads all reflection values at once. The default issues the three
+    // getters above, which is only consistent if the handle itself is;
+    // storage-backed handles override it with a single snapshot read.
+    // Returns false if the read itself failed (not for missing keys).
+    virtual bool read_reflection(ReflectionRead& out) const {
+        // Sequence first: a write landing mid-read then shows up as a change.
+        out.has_sequence = latest_sequence_number(out.sequence);
+        out.block_height = rocksdb::Slice();
+        out.anchor = rocksdb::Slice();
+        out.reorg = rocksdb::Slice();
+        out.has_block_height = get_raw_block_height_slice(out.block_height);
+        out.has_anchor = get_raw_anchor_slice(out.anchor);
+        out.has_reorg = get_raw_reorg_slice(out.reorg);
+        return true;
+    }
+
+    // Sequence number of the newest write visible to readers. Handles that
+    // cannot tell return false, and callers must then assume a change.
+    virtual bool latest_sequence_number(uint64_t& /*out_sequence*/) const { return false; }
 };
 
 } // namespace ailee
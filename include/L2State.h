@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
@@ -12,6 +13,7 @@ class SidechainBridge;
 
 namespace ailee::econ {
 class ILedger;
+struct LedgerVersion;
 }
 
 namespace ailee::sched {
@@ -32,6 +34,7 @@ struct LedgerEscrowSnapshot {
     std::uint64_t amount{0};
     bool locked{false};
     std::uint64_t createdAt{0};
+    std::uint64_t timeoutMs{0};  // 0 = never expires
 };
 
 struct LedgerSnapshot {
@@ -65,8 +68,10 @@ struct PegOutSnapshot {
 };
 
 struct BridgeSnapshot {
-    std::vector<PegInSnapshot> pegins;
-    std::vector<PegOutSnapshot> pegouts;
+    std::vector<PegInSnapshot> pegins;      // In-flight only
+    std::vector<PegOutSnapshot> pegouts;    // In-flight only
+    std::string archiveRoot;                // Running root over archived items, empty if none
+    std::uint64_t archivedCount{0};
 };
 
 struct TaskSnapshot {
@@ -94,6 +99,10 @@ struct AnchorSnapshot {
 struct L2StateSnapshot {
     std::uint64_t snapshotTimestampMs{0};
     LedgerSnapshot ledger;
+    // Set by captureSnapshot instead of filling `ledger`: an O(1) version
+    // of the live ledger. When set it is the ledger section, and the state
+    // root and snapshot file walk it in key order.
+    std::shared_ptr<const ailee::econ::LedgerVersion> ledgerVersion;
     BridgeSnapshot bridge;
     OrchestrationSnapshot orchestration;
     std::optional<AnchorSnapshot> anchor;
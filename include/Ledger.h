@@ -1,8 +1,11 @@
 #pragma once
 #include <string>
-#include <unordered_map>
 #include <optional>
+#include <set>
+#include <unordered_map>
+#include <utility>
 #include <cstdint>
+#include <limits>
 #include <mutex>
 #include <shared_mutex>
 #include <functional>
@@ -10,6 +13,7 @@
 #include <stdexcept>
 
 #include "L2State.h"
+#include "util/PersistentMap.h"
 
 namespace ailee::econ {
 
@@ -50,6 +54,15 @@ struct Escrow {
     std::uint64_t amount = 0;
     bool locked = false;
     std::uint64_t createdAt = 0;  // Timestamp for tracking
+    std::uint64_t timeoutMs = 0;  // Refundable by sweepExpired() after createdAt + timeoutMs; 0 = never
+    
+    std::uint64_t deadline() const {
+        if (timeoutMs == 0) return 0;
+        // Saturate rather than wrap so a huge timeout never looks expired
+        return createdAt > std::numeric_limits<std::uint64_t>::max() - timeoutMs
+            ? std::numeric_limits<std::uint64_t>::max()
+            : createdAt + timeoutMs;
+    }
     
     bool isValid() const {
         return !taskId.empty() && !clientPeerId.empty() && amount > 0;
@@ -75,6 +88,26 @@ struct LedgerEvent {
 
 using LedgerEventCallback = std::function<void(const LedgerEvent&)>;
 
+// Outcome of one InMemoryLedger::sweepExpired() pass.
+struct EscrowSweepResult {
+    std::vector<std::string> refundedTaskIds;
+    std::uint64_t refundedAmount = 0;
+    std::size_t skippedLocked = 0;   // newly expired but locked, left in place
+    bool more = false;               // limit reached with expired escrows remaining
+};
+
+// Immutable, key-ordered view of the ledger at one point in time.
+// Obtaining one is O(1): it shares structure with the live ledger, and
+// later writes path-copy instead of mutating nodes this view can reach.
+struct LedgerVersion {
+    ailee::util::PersistentMap<std::string, std::uint64_t> balances;  // by peerId
+    ailee::util::PersistentMap<std::string, Escrow> escrows;          // by taskId
+
+    // Flattens the version into the canonical snapshot form. Linear in the
+    // number of entries, already sorted, and takes no ledger locks.
+    ailee::l2::LedgerSnapshot materialize() const;
+};
+
 class ILedger {
 public:
     virtual ~ILedger() = default;
@@ -99,6 +132,8 @@ public:
                          std::uint64_t amount) = 0;
 
     virtual ailee::l2::LedgerSnapshot snapshot() const = 0;
+    // O(1) consistent version handle; see LedgerVersion.
+    virtual LedgerVersion version() const = 0;
     
     // Observability
     virtual void registerEventCallback(LedgerEventCallback callback) = 0;
@@ -135,6 +170,8 @@ public:
                  std::uint64_t amount) override;
 
     ailee::l2::LedgerSnapshot snapshot() const override;
+
+    LedgerVersion version() const override;
     
     // Observability
     void registerEventCallback(LedgerEventCallback callback) override;
@@ -146,6 +183,12 @@ public:
     std::uint64_t getTotalBalance() const;
     std::uint64_t getTotalEscrow() const;
     
+    // Escrow expiry and per-client quotas
+    EscrowSweepResult sweepExpired(std::uint64_t nowMs, std::size_t limit);
+    std::size_t getOutstandingEscrowCount(const std::string& clientPeerId) const;
+    std::uint64_t getOutstandingEscrowAmount(const std::string& clientPeerId) const;
+    void setMaxEscrowsPerClient(std::size_t maxEscrows);  // 0 = unlimited
+    
     // Administrative operations
     void clear();
     bool removeAccount(const std::string& peerId);
@@ -156,14 +199,29 @@ private:
     mutable std::shared_mutex escrows_mutex_;
     mutable std::mutex callback_mutex_;
     
-    std::unordered_map<std::string, std::uint64_t> balances_;
-    std::unordered_map<std::string, Escrow> escrows_;
+    // Persistent ordered maps: writers path-copy under the unique lock,
+    // snapshots just copy the roots under the shared lock.
+    ailee::util::PersistentMap<std::string, std::uint64_t> balances_;
+    ailee::util::PersistentMap<std::string, Escrow> escrows_;
+    
+    // Guarded by escrows_mutex_. Expiry index is ordered by (deadline, taskId)
+    // and only holds escrows with a timeout that have not yet been swept.
+    // Locked escrows found expired leave the index so later sweeps don't
+    // rescan them; they stay in escrows_ until released or refunded.
+    struct ClientEscrowUsage {
+        std::size_t count = 0;
+        std::uint64_t amount = 0;
+    };
+    std::set<std::pair<std::uint64_t, std::string>> escrow_expiry_;
+    std::unordered_map<std::string, ClientEscrowUsage> client_escrows_;
+    std::size_t max_escrows_per_client_ = 0;
     
     LedgerEventCallback event_callback_;
     
     // Helper methods
     void emitEvent(LedgerEventType type, const std::string& peerId, 
                    std::uint64_t amount, const std::optional<std::string>& taskId = std::nullopt);
+    void emitEvents(const std::vector<LedgerEvent>& events);
     
     bool validatePeerId(const std::string& peerId) const;
     bool validateAmount(std::uint64_t amount) const;
@@ -171,6 +229,8 @@ private:
     // Internal helpers that assume locks are held
     std::uint64_t getBalance_unsafe(const std::string& peerId) const;
     void setBalance_unsafe(const std::string& peerId, std::uint64_t balance);
+    void insertEscrow_unsafe(const Escrow& escrow);
+    void eraseEscrow_unsafe(const Escrow& escrow);
 };
 
 } // namespace ailee::econ
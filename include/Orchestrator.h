@@ -22,6 +22,10 @@
 #include "ProverSwarm.h"
 #include "protocol/ProtocolFrame.hpp"
 
+namespace ailee::econ {
+class InMemoryLedger;
+}
+
 namespace ailee::sched {
 
 // ==================== CORE TYPES ====================
@@ -243,6 +247,7 @@ struct EconomicConfig {
     double priceAdjustmentRate = 0.1;
     uint64_t slashingPenalty = 100;
     double reputationDecayRate = 0.01;
+    std::size_t escrowSweepLimit = 256;  // Expired escrows refunded per discovery tick
 };
 
 struct MonitoringConfig {
@@ -562,6 +567,12 @@ public:
 
     void setCustomScorer(ScorerFn scorer) { customScorer_ = std::move(scorer); }
 
+    // Batch entry points. Under the score-based strategies the whole batch is
+    // assigned at once: each worker takes at most maxConcurrentTasks -
+    // activeTaskCount tasks (maxConcurrentTasks == 0 means no limit) and the
+    // total score is maximised by an auction, so a burst spreads across
+    // workers instead of piling onto the top scorer. Other strategies assign
+    // task by task as before.
     std::vector<Assignment> assignParallel(const std::vector<TaskPayload>& tasks,
                                            const std::vector<NodeMetrics>& candidates) const;
 
@@ -601,8 +612,13 @@ private:
                      double trustW,
                      double speedW,
                      double powerW) const;
-    std::vector<NodeMetrics> filterCandidates(const std::vector<NodeMetrics>& candidates,
-                                              const TaskPayload& task) const;
+    std::vector<const NodeMetrics*> filterCandidates(const std::vector<NodeMetrics>& candidates,
+                                                     const TaskPayload& task) const;
+    std::vector<Assignment> assignBatchGlobal(const std::vector<TaskPayload>& tasks,
+                                              const std::vector<NodeMetrics>& candidates,
+                                              double trustW,
+                                              double speedW,
+                                              double powerW) const;
 
     IReputationLedger& rep_;
     ILatencyMap& lat_;
@@ -887,6 +903,10 @@ public:
     std::vector<TaskPayload> getQueuedTasks() const { return taskQueue_.snapshot(); }
     
     ailee::orchestration::ProverSwarm* getProverSwarm() const { return proverSwarm_.get(); }
+    
+    // Escrow ledger whose expired escrows the discovery loop refunds.
+    // Not owned; must outlive the engine or be detached with nullptr.
+    void attachEscrowLedger(ailee::econ::InMemoryLedger* ledger) { escrowLedger_.store(ledger); }
 
 private:
     Config config_;
@@ -894,6 +914,7 @@ private:
     LatencyMap latencyMap_;
     WeightedOrchestrator orchestrator_;
     std::unique_ptr<ailee::orchestration::ProverSwarm> proverSwarm_;
+    std::atomic<ailee::econ::InMemoryLedger*> escrowLedger_{nullptr};
     
     std::atomic<bool> running_;
     TaskQueue taskQueue_;
@@ -950,6 +971,9 @@ private:
                 // Decay inactive reputations
                 repLedger_.decayInactiveNodes(std::chrono::hours(24));
                 
+                // Refund escrows whose timeout has passed
+                sweepExpiredEscrows();
+                
             } catch (const std::exception& e) {
                 // Log error
             }
@@ -976,6 +1000,8 @@ private:
     
     // ========== Helper Methods ==========
     
+    void sweepExpiredEscrows();  // Orchestrator.cpp, which links the ledger
+    
     std::vector<NodeMetrics> discoverNodes() const {
         return getNodes();
     }
@@ -10,7 +10,10 @@
 #include <cstdint>
 #include <chrono>
 #include <optional>
+#include <condition_variable>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <nlohmann/json.hpp>
 
 namespace rocksdb {
@@ -22,6 +25,7 @@ namespace ailee::orchestration {
 
 struct ProverIdentity {
     std::string pubkey;
+    std::string endpoint;
     double reputation = 0.5;
     double capacity = 1.0;
     double latency_ms = 0.0;
@@ -30,6 +34,7 @@ struct ProverIdentity {
     nlohmann::json toJson() const {
         nlohmann::json j;
         j["pubkey"] = pubkey;
+        j["endpoint"] = endpoint;
         j["reputation"] = reputation;
         j["capacity"] = capacity;
         j["latency_ms"] = latency_ms;
@@ -40,6 +45,7 @@ struct ProverIdentity {
     static ProverIdentity fromJson(const nlohmann::json& j) {
         ProverIdentity p;
         if (j.contains("pubkey")) p.pubkey = j["pubkey"].get<std::string>();
+        if (j.contains("endpoint")) p.endpoint = j["endpoint"].get<std::string>();
         if (j.contains("reputation")) p.reputation = j["reputation"].get<double>();
         if (j.contains("capacity")) p.capacity = j["capacity"].get<double>();
         if (j.contains("latency_ms")) p.latency_ms = j["latency_ms"].get<double>();
@@ -102,6 +108,20 @@ struct ProverJob {
     }
 };
 
+// One proof outcome reported by the prover that leased the job.
+struct ProofResult {
+    std::string job_id;
+    bool success = false;
+    double latency_ms = 0.0;
+};
+
+// Result of a bulk call: how many entries took effect, and why the others
+// did not (key is the pubkey or job id the entry named).
+struct BatchOutcome {
+    std::size_t accepted = 0;
+    std::vector<std::pair<std::string, std::string>> rejected;
+};
+
 struct SwarmMetrics {
     std::uint64_t queue_depth = 0;
     double avg_proof_latency_ms = 0.0;
@@ -139,6 +159,23 @@ public:
 
     std::vector<std::string> checkTimeouts(std::uint64_t current_time_ms);
 
+    // Bulk forms for large prover fleets. Each call commits a single
+    // WriteBatch and rewrites queue_order at most once.
+    // Already-registered provers count as accepted and are left unchanged.
+    BatchOutcome registerProvers(const std::vector<ProverIdentity>& provers, std::string* err = nullptr);
+    // Records liveness; unknown and banned provers are rejected.
+    BatchOutcome heartbeat(const std::vector<std::string>& pubkeys, std::uint64_t now_ms);
+    std::optional<std::uint64_t> lastHeartbeat(const std::string& pubkey) const;
+    // Assigns up to max_jobs unassigned jobs to `pubkey`. With a non-zero
+    // `wait`, blocks until at least one job is available or the wait ends.
+    std::vector<ProverJob> leaseJobs(const std::string& pubkey, std::size_t max_jobs,
+                                     std::chrono::milliseconds wait = std::chrono::milliseconds(0),
+                                     std::string* err = nullptr);
+    // Applies results for jobs leased by `pubkey`, with the same effect as
+    // recordJobSuccess/recordJobFailure per entry.
+    BatchOutcome submitResults(const std::string& pubkey, const std::vector<ProofResult>& results,
+                               std::string* err = nullptr);
+
     std::optional<ProverIdentity> getProver(const std::string& pubkey) const;
     std::vector<ProverIdentity> getAllProvers() const;
     SwarmMetrics getMetrics() const;
@@ -153,12 +190,20 @@ private:
     rocksdb::ColumnFamilyHandle* state_cf_ = nullptr;
 
     mutable std::mutex mu_;
+    std::condition_variable jobs_cv_;   // Signalled when jobs become leasable
 
     std::vector<std::string> queue_order_;
+    // Queued jobs that currently have a prover, so leasing skips them
+    // without reading them back from the DB.
+    std::unordered_set<std::string> assigned_;
+    std::unordered_map<std::string, std::uint64_t> heartbeats_;
 
     SwarmMetrics metrics_;
     double total_latency_ms_ = 0.0;
 
+    bool hasLeasableJobLocked() const { return queue_order_.size() > assigned_.size(); }
+    static nlohmann::json queueOrderJson(const std::vector<std::string>& order);
+
     bool saveQueueOrder(std::string* err = nullptr);
     bool loadQueueOrder(std::string* err = nullptr);
     bool saveJob(const ProverJob& job, std::string* err = nullptr);
@@ -46,10 +46,27 @@ bool reflect_reorg_event(
     CacheAlignedReorgEvent& out_reorg
 );
 
+// All three values come from one RocksDbHandle::read_reflection call, so a
+// storage-backed handle yields a snapshot no concurrent writer can tear.
 ReflectionSnapshot build_reflection_snapshot(
     const RocksDbHandle& db
 );
 
+// Storage position a snapshot was last reflected at.
+struct ReflectionCursor {
+    uint64_t sequence;
+    bool valid;
+};
+
+// Rebuilds `snap` unless the handle reports no writes since `cursor`.
+// Returns true if `snap` was rebuilt. On a failed read `snap` is left as is,
+// the cursor is invalidated and false is returned.
+bool refresh_reflection_snapshot(
+    const RocksDbHandle& db,
+    ReflectionSnapshot& snap,
+    ReflectionCursor& cursor
+);
+
 uint64_t reflection_get_height(const ReflectionSnapshot& snap);
 const uint8_t* reflection_get_anchor_hash(const ReflectionSnapshot& snap);
 uint64_t reflection_get_anchor_height(const ReflectionSnapshot& snap);
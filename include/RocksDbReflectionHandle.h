@@ -0,0 +1,93 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "L1Reflection.h"
+
+// Forward declarations
+namespace rocksdb {
+    class DB;
+}
+
+namespace ailee {
+
+// Keys the reflection values are stored under in the default column family.
+struct ReflectionKeys {
+    std::string block_height = "reflection:l1_height";
+    std::string anchor = "reflection:anchor";
+    std::string reorg = "reflection:reorg";
+};
+
+/**
+ * @brief RocksDbHandle backed by a live RocksDB instance.
+ *
+ * read_reflection() fetches all reflection keys with one MultiGet against a
+ * single snapshot and hands back pinned slices, so the values are neither
+ * torn by concurrent writers nor copied. The sequence number it records is
+ * what refresh_reflection_snapshot() compares against to skip unchanged
+ * ticks. Any write to the database advances it, so the check is
+ * conservative: it may re-reflect needlessly but never misses a change.
+ *
+ * The raw slice getters pin into thread_local buffers owned by the calling
+ * thread: a returned slice stays valid until that thread calls the same
+ * getter again, the thread exits, or the handle is destroyed, and other
+ * threads never touch it. A thread's pins are released when it exits, and
+ * the handle's destructor releases those of threads still running. The
+ * decoded getters and read_reflection() pin per call and hold nothing
+ * afterwards.
+ */
+class RocksDbReflectionHandle : public RocksDbHandle {
+public:
+    explicit RocksDbReflectionHandle(std::shared_ptr<rocksdb::DB> db, ReflectionKeys keys = ReflectionKeys());
+    ~RocksDbReflectionHandle() override;
+
+    uint64_t get_latest_l1_height() const override;
+    void get_latest_confirmed_anchor(uint8_t out_hash[32]) const override;
+
+    bool get_raw_value(const std::string& key, rocksdb::Slice& out_slice) const override;
+    bool get_raw_anchor_slice(rocksdb::Slice& out_slice) const override;
+    bool get_raw_reorg_slice(rocksdb::Slice& out_slice) const override;
+    bool get_raw_block_height_slice(rocksdb::Slice& out_slice) const override;
+
+    bool read_reflection(ReflectionRead& out) const override;
+    bool latest_sequence_number(uint64_t& out_sequence) const override;
+
+    // Threads currently holding raw-slice pins on this handle.
+    size_t pinned_thread_count() const;
+
+private:
+    // Buffers behind the raw slice getters, one set per calling thread.
+    // Owned by that thread's thread_local table; the handle only tracks them.
+    struct ThreadPins {
+        rocksdb::PinnableSlice value;
+        rocksdb::PinnableSlice anchor;
+        rocksdb::PinnableSlice reorg;
+        rocksdb::PinnableSlice height;
+        // Set once the owning handle is gone; the thread drops the entry.
+        std::atomic<bool> orphaned{false};
+    };
+
+    bool get_pinned(const std::string& key, rocksdb::PinnableSlice& pinned, rocksdb::Slice& out_slice) const;
+    ThreadPins& pins_for_this_thread() const;
+
+    std::shared_ptr<rocksdb::DB> db_;
+    ReflectionKeys keys_;
+    // Never reused, so a thread cannot mistake a later handle for this one.
+    uint64_t id_;
+
+    // Pins of threads that have used the raw getters; expired entries belong
+    // to threads that have exited.
+    mutable std::mutex pins_mutex_;
+    mutable std::vector<std::weak_ptr<ThreadPins>> pins_;
+
+    // The calling thread's pins, by handle id. Destroyed at thread exit,
+    // which releases whatever the thread still has pinned.
+    static thread_local std::unordered_map<uint64_t, std::shared_ptr<ThreadPins>> thread_pins_;
+};
+
+} // namespace ailee
@@ -1,9 +1,78 @@
+// SPDX-License-Identifier: MIT
+// SwarmHttpServer.h — Batched HTTP API for provers joining a ProverSwarm
+
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace httplib {
+class Server;
+}
+
+namespace ailee::zk {
+class VerificationPool;
+struct VerificationKey;
+}
+
+namespace ailee::orchestration {
+
 class ProverSwarm;
 
+struct SwarmHttpConfig {
+    std::size_t max_batch = 512;              // Entries accepted in one request
+    std::uint64_t max_lease_wait_ms = 30000;  // Cap on long-poll lease waits
+    std::size_t max_long_polls = 64;          // Leases waiting at once; the rest return immediately
+    double max_latency_ms = 600000.0;         // Reported latencies are clamped to this
+
+    // Checks the proof attached to each successful result. Without a pool,
+    // successful results are rejected. Both must outlive the server.
+    zk::VerificationPool* verifier = nullptr;
+    std::shared_ptr<const zk::VerificationKey> verification_key;
+};
+
+/**
+ * Prover-facing routes, all POST with JSON bodies:
+ *
+ *   /prover/register    {"provers": [{"pubkey", "endpoint"}, ...]}
+ *   /prover/heartbeat   {"heartbeats": [{"pubkey", "nonce", "signature"}, ...]}
+ *   /prover/jobs/lease  {"pubkey", "nonce", "signature", "max_jobs", "wait_ms"}
+ *                         -> {"jobs": [{"job_id", "payload", "retry_count"}]}
+ *   /prover/results     {"pubkey", "nonce", "signature",
+ *                        "results": [{"job_id", "success", "latency_ms", "proof"}, ...]}
+ *
+ * Pubkeys are hex secp256k1 keys; reputation and ban state are the swarm's
+ * own. Signatures are hex DER ECDSA over signingDigest(), and each nonce is
+ * accepted once per prover. A successful result carries its proof as hex and
+ * only completes the job once the configured verifier accepts it.
+ *
+ * Batch routes answer {"accepted": n, "rejected": [{"id", "reason"}]}. A
+ * lease with wait_ms > 0 long-polls until a job is queued or the wait ends,
+ * so an idle fleet does not spin on the coordinator.
+ *
+ * The swarm must outlive the server the routes are mounted on.
+ */
 class SwarmHttpServer {
 public:
-    // Optional: hook into existing AILEEWebServer to expose /prover/register
-    static void attach(ProverSwarm& swarm);
+    // Registers the routes with RouteRegistry so AILEEWebServer mounts them;
+    // call before the web server is constructed.
+    static void attach(ProverSwarm& swarm, const SwarmHttpConfig& config = SwarmHttpConfig{});
+
+    // Mounts the routes directly, e.g. on a dedicated prover port.
+    static void attach(ProverSwarm& swarm, httplib::Server& server,
+                       const SwarmHttpConfig& config = SwarmHttpConfig{});
+
+    // What a prover signs for one request: SHA-256 over the route, its
+    // pubkey, the nonce in decimal and `fields`, each prefixed with its
+    // 4-byte big-endian length. Heartbeats and leases sign no fields; results
+    // sign job_id, "1" or "0" for success, and proof for every entry.
+    static std::array<std::uint8_t, 32> signingDigest(const std::string& route, const std::string& pubkey,
+                                                      std::uint64_t nonce,
+                                                      const std::vector<std::string>& fields = {});
 };
+
+} // namespace ailee::orchestration
@@ -2,10 +2,12 @@
 
 #include "SwarmConfig.h"
 
+namespace ailee::orchestration {
 class ProverSwarm; // forward declare, implemented in ProverSwarm.cpp
+}
 
 class SwarmRuntime {
 public:
     // Initialize swarm from config and register provers into ProverSwarm
-    static void initialize(ProverSwarm& swarm);
+    static void initialize(ailee::orchestration::ProverSwarm& swarm);
 };
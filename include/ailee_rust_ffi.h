@@ -18,6 +18,46 @@ int generate_halo2_proof_ffi(const char* task_id, const char* computation_hash,
 int verify_halo2_proof_ffi(const unsigned char* proof_data, size_t proof_len, const char* computation_hash);
 void free_halo2_proof_ffi(Halo2ProofOutput* proof_ptr);
 
+// Batched proving. Inputs are packed arrays of fixed-size binary digests and
+// outputs land in a caller-owned arena, so an epoch-sized run crosses the
+// boundary once and allocates nothing on the callee side.
+
+#define HALO2_DIGEST_LEN 32
+#define HALO2_COMMITMENT_LEN 96
+
+// Per-item status codes written to out_status.
+#define HALO2_ITEM_OK 0
+#define HALO2_ITEM_PROVER_ERROR -1
+#define HALO2_ITEM_ARENA_FULL -2
+
+typedef struct {
+    unsigned char* base;   // Caller-owned buffer
+    size_t capacity;       // Bytes available at base
+    size_t used;           // Bytes written so far; the callee appends from here
+} Halo2ProofArena;
+
+// Offsets are relative to Halo2ProofArena::base.
+typedef struct {
+    size_t proof_offset;
+    size_t proof_len;
+    size_t commitment_offset;
+    size_t commitment_len;
+} Halo2ProofSlice;
+
+// Arena bytes needed to prove `count` items in one call.
+size_t halo2_proof_arena_bound_ffi(size_t count);
+
+// task_digests and computation_digests each hold count * HALO2_DIGEST_LEN
+// bytes; out_slices and out_status hold count entries. Items that do not fit
+// are marked HALO2_ITEM_ARENA_FULL and leave the arena untouched. Returns the
+// number of items proved, or -1 on invalid arguments.
+int generate_halo2_proofs_batch_ffi(const unsigned char* task_digests,
+                                    const unsigned char* computation_digests,
+                                    size_t count,
+                                    Halo2ProofArena* arena,
+                                    Halo2ProofSlice* out_slices,
+                                    int* out_status);
+
 // Network FFI functions for libp2p via rust-libp2p
 int init_network_ffi();
 int broadcast_message_ffi(const char* topic, const unsigned char* payload, size_t payload_len);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <vector>
 #include "NodeIdentity.h"
@@ -40,6 +41,33 @@ struct alignas(64) EngineRunSummary {
 };
 static_assert(sizeof(EngineRunSummary) == 704, "EngineRunSummary must be a multiple of 64 bytes");
 
+// Snapshot of the engine after `step` steps. `digest` rolls over every
+// state produced so far: d = SHA256(d || state) after each step, seeded with
+// SHA256(zero32 || initial state). Because each step's state depends only on
+// that step's inputs, the digest is what covers the steps between checkpoints.
+struct alignas(64) EngineCheckpoint {
+    EngineState state;              // 640 bytes
+    uint64_t step;                  // 8 bytes
+    uint8_t digest[32];             // 32 bytes
+    uint8_t padding[24];            // 640+8+32 = 680. 704 - 680 = 24.
+};
+static_assert(sizeof(EngineCheckpoint) == 704, "EngineCheckpoint must be a multiple of 64 bytes");
+
+// Rolling digest after each step; entry i follows the step that consumed input i.
+using EngineStepDigest = std::array<uint8_t, 32>;
+
+struct alignas(64) EngineVerifyResult {
+    uint64_t first_divergent_step;      // 8 bytes, first differing step if step_exact, else the failing checkpoint's step
+    uint64_t segment_start_step;        // 8 bytes, checkpoint the failing segment replayed from
+    uint64_t segments_verified;         // 8 bytes
+    uint32_t first_divergent_checkpoint;// 4 bytes
+    bool diverged;                      // 1 byte
+    bool state_mismatch;                // 1 byte, checkpoint state itself differs (else only the digest)
+    bool step_exact;                    // 1 byte, located within the segment via the step digest trail
+    uint8_t padding[33];                // 8+8+8+4+1+1+1 = 31. 64 - 31 = 33.
+};
+static_assert(sizeof(EngineVerifyResult) == 64, "EngineVerifyResult must be 64 bytes");
+
 class DeterministicEngine {
 public:
     DeterministicEngine();
@@ -63,6 +91,40 @@ public:
         uint32_t protocol_version
     );
 
+    // As above, additionally recording a checkpoint at step 0, every
+    // `checkpoint_interval` steps and at the final step. When `step_digests`
+    // is given it also receives the rolling digest after every step, which
+    // lets verify_offline pin a divergence to the exact step.
+    static EngineRunSummary run_offline(
+        const std::vector<reflection::ReflectionSnapshot>& snapshots,
+        const std::vector<l1::SettlementIngestion>& ingestions,
+        const std::vector<mesh::MeshCoherenceResult>& coherences,
+        const identity::NodeId& node_id,
+        uint32_t protocol_version,
+        uint64_t checkpoint_interval,
+        std::vector<EngineCheckpoint>& checkpoints,
+        std::vector<EngineStepDigest>* step_digests = nullptr
+    );
+
+    // Re-executes every checkpoint-to-checkpoint segment independently on up
+    // to `max_threads` threads (0 = hardware concurrency) and reports the
+    // first checkpoint whose recomputed state or rolling digest disagrees.
+    // With the recorded `step_digests`, the failing segment is then replayed
+    // from its last good checkpoint to find the first step that differs.
+    static EngineVerifyResult verify_offline(
+        const std::vector<reflection::ReflectionSnapshot>& snapshots,
+        const std::vector<l1::SettlementIngestion>& ingestions,
+        const std::vector<mesh::MeshCoherenceResult>& coherences,
+        const identity::NodeId& node_id,
+        uint32_t protocol_version,
+        const std::vector<EngineCheckpoint>& checkpoints,
+        uint32_t max_threads,
+        const std::vector<EngineStepDigest>* step_digests = nullptr
+    );
+
+    // digest = SHA256(digest || state)
+    static void fold_state_digest(uint8_t digest[32], const EngineState& state);
+
 private:
     EngineState m_state;
 };
@@ -16,8 +16,13 @@ struct NetworkConfig {
     std::string rpc_password;
     std::string network_type;
     uint32_t max_steps;
+    // Steps fetched per JSON-RPC batch. The next batch is fetched while the
+    // current one is stepped, so at most two batches are held at once.
+    uint32_t prefetch_window = 32;
 };
 
+class NetworkRpcSession;
+
 // Wraps a std::vector but keeps 64-byte alignment
 // Note: std::vector dynamic allocation breaks pure POD nature inside the struct,
 // but alignas(64) guarantees the struct's base pointer is aligned.
@@ -44,6 +49,12 @@ public:
 
 private:
     static NetworkSnapshot fetch_network_snapshot(const NetworkConfig& config, uint32_t step);
+
+    // Fetches snapshots for steps [first_step, first_step + count) in two
+    // batched round trips: getblockhash for every step, then getblock,
+    // getmempoolinfo and getpeerinfo for every step.
+    static std::vector<NetworkSnapshot> fetch_network_snapshots(
+        NetworkRpcSession& session, uint32_t first_step, uint32_t count);
 };
 
 } // namespace l3
@@ -3,6 +3,10 @@
 #include <cstdint>
 #include <string>
 
+namespace Json {
+class Value;
+}
+
 namespace ailee {
 namespace l3 {
 
@@ -61,5 +65,10 @@ NetworkMempoolSnapshot parse_network_mempool_snapshot(const std::string& json_da
 // into a deterministic NetworkPeerSnapshot struct.
 NetworkPeerSnapshot parse_network_peer_snapshot(const std::string& json_data);
 
+// Overloads taking an already parsed RPC `result`, so a response is parsed once.
+NetworkBlockSnapshot parse_network_block_snapshot(const Json::Value& root);
+NetworkMempoolSnapshot parse_network_mempool_snapshot(const Json::Value& root);
+NetworkPeerSnapshot parse_network_peer_snapshot(const Json::Value& root);
+
 } // namespace l3
 } // namespace ailee
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include "l4/DeterministicTelemetry.h"
 
@@ -12,7 +13,12 @@ struct DashboardSnapshot {
 
 class DashboardBuilder {
 public:
+    // Every retained sample.
     DashboardSnapshot build_snapshot(const TelemetryBuffer& buffer) const;
+    // Retained samples with first_tick <= tick_count <= last_tick.
+    DashboardSnapshot build_snapshot(const TelemetryBuffer& buffer, uint64_t first_tick, uint64_t last_tick) const;
+    // Per-epoch and per-block min/max/mean rollups.
+    DashboardSnapshot build_rollup_snapshot(const TelemetryBuffer& buffer) const;
 };
 
 } // namespace l4
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 #include "l4/ClusterTypes.h"
@@ -20,8 +21,149 @@ struct alignas(64) TelemetrySample {
 };
 static_assert(sizeof(TelemetrySample) == 64, "TelemetrySample must be 64 bytes");
 
-struct TelemetryBuffer {
-    std::vector<TelemetrySample> samples;
+// Raw per-tick samples kept before the oldest is overwritten.
+static constexpr size_t TELEMETRY_SAMPLE_CAPACITY = 4096;
+// Rollups kept per resolution (epochs, and blocks of TELEMETRY_BLOCK_TICKS ticks).
+static constexpr size_t TELEMETRY_ROLLUP_CAPACITY = 1024;
+static constexpr uint64_t TELEMETRY_BLOCK_TICKS = 1000;
+
+enum TelemetryMetric : uint8_t {
+    TELEMETRY_TOTAL_NODES = 0,
+    TELEMETRY_IN_SYNC_NODES = 1,
+    TELEMETRY_CONSISTENT_STATE_ROOT_NODES = 2,
+    TELEMETRY_INCONSISTENT_STATE_ROOT_NODES = 3,
+    TELEMETRY_GLOBAL_COHERENCE_SCORE = 4,
+    TELEMETRY_METRIC_COUNT = 5
+};
+
+struct TelemetryStat {
+    uint64_t min;
+    uint64_t max;
+    uint64_t sum;
+};
+static_assert(sizeof(TelemetryStat) == 24, "TelemetryStat must be 24 bytes");
+
+// Min/max/sum of every metric over the samples sharing `key` (an epoch
+// height, or tick_count / TELEMETRY_BLOCK_TICKS). Means are integer
+// (sum / sample_count) so rollups stay bit-identical across platforms.
+struct alignas(64) TelemetryRollup {
+    uint64_t key;                                   // 8 bytes
+    uint64_t first_tick;                            // 8 bytes
+    uint64_t last_tick;                             // 8 bytes
+    uint64_t sample_count;                          // 8 bytes
+    TelemetryStat stats[TELEMETRY_METRIC_COUNT];    // 120 bytes
+    uint8_t padding[40];                            // 32+120 = 152. 192 - 152 = 40.
+
+    uint64_t mean(TelemetryMetric metric) const {
+        return sample_count == 0 ? 0 : stats[metric].sum / sample_count;
+    }
+};
+static_assert(sizeof(TelemetryRollup) == 192, "TelemetryRollup must be a multiple of 64 bytes");
+
+// Half-open [begin, end) range of logical ring positions, oldest first.
+struct TelemetryRange {
+    size_t begin;
+    size_t end;
+
+    size_t size() const { return end - begin; }
+    bool empty() const { return begin == end; }
+};
+
+// Fixed-capacity ring of samples stored one column per field. Samples must
+// be appended in non-decreasing tick (and therefore epoch) order, which is
+// what makes the range lookups binary searches.
+class TelemetryRing {
+public:
+    explicit TelemetryRing(size_t capacity = TELEMETRY_SAMPLE_CAPACITY);
+
+    void push_back(const TelemetrySample& sample);
+    void clear();
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t capacity() const { return capacity_; }
+    // Samples overwritten since construction or the last clear().
+    uint64_t evicted() const { return evicted_; }
+
+    // Position 0 is the oldest retained sample.
+    TelemetrySample operator[](size_t pos) const;
+    TelemetrySample front() const { return (*this)[0]; }
+    TelemetrySample back() const { return (*this)[size_ - 1]; }
+
+    uint64_t tick_at(size_t pos) const { return tick_[physical(pos)]; }
+    uint64_t epoch_at(size_t pos) const { return epoch_[physical(pos)]; }
+
+    // Retained samples with first <= tick_count <= last (resp. epoch_height).
+    TelemetryRange tick_range(uint64_t first_tick, uint64_t last_tick) const;
+    TelemetryRange epoch_range(uint64_t first_epoch, uint64_t last_epoch) const;
+    bool find_tick(uint64_t tick, TelemetrySample& out) const;
+
+private:
+    size_t physical(size_t pos) const {
+        size_t p = head_ + pos;
+        return p >= capacity_ ? p - capacity_ : p;
+    }
+
+    size_t capacity_;
+    size_t head_;
+    size_t size_;
+    uint64_t evicted_;
+    std::vector<uint64_t> tick_;
+    std::vector<uint64_t> epoch_;
+    std::vector<uint64_t> metrics_[TELEMETRY_METRIC_COUNT];
+};
+
+// Fixed-capacity ring of rollups in ascending key order. The newest rollup
+// is still open and absorbs samples until one with a larger key arrives.
+class TelemetryRollupRing {
+public:
+    explicit TelemetryRollupRing(size_t capacity = TELEMETRY_ROLLUP_CAPACITY);
+
+    void add(uint64_t key, const TelemetrySample& sample);
+    void clear();
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t capacity() const { return capacity_; }
+    uint64_t evicted() const { return evicted_; }
+
+    const TelemetryRollup& operator[](size_t pos) const { return rollups_[physical(pos)]; }
+    const TelemetryRollup& back() const { return (*this)[size_ - 1]; }
+
+    // Retained rollups with first_key <= key <= last_key.
+    TelemetryRange range(uint64_t first_key, uint64_t last_key) const;
+    bool find(uint64_t key, TelemetryRollup& out) const;
+
+private:
+    size_t physical(size_t pos) const {
+        size_t p = head_ + pos;
+        return p >= capacity_ ? p - capacity_ : p;
+    }
+
+    size_t capacity_;
+    size_t head_;
+    size_t size_;
+    uint64_t evicted_;
+    std::vector<TelemetryRollup> rollups_;
+};
+
+// Per-tick samples plus their rollups. Samples only enter through record(),
+// so the rollups always cover every sample the ring has seen.
+class TelemetryBuffer {
+public:
+    explicit TelemetryBuffer(size_t sample_capacity = TELEMETRY_SAMPLE_CAPACITY);
+
+    void record(const TelemetrySample& sample);
+    void clear();
+
+    const TelemetryRing& samples() const { return samples_; }
+    const TelemetryRollupRing& epoch_rollups() const { return epoch_rollups_; }
+    const TelemetryRollupRing& block_rollups() const { return block_rollups_; }
+
+private:
+    TelemetryRing samples_;              // per tick
+    TelemetryRollupRing epoch_rollups_;  // keyed by epoch_height
+    TelemetryRollupRing block_rollups_;  // keyed by tick_count / TELEMETRY_BLOCK_TICKS
 };
 
 void record_telemetry_sample(
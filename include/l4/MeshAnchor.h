@@ -1,6 +1,9 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <vector>
 
 namespace ailee {
 namespace l4 {
@@ -46,6 +49,54 @@ struct alignas(64) MeshPropagationEnvelope {
 };
 static_assert(sizeof(MeshPropagationEnvelope) == 384, "MeshPropagationEnvelope must be 384 bytes");
 
+static constexpr uint32_t MESH_PROOF_MAX_DEPTH = 32;
+
+// Inclusion proof of one node's state root under mesh_state_root. Only the
+// first sibling_count entries of `siblings` are meaningful; left/right order
+// follows from leaf_index and leaf_count.
+struct alignas(64) MeshInclusionProof {
+    uint64_t node_id_hash;         // 8 bytes
+    uint64_t leaf_index;           // 8 bytes
+    uint64_t leaf_count;           // 8 bytes
+    uint32_t sibling_count;        // 4 bytes
+    uint8_t reserved[4];           // 4 bytes
+    uint8_t state_root[32];        // 32 bytes
+    uint8_t siblings[MESH_PROOF_MAX_DEPTH][32]; // 1024 bytes
+    // Total size = 8 + 8 + 8 + 4 + 4 + 32 + 1024 = 1088 bytes (multiple of 64)
+};
+static_assert(sizeof(MeshInclusionProof) == 1088, "MeshInclusionProof must be 1088 bytes");
+
+// Merkle tree behind mesh_state_root. Leaves are
+// SHA256(0x00 || node_id_hash_le || state_root) in node_id_hash order, inner
+// nodes SHA256(0x01 || left || right); an odd node at the end of a level is
+// carried up unchanged. An empty tree has an all-zero root.
+class MeshStateTree {
+public:
+    void build(const ClusterView& view);
+
+    // Replaces one node's state root and rehashes its path to the root.
+    // Returns false if the node is not in the tree.
+    bool update(uint64_t node_id_hash, const uint8_t state_root[32]);
+
+    bool prove(uint64_t node_id_hash, MeshInclusionProof& out) const;
+
+    void root(uint8_t out[32]) const;
+    size_t leaf_count() const { return node_ids_.size(); }
+
+private:
+    using Digest = std::array<uint8_t, 32>;
+
+    void rehash_parent(size_t level, size_t index);
+
+    std::vector<uint64_t> node_ids_;
+    std::vector<Digest> state_roots_;
+    std::vector<std::vector<Digest>> levels_; // levels_[0] holds the leaves
+};
+
+// Recomputes the root from `proof` and compares it with the anchor's
+// mesh_state_root.
+bool verify_mesh_inclusion(const MeshInclusionProof& proof, const MeshAnchor& anchor);
+
 // Helpers
 MeshEpoch build_mesh_epoch(const ClusterView& view);
 MeshAnchor build_mesh_anchor(const MeshEpoch& epoch, const ClusterView& view);
@@ -29,10 +29,47 @@ struct ReplayClusterViewSnapshot {
     std::vector<l1_sync::ReplayEvent> replay_events;
 };
 
+// Components of a recorded tick, in the order their sub-digests are chained.
+enum class ReplayComponent : uint8_t {
+    SCHEDULER = 0,
+    TELEMETRY = 1,
+    SUMMARY = 2,         // total_nodes, total_steps, coherence summary
+    CLOCK = 3,
+    EVENTS = 4,
+    NODES = 5,           // node state and peer-sync arrays
+    MESH_ENVELOPES = 6,
+    TRANSPORT_QUEUE = 7,
+    TICK_COUNT = 8,      // one replay is a strict prefix of the other
+    NONE = 0xFF
+};
+static constexpr size_t REPLAY_COMPONENT_COUNT = 8;
+
+// Per-tick digest record. chain = SHA256(previous chain || components), with
+// the chain before tick 0 all zeros, so equal chains at tick i mean ticks
+// [0, i] are equal in both replays.
+struct alignas(64) ReplayTickDigest {
+    uint8_t components[REPLAY_COMPONENT_COUNT][32]; // 256 bytes
+    uint8_t chain[32];                              // 32 bytes
+    uint8_t padding[32];                            // 256+32 = 288. 320 - 288 = 32.
+};
+static_assert(sizeof(ReplayTickDigest) == 320, "ReplayTickDigest must be 320 bytes");
+
+// SHA256 of a node's fixed fields (peer-sync vector footprint zeroed) followed
+// by its peer-sync count and array.
+void compute_replay_node_digest(const ClusterNodeState& node, uint8_t out[32]);
+
+ReplayTickDigest compute_replay_tick_digest(
+    const DeterministicSchedulerState& scheduler_state,
+    const ReplayClusterViewSnapshot& view,
+    const TelemetrySample& telemetry_sample,
+    const uint8_t previous_chain[32]
+);
+
 struct ReplayBuffer {
     std::vector<ReplaySchedulerSnapshot> scheduler_snapshots;
     std::vector<ReplayClusterViewSnapshot> view_snapshots;
     std::vector<TelemetrySample> telemetry_snapshots;
+    std::vector<ReplayTickDigest> tick_digests;
 
     std::vector<std::vector<uint8_t>> compressed_ticks;
     l5::DeterministicCompressor compressor;
@@ -45,6 +82,9 @@ struct ReplayBuffer {
         const ClusterView& view,
         const TelemetrySample& telemetry_sample
     );
+
+    // Recomputes tick_digests from the recorded snapshots.
+    void rebuild_digests();
 };
 
 } // namespace l4
@@ -8,6 +8,18 @@
 namespace ailee {
 namespace l4 {
 
+struct alignas(64) ReplayDivergence {
+    uint64_t tick;                  // 8 bytes, first tick whose chain differs
+    uint64_t node_index;            // 8 bytes, first differing node when component == NODES
+    uint64_t node_id_hash;          // 8 bytes, node_id_hash of that node in the first replay
+    uint64_t chain_comparisons;     // 8 bytes, chain digests compared by the search
+    ReplayComponent component;      // 1 byte
+    bool diverged;                  // 1 byte
+    bool digests_rebuilt;           // 1 byte, a side's digest chain was recomputed from tick data
+    uint8_t padding[29];            // 8+8+8+8+1+1+1 = 35. 64 - 35 = 29.
+};
+static_assert(sizeof(ReplayDivergence) == 64, "ReplayDivergence must be 64 bytes");
+
 struct ReplayEngine {
     ReplayBuffer buffer;
 
@@ -25,6 +37,19 @@ struct ReplayEngine {
                      const DeterministicSchedulerState& scheduler,
                      const ClusterView& view,
                      const TelemetrySample& telemetry) const;
+
+    // Locates the first tick at which two replays differ by bisecting over
+    // their digest chains, then compares that tick's component digests and,
+    // for NODES, its per-node digests. Only the one divergent tick is
+    // re-hashed, so the cost is O(log n) chain comparisons.
+    //
+    // The stored chains are trusted only while they look current: a side
+    // whose digest count differs from its tick count, or whose last digest
+    // does not match its last tick's data, is re-hashed from the full tick
+    // data first. `rehash` forces that for both sides, for callers that
+    // cannot vouch for digests loaded from elsewhere.
+    static ReplayDivergence find_divergence(const ReplayBuffer& a, const ReplayBuffer& b, bool rehash = false);
+    static ReplayDivergence find_divergence(const std::string& path_a, const std::string& path_b);
 };
 
 } // namespace l4
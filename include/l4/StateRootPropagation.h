@@ -32,6 +32,16 @@ struct alignas(64) StateRootValidationResult {
 };
 static_assert(sizeof(StateRootValidationResult) == 64, "StateRootValidationResult must be 64 bytes");
 
+struct alignas(64) StateRootValidationSummary {
+    uint64_t accepted_count;       // 8 bytes
+    uint64_t rejected_count;       // 8 bytes
+    uint64_t missing_count;        // 8 bytes, nodes with no announcement
+    uint64_t unknown_source_count; // 8 bytes, announcements from no node in the view
+    // Total size = 32 bytes. Padding needed: 32 bytes
+    uint8_t padding[32];
+};
+static_assert(sizeof(StateRootValidationSummary) == 64, "StateRootValidationSummary must be 64 bytes");
+
 std::vector<StateRootAnnouncement> build_state_root_announcements(const ClusterView& view);
 
 std::vector<StateRootValidationResult> validate_state_roots(
@@ -40,5 +50,23 @@ std::vector<StateRootValidationResult> validate_state_roots(
     const std::vector<StateRootAnnouncement>& announcements
 );
 
+// As above, also filling `summary`. Nodes and announcements are joined on
+// node_id_hash by one merge over sorted arrays; announcements that arrive
+// sorted (as build_state_root_announcements returns them) are not re-sorted.
+std::vector<StateRootValidationResult> validate_state_roots(
+    const ClusterView& view,
+    const MeshAnchor& anchor,
+    const std::vector<StateRootAnnouncement>& announcements,
+    StateRootValidationSummary& summary
+);
+
+// Checks one announcement against the anchor using only its inclusion proof:
+// the proof must be for the announcing node and root, at the anchor's epoch.
+bool verify_state_root_announcement(
+    const StateRootAnnouncement& announcement,
+    const MeshInclusionProof& proof,
+    const MeshAnchor& anchor
+);
+
 } // namespace l4
 } // namespace ailee
@@ -1,8 +1,14 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <map>
 #include <string>
 #include <optional>
+#include <vector>
+
+#include "l6/AnchorSerializer.h"
 
 namespace ailee {
 namespace l6 {
@@ -10,7 +16,8 @@ namespace l6 {
 enum class ReplayStatus {
     OK,
     MISMATCH,
-    MISSING_ANCHOR
+    MISSING_ANCHOR,
+    CONFLICTING_ANCHOR  // L1 carries different hashes for the epoch
 };
 
 struct ReplayVerdict {
@@ -26,5 +33,90 @@ ReplayVerdict verify_epoch_against_anchor(
     const std::optional<std::string>& anchor_hash_from_l1
 );
 
+using EpochHash = std::array<uint8_t, 32>;
+
+// Epoch -> anchored hash, kept sorted by epoch in parallel arrays so range
+// reconciliation walks it linearly.
+//
+// Anyone can publish an anchor-shaped OP_RETURN, so the index does not pick
+// a winner when L1 carries two hashes for one epoch: the epoch is disputed,
+// find() stops answering for it, and reconciliation reports it as
+// CONFLICTING_ANCHOR until a reorg removes one side.
+class EpochAnchorIndex {
+public:
+    // Records an anchor. Returns true if the epoch was not anchored before;
+    // repeats and conflicting hashes are kept so unscan_from can fall back
+    // to them.
+    bool insert(uint64_t epoch_id, const EpochHash& hash, uint64_t l1_height = 0);
+
+    // Scans a block's output scripts for anchor commitments: OP_RETURN
+    // pushing "AILEE" followed by a serialized AnchorRecord, whose
+    // replay_height carries the epoch id and state_root the epoch hash.
+    // Returns the number of anchors added.
+    std::size_t scan_block(uint64_t l1_height, const std::vector<std::vector<uint8_t>>& output_scripts);
+
+    // Forgets every anchor seen at l1_height or above, e.g. after a reorg
+    // back to l1_height - 1. Epochs also anchored lower down fall back to
+    // the earliest surviving anchor. Returns the number of anchors dropped.
+    std::size_t unscan_from(uint64_t l1_height);
+
+    // Anchored hash, or nullopt if the epoch is unanchored or disputed.
+    std::optional<EpochHash> find(uint64_t epoch_id) const;
+    std::optional<uint64_t> anchor_height(uint64_t epoch_id) const;
+    bool disputed(uint64_t epoch_id) const;
+    std::size_t size() const { return epochs_.size(); }
+    // Number of disputed epochs.
+    std::size_t conflicts() const { return conflicts_; }
+
+    const std::vector<uint64_t>& epochs() const { return epochs_; }
+    const std::vector<EpochHash>& hashes() const { return hashes_; }
+    // Parallel to epochs(): non-zero where the epoch is disputed.
+    const std::vector<uint8_t>& disputed_flags() const { return disputed_; }
+
+private:
+    struct LaterAnchor {
+        EpochHash hash;
+        uint64_t l1_height;
+    };
+
+    bool differs_from_later(uint64_t epoch_id, const EpochHash& hash) const;
+
+    std::vector<uint64_t> epochs_;
+    std::vector<EpochHash> hashes_;
+    std::vector<uint64_t> heights_;
+    std::vector<uint8_t> disputed_;
+    // Anchors seen after the first for an epoch, in arrival order.
+    std::map<uint64_t, std::vector<LaterAnchor>> later_;
+    std::size_t conflicts_ = 0;
+};
+
+// OP_RETURN script committing `record` in the form scan_block recognises.
+std::vector<uint8_t> build_epoch_anchor_script(const AnchorRecord& record);
+
+// Inclusive run of consecutive epochs sharing a status.
+struct ReplayRun {
+    ReplayStatus status;
+    uint64_t first_epoch;
+    uint64_t last_epoch;
+};
+
+struct ReconciliationReport {
+    std::vector<ReplayRun> runs;
+    uint64_t ok_epochs = 0;
+    uint64_t mismatched_epochs = 0;
+    uint64_t missing_epochs = 0;
+    uint64_t conflicting_epochs = 0;
+
+    bool clean() const { return mismatched_epochs == 0 && missing_epochs == 0 && conflicting_epochs == 0; }
+};
+
+// Compares local_hashes[i] (the hash of epoch first_epoch + i) against the
+// index in one linear pass, comparing contiguous anchored stretches in bulk.
+ReconciliationReport reconcile_epoch_range(
+    uint64_t first_epoch,
+    const std::vector<EpochHash>& local_hashes,
+    const EpochAnchorIndex& index
+);
+
 } // namespace l6
 } // namespace ailee
@@ -0,0 +1,269 @@
+#pragma once
+
+// Persistent (structurally shared) ordered map.
+//
+// Every mutation path-copies the O(log n) nodes between the root and the
+// touched key and leaves all other nodes shared with earlier versions, so
+// copying a PersistentMap is O(1) and a copy is an immutable, key-ordered
+// version that later writes to the original can never observe or tear.
+// Balanced as an AVL tree; nodes are immutable once published.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace ailee {
+namespace util {
+
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+class PersistentMap {
+    struct Node;
+    using NodePtr = std::shared_ptr<const Node>;
+
+    struct Node {
+        Key key;
+        Value value;
+        NodePtr left;
+        NodePtr right;
+        std::uint8_t height{1};
+        std::size_t size{1};
+
+        Node(Key k, Value v, NodePtr l, NodePtr r)
+            : key(std::move(k)), value(std::move(v)), left(std::move(l)), right(std::move(r)) {
+            height = static_cast<std::uint8_t>(1 + std::max(height_of(left), height_of(right)));
+            size = 1 + size_of(left) + size_of(right);
+        }
+    };
+
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+
+    // In-order (ascending key) iterator. Holds the root-to-node stack, so it
+    // stays valid for as long as the map version it was taken from is alive.
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::pair<const Key&, const Value&>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = value_type;
+
+        const_iterator() = default;
+
+        reference operator*() const { return {stack_.back()->key, stack_.back()->value}; }
+        const Key& key() const { return stack_.back()->key; }
+        const Value& value() const { return stack_.back()->value; }
+
+        const_iterator& operator++() {
+            const Node* node = stack_.back();
+            stack_.pop_back();
+            push_left(node->right.get());
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            if (stack_.empty() || other.stack_.empty()) {
+                return stack_.empty() == other.stack_.empty();
+            }
+            return stack_.back() == other.stack_.back();
+        }
+        bool operator!=(const const_iterator& other) const { return !(*this == other); }
+
+    private:
+        friend class PersistentMap;
+
+        void push_left(const Node* node) {
+            while (node) {
+                stack_.push_back(node);
+                node = node->left.get();
+            }
+        }
+
+        std::vector<const Node*> stack_;
+    };
+
+    PersistentMap() = default;
+
+    std::size_t size() const { return size_of(root_); }
+    bool empty() const { return !root_; }
+    void clear() { root_.reset(); }
+
+    const Value* find(const Key& key) const {
+        const Node* node = root_.get();
+        while (node) {
+            if (comp_(key, node->key)) {
+                node = node->left.get();
+            } else if (comp_(node->key, key)) {
+                node = node->right.get();
+            } else {
+                return &node->value;
+            }
+        }
+        return nullptr;
+    }
+
+    bool contains(const Key& key) const { return find(key) != nullptr; }
+
+    // Inserts or overwrites |key|. Only this map's root changes; other
+    // versions sharing nodes with it are unaffected.
+    void insert_or_assign(const Key& key, Value value) {
+        root_ = insert_node(root_, key, std::move(value));
+    }
+
+    // Returns true if |key| was present.
+    bool erase(const Key& key) {
+        bool erased = false;
+        root_ = erase_node(root_, key, &erased);
+        return erased;
+    }
+
+    const_iterator begin() const {
+        const_iterator it;
+        it.push_left(root_.get());
+        return it;
+    }
+
+    const_iterator end() const { return const_iterator(); }
+
+    // First element whose key is not less than |key|.
+    const_iterator lower_bound(const Key& key) const {
+        const_iterator it;
+        const Node* node = root_.get();
+        while (node) {
+            if (comp_(node->key, key)) {
+                node = node->right.get();
+            } else {
+                it.stack_.push_back(node);
+                node = node->left.get();
+            }
+        }
+        return it;
+    }
+
+    // In-order visitation without iterator bookkeeping.
+    template <typename Fn>
+    void for_each(Fn&& fn) const {
+        for_each_node(root_.get(), fn);
+    }
+
+    // True when both maps are the same version (share the same root).
+    bool same_version(const PersistentMap& other) const { return root_ == other.root_; }
+
+private:
+    static std::uint8_t height_of(const NodePtr& node) { return node ? node->height : 0; }
+    static std::size_t size_of(const NodePtr& node) { return node ? node->size : 0; }
+
+    static NodePtr make(Key key, Value value, NodePtr left, NodePtr right) {
+        return std::make_shared<const Node>(std::move(key), std::move(value),
+                                            std::move(left), std::move(right));
+    }
+
+    static NodePtr rotate_right(const Key& key, const Value& value, const NodePtr& left,
+                                const NodePtr& right) {
+        return make(left->key, left->value, left->left,
+                    make(key, value, left->right, right));
+    }
+
+    static NodePtr rotate_left(const Key& key, const Value& value, const NodePtr& left,
+                               const NodePtr& right) {
+        return make(right->key, right->value,
+                    make(key, value, left, right->left), right->right);
+    }
+
+    // Builds a node from (key, value, left, right), restoring the AVL
+    // invariant when the subtrees differ in height by two.
+    static NodePtr balance(const Key& key, const Value& value, const NodePtr& left,
+                           const NodePtr& right) {
+        const int hl = height_of(left);
+        const int hr = height_of(right);
+        if (hl > hr + 1) {
+            if (height_of(left->left) >= height_of(left->right)) {
+                return rotate_right(key, value, left, right);
+            }
+            NodePtr pivot = rotate_left(left->key, left->value, left->left, left->right);
+            return rotate_right(key, value, pivot, right);
+        }
+        if (hr > hl + 1) {
+            if (height_of(right->right) >= height_of(right->left)) {
+                return rotate_left(key, value, left, right);
+            }
+            NodePtr pivot = rotate_right(right->key, right->value, right->left, right->right);
+            return rotate_left(key, value, left, pivot);
+        }
+        return make(key, value, left, right);
+    }
+
+    NodePtr insert_node(const NodePtr& node, const Key& key, Value value) const {
+        if (!node) {
+            return make(key, std::move(value), nullptr, nullptr);
+        }
+        if (comp_(key, node->key)) {
+            return balance(node->key, node->value, insert_node(node->left, key, std::move(value)),
+                           node->right);
+        }
+        if (comp_(node->key, key)) {
+            return balance(node->key, node->value, node->left,
+                           insert_node(node->right, key, std::move(value)));
+        }
+        return make(node->key, std::move(value), node->left, node->right);
+    }
+
+    static NodePtr erase_min(const NodePtr& node, const Node** min_out) {
+        if (!node->left) {
+            *min_out = node.get();
+            return node->right;
+        }
+        return balance(node->key, node->value, erase_min(node->left, min_out), node->right);
+    }
+
+    NodePtr erase_node(const NodePtr& node, const Key& key, bool* erased) const {
+        if (!node) {
+            return node;
+        }
+        if (comp_(key, node->key)) {
+            NodePtr left = erase_node(node->left, key, erased);
+            return *erased ? balance(node->key, node->value, left, node->right) : node;
+        }
+        if (comp_(node->key, key)) {
+            NodePtr right = erase_node(node->right, key, erased);
+            return *erased ? balance(node->key, node->value, node->left, right) : node;
+        }
+        *erased = true;
+        if (!node->left) {
+            return node->right;
+        }
+        if (!node->right) {
+            return node->left;
+        }
+        const Node* successor = nullptr;
+        NodePtr right = erase_min(node->right, &successor);
+        return balance(successor->key, successor->value, node->left, right);
+    }
+
+    template <typename Fn>
+    static void for_each_node(const Node* node, Fn& fn) {
+        while (node) {
+            for_each_node(node->left.get(), fn);
+            fn(node->key, node->value);
+            node = node->right.get();
+        }
+    }
+
+    NodePtr root_;
+    Compare comp_{};
+};
+
+} // namespace util
+} // namespace ailee
@@ -11,11 +11,15 @@
  */
 
 #pragma once
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 #include <string>
 #include <vector>
 
+#include "ailee_rust_ffi.h"
+
 namespace ailee::zk {
 
 // Shared SHA-256 utility for deterministic commitments.
@@ -29,6 +33,51 @@ struct Proof {
     std::vector<uint8_t> commitmentBytes; // 96-byte commitment from Halo2
 };
 
+using Digest32 = std::array<uint8_t, HALO2_DIGEST_LEN>;
+
+// Non-owning view into a Halo2ProofBatch arena.
+struct ByteView {
+    const uint8_t* data = nullptr;
+    std::size_t size = 0;
+
+    const uint8_t* begin() const { return data; }
+    const uint8_t* end() const { return data + size; }
+};
+
+/**
+ * Reusable buffers for batched Halo2 proving.
+ *
+ * Inputs are packed binary digests and every proof and commitment lives in a
+ * single arena owned by the batch, so an epoch of proofs costs one FFI call
+ * and no per-proof allocation. Views returned by proof()/commitment() stay
+ * valid until the next clear() or generateHalo2Proofs() on this batch.
+ */
+class Halo2ProofBatch {
+public:
+    // Drops items but keeps buffer capacity for the next epoch.
+    void clear();
+    void reserve(std::size_t count);
+    void add(const Digest32& taskDigest, const Digest32& computationDigest);
+
+    std::size_t size() const { return status_.size(); }
+    int status(std::size_t i) const { return status_[i]; }
+    bool ok(std::size_t i) const { return status_[i] == HALO2_ITEM_OK; }
+    ByteView proof(std::size_t i) const;
+    ByteView commitment(std::size_t i) const;
+
+    // Copies item i out as a standalone Proof (publicInput is the hex digest).
+    Proof toProof(std::size_t i) const;
+
+private:
+    friend class ZKEngine;
+
+    std::vector<uint8_t> taskDigests_;
+    std::vector<uint8_t> computationDigests_;
+    std::vector<uint8_t> arena_;
+    std::vector<Halo2ProofSlice> slices_;
+    std::vector<int> status_;
+};
+
 class ZKEngine {
 public:
     ZKEngine() = default;
@@ -45,6 +94,13 @@ public:
      */
     Proof generateHalo2Proof(const std::string& taskId, const std::string& computationHash);
 
+    /**
+     * Prove every item in the batch with one FFI call, writing into the
+     * batch's arena. Returns the number of items proved; per-item results
+     * are in batch.status(i).
+     */
+    std::size_t generateHalo2Proofs(Halo2ProofBatch& batch);
+
     /**
      * Verify a zk-proof
      * Returns true if the proof is valid
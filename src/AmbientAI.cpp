@@ -29,6 +29,29 @@ inline std::string sha256Hex(const std::vector<uint8_t>& input) {
     return ailee::crypto::sha256_hex(input);
 }
 
+// (a * b) / FIXED_POINT_SCALE truncated to 64 bits, exactly as the
+// __uint128_t expressions below compute it. When both factors fit in 32 bits
+// the product fits in 64, and the division by a constant becomes a multiply
+// instead of a call into the 128-bit division routine.
+inline uint64_t mulDivScaleFp(uint64_t a, uint64_t b) {
+    if (((a | b) >> 32) == 0) {
+        return (a * b) / FIXED_POINT_SCALE;
+    }
+    return static_cast<uint64_t>(static_cast<__uint128_t>(a) * static_cast<__uint128_t>(b) / FIXED_POINT_SCALE);
+}
+
+// (k * x) / FIXED_POINT_SCALE for the EMA weights k (< 2^14), with the same
+// truncation toward zero as the __int128_t form.
+inline int64_t emaTermFp(int64_t k, int64_t x) {
+    constexpr int64_t kFastBound = int64_t{1} << 48;
+    if (x > -kFastBound && x < kFastBound) {
+        return (k * x) / static_cast<int64_t>(FIXED_POINT_SCALE);
+    }
+    return static_cast<int64_t>(static_cast<__int128_t>(k) * static_cast<__int128_t>(x) / FIXED_POINT_SCALE);
+}
+
+constexpr uint64_t MAX_REWARD_FP = 100000000ULL * FIXED_POINT_SCALE;
+
 } // namespace
 
 // ============================================================================
@@ -284,7 +307,6 @@ IncentiveRecord calculateTokenReward(const AmbientNode& node, uint64_t baseRateF
     uint64_t finalAmountFp = static_cast<uint64_t>(finalProduct / FIXED_POINT_SCALE);
 
     // Overflow guard: ensure reward stays within expected protocol bounds (e.g., max 100M tokens scaled)
-    uint64_t MAX_REWARD_FP = 100000000ULL * FIXED_POINT_SCALE;
     if (finalAmountFp > MAX_REWARD_FP) {
         finalAmountFp = MAX_REWARD_FP;
     }
@@ -292,6 +314,92 @@ IncentiveRecord calculateTokenReward(const AmbientNode& node, uint64_t baseRateF
     return node.accrueReward("autoTask", finalAmountFp);
 }
 
+// ============================================================================
+// EPOCH SETTLEMENT
+// ============================================================================
+
+EpochSettlementResult EpochSettlementEngine::settle(const std::vector<EpochParticipant>& participants,
+                                                    uint64_t baseRateFp) {
+    snapshot(participants);
+    computeRewards(baseRateFp);
+    computeReputation();
+
+    for (std::size_t i = 0; i < participants.size(); ++i) {
+        participants[i].node->applySettledReputation(newReputationFp_[i]);
+    }
+    EpochSettlementResult result;
+    result.rewardFp = rewardFp_;
+    result.reputationFp = newReputationFp_;
+    return result;
+}
+
+void EpochSettlementEngine::snapshot(const std::vector<EpochParticipant>& participants) {
+    const std::size_t n = participants.size();
+    for (auto* column : {&powerFp_, &efficiencyFp_, &privacyFp_, &reputationFp_, &slaFp_,
+                         &rewardFp_, &newReputationFp_}) {
+        column->resize(n);
+    }
+    hasSample_.resize(n);
+    success_.resize(n);
+    uptimeMs_.resize(n);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto& p = participants[i];
+        if (!p.node) {
+            throw std::invalid_argument("EpochSettlementEngine: null participant node");
+        }
+        const auto view = p.node->settlementView();
+        hasSample_[i] = view.hasSample ? 1 : 0;
+        powerFp_[i] = view.instantaneousPower_GFLOPSFp;
+        efficiencyFp_[i] = view.computeEfficiency_GFLOPS_WFp;
+        privacyFp_[i] = view.privacyBudgetRemainingFp;
+        reputationFp_[i] = view.reputationFp;
+        success_[i] = p.success ? 1 : 0;
+        slaFp_[i] = p.slaFp;
+        uptimeMs_[i] = p.uptimeMs;
+    }
+}
+
+// Same chain of truncating multiplications as calculateTokenReward.
+void EpochSettlementEngine::computeRewards(uint64_t baseRateFp) {
+    const std::size_t n = powerFp_.size();
+    const uint64_t* power = powerFp_.data();
+    const uint64_t* eff = efficiencyFp_.data();
+    const uint64_t* priv = privacyFp_.data();
+    const uint64_t* rep = reputationFp_.data();
+    uint64_t* out = rewardFp_.data();
+    const uint8_t* hasSample = hasSample_.data();
+    for (std::size_t i = 0; i < n; ++i) {
+        uint64_t amount = mulDivScaleFp(power[i], baseRateFp);
+        amount = mulDivScaleFp(amount, eff[i]);
+        amount = mulDivScaleFp(amount, priv[i]);
+        amount = mulDivScaleFp(amount, rep[i]);
+        out[i] = hasSample[i] ? std::min(amount, MAX_REWARD_FP) : 0;
+    }
+}
+
+// Same EMA as updateReputationScoreFp. (100 * sla) / SCALE is sla / 100.
+void EpochSettlementEngine::computeReputation() {
+    const std::size_t n = reputationFp_.size();
+    const uint64_t* rep = reputationFp_.data();
+    const uint8_t* success = success_.data();
+    const uint64_t* sla = slaFp_.data();
+    const int64_t* uptime = uptimeMs_.data();
+    uint64_t* out = newReputationFp_.data();
+    for (std::size_t i = 0; i < n; ++i) {
+        int64_t deltaFp = success[i] ? static_cast<int64_t>(sla[i] / 100) : -500;
+        uint64_t uptimeBonusFp = (uptime[i] * 10) / 3600000;
+        if (uptimeBonusFp > 100) uptimeBonusFp = 100;
+        deltaFp += uptimeBonusFp;
+
+        const int64_t currentScoreFp = static_cast<int64_t>(rep[i]);
+        int64_t newScoreFp = emaTermFp(9500, currentScoreFp) + emaTermFp(500, currentScoreFp + deltaFp);
+        if (newScoreFp < 0) newScoreFp = 0;
+        if (newScoreFp > static_cast<int64_t>(FIXED_POINT_SCALE)) newScoreFp = FIXED_POINT_SCALE;
+        out[i] = static_cast<uint64_t>(newScoreFp);
+    }
+}
+
 // ============================================================================
 // SYSTEM HEALTH & VALIDATION
 // ============================================================================
@@ -6,18 +6,73 @@
 namespace ailee {
 namespace reflection {
 
+namespace {
+
+bool decode_block_height(const rocksdb::Slice& slice, CacheAlignedBlockHeight& out_height) {
+    if (slice.size() == sizeof(uint64_t)) {
+        std::memcpy(&out_height.height, slice.data(), sizeof(uint64_t));
+        return true;
+    }
+    return false;
+}
+
+bool decode_anchor(const rocksdb::Slice& slice, CacheAlignedAnchor& out_anchor) {
+    if (slice.size() == sizeof(CacheAlignedAnchor)) {
+        // Memory layout of CacheAlignedAnchor is fixed (sizeof == 128)
+        // but the populated data fields are:
+        // 32 bytes anchor_hash (offset 0)
+        // 8 bytes block_height (offset 64 due to alignment padding or packed layout)
+        // To be perfectly safe against padding differences, we just copy the raw aligned struct bytes.
+        std::memcpy(&out_anchor, slice.data(), sizeof(CacheAlignedAnchor));
+        return true;
+    } else if (slice.size() == 40) {
+        // Explicitly support the compact 40 byte packed structure without alignas padding.
+        const uint8_t* data = reinterpret_cast<const uint8_t*>(slice.data());
+        std::memcpy(out_anchor.anchor_hash, data, 32);
+        std::memcpy(&out_anchor.block_height, data + 32, sizeof(uint64_t));
+        return true;
+    }
+    return false;
+}
+
+bool decode_reorg_event(const rocksdb::Slice& slice, CacheAlignedReorgEvent& out_reorg) {
+    if (slice.size() == sizeof(CacheAlignedReorgEvent)) {
+        std::memcpy(&out_reorg, slice.data(), sizeof(CacheAlignedReorgEvent));
+        return true;
+    } else if (slice.size() == 80) {
+        // Explicitly support compact 80 byte format: old_height(8) + new_height(8) + old_hash(32) + new_hash(32)
+        const uint8_t* data = reinterpret_cast<const uint8_t*>(slice.data());
+        std::memcpy(&out_reorg.old_height, data, sizeof(uint64_t));
+        std::memcpy(&out_reorg.new_height, data + sizeof(uint64_t), sizeof(uint64_t));
+        std::memcpy(out_reorg.old_anchor_hash, data + sizeof(uint64_t) * 2, 32);
+        std::memcpy(out_reorg.new_anchor_hash, data + sizeof(uint64_t) * 2 + 32, 32);
+        return true;
+    }
+    return false;
+}
+
+void snapshot_from_read(const ReflectionRead& read, ReflectionSnapshot& snap) {
+    std::memset(&snap, 0, sizeof(snap));
+
+    if (!read.has_block_height || !decode_block_height(read.block_height, snap.height)) {
+        std::memset(&snap.height, 0, sizeof(snap.height));
+    }
+    if (!read.has_anchor || !decode_anchor(read.anchor, snap.anchor)) {
+        std::memset(&snap.anchor, 0, sizeof(snap.anchor));
+    }
+    if (!read.has_reorg || !decode_reorg_event(read.reorg, snap.reorg)) {
+        std::memset(&snap.reorg, 0, sizeof(snap.reorg));
+    }
+}
+
+} // namespace
+
 bool reflect_latest_block_height(
     const RocksDbHandle& db,
     CacheAlignedBlockHeight& out_height
 ) {
     rocksdb::Slice slice;
-    if (db.get_raw_block_height_slice(slice)) {
-        if (slice.size() == sizeof(uint64_t)) {
-            std::memcpy(&out_height.height, slice.data(), sizeof(uint64_t));
-            return true;
-        }
-    }
-    return false;
+    return db.get_raw_block_height_slice(slice) && decode_block_height(slice, out_height);
 }
 
 bool reflect_latest_anchor(
@@ -25,24 +80,7 @@ bool reflect_latest_anchor(
     CacheAlignedAnchor& out_anchor
 ) {
     rocksdb::Slice slice;
-    if (db.get_raw_anchor_slice(slice)) {
-        if (slice.size() == sizeof(CacheAlignedAnchor)) {
-            // Memory layout of CacheAlignedAnchor is fixed (sizeof == 128)
-            // but the populated data fields are:
-            // 32 bytes anchor_hash (offset 0)
-            // 8 bytes block_height (offset 64 due to alignment padding or packed layout)
-            // To be perfectly safe against padding differences, we just copy the raw aligned struct bytes.
-            std::memcpy(&out_anchor, slice.data(), sizeof(CacheAlignedAnchor));
-            return true;
-        } else if (slice.size() == 40) {
-            // Explicitly support the compact 40 byte packed structure without alignas padding.
-            const uint8_t* data = reinterpret_cast<const uint8_t*>(slice.data());
-            std::memcpy(out_anchor.anchor_hash, data, 32);
-            std::memcpy(&out_anchor.block_height, data + 32, sizeof(uint64_t));
-            return true;
-        }
-    }
-    return false;
+    return db.get_raw_anchor_slice(slice) && decode_anchor(slice, out_anchor);
 }
 
 bool reflect_reorg_event(
@@ -50,21 +88,7 @@ bool reflect_reorg_event(
     CacheAlignedReorgEvent& out_reorg
 ) {
     rocksdb::Slice slice;
-    if (db.get_raw_reorg_slice(slice)) {
-        if (slice.size() == sizeof(CacheAlignedReorgEvent)) {
-            std::memcpy(&out_reorg, slice.data(), sizeof(CacheAlignedReorgEvent));
-            return true;
-        } else if (slice.size() == 80) {
-            // Explicitly support compact 80 byte format: old_height(8) + new_height(8) + old_hash(32) + new_hash(32)
-            const uint8_t* data = reinterpret_cast<const uint8_t*>(slice.data());
-            std::memcpy(&out_reorg.old_height, data, sizeof(uint64_t));
-            std::memcpy(&out_reorg.new_height, data + sizeof(uint64_t), sizeof(uint64_t));
-            std::memcpy(out_reorg.old_anchor_hash, data + sizeof(uint64_t) * 2, 32);
-            std::memcpy(out_reorg.new_anchor_hash, data + sizeof(uint64_t) * 2 + 32, 32);
-            return true;
-        }
-    }
-    return false;
+    return db.get_raw_reorg_slice(slice) && decode_reorg_event(slice, out_reorg);
 }
 
 ReflectionSnapshot build_reflection_snapshot(
@@ -73,17 +97,32 @@ ReflectionSnapshot build_reflection_snapshot(
     ReflectionSnapshot snap;
     std::memset(&snap, 0, sizeof(snap));
 
-    if (!reflect_latest_block_height(db, snap.height)) {
-        std::memset(&snap.height, 0, sizeof(snap.height));
+    ReflectionRead read;
+    if (db.read_reflection(read)) {
+        snapshot_from_read(read, snap);
     }
-    if (!reflect_latest_anchor(db, snap.anchor)) {
-        std::memset(&snap.anchor, 0, sizeof(snap.anchor));
-    }
-    if (!reflect_reorg_event(db, snap.reorg)) {
-        std::memset(&snap.reorg, 0, sizeof(snap.reorg));
+    return snap;
+}
+
+bool refresh_reflection_snapshot(
+    const RocksDbHandle& db,
+    ReflectionSnapshot& snap,
+    ReflectionCursor& cursor
+) {
+    uint64_t latest = 0;
+    if (cursor.valid && db.latest_sequence_number(latest) && latest == cursor.sequence) {
+        return false;
     }
 
-    return snap;
+    ReflectionRead read;
+    if (!db.read_reflection(read)) {
+        cursor.valid = false;
+        return false;
+    }
+    snapshot_from_read(read, snap);
+    cursor.sequence = read.sequence;
+    cursor.valid = read.has_sequence;
+    return true;
 }
 
 uint64_t reflection_get_height(const ReflectionSnapshot& snap) {
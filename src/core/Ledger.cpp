@@ -1,5 +1,4 @@
 #include "Ledger.h"
-#include <algorithm>
 #include <chrono>
 #include <limits>
 
@@ -86,28 +85,37 @@ bool InMemoryLedger::putInEscrow(const Escrow& e) {
         return false;
     }
     
-    // Check if escrow already exists
-    {
-        std::shared_lock lock(escrows_mutex_);
-        if (escrows_.find(e.taskId) != escrows_.end()) {
-            return false;
-        }
-    }
-    
-    // Debit from client's account
-    if (!debit(e.clientPeerId, e.amount)) {
-        return false;
-    }
-    
     // Create escrow with timestamp
     Escrow escrowWithTimestamp = e;
     escrowWithTimestamp.createdAt = getCurrentTimestamp();
     
+    // Existence, quota and balance are checked and the debit applied under
+    // both locks (in clear()'s order) so concurrent calls can't both pass.
     {
-        std::unique_lock lock(escrows_mutex_);
-        escrows_[e.taskId] = escrowWithTimestamp;
+        std::unique_lock balancesLock(balances_mutex_);
+        std::unique_lock escrowsLock(escrows_mutex_);
+        if (escrows_.contains(e.taskId)) {
+            return false;
+        }
+        
+        // Enforce per-client outstanding escrow quota
+        if (max_escrows_per_client_ != 0) {
+            auto usage = client_escrows_.find(e.clientPeerId);
+            if (usage != client_escrows_.end() && usage->second.count >= max_escrows_per_client_) {
+                return false;
+            }
+        }
+        
+        // Debit from client's account
+        std::uint64_t currentBalance = getBalance_unsafe(e.clientPeerId);
+        if (currentBalance < e.amount) {
+            return false;
+        }
+        setBalance_unsafe(e.clientPeerId, currentBalance - e.amount);
+        insertEscrow_unsafe(escrowWithTimestamp);
     }
     
+    emitEvent(LedgerEventType::DEBIT, e.clientPeerId, e.amount);
     emitEvent(LedgerEventType::ESCROW_CREATED, e.clientPeerId, e.amount, e.taskId);
     return true;
 }
@@ -122,20 +130,20 @@ bool InMemoryLedger::releaseEscrow(const std::string& taskId, const std::string&
     // Retrieve and remove escrow
     {
         std::unique_lock lock(escrows_mutex_);
-        auto it = escrows_.find(taskId);
+        const Escrow* found = escrows_.find(taskId);
         
-        if (it == escrows_.end()) {
+        if (!found) {
             return false;
         }
         
-        escrow = it->second;
+        escrow = *found;
         
         // Check if escrow is locked
         if (escrow.locked) {
             return false;
         }
         
-        escrows_.erase(it);
+        eraseEscrow_unsafe(escrow);
     }
     
     // Credit worker with escrowed amount
@@ -144,7 +152,7 @@ bool InMemoryLedger::releaseEscrow(const std::string& taskId, const std::string&
     } catch (const LedgerException&) {
         // Rollback: put escrow back
         std::unique_lock lock(escrows_mutex_);
-        escrows_[taskId] = escrow;
+        insertEscrow_unsafe(escrow);
         return false;
     }
     
@@ -162,20 +170,20 @@ bool InMemoryLedger::refundEscrow(const std::string& taskId) {
     // Retrieve and remove escrow
     {
         std::unique_lock lock(escrows_mutex_);
-        auto it = escrows_.find(taskId);
+        const Escrow* found = escrows_.find(taskId);
         
-        if (it == escrows_.end()) {
+        if (!found) {
             return false;
         }
         
-        escrow = it->second;
+        escrow = *found;
         
         // Check if escrow is locked
         if (escrow.locked) {
             return false;
         }
         
-        escrows_.erase(it);
+        eraseEscrow_unsafe(escrow);
     }
     
     // Refund client
@@ -184,7 +192,7 @@ bool InMemoryLedger::refundEscrow(const std::string& taskId) {
     } catch (const LedgerException&) {
         // Rollback: put escrow back
         std::unique_lock lock(escrows_mutex_);
-        escrows_[taskId] = escrow;
+        insertEscrow_unsafe(escrow);
         return false;
     }
     
@@ -198,13 +206,13 @@ std::optional<Escrow> InMemoryLedger::getEscrow(const std::string& taskId) const
     }
     
     std::shared_lock lock(escrows_mutex_);
-    auto it = escrows_.find(taskId);
+    const Escrow* found = escrows_.find(taskId);
     
-    if (it == escrows_.end()) {
+    if (!found) {
         return std::nullopt;
     }
     
-    return it->second;
+    return *found;
 }
 
 bool InMemoryLedger::hasEscrow(const std::string& taskId) const {
@@ -213,7 +221,7 @@ bool InMemoryLedger::hasEscrow(const std::string& taskId) const {
     }
     
     std::shared_lock lock(escrows_mutex_);
-    return escrows_.find(taskId) != escrows_.end();
+    return escrows_.contains(taskId);
 }
 
 std::vector<std::string> InMemoryLedger::getEscrowTaskIds() const {
@@ -222,9 +230,9 @@ std::vector<std::string> InMemoryLedger::getEscrowTaskIds() const {
     std::vector<std::string> taskIds;
     taskIds.reserve(escrows_.size());
     
-    for (const auto& [taskId, _] : escrows_) {
+    escrows_.for_each([&](const std::string& taskId, const Escrow&) {
         taskIds.push_back(taskId);
-    }
+    });
     
     return taskIds;
 }
@@ -292,10 +300,14 @@ std::size_t InMemoryLedger::getEscrowCount() const {
 }
 
 std::uint64_t InMemoryLedger::getTotalBalance() const {
-    std::shared_lock lock(balances_mutex_);
+    ailee::util::PersistentMap<std::string, std::uint64_t> balances;
+    {
+        std::shared_lock lock(balances_mutex_);
+        balances = balances_;
+    }
     
     std::uint64_t total = 0;
-    for (const auto& [_, balance] : balances_) {
+    for (const auto& [_, balance] : balances) {
         // Saturate on overflow rather than wrap
         if (total > std::numeric_limits<std::uint64_t>::max() - balance) {
             return std::numeric_limits<std::uint64_t>::max();
@@ -307,10 +319,14 @@ std::uint64_t InMemoryLedger::getTotalBalance() const {
 }
 
 std::uint64_t InMemoryLedger::getTotalEscrow() const {
-    std::shared_lock lock(escrows_mutex_);
+    ailee::util::PersistentMap<std::string, Escrow> escrows;
+    {
+        std::shared_lock lock(escrows_mutex_);
+        escrows = escrows_;
+    }
     
     std::uint64_t total = 0;
-    for (const auto& [_, escrow] : escrows_) {
+    for (const auto& [_, escrow] : escrows) {
         // Saturate on overflow rather than wrap
         if (total > std::numeric_limits<std::uint64_t>::max() - escrow.amount) {
             return std::numeric_limits<std::uint64_t>::max();
@@ -321,27 +337,117 @@ std::uint64_t InMemoryLedger::getTotalEscrow() const {
     return total;
 }
 
-ailee::l2::LedgerSnapshot InMemoryLedger::snapshot() const {
-    ailee::l2::LedgerSnapshot snapshot;
+EscrowSweepResult InMemoryLedger::sweepExpired(std::uint64_t nowMs, std::size_t limit) {
+    EscrowSweepResult result;
+    std::vector<Escrow> expired;
+    
+    // Pop expired escrows off the front of the deadline index
     {
-        std::shared_lock balancesLock(balances_mutex_);
-        snapshot.balances.reserve(balances_.size());
-        for (const auto& [peerId, balance] : balances_) {
-            snapshot.balances.push_back({peerId, balance});
+        std::unique_lock lock(escrows_mutex_);
+        auto it = escrow_expiry_.begin();
+        while (it != escrow_expiry_.end() && it->first <= nowMs) {
+            if (expired.size() >= limit) {
+                result.more = true;
+                break;
+            }
+            
+            const Escrow* found = escrows_.find(it->second);
+            if (!found) {
+                it = escrow_expiry_.erase(it);
+                continue;
+            }
+            if (found->locked) {
+                // Drop it from the index so the next sweep starts past it
+                ++result.skippedLocked;
+                it = escrow_expiry_.erase(it);
+                continue;
+            }
+            
+            ++it;
+            expired.push_back(*found);
+            eraseEscrow_unsafe(expired.back());
         }
     }
+    
+    if (expired.empty()) {
+        return result;
+    }
+    
+    // Refund every client under a single balances lock
+    std::vector<Escrow> rollback;
+    std::vector<LedgerEvent> events;
+    events.reserve(expired.size());
+    const std::uint64_t timestamp = getCurrentTimestamp();
     {
-        std::shared_lock escrowsLock(escrows_mutex_);
-        snapshot.escrows.reserve(escrows_.size());
-        for (const auto& [_, escrow] : escrows_) {
-            snapshot.escrows.push_back(
-                {escrow.taskId, escrow.clientPeerId, escrow.amount, escrow.locked, escrow.createdAt});
+        std::unique_lock lock(balances_mutex_);
+        for (const auto& escrow : expired) {
+            std::uint64_t currentBalance = getBalance_unsafe(escrow.clientPeerId);
+            if (currentBalance > std::numeric_limits<std::uint64_t>::max() - escrow.amount) {
+                rollback.push_back(escrow);
+                continue;
+            }
+            setBalance_unsafe(escrow.clientPeerId, currentBalance + escrow.amount);
+            
+            result.refundedTaskIds.push_back(escrow.taskId);
+            result.refundedAmount += escrow.amount;
+            events.push_back({LedgerEventType::ESCROW_REFUNDED, escrow.clientPeerId,
+                              escrow.amount, escrow.taskId, timestamp});
         }
     }
-    std::sort(snapshot.balances.begin(), snapshot.balances.end(),
-              [](const auto& lhs, const auto& rhs) { return lhs.peerId < rhs.peerId; });
-    std::sort(snapshot.escrows.begin(), snapshot.escrows.end(),
-              [](const auto& lhs, const auto& rhs) { return lhs.taskId < rhs.taskId; });
+    
+    if (!rollback.empty()) {
+        // Rollback: put escrows that would overflow their client back
+        std::unique_lock lock(escrows_mutex_);
+        for (const auto& escrow : rollback) {
+            insertEscrow_unsafe(escrow);
+        }
+    }
+    
+    emitEvents(events);
+    return result;
+}
+
+std::size_t InMemoryLedger::getOutstandingEscrowCount(const std::string& clientPeerId) const {
+    std::shared_lock lock(escrows_mutex_);
+    auto it = client_escrows_.find(clientPeerId);
+    return it != client_escrows_.end() ? it->second.count : 0;
+}
+
+std::uint64_t InMemoryLedger::getOutstandingEscrowAmount(const std::string& clientPeerId) const {
+    std::shared_lock lock(escrows_mutex_);
+    auto it = client_escrows_.find(clientPeerId);
+    return it != client_escrows_.end() ? it->second.amount : 0;
+}
+
+void InMemoryLedger::setMaxEscrowsPerClient(std::size_t maxEscrows) {
+    std::unique_lock lock(escrows_mutex_);
+    max_escrows_per_client_ = maxEscrows;
+}
+
+ailee::l2::LedgerSnapshot InMemoryLedger::snapshot() const {
+    return version().materialize();
+}
+
+LedgerVersion InMemoryLedger::version() const {
+    // Both locks are taken (in clear()'s order) so balances and escrows come
+    // from the same instant; only two root pointers are copied under them.
+    std::shared_lock balancesLock(balances_mutex_);
+    std::shared_lock escrowsLock(escrows_mutex_);
+    return LedgerVersion{balances_, escrows_};
+}
+
+ailee::l2::LedgerSnapshot LedgerVersion::materialize() const {
+    ailee::l2::LedgerSnapshot snapshot;
+    snapshot.balances.reserve(balances.size());
+    for (const auto& [peerId, balance] : balances) {
+        snapshot.balances.push_back({peerId, balance});
+    }
+    snapshot.escrows.reserve(escrows.size());
+    for (const auto& [_, escrow] : escrows) {
+        snapshot.escrows.push_back(
+            {escrow.taskId, escrow.clientPeerId, escrow.amount, escrow.locked, escrow.createdAt,
+             escrow.timeoutMs});
+    }
     return snapshot;
 }
 
@@ -351,6 +457,8 @@ void InMemoryLedger::clear() {
     
     balances_.clear();
     escrows_.clear();
+    escrow_expiry_.clear();
+    client_escrows_.clear();
 }
 
 bool InMemoryLedger::removeAccount(const std::string& peerId) {
@@ -360,17 +468,17 @@ bool InMemoryLedger::removeAccount(const std::string& peerId) {
     
     std::unique_lock lock(balances_mutex_);
     
-    auto it = balances_.find(peerId);
-    if (it == balances_.end()) {
+    const std::uint64_t* balance = balances_.find(peerId);
+    if (!balance) {
         return false;
     }
     
     // Only allow removal of zero-balance accounts
-    if (it->second != 0) {
+    if (*balance != 0) {
         return false;
     }
     
-    balances_.erase(it);
+    balances_.erase(peerId);
     return true;
 }
 
@@ -405,6 +513,30 @@ void InMemoryLedger::emitEvent(LedgerEventType type, const std::string& peerId,
     }
 }
 
+void InMemoryLedger::emitEvents(const std::vector<LedgerEvent>& events) {
+    if (events.empty()) {
+        return;
+    }
+    
+    std::unique_lock lock(callback_mutex_);
+    
+    if (!event_callback_) {
+        return;
+    }
+    
+    // Copy the callback once for the whole batch
+    auto callback = event_callback_;
+    lock.unlock();
+    
+    for (const auto& event : events) {
+        try {
+            callback(event);
+        } catch (...) {
+            // Swallow exceptions from callbacks to maintain ledger consistency
+        }
+    }
+}
+
 bool InMemoryLedger::validatePeerId(const std::string& peerId) const {
     return !peerId.empty() && peerId.length() <= 256;
 }
@@ -414,15 +546,39 @@ bool InMemoryLedger::validateAmount(std::uint64_t amount) const {
 }
 
 std::uint64_t InMemoryLedger::getBalance_unsafe(const std::string& peerId) const {
-    auto it = balances_.find(peerId);
-    return (it != balances_.end()) ? it->second : 0;
+    const std::uint64_t* balance = balances_.find(peerId);
+    return balance ? *balance : 0;
 }
 
 void InMemoryLedger::setBalance_unsafe(const std::string& peerId, std::uint64_t balance) {
     if (balance == 0) {
         balances_.erase(peerId);
     } else {
-        balances_[peerId] = balance;
+        balances_.insert_or_assign(peerId, balance);
+    }
+}
+
+void InMemoryLedger::insertEscrow_unsafe(const Escrow& escrow) {
+    escrows_.insert_or_assign(escrow.taskId, escrow);
+    if (escrow.timeoutMs != 0) {
+        escrow_expiry_.emplace(escrow.deadline(), escrow.taskId);
+    }
+    auto& usage = client_escrows_[escrow.clientPeerId];
+    usage.count += 1;
+    usage.amount += escrow.amount;
+}
+
+void InMemoryLedger::eraseEscrow_unsafe(const Escrow& escrow) {
+    escrows_.erase(escrow.taskId);
+    if (escrow.timeoutMs != 0) {
+        escrow_expiry_.erase({escrow.deadline(), escrow.taskId});
+    }
+    auto usage = client_escrows_.find(escrow.clientPeerId);
+    if (usage != client_escrows_.end()) {
+        usage->second.amount -= escrow.amount;
+        if (--usage->second.count == 0) {
+            client_escrows_.erase(usage);
+        }
     }
 }
 
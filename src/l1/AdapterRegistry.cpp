@@ -25,6 +25,9 @@ namespace global_seven {
 
 // ---- Internal state ----
 static std::mutex g_registryMutex;
+// Serializes table publication; separate from g_registryMutex because the
+// bootstrap holds that one while registering.
+static std::mutex g_publishMutex;
 
 // ---- AdapterRegistry methods ----
 
@@ -33,20 +36,41 @@ AdapterRegistry& AdapterRegistry::instance() {
     return reg;
 }
 
+AdapterRegistry::AdapterRegistry()
+    : table_(std::make_shared<const AdapterTable>()) {}
+
 void AdapterRegistry::registerAdapter(
     Chain chain,
     std::unique_ptr<IChainAdapter> adapter
 ) {
-    std::lock_guard<std::mutex> lock(g_registryMutex);
-    adapters_[chain] = std::move(adapter);
+    const size_t index = static_cast<size_t>(chain);
+    if (index >= kChainCount) {
+        std::cerr << "[AdapterRegistry] Rejected adapter for unknown chain="
+                  << index << std::endl;
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(g_publishMutex);
+
+    // Copy-on-write: readers never see a table being modified.
+    auto next = std::make_shared<AdapterTable>(*std::atomic_load(&table_));
+    (*next)[index] = std::shared_ptr<IChainAdapter>(std::move(adapter));
+    std::atomic_store(&table_, std::shared_ptr<const AdapterTable>(std::move(next)));
 
     std::cout << "[AdapterRegistry] Registered adapter for chain="
               << static_cast<int>(chain) << std::endl;
 }
 
-IChainAdapter* AdapterRegistry::get(Chain chain) const {
-    auto it = adapters_.find(chain);
-    return (it != adapters_.end()) ? it->second.get() : nullptr;
+std::shared_ptr<IChainAdapter> AdapterRegistry::get(Chain chain) const {
+    const size_t index = static_cast<size_t>(chain);
+    if (index >= kChainCount) {
+        return nullptr;
+    }
+    return (*std::atomic_load(&table_))[index];
+}
+
+std::shared_ptr<const AdapterTable> AdapterRegistry::snapshot() const {
+    return std::atomic_load(&table_);
 }
 
 // ---- Default bootstrap ----
@@ -0,0 +1,168 @@
+#include "RocksDbReflectionHandle.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <rocksdb/db.h>
+#include <rocksdb/slice.h>
+
+namespace ailee {
+
+namespace {
+
+std::atomic<uint64_t> next_handle_id{1};
+
+} // namespace
+
+thread_local std::unordered_map<uint64_t, std::shared_ptr<RocksDbReflectionHandle::ThreadPins>>
+    RocksDbReflectionHandle::thread_pins_;
+
+RocksDbReflectionHandle::RocksDbReflectionHandle(std::shared_ptr<rocksdb::DB> db, ReflectionKeys keys)
+    : db_(std::move(db)), keys_(std::move(keys)), id_(next_handle_id.fetch_add(1, std::memory_order_relaxed)) {
+    if (!db_) {
+        throw std::runtime_error("RocksDbReflectionHandle requires a valid RocksDB instance");
+    }
+}
+
+RocksDbReflectionHandle::~RocksDbReflectionHandle() {
+    // Release pins of threads that outlive the handle while db_ is still held.
+    std::lock_guard<std::mutex> lock(pins_mutex_);
+    for (auto& weak : pins_) {
+        if (auto pins = weak.lock()) {
+            pins->value.Reset();
+            pins->anchor.Reset();
+            pins->reorg.Reset();
+            pins->height.Reset();
+            pins->orphaned.store(true, std::memory_order_release);
+        }
+    }
+}
+
+bool RocksDbReflectionHandle::get_pinned(
+    const std::string& key,
+    rocksdb::PinnableSlice& pinned,
+    rocksdb::Slice& out_slice) const {
+    pinned.Reset();
+    rocksdb::Status s = db_->Get(rocksdb::ReadOptions(), db_->DefaultColumnFamily(), key, &pinned);
+    if (!s.ok()) {
+        return false;
+    }
+    out_slice = rocksdb::Slice(pinned.data(), pinned.size());
+    return true;
+}
+
+RocksDbReflectionHandle::ThreadPins& RocksDbReflectionHandle::pins_for_this_thread() const {
+    auto found = thread_pins_.find(id_);
+    if (found != thread_pins_.end()) {
+        return *found->second;
+    }
+
+    // First use on this thread: drop entries left by destroyed handles.
+    for (auto it = thread_pins_.begin(); it != thread_pins_.end();) {
+        if (it->second->orphaned.load(std::memory_order_acquire)) {
+            it = thread_pins_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    auto pins = std::make_shared<ThreadPins>();
+    {
+        std::lock_guard<std::mutex> lock(pins_mutex_);
+        pins_.erase(std::remove_if(pins_.begin(), pins_.end(),
+                                   [](const std::weak_ptr<ThreadPins>& weak) { return weak.expired(); }),
+                    pins_.end());
+        pins_.push_back(pins);
+    }
+    return *thread_pins_.emplace(id_, std::move(pins)).first->second;
+}
+
+size_t RocksDbReflectionHandle::pinned_thread_count() const {
+    std::lock_guard<std::mutex> lock(pins_mutex_);
+    return static_cast<size_t>(std::count_if(pins_.begin(), pins_.end(),
+                                             [](const std::weak_ptr<ThreadPins>& weak) { return !weak.expired(); }));
+}
+
+uint64_t RocksDbReflectionHandle::get_latest_l1_height() const {
+    rocksdb::PinnableSlice pinned;
+    rocksdb::Slice slice;
+    uint64_t height = 0;
+    if (get_pinned(keys_.block_height, pinned, slice) && slice.size() == sizeof(uint64_t)) {
+        std::memcpy(&height, slice.data(), sizeof(uint64_t));
+    }
+    return height;
+}
+
+void RocksDbReflectionHandle::get_latest_confirmed_anchor(uint8_t out_hash[32]) const {
+    rocksdb::PinnableSlice pinned;
+    rocksdb::Slice slice;
+    if (get_pinned(keys_.anchor, pinned, slice) && slice.size() >= 32) {
+        std::memcpy(out_hash, slice.data(), 32);
+    } else {
+        std::memset(out_hash, 0, 32);
+    }
+}
+
+bool RocksDbReflectionHandle::get_raw_value(const std::string& key, rocksdb::Slice& out_slice) const {
+    return get_pinned(key, pins_for_this_thread().value, out_slice);
+}
+
+bool RocksDbReflectionHandle::get_raw_anchor_slice(rocksdb::Slice& out_slice) const {
+    return get_pinned(keys_.anchor, pins_for_this_thread().anchor, out_slice);
+}
+
+bool RocksDbReflectionHandle::get_raw_reorg_slice(rocksdb::Slice& out_slice) const {
+    return get_pinned(keys_.reorg, pins_for_this_thread().reorg, out_slice);
+}
+
+bool RocksDbReflectionHandle::get_raw_block_height_slice(rocksdb::Slice& out_slice) const {
+    return get_pinned(keys_.block_height, pins_for_this_thread().height, out_slice);
+}
+
+bool RocksDbReflectionHandle::read_reflection(ReflectionRead& out) const {
+    constexpr size_t KEY_COUNT = 3;
+
+    const rocksdb::Snapshot* snapshot = db_->GetSnapshot();
+    rocksdb::ReadOptions read_options;
+    read_options.snapshot = snapshot;
+
+    rocksdb::Slice keys[KEY_COUNT] = {
+        rocksdb::Slice(keys_.block_height),
+        rocksdb::Slice(keys_.anchor),
+        rocksdb::Slice(keys_.reorg)
+    };
+    rocksdb::Status statuses[KEY_COUNT];
+    for (auto& pinned : out.pinned) {
+        pinned.Reset();
+    }
+
+    db_->MultiGet(read_options, db_->DefaultColumnFamily(), KEY_COUNT, keys, out.pinned, statuses);
+
+    out.sequence = snapshot->GetSequenceNumber();
+    out.has_sequence = true;
+    // Pinned values hold their own references and outlive the snapshot.
+    db_->ReleaseSnapshot(snapshot);
+
+    rocksdb::Slice* views[KEY_COUNT] = {&out.block_height, &out.anchor, &out.reorg};
+    bool* present[KEY_COUNT] = {&out.has_block_height, &out.has_anchor, &out.has_reorg};
+    for (size_t i = 0; i < KEY_COUNT; ++i) {
+        if (statuses[i].ok()) {
+            *views[i] = rocksdb::Slice(out.pinned[i].data(), out.pinned[i].size());
+            *present[i] = true;
+        } else if (statuses[i].IsNotFound()) {
+            *views[i] = rocksdb::Slice();
+            *present[i] = false;
+        } else {
+            // An I/O error on any key fails the whole read rather than
+            // mixing fresh and missing values.
+            return false;
+        }
+    }
+    return true;
+}
+
+bool RocksDbReflectionHandle::latest_sequence_number(uint64_t& out_sequence) const {
+    out_sequence = db_->GetLatestSequenceNumber();
+    return true;
+}
+
+} // namespace ailee
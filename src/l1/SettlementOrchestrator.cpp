@@ -0,0 +1,356 @@
+// SettlementOrchestrator.cpp
+// Bitcoin-anchored settlement: synchronous execution plus per-chain
+// asynchronous lanes with batched risk checks and coalesced broadcasts.
+
+#include "Global_Seven.h"
+
+#include <utility>
+
+namespace ailee {
+namespace global_seven {
+
+namespace {
+
+std::string paramOrEmpty(const SettlementIntent& intent, const char* key) {
+    auto it = intent.params.find(key);
+    return it != intent.params.end() ? it->second : "";
+}
+
+TxOut buildOutput(const SettlementIntent& intent) {
+    // Build outputs (simplified; actual peg logic handled upstream)
+    TxOut o;
+    o.address = paramOrEmpty(intent, "targetAddress");
+    o.amount  = intent.minReceiveTarget;
+    return o;
+}
+
+std::unordered_map<std::string, std::string> buildOptions(const SettlementIntent& intent) {
+    return {
+        {"settlementKind", std::to_string(static_cast<int>(intent.kind))},
+        {"vaultId", paramOrEmpty(intent, "vaultId")},
+        {"pegTag", paramOrEmpty(intent, "pegTag")}
+    };
+}
+
+SettlementReceipt rejected(RiskFlags risk, const char* reason) {
+    SettlementReceipt receipt;
+    receipt.risk = std::move(risk);
+    receipt.risk.reason = reason;
+    return receipt;
+}
+
+} // namespace
+
+SettlementOrchestrator::SettlementOrchestrator(ErrorCallback onError, size_t queueCapacity)
+    : onError_(std::move(onError)),
+      queueCapacity_(queueCapacity == 0 ? 1 : queueCapacity) {}
+
+SettlementOrchestrator::~SettlementOrchestrator() {
+    shutdown();
+}
+
+// ---- Risk controls ----
+
+SettlementOrchestrator::RiskState SettlementOrchestrator::riskSnapshot() const {
+    std::lock_guard<std::mutex> lock(riskMutex_);
+    return RiskState{currentRisk_, minOracleConfidence_, enforceOracleConfidence_};
+}
+
+bool SettlementOrchestrator::precheck(const SettlementIntent& intent,
+                                      const RiskState& state,
+                                      RiskFlags& outRisk) {
+    outRisk = state.risk;
+
+    // Circuit breaker: force BTC settlement only
+    if (state.risk.circuitBreakerTripped) {
+        if (intent.targetChain != Chain::Bitcoin) {
+            outRisk.reason = "Circuit breaker: non‑BTC settlement blocked.";
+            return false;
+        }
+    }
+
+    // Oracle confidence check (if provided)
+    if (intent.oracle.has_value() && intent.oracle->confidence < state.minOracleConfidence) {
+        outRisk.anomalyDetected = true;
+        outRisk.reason = "Low oracle confidence.";
+        if (state.enforceOracleConfidence) return false;
+    }
+
+    // Fee/slippage pre‑check (display‑level validation; exact math in adapters)
+    // Note: actual settlement math must be integer‑safe and done per chain adapter.
+    if (intent.slippagePolicy.enforceHard && intent.slippagePolicy.maxSlippagePct <= 0.0) {
+        outRisk.reason = "Invalid slippage policy.";
+        return false;
+    }
+    return true;
+}
+
+void SettlementOrchestrator::markBroadcastFailure() {
+    {
+        std::lock_guard<std::mutex> lock(riskMutex_);
+        currentRisk_.anomalyDetected = true;
+    }
+    reportError("Broadcast failure");
+}
+
+void SettlementOrchestrator::reportError(const std::string& message) {
+    if (!onError_) {
+        return;
+    }
+    // Runs on lane workers too, where an escaping exception would terminate.
+    try {
+        onError_(AdapterError{Severity::Error, message, "Orchestrator", -2});
+    } catch (...) {
+    }
+}
+
+void SettlementOrchestrator::setRisk(const RiskFlags& r) {
+    std::lock_guard<std::mutex> lock(riskMutex_);
+    currentRisk_ = r;
+}
+
+RiskFlags SettlementOrchestrator::getRisk() const {
+    std::lock_guard<std::mutex> lock(riskMutex_);
+    return currentRisk_;
+}
+
+void SettlementOrchestrator::setOracleConfidenceFloor(double floor, bool enforce) {
+    std::lock_guard<std::mutex> lock(riskMutex_);
+    minOracleConfidence_ = floor;
+    enforceOracleConfidence_ = enforce;
+}
+
+// ---- Synchronous path ----
+
+bool SettlementOrchestrator::execute(const SettlementIntent& intent,
+                                     std::string& outTargetTxId,
+                                     RiskFlags& outRisk) {
+    if (!precheck(intent, riskSnapshot(), outRisk)) {
+        return false;
+    }
+
+    // Route to target adapter (often BTC for final settlement)
+    std::shared_ptr<IChainAdapter> adapter = AdapterRegistry::instance().get(intent.targetChain);
+    if (!adapter) {
+        outRisk.reason = "No adapter registered for target chain.";
+        return false;
+    }
+
+    // Broadcast via target adapter
+    std::string txid;
+    bool ok = adapter->broadcastTransaction({buildOutput(intent)}, buildOptions(intent), txid);
+    if (!ok) {
+        outRisk.reason = "Broadcast failed at target adapter.";
+        markBroadcastFailure();
+        return false;
+    }
+
+    outTargetTxId = txid;
+    return true;
+}
+
+// ---- Asynchronous lanes ----
+
+std::future<SettlementReceipt> SettlementOrchestrator::submit(SettlementIntent intent) {
+    Pending pending;
+    pending.intent = std::move(intent);
+    std::future<SettlementReceipt> future = pending.promise.get_future();
+    enqueue(std::move(pending));
+    return future;
+}
+
+bool SettlementOrchestrator::submit(SettlementIntent intent, SettlementCallback onDone) {
+    Pending pending;
+    pending.intent = std::move(intent);
+    pending.callback = std::move(onDone);
+    return enqueue(std::move(pending));
+}
+
+void SettlementOrchestrator::complete(Pending& pending, const SettlementReceipt& receipt) {
+    if (pending.done) {
+        return;
+    }
+    pending.done = true;
+    // Fulfil the future first so a throwing callback cannot strand it.
+    pending.promise.set_value(receipt);
+    if (!pending.callback) {
+        return;
+    }
+    try {
+        pending.callback(receipt);
+    } catch (const std::exception& e) {
+        reportError(std::string("Settlement callback threw: ") + e.what());
+    } catch (...) {
+        reportError("Settlement callback threw.");
+    }
+}
+
+bool SettlementOrchestrator::enqueue(Pending pending) {
+    const size_t index = static_cast<size_t>(pending.intent.targetChain);
+    if (index >= kChainCount) {
+        complete(pending, rejected(getRisk(), "Unknown target chain."));
+        return false;
+    }
+    Lane* lane = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(lanesMutex_);
+        if (!stopped_) {
+            if (!lanes_[index]) {
+                lanes_[index] = std::make_unique<Lane>();
+                Lane& created = *lanes_[index];
+                created.worker = std::thread([this, chain = pending.intent.targetChain, &created]() {
+                    runLane(chain, created);
+                });
+            }
+            lane = lanes_[index].get();
+        }
+    }
+    if (!lane) {
+        complete(pending, rejected(getRisk(), "Orchestrator stopped."));
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(lane->mutex);
+        if (!lane->stopping && lane->queue.size() < queueCapacity_) {
+            lane->queue.push_back(std::move(pending));
+            lane->cv.notify_one();
+            return true;
+        }
+    }
+    complete(pending, rejected(getRisk(), "Settlement queue full."));
+    return false;
+}
+
+void SettlementOrchestrator::runLane(Chain chain, Lane& lane) {
+    std::vector<Pending> batch;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(lane.mutex);
+            lane.cv.wait(lock, [&lane]() { return lane.stopping || !lane.queue.empty(); });
+            if (lane.queue.empty()) {
+                return;  // stopping and drained
+            }
+            batch.clear();
+            while (!lane.queue.empty()) {
+                batch.push_back(std::move(lane.queue.front()));
+                lane.queue.pop_front();
+            }
+        }
+        try {
+            settleBatch(chain, batch);
+        } catch (const std::exception& e) {
+            reportError(std::string("Settlement batch failed: ") + e.what());
+        } catch (...) {
+            reportError("Settlement batch failed.");
+        }
+        // Anything the batch did not get to still owes its caller a receipt.
+        for (auto& pending : batch) {
+            complete(pending, rejected(getRisk(), "Settlement failed in orchestrator."));
+        }
+    }
+}
+
+void SettlementOrchestrator::settleBatch(Chain chain, std::vector<Pending>& batch) {
+    const RiskState state = riskSnapshot();
+
+    // Resolve the adapter once per batch; the reference keeps it alive even
+    // if it is replaced while the batch settles.
+    std::shared_ptr<IChainAdapter> adapter = AdapterRegistry::instance().get(chain);
+
+    // Risk checks for the whole batch against one snapshot; survivors are
+    // grouped by broadcast options in first-seen order.
+    struct Group {
+        std::unordered_map<std::string, std::string> opts;
+        std::vector<size_t> members;
+    };
+    std::vector<Group> groups;
+    std::vector<RiskFlags> risks(batch.size());
+
+    for (size_t i = 0; i < batch.size(); ++i) {
+        if (!precheck(batch[i].intent, state, risks[i])) {
+            SettlementReceipt receipt;
+            receipt.risk = risks[i];
+            complete(batch[i], receipt);
+            continue;
+        }
+        if (!adapter) {
+            complete(batch[i], rejected(risks[i], "No adapter registered for target chain."));
+            continue;
+        }
+
+        auto opts = buildOptions(batch[i].intent);
+        Group* target = nullptr;
+        for (auto& group : groups) {
+            if (group.opts == opts && group.members.size() < kMaxOutputsPerBroadcast) {
+                target = &group;
+                break;
+            }
+        }
+        if (!target) {
+            groups.push_back(Group{std::move(opts), {}});
+            target = &groups.back();
+        }
+        target->members.push_back(i);
+    }
+
+    for (auto& group : groups) {
+        std::vector<TxOut> outs;
+        outs.reserve(group.members.size());
+        for (size_t i : group.members) {
+            outs.push_back(buildOutput(batch[i].intent));
+        }
+
+        std::string txid;
+        bool ok = false;
+        const char* failure = "Broadcast failed at target adapter.";
+        try {
+            ok = adapter->broadcastTransaction(outs, group.opts, txid);
+        } catch (...) {
+            failure = "Broadcast threw at target adapter.";
+        }
+        if (!ok) {
+            markBroadcastFailure();
+        }
+
+        for (size_t i : group.members) {
+            SettlementReceipt receipt;
+            receipt.risk = risks[i];
+            receipt.coalescedIntents = group.members.size();
+            if (ok) {
+                receipt.ok = true;
+                receipt.targetTxId = txid;
+            } else {
+                receipt.risk.reason = failure;
+            }
+            complete(batch[i], receipt);
+        }
+    }
+}
+
+void SettlementOrchestrator::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(lanesMutex_);
+        if (stopped_) {
+            return;
+        }
+        stopped_ = true;
+    }
+    // No new lanes can appear once stopped_ is set.
+    for (auto& lane : lanes_) {
+        if (!lane) continue;
+        {
+            std::lock_guard<std::mutex> lock(lane->mutex);
+            lane->stopping = true;
+        }
+        lane->cv.notify_all();
+    }
+    for (auto& lane : lanes_) {
+        if (lane && lane->worker.joinable()) {
+            lane->worker.join();
+        }
+    }
+}
+
+} // namespace global_seven
+} // namespace ailee
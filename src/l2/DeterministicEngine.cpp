@@ -1,6 +1,9 @@
 #include "l2/DeterministicEngine.h"
 #include <cstring>
 #include <algorithm>
+#include <atomic>
+#include <thread>
+#include <openssl/sha.h>
 
 namespace ailee {
 namespace l2 {
@@ -44,14 +47,80 @@ EngineRunSummary DeterministicEngine::run_offline(
     const std::vector<mesh::MeshCoherenceResult>& coherences,
     const identity::NodeId& node_id,
     uint32_t protocol_version
+) {
+    std::vector<EngineCheckpoint> unused;
+    return run_offline(snapshots, ingestions, coherences, node_id, protocol_version, 0, unused);
+}
+
+void DeterministicEngine::fold_state_digest(uint8_t digest[32], const EngineState& state) {
+    uint8_t buffer[32 + sizeof(EngineState)];
+    std::memcpy(buffer, digest, 32);
+    std::memcpy(buffer + 32, &state, sizeof(EngineState));
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+    SHA256(buffer, sizeof(buffer), digest);
+#pragma GCC diagnostic pop
+}
+
+namespace {
+
+void append_checkpoint(std::vector<EngineCheckpoint>& checkpoints,
+                       const EngineState& state,
+                       const uint8_t digest[32]) {
+    EngineCheckpoint cp;
+    std::memset(&cp, 0, sizeof(EngineCheckpoint));
+    cp.state = state;
+    cp.step = state.step_counter;
+    std::memcpy(cp.digest, digest, 32);
+    checkpoints.push_back(cp);
+}
+
+} // namespace
+
+EngineRunSummary DeterministicEngine::run_offline(
+    const std::vector<reflection::ReflectionSnapshot>& snapshots,
+    const std::vector<l1::SettlementIngestion>& ingestions,
+    const std::vector<mesh::MeshCoherenceResult>& coherences,
+    const identity::NodeId& node_id,
+    uint32_t protocol_version,
+    uint64_t checkpoint_interval,
+    std::vector<EngineCheckpoint>& checkpoints,
+    std::vector<EngineStepDigest>* step_digests
 ) {
     DeterministicEngine engine;
 
     size_t min_len = std::min({snapshots.size(), ingestions.size(), coherences.size()});
     bool mismatch = (snapshots.size() != ingestions.size()) || (ingestions.size() != coherences.size());
 
+    uint8_t digest[32] = {0};
+    const bool track_digest = checkpoint_interval > 0 || step_digests != nullptr;
+    if (track_digest) {
+        fold_state_digest(digest, engine.m_state);
+    }
+    if (step_digests) {
+        step_digests->clear();
+        step_digests->reserve(min_len);
+    }
+    if (checkpoint_interval > 0) {
+        checkpoints.clear();
+        checkpoints.reserve(min_len / checkpoint_interval + 2);
+        append_checkpoint(checkpoints, engine.m_state, digest);
+    }
+
     for (size_t i = 0; i < min_len; ++i) {
         engine.step(snapshots[i], ingestions[i], coherences[i], node_id, protocol_version);
+        if (track_digest) {
+            fold_state_digest(digest, engine.m_state);
+        }
+        if (step_digests) {
+            EngineStepDigest entry;
+            std::memcpy(entry.data(), digest, 32);
+            step_digests->push_back(entry);
+        }
+        if (checkpoint_interval > 0 && ((i + 1) % checkpoint_interval == 0 || i + 1 == min_len)) {
+            append_checkpoint(checkpoints, engine.m_state, digest);
+        }
     }
 
     EngineRunSummary summary;
@@ -66,5 +135,128 @@ EngineRunSummary DeterministicEngine::run_offline(
     return summary;
 }
 
+EngineVerifyResult DeterministicEngine::verify_offline(
+    const std::vector<reflection::ReflectionSnapshot>& snapshots,
+    const std::vector<l1::SettlementIngestion>& ingestions,
+    const std::vector<mesh::MeshCoherenceResult>& coherences,
+    const identity::NodeId& node_id,
+    uint32_t protocol_version,
+    const std::vector<EngineCheckpoint>& checkpoints,
+    uint32_t max_threads,
+    const std::vector<EngineStepDigest>* step_digests
+) {
+    EngineVerifyResult result;
+    std::memset(&result, 0, sizeof(EngineVerifyResult));
+
+    const size_t min_len = std::min({snapshots.size(), ingestions.size(), coherences.size()});
+    const size_t count = checkpoints.size();
+    if (count == 0) {
+        return result;
+    }
+
+    // Checkpoint 0 must be the zeroed initial state every run starts from,
+    // and later checkpoints must be strictly ordered and within the inputs.
+    // Segments are only replayed up to the first malformed record.
+    size_t first_bad = count;
+    {
+        EngineState initial;
+        std::memset(&initial, 0, sizeof(EngineState));
+        uint8_t seed[32] = {0};
+        fold_state_digest(seed, initial);
+        if (std::memcmp(&initial, &checkpoints[0].state, sizeof(EngineState)) != 0 ||
+            std::memcmp(seed, checkpoints[0].digest, 32) != 0 || checkpoints[0].step != 0) {
+            first_bad = 0;
+        }
+    }
+    for (size_t i = 1; i < count && first_bad == count; ++i) {
+        const EngineCheckpoint& cp = checkpoints[i];
+        if (cp.step <= checkpoints[i - 1].step || cp.step > min_len) {
+            first_bad = i;
+        }
+    }
+
+    // Segment i replays (checkpoint i, checkpoint i+1]. Segments are claimed
+    // in ascending order so the earliest failure is found first; later
+    // segments are skipped once an earlier one has failed.
+    const size_t segments = first_bad == 0 ? 0 : std::min(first_bad, count) - 1;
+    std::atomic<size_t> next_segment{0};
+    std::atomic<size_t> first_failed{count};
+    std::atomic<uint64_t> verified{0};
+    std::vector<uint8_t> state_differs(count, 0);
+
+    auto worker = [&]() {
+        for (;;) {
+            const size_t seg = next_segment.fetch_add(1);
+            if (seg >= segments || seg + 1 >= first_failed.load()) {
+                return;
+            }
+
+            DeterministicEngine engine(checkpoints[seg].state);
+            uint8_t digest[32];
+            std::memcpy(digest, checkpoints[seg].digest, 32);
+            for (uint64_t s = checkpoints[seg].step; s < checkpoints[seg + 1].step; ++s) {
+                engine.step(snapshots[s], ingestions[s], coherences[s], node_id, protocol_version);
+                fold_state_digest(digest, engine.m_state);
+            }
+
+            const EngineCheckpoint& expected = checkpoints[seg + 1];
+            const bool state_ok = std::memcmp(&engine.m_state, &expected.state, sizeof(EngineState)) == 0;
+            if (!state_ok || std::memcmp(digest, expected.digest, 32) != 0) {
+                state_differs[seg + 1] = state_ok ? 0 : 1;
+                size_t current = first_failed.load();
+                while (seg + 1 < current && !first_failed.compare_exchange_weak(current, seg + 1)) {
+                }
+            }
+            verified.fetch_add(1);
+        }
+    };
+
+    uint32_t threads = max_threads != 0 ? max_threads : std::thread::hardware_concurrency();
+    threads = static_cast<uint32_t>(std::min<size_t>(std::max<uint32_t>(threads, 1), std::max<size_t>(segments, 1)));
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (uint32_t t = 1; t < threads; ++t) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    const size_t divergent = std::min(first_failed.load(), first_bad);
+
+    result.segments_verified = verified.load();
+    if (divergent < count) {
+        result.diverged = true;
+        result.state_mismatch = divergent == first_bad || state_differs[divergent] != 0;
+        result.first_divergent_checkpoint = static_cast<uint32_t>(divergent);
+        result.first_divergent_step = checkpoints[divergent].step;
+        result.segment_start_step = divergent > 0 ? checkpoints[divergent - 1].step : 0;
+
+        // Replay the failing segment from its last good checkpoint against
+        // the recorded trail. Only possible when the segment was replayable
+        // and the trail covers it.
+        const uint64_t end_step = checkpoints[divergent].step;
+        if (step_digests && divergent > 0 && divergent < first_bad && end_step <= step_digests->size()) {
+            const EngineCheckpoint& start = checkpoints[divergent - 1];
+            DeterministicEngine engine(start.state);
+            uint8_t digest[32];
+            std::memcpy(digest, start.digest, 32);
+            for (uint64_t s = start.step; s < end_step; ++s) {
+                engine.step(snapshots[s], ingestions[s], coherences[s], node_id, protocol_version);
+                fold_state_digest(digest, engine.m_state);
+                if (std::memcmp(digest, (*step_digests)[s].data(), 32) != 0) {
+                    result.first_divergent_step = s + 1;
+                    result.step_exact = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
 } // namespace l2
 } // namespace ailee
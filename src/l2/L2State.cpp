@@ -56,18 +56,59 @@ void sortSnapshot(L2StateSnapshot& snapshot) {
               [](const auto& lhs, const auto& rhs) { return lhs.taskId < rhs.taskId; });
 }
 
-std::string canonicalizeSnapshot(const L2StateSnapshot& snapshot) {
-    std::ostringstream oss;
-    oss << "L2STATE|v1\n";
-    oss << "balances:" << snapshot.ledger.balances.size() << "\n";
+// The ledger section comes from the captured version when there is one,
+// already in key order; otherwise from the (sorted) flat vectors. The escrow
+// visitor gets either an econ::Escrow or a LedgerEscrowSnapshot, which share
+// the field names it reads.
+std::size_t balanceCount(const L2StateSnapshot& snapshot) {
+    return snapshot.ledgerVersion ? snapshot.ledgerVersion->balances.size()
+                                  : snapshot.ledger.balances.size();
+}
+
+std::size_t escrowCount(const L2StateSnapshot& snapshot) {
+    return snapshot.ledgerVersion ? snapshot.ledgerVersion->escrows.size()
+                                  : snapshot.ledger.escrows.size();
+}
+
+template <typename Fn>
+void forEachBalance(const L2StateSnapshot& snapshot, Fn&& fn) {
+    if (snapshot.ledgerVersion) {
+        for (const auto& [peerId, balance] : snapshot.ledgerVersion->balances) {
+            fn(peerId, balance);
+        }
+        return;
+    }
     for (const auto& balance : snapshot.ledger.balances) {
-        oss << "balance:" << balance.peerId << ":" << balance.balance << "\n";
+        fn(balance.peerId, balance.balance);
+    }
+}
+
+template <typename Fn>
+void forEachEscrow(const L2StateSnapshot& snapshot, Fn&& fn) {
+    if (snapshot.ledgerVersion) {
+        for (const auto& entry : snapshot.ledgerVersion->escrows) {
+            fn(entry.second);
+        }
+        return;
     }
-    oss << "escrows:" << snapshot.ledger.escrows.size() << "\n";
     for (const auto& escrow : snapshot.ledger.escrows) {
-        oss << "escrow:" << escrow.taskId << ":" << escrow.clientPeerId << ":"
-            << escrow.amount << ":" << (escrow.locked ? 1 : 0) << ":" << escrow.createdAt << "\n";
+        fn(escrow);
     }
+}
+
+std::string canonicalizeSnapshot(const L2StateSnapshot& snapshot) {
+    std::ostringstream oss;
+    oss << "L2STATE|v1\n";
+    oss << "balances:" << balanceCount(snapshot) << "\n";
+    forEachBalance(snapshot, [&](const std::string& peerId, std::uint64_t balance) {
+        oss << "balance:" << peerId << ":" << balance << "\n";
+    });
+    oss << "escrows:" << escrowCount(snapshot) << "\n";
+    forEachEscrow(snapshot, [&](const auto& escrow) {
+        oss << "escrow:" << escrow.taskId << ":" << escrow.clientPeerId << ":"
+            << escrow.amount << ":" << (escrow.locked ? 1 : 0) << ":" << escrow.createdAt << ":"
+            << escrow.timeoutMs << "\n";
+    });
     oss << "pegins:" << snapshot.bridge.pegins.size() << "\n";
     for (const auto& pegin : snapshot.bridge.pegins) {
         oss << "pegin:" << pegin.pegId << ":" << pegin.btcTxId << ":" << pegin.vout << ":"
@@ -82,6 +123,10 @@ std::string canonicalizeSnapshot(const L2StateSnapshot& snapshot) {
             << ":" << pegout.anchorCommitmentHash << ":" << pegout.initiatedTime << ":"
             << pegout.completedTime << "\n";
     }
+    // Omitted until something is archived so earlier roots are unchanged.
+    if (snapshot.bridge.archivedCount > 0) {
+        oss << "archive:" << snapshot.bridge.archivedCount << ":" << snapshot.bridge.archiveRoot << "\n";
+    }
     oss << "tasks:" << snapshot.orchestration.tasks.size() << "\n";
     for (const auto& task : snapshot.orchestration.tasks) {
         oss << "task:" << task.taskId << ":" << task.taskType << ":" << task.priority << ":"
@@ -147,15 +192,16 @@ bool appendSnapshotToFile(const L2StateSnapshot& snapshot,
 
     out << kSnapshotHeader << "\n";
     out << "timestamp_ms " << snapshot.snapshotTimestampMs << "\n";
-    out << "balances " << snapshot.ledger.balances.size() << "\n";
-    for (const auto& balance : snapshot.ledger.balances) {
-        out << "balance " << quoted(balance.peerId) << " " << balance.balance << "\n";
-    }
-    out << "escrows " << snapshot.ledger.escrows.size() << "\n";
-    for (const auto& escrow : snapshot.ledger.escrows) {
+    out << "balances " << balanceCount(snapshot) << "\n";
+    forEachBalance(snapshot, [&](const std::string& peerId, std::uint64_t balance) {
+        out << "balance " << quoted(peerId) << " " << balance << "\n";
+    });
+    out << "escrows " << escrowCount(snapshot) << "\n";
+    forEachEscrow(snapshot, [&](const auto& escrow) {
         out << "escrow " << quoted(escrow.taskId) << " " << quoted(escrow.clientPeerId) << " "
-            << escrow.amount << " " << (escrow.locked ? 1 : 0) << " " << escrow.createdAt << "\n";
-    }
+            << escrow.amount << " " << (escrow.locked ? 1 : 0) << " " << escrow.createdAt << " "
+            << escrow.timeoutMs << "\n";
+    });
     out << "pegins " << snapshot.bridge.pegins.size() << "\n";
     for (const auto& pegin : snapshot.bridge.pegins) {
         out << "pegin " << quoted(pegin.pegId) << " " << quoted(pegin.btcTxId) << " " << pegin.vout
@@ -171,6 +217,9 @@ bool appendSnapshotToFile(const L2StateSnapshot& snapshot,
             << quoted(pegout.anchorCommitmentHash) << " " << pegout.initiatedTime << " "
             << pegout.completedTime << "\n";
     }
+    if (snapshot.bridge.archivedCount > 0) {
+        out << "archive " << snapshot.bridge.archivedCount << " " << quoted(snapshot.bridge.archiveRoot) << "\n";
+    }
     out << "tasks " << snapshot.orchestration.tasks.size() << "\n";
     for (const auto& task : snapshot.orchestration.tasks) {
         out << "task " << quoted(task.taskId) << " " << task.taskType << " " << task.priority << " "
@@ -252,6 +301,10 @@ std::optional<L2StateSnapshot> loadLatestSnapshotFromFile(const std::string& pat
             }
             int locked = 0;
             iss >> escrow.amount >> locked >> escrow.createdAt;
+            // Snapshots written before timeouts were recorded end here
+            if (!(iss >> escrow.timeoutMs)) {
+                escrow.timeoutMs = 0;
+            }
             escrow.locked = locked != 0;
             current.ledger.escrows.push_back(escrow);
         } else if (tag == "pegin") {
@@ -288,6 +341,14 @@ std::optional<L2StateSnapshot> loadLatestSnapshotFromFile(const std::string& pat
             }
             iss >> pegout.initiatedTime >> pegout.completedTime;
             current.bridge.pegouts.push_back(pegout);
+        } else if (tag == "archive") {
+            std::uint64_t count = 0;
+            std::string root;
+            if (!(iss >> count) || !readQuoted(iss, &root)) {
+                continue;
+            }
+            current.bridge.archivedCount = count;
+            current.bridge.archiveRoot = root;
         } else if (tag == "task") {
             TaskSnapshot task;
             if (!readQuoted(iss, &task.taskId)) {
@@ -345,7 +406,8 @@ L2StateSnapshot captureSnapshot(const ailee::econ::ILedger& ledger,
                                 std::uint64_t timestampMs) {
     L2StateSnapshot snapshot;
     snapshot.snapshotTimestampMs = timestampMs;
-    snapshot.ledger = ledger.snapshot();
+    // Only the version's roots are copied; nothing here walks the ledger.
+    snapshot.ledgerVersion = std::make_shared<const ailee::econ::LedgerVersion>(ledger.version());
     snapshot.bridge = bridge.snapshotBridgeState();
 
     auto tasks = sortedTasks(engine.getQueuedTasks());
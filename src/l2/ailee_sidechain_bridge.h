@@ -24,12 +24,19 @@
 #include <vector>
 #include <memory>
 #include <cstdint>
+#include <initializer_list>
 #include <map>
+#include <optional>
 #include <set>
+#include <stdexcept>
 #include <cmath>
 #include <chrono>
 #include <algorithm>
+#include <array>
 #include <cctype>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
 #include "Global_Seven.h"
 #include "L2State.h"
 #include "zk_proofs.h"
@@ -46,6 +53,105 @@ inline secp256k1_context* getBridgeSecp256k1VerifyContext() {
     return ctx;
 }
 
+using PegOutDigest = std::array<unsigned char, SHA256_DIGEST_LENGTH>;
+
+/**
+ * Decode a hex-encoded public key and parse it. Returns false on odd length,
+ * non-hex characters or a key secp256k1 rejects.
+ */
+inline bool parseBridgePubKeyHex(const std::string& hex, secp256k1_pubkey& out) {
+    if (hex.empty() || hex.size() % 2 != 0 || hex.size() > 130) return false;
+    auto nibble = [](char c) -> int {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    };
+    unsigned char bytes[65];
+    const size_t len = hex.size() / 2;
+    for (size_t i = 0; i < len; ++i) {
+        int hi = nibble(hex[2 * i]);
+        int lo = nibble(hex[2 * i + 1]);
+        if (hi < 0 || lo < 0) return false;
+        bytes[i] = static_cast<unsigned char>((hi << 4) | lo);
+    }
+    return secp256k1_ec_pubkey_parse(getBridgeSecp256k1VerifyContext(), &out, bytes, len) == 1;
+}
+
+/**
+ * Verify a compact (64-byte) or DER ECDSA signature over a precomputed digest.
+ * Only reads the shared verify context, so it is safe to call concurrently.
+ */
+inline bool verifyBridgeSignature(const PegOutDigest& digest,
+                                  const secp256k1_pubkey& pubkey,
+                                  const std::vector<uint8_t>& signature) {
+    if (signature.size() < 64) return false;
+    secp256k1_context* ctx = getBridgeSecp256k1VerifyContext();
+
+    secp256k1_ecdsa_signature sig;
+    bool parsed = signature.size() == 64 &&
+                  secp256k1_ecdsa_signature_parse_compact(ctx, &sig, signature.data()) == 1;
+    if (!parsed) {
+        parsed = secp256k1_ecdsa_signature_parse_der(ctx, &sig, signature.data(), signature.size()) == 1;
+    }
+    if (!parsed) return false;
+
+    secp256k1_ecdsa_signature normalized_sig;
+    secp256k1_ecdsa_signature_normalize(ctx, &normalized_sig, &sig);
+    return secp256k1_ecdsa_verify(ctx, &normalized_sig, digest.data(), &pubkey) == 1;
+}
+
+/**
+ * One signature to check. Inputs are borrowed and must outlive the call to
+ * verifyBridgeSignatures; a null pubkey (unknown or unparseable signer) fails.
+ */
+struct BridgeSignatureCheck {
+    const PegOutDigest* digest = nullptr;
+    const secp256k1_pubkey* pubkey = nullptr;
+    const std::vector<uint8_t>* signature = nullptr;
+    bool valid = false;
+};
+
+/**
+ * Verify a set of signatures, splitting them across threads once there are
+ * enough to pay for the spawn. Fills in each check's `valid` flag.
+ */
+inline void verifyBridgeSignatures(std::vector<BridgeSignatureCheck>& checks) {
+    constexpr size_t kMinChecksPerThread = 8;
+    auto run = [&checks](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            auto& c = checks[i];
+            c.valid = c.digest && c.pubkey && c.signature &&
+                      verifyBridgeSignature(*c.digest, *c.pubkey, *c.signature);
+        }
+    };
+
+    const size_t hw = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    const size_t threads = std::min(hw, checks.size() / kMinChecksPerThread);
+    if (threads <= 1) {
+        run(0, checks.size());
+        return;
+    }
+
+    const size_t chunk = (checks.size() + threads - 1) / threads;
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    size_t handedOff = std::min(chunk, checks.size()); // [0, chunk) runs here
+    try {
+        for (size_t t = 1; t < threads && handedOff < checks.size(); ++t) {
+            const size_t end = std::min(handedOff + chunk, checks.size());
+            workers.emplace_back(run, handedOff, end);
+            handedOff = end;
+        }
+    } catch (const std::system_error&) {
+        // Out of threads: the workers already started still get joined
+        // below and whatever was not handed off runs on this thread.
+    }
+    run(0, std::min(chunk, checks.size()));
+    run(handedOff, checks.size());
+    for (auto& w : workers) w.join();
+}
+
 // Bridge configuration constants
 constexpr size_t MIN_CONFIRMATIONS_PEGIN = 6;      // Bitcoin confirmations required
 constexpr size_t MIN_CONFIRMATIONS_PEGOUT = 100;   // AILEE confirmations for peg-out
@@ -260,14 +366,38 @@ public:
     bool addSigner(std::shared_ptr<FederationSigner> signer) {
         if (signers_.size() >= FEDERATION_SIZE) return false;
         
-        signers_[signer->getId()] = signer;
+        const std::string id = signer->getId();
+        signers_[id] = signer;
+
+        // Parse once here instead of on every signature check.
+        secp256k1_pubkey pubkey;
+        if (parseBridgePubKeyHex(signer->getData().publicKey, pubkey)) {
+            parsedKeys_[id] = pubkey;
+        } else {
+            parsedKeys_.erase(id);
+        }
         return true;
     }
 
     bool removeSigner(const std::string& signerId) {
+        parsedKeys_.erase(signerId);
         return signers_.erase(signerId) > 0;
     }
 
+    /**
+     * Parsed public key for a signer, as of its last addSigner. Null if the
+     * signer is unknown or its key does not parse.
+     */
+    const secp256k1_pubkey* getParsedPubKey(const std::string& signerId) const {
+        auto it = parsedKeys_.find(signerId);
+        return (it != parsedKeys_.end()) ? &it->second : nullptr;
+    }
+
+    bool isActiveSigner(const std::string& signerId) const {
+        auto it = signers_.find(signerId);
+        return it != signers_.end() && it->second->isActive();
+    }
+
     std::vector<std::string> getActiveSigners() const {
         std::vector<std::string> active;
         for (const auto& pair : signers_) {
@@ -282,6 +412,16 @@ public:
         return getActiveSigners().size();
     }
 
+    // Every registered signer, active or not.
+    std::vector<std::string> getSignerIds() const {
+        std::vector<std::string> ids;
+        ids.reserve(signers_.size());
+        for (const auto& pair : signers_) {
+            ids.push_back(pair.first);
+        }
+        return ids;
+    }
+
     std::shared_ptr<FederationSigner> getSigner(const std::string& id) {
         auto it = signers_.find(id);
         return (it != signers_.end()) ? it->second : nullptr;
@@ -295,6 +435,7 @@ public:
 
 private:
     std::map<std::string, std::shared_ptr<FederationSigner>> signers_;
+    std::map<std::string, secp256k1_pubkey> parsedKeys_;
     size_t requiredSignatures_;
 };
 
@@ -362,6 +503,14 @@ public:
         return false;
     }
 
+    // Undo a promotion whose confirmations were reorged out.
+    bool revertConfirmation() {
+        if (data_.status != PegStatus::BTC_CONFIRMED) return false;
+        data_.status = PegStatus::PENDING_BTC_CONF;
+        data_.btcConfirmations = 0;
+        return true;
+    }
+
     bool attachSPVProof(const SPVProof::ProofData& proof) {
         data_.spvProof = proof;
         data_.status = PegStatus::PENDING_BTC_CONF;
@@ -448,6 +597,7 @@ public:
         data_.completedTime = 0;
         data_.status = PegStatus::BURN_INITIATED;
         data_.anchorCommitmentHash = anchorCommitmentHash;
+        signingDigest_ = computeSigningDigest(data_);
     }
 
     bool updateConfirmations(uint64_t burnHeight, uint64_t currentHeight) {
@@ -466,6 +616,19 @@ public:
         return false;
     }
 
+    void recordBurnHeight(uint64_t burnHeight) {
+        data_.aileeBurnTxHeight = burnHeight;
+    }
+
+    // Undo a promotion whose confirmations were reorged out. Collected
+    // signatures stay; they cover fields a reorg does not change.
+    bool revertConfirmation() {
+        if (data_.status != PegStatus::PENDING_PEGOUT) return false;
+        data_.status = PegStatus::BURN_INITIATED;
+        data_.aileeConfirmations = 0;
+        return true;
+    }
+
     bool addSignature(const std::string& signerId, 
                      const std::vector<uint8_t>& signature) {
         if (data_.status != PegStatus::PENDING_PEGOUT) return false;
@@ -478,6 +641,10 @@ public:
         return data_.signatures.size() >= threshold;
     }
 
+    bool removeSignature(const std::string& signerId) {
+        return data_.signatures.erase(signerId) > 0;
+    }
+
     bool completeRelease(const std::string& btcTxId) {
         if (data_.status != PegStatus::PENDING_PEGOUT) return false;
         
@@ -543,13 +710,33 @@ public:
                 data_.signatures[it.key()] = sigBytes;
             }
         }
+        signingDigest_ = computeSigningDigest(data_);
     }
 
     const PegOutData& getData() const { return data_; }
     PegStatus getStatus() const { return data_.status; }
 
+    /**
+     * Double-SHA256 of the fields federation signers commit to. The fields are
+     * fixed once the peg-out exists, so this is computed up front.
+     */
+    const PegOutDigest& getSigningDigest() const { return signingDigest_; }
+
+    static PegOutDigest computeSigningDigest(const PegOutData& data) {
+        std::string payload = data.pegId + "|" + data.aileeSourceAddress + "|" + data.btcDestAddress + "|" +
+                              std::to_string(data.aileeBurnAmount) + "|" + std::to_string(data.btcReleaseAmount) + "|" +
+                              data.anchorCommitmentHash;
+
+        unsigned char hash1[SHA256_DIGEST_LENGTH];
+        SHA256(reinterpret_cast<const unsigned char*>(payload.data()), payload.size(), hash1);
+        PegOutDigest hash2;
+        SHA256(hash1, SHA256_DIGEST_LENGTH, hash2.data());
+        return hash2;
+    }
+
 private:
     PegOutData data_;
+    PegOutDigest signingDigest_{};
 
     static uint64_t calculateReleaseAmount(uint64_t aileeAmount) {
         // Subtract bridge fee
@@ -669,6 +856,12 @@ public:
         return data_.claimedByA && data_.claimedByB;
     }
 
+    // Both sides have either claimed or refunded; nothing can change anymore.
+    bool isSettled() const {
+        return (data_.claimedByA || data_.refundedA) &&
+               (data_.claimedByB || data_.refundedB);
+    }
+
     const SwapData& getData() const { return data_; }
 
 private:
@@ -768,6 +961,349 @@ private:
     Stats stats_;
 };
 
+/**
+ * Peg Maturity Queue
+ * Pending pegs bucketed by the height at which they reach the required
+ * confirmations, so a new tip only touches the pegs that just matured.
+ */
+class PegMaturityQueue {
+public:
+    explicit PegMaturityQueue(uint64_t confirmations) : confirmations_(confirmations) {}
+
+    uint64_t maturityHeight(uint64_t inclusionHeight) const {
+        return inclusionHeight + confirmations_;
+    }
+
+    // Tracks a peg included at `inclusionHeight`, moving it if it was
+    // already tracked at another height.
+    void track(const std::string& pegId, uint64_t inclusionHeight) {
+        untrack(pegId);
+        buckets_[maturityHeight(inclusionHeight)].push_back(pegId);
+        inclusion_[pegId] = inclusionHeight;
+    }
+
+    bool untrack(const std::string& pegId) {
+        auto it = inclusion_.find(pegId);
+        if (it == inclusion_.end()) return false;
+        auto bucketIt = buckets_.find(maturityHeight(it->second));
+        if (bucketIt != buckets_.end()) {
+            auto& ids = bucketIt->second;
+            ids.erase(std::find(ids.begin(), ids.end(), pegId));
+            if (ids.empty()) buckets_.erase(bucketIt);
+        }
+        inclusion_.erase(it);
+        return true;
+    }
+
+    /**
+     * Remove and return every peg that has matured at `tip`, paired with its
+     * inclusion height.
+     */
+    std::vector<std::pair<std::string, uint64_t>> popMatured(uint64_t tip) {
+        std::vector<std::pair<std::string, uint64_t>> matured;
+        auto end = buckets_.upper_bound(tip);
+        for (auto it = buckets_.begin(); it != end; ++it) {
+            for (auto& pegId : it->second) {
+                auto incIt = inclusion_.find(pegId);
+                matured.emplace_back(std::move(pegId), incIt->second);
+                inclusion_.erase(incIt);
+            }
+        }
+        buckets_.erase(buckets_.begin(), end);
+        return matured;
+    }
+
+    /**
+     * Drop pegs whose inclusion block is above `forkHeight` after a reorg and
+     * return their ids; they are re-tracked once included again.
+     */
+    std::vector<std::string> rewind(uint64_t forkHeight) {
+        std::vector<std::string> orphaned;
+        auto begin = buckets_.upper_bound(maturityHeight(forkHeight));
+        for (auto it = begin; it != buckets_.end(); ++it) {
+            for (auto& pegId : it->second) {
+                inclusion_.erase(pegId);
+                orphaned.push_back(std::move(pegId));
+            }
+        }
+        buckets_.erase(begin, buckets_.end());
+        return orphaned;
+    }
+
+    bool contains(const std::string& pegId) const { return inclusion_.count(pegId) > 0; }
+    size_t size() const { return inclusion_.size(); }
+
+private:
+    uint64_t confirmations_;
+    std::map<uint64_t, std::vector<std::string>> buckets_;  // Maturity height -> peg ids
+    std::unordered_map<std::string, uint64_t> inclusion_;   // Peg id -> inclusion height
+};
+
+/**
+ * Bridge Archive
+ * Append-only record of pegs, swaps and anchors that reached a terminal
+ * state. Each entry is addressed by the SHA-256 of its canonical record and
+ * folded into a running root, root_n = SHA256(root_{n-1} || hash_n), so two
+ * bridges that archived the same items in the same order agree on the root.
+ *
+ * Without storage the entries are kept in memory. With storage attached only
+ * the root and count are; entries live under bridge/archive/ and lookups
+ * read them back through the id and hash index keys.
+ */
+class BridgeArchive {
+public:
+    using Hash = std::array<unsigned char, SHA256_DIGEST_LENGTH>;
+    using BatchOps = std::vector<ailee::storage::PersistentStorage::BatchOp>;
+
+    enum class Kind : uint8_t {
+        PEGIN = 1,
+        PEGOUT = 2,
+        SWAP = 3,
+        ANCHOR = 4
+    };
+
+    struct Entry {
+        Kind kind;
+        std::string id;
+        std::string record;    // Canonical, length-prefixed fields
+        Hash hash;             // SHA256(kind || record)
+    };
+
+    explicit BridgeArchive(ailee::storage::PersistentStorage* storage = nullptr)
+        : storage_(storage) {}
+
+    /**
+     * Append a terminal item. Returns false if an entry of the same kind and
+     * id is already archived; the archive never rewrites history.
+     *
+     * With storage attached the entry, its index keys and the new head are
+     * queued on `ops` for the caller to write together with the state
+     * change. Queued entries are not visible to lookups, and do not move
+     * root() or size(), until commit(); call rollback() if the write fails.
+     */
+    bool append(Kind kind, const std::string& id, std::string record, BatchOps& ops) {
+        if (contains(kind, id)) return false;
+
+        const Hash hash = hashRecord(kind, record);
+        Entry entry{kind, id, std::move(record), hash};
+        pendingRoot_ = chain(pendingRoot_, entry.hash);
+        const uint64_t index = pendingCount_++;
+
+        if (!storage_) {
+            byId_.emplace(indexKey(kind, id), entries_.size());
+            byHash_.emplace(std::string(entry.hash.begin(), entry.hash.end()), entries_.size());
+            entries_.push_back(std::move(entry));
+            commit();
+            return true;
+        }
+
+        nlohmann::json entry_j = nlohmann::json();
+        entry_j["kind"] = static_cast<int>(entry.kind);
+        entry_j["id"] = entry.id;
+        entry_j["record"] = entry.record;
+        pushPut(ops, entryKey(index), entry_j.dump());
+        pushPut(ops, idKey(kind, id), std::to_string(index));
+        pushPut(ops, hashKey(entry.hash), std::to_string(index));
+
+        nlohmann::json head = nlohmann::json();
+        head["count"] = static_cast<double>(pendingCount_);
+        head["root"] = toHex(pendingRoot_.data(), pendingRoot_.size());
+        pushPut(ops, kHeadKey, head.dump());
+        return true;
+    }
+
+    // The batch holding the queued entries was written; advance the head.
+    void commit() {
+        root_ = pendingRoot_;
+        count_ = pendingCount_;
+    }
+
+    // The batch was not written; forget the queued entries so the next
+    // append reuses their indices instead of leaving a hole.
+    void rollback() {
+        pendingRoot_ = root_;
+        pendingCount_ = count_;
+    }
+
+    std::optional<Entry> find(Kind kind, const std::string& id) const {
+        if (!storage_) {
+            auto it = byId_.find(indexKey(kind, id));
+            if (it == byId_.end()) return std::nullopt;
+            return entries_[it->second];
+        }
+        auto entry = loadIndexed(idKey(kind, id));
+        if (entry && (entry->kind != kind || entry->id != id)) return std::nullopt;
+        return entry;
+    }
+
+    std::optional<Entry> findByHash(const Hash& hash) const {
+        if (!storage_) {
+            auto it = byHash_.find(std::string(hash.begin(), hash.end()));
+            if (it == byHash_.end()) return std::nullopt;
+            return entries_[it->second];
+        }
+        auto entry = loadIndexed(hashKey(hash));
+        if (entry && entry->hash != hash) return std::nullopt;
+        return entry;
+    }
+
+    bool contains(Kind kind, const std::string& id) const {
+        if (!storage_) return byId_.count(indexKey(kind, id)) > 0;
+        return storage_->exists(idKey(kind, id));
+    }
+
+    size_t size() const { return static_cast<size_t>(count_); }
+    const Hash& root() const { return root_; }
+
+    // Hex root, or empty while nothing is archived.
+    std::string rootHex() const {
+        if (count_ == 0) return "";
+        return toHex(root_.data(), root_.size());
+    }
+
+    /**
+     * Reload the head from storage and replay every stored entry against it.
+     * Throws std::runtime_error if the head does not parse, an entry is
+     * missing or unreadable, or the replayed root differs from the head's.
+     */
+    void recover() {
+        count_ = 0;
+        root_ = Hash{};
+        rollback();
+        entries_.clear();
+        byId_.clear();
+        byHash_.clear();
+        if (!storage_) return;
+
+        auto headOpt = storage_->get(kHeadKey);
+        if (!headOpt) return;
+
+        uint64_t count = 0;
+        std::string rootHexStored;
+        try {
+            auto head = nlohmann::json::parse(*headOpt);
+            count = head.value("count", 0ULL);
+            rootHexStored = head.value("root", "");
+        } catch (const std::exception& e) {
+            throw std::runtime_error(std::string("bridge archive head is unreadable: ") + e.what());
+        }
+
+        Hash root{};
+        for (uint64_t n = 0; n < count; ++n) {
+            auto entry = loadEntry(n);
+            if (!entry) {
+                throw std::runtime_error("bridge archive entry " + std::to_string(n) + " of " +
+                                         std::to_string(count) + " is missing or unreadable");
+            }
+            root = chain(root, entry->hash);
+        }
+        const std::string replayed = count ? toHex(root.data(), root.size()) : "";
+        if (replayed != rootHexStored) {
+            throw std::runtime_error("bridge archive root mismatch: head has " + rootHexStored +
+                                     ", entries replay to " + replayed);
+        }
+        count_ = count;
+        root_ = root;
+        rollback();
+    }
+
+    static Hash hashRecord(Kind kind, const std::string& record) {
+        std::string content(1, static_cast<char>(kind));
+        content += record;
+        Hash hash;
+        SHA256(reinterpret_cast<const unsigned char*>(content.data()), content.size(), hash.data());
+        return hash;
+    }
+
+    static std::string toHex(const unsigned char* data, size_t len) {
+        static const char* digits = "0123456789abcdef";
+        std::string out(len * 2, '0');
+        for (size_t i = 0; i < len; ++i) {
+            out[2 * i] = digits[data[i] >> 4];
+            out[2 * i + 1] = digits[data[i] & 0x0f];
+        }
+        return out;
+    }
+
+private:
+    static constexpr const char* kHeadKey = "bridge/archive/head";
+
+    ailee::storage::PersistentStorage* storage_;
+    uint64_t count_ = 0;
+    Hash root_{};
+    // Head including entries queued but not yet committed.
+    uint64_t pendingCount_ = 0;
+    Hash pendingRoot_{};
+    // In-memory mode only.
+    std::vector<Entry> entries_;
+    std::unordered_map<std::string, size_t> byId_;
+    std::unordered_map<std::string, size_t> byHash_;
+
+    static Hash chain(const Hash& root, const Hash& hash) {
+        unsigned char chained[2 * SHA256_DIGEST_LENGTH];
+        std::copy(root.begin(), root.end(), chained);
+        std::copy(hash.begin(), hash.end(), chained + SHA256_DIGEST_LENGTH);
+        Hash next;
+        SHA256(chained, sizeof(chained), next.data());
+        return next;
+    }
+
+    static std::string indexKey(Kind kind, const std::string& id) {
+        std::string key(1, static_cast<char>(kind));
+        key += id;
+        return key;
+    }
+
+    static std::string entryKey(uint64_t index) {
+        return "bridge/archive/entry/" + std::to_string(index);
+    }
+
+    static std::string idKey(Kind kind, const std::string& id) {
+        return "bridge/archive/id/" + std::to_string(static_cast<int>(kind)) + "/" + id;
+    }
+
+    static std::string hashKey(const Hash& hash) {
+        return "bridge/archive/hash/" + toHex(hash.data(), hash.size());
+    }
+
+    static void pushPut(BatchOps& ops, std::string key, std::string value) {
+        ailee::storage::PersistentStorage::BatchOp op;
+        op.type = ailee::storage::PersistentStorage::BatchOpType::PUT;
+        op.key = std::move(key);
+        op.value = std::move(value);
+        ops.push_back(std::move(op));
+    }
+
+    std::optional<Entry> loadEntry(uint64_t index) const {
+        auto entryOpt = storage_->get(entryKey(index));
+        if (!entryOpt) return std::nullopt;
+        try {
+            auto entry_j = nlohmann::json::parse(*entryOpt);
+            Entry entry;
+            entry.kind = static_cast<Kind>(entry_j.value("kind", 0));
+            entry.id = entry_j.value("id", "");
+            entry.record = entry_j.value("record", "");
+            entry.hash = hashRecord(entry.kind, entry.record);
+            return entry;
+        } catch (...) {
+            return std::nullopt;
+        }
+    }
+
+    // Follows an id or hash index key to its entry.
+    std::optional<Entry> loadIndexed(const std::string& key) const {
+        auto indexOpt = storage_->get(key);
+        if (!indexOpt) return std::nullopt;
+        try {
+            const uint64_t index = std::stoull(*indexOpt);
+            if (index >= count_) return std::nullopt;
+            return loadEntry(index);
+        } catch (...) {
+            return std::nullopt;
+        }
+    }
+};
+
 /**
  * Sidechain Bridge Manager
  * Main orchestrator for all bridge operations
@@ -777,27 +1313,35 @@ public:
     SidechainBridge(ailee::storage::PersistentStorage* storage = nullptr)
         : federation_(std::make_unique<FederationManager>()),
           statistics_(std::make_unique<BridgeStatistics>()),
+          archive_(storage),
           emergencyMode_(false),
           storage_(storage) {
         recoverState();
     }
 
+    // Throws std::runtime_error if the stored archive is incomplete or does
+    // not match its recorded root; the bridge must not run on a bad archive.
     void recoverState() {
         if (!storage_) return;
 
+        archive_.recover();
+
+        // One unreadable signer record does not stop the others loading.
         auto idxOpt = storage_->get("bridge/federation/signer_index");
         if (idxOpt) {
             try {
                 auto arr = nlohmann::json::parse(*idxOpt);
                 for (const auto& id_json : arr) {
-                    std::string id = id_json.get<std::string>();
-                    auto signerOpt = storage_->get("bridge/federation/signer/" + id);
-                    if (signerOpt) {
-                        auto signer_j = nlohmann::json::parse(*signerOpt);
-                        auto signer = std::make_shared<FederationSigner>("", "", "", 0);
-                        signer->from_json(signer_j);
-                        federation_->addSigner(signer);
-                    }
+                    try {
+                        std::string id = id_json.get<std::string>();
+                        auto signerOpt = storage_->get("bridge/federation/signer/" + id);
+                        if (signerOpt) {
+                            auto signer_j = nlohmann::json::parse(*signerOpt);
+                            auto signer = std::make_shared<FederationSigner>("", "", "", 0);
+                            signer->from_json(signer_j);
+                            federation_->addSigner(signer);
+                        }
+                    } catch (...) {}
                 }
             } catch (...) {}
         }
@@ -818,6 +1362,33 @@ public:
                 }
             } catch (...) {}
         }
+
+        // Older stores kept completed peg-outs live; move them over now.
+        // If the write fails they stay live and the next restart retries.
+        std::vector<ailee::storage::PersistentStorage::BatchOp> ops;
+        std::map<std::string, std::shared_ptr<PegOutTransaction>> migrated;
+        for (auto it = pegouts_.begin(); it != pegouts_.end();) {
+            if (it->second->getStatus() == PegStatus::COMPLETED) {
+                archivePegOut(it->first, *it->second, ops);
+                migrated.insert(pegouts_.extract(it++));
+            } else {
+                ++it;
+            }
+        }
+        if (!ops.empty()) {
+            appendPegOutIndexOp(ops);
+            if (!commitArchiveOps(ops)) pegouts_.merge(migrated);
+        }
+
+        // Burns recorded before the restart go back on the maturity queue.
+        for (const auto& [pegId, pegout] : pegouts_) {
+            const auto& data = pegout->getData();
+            if (data.status == PegStatus::BURN_INITIATED && data.aileeBurnTxHeight > 0) {
+                pegOutMaturity_.track(pegId, data.aileeBurnTxHeight);
+            }
+        }
+
+        dropInvalidPendingSignatures();
     }
 
 
@@ -836,9 +1407,10 @@ void persistSigners(const std::vector<std::string>& signerIds) {
             }
         }
 
-        auto active_signers = federation_->getActiveSigners();
+        // Inactive signers are indexed too: their signatures on pending
+        // peg-outs can only be checked if they are reloaded.
         nlohmann::json arr = nlohmann::json::array_t{};
-        for (const auto& s : active_signers) {
+        for (const auto& s : federation_->getSignerIds()) {
             arr.push_back(s);
         }
         ailee::storage::PersistentStorage::BatchOp idxOp;
@@ -890,7 +1462,9 @@ void persistSigners(const std::vector<std::string>& signerIds) {
 
         if (!pegin->validateAmount()) return "";
 
+        // The id is derived from the BTC outpoint; an archived one was already minted.
         std::string pegId = pegin->getData().pegId;
+        if (archive_.contains(BridgeArchive::Kind::PEGIN, pegId)) return "";
         pegins_[pegId] = pegin;
 
         return pegId;
@@ -907,7 +1481,11 @@ void persistSigners(const std::vector<std::string>& signerIds) {
         // Verify SPV proof
         if (!SPVProof::verify(proof, blockHeader)) return false;
 
-        return it->second->attachSPVProof(proof);
+        if (!it->second->attachSPVProof(proof)) return false;
+        if (proof.blockHeight > 0) {
+            trackPegInInclusion(pegId, proof.blockHeight);
+        }
+        return true;
     }
 
     bool updatePegInConfirmations(
@@ -918,21 +1496,29 @@ void persistSigners(const std::vector<std::string>& signerIds) {
         auto it = pegins_.find(pegId);
         if (it == pegins_.end()) return false;
 
-        return it->second->updateConfirmations(btcBlockHeight, currentBtcHeight);
+        if (!it->second->updateConfirmations(btcBlockHeight, currentBtcHeight)) return false;
+        pegInMaturity_.untrack(pegId);
+        return true;
     }
 
     bool completePegInMint(const std::string& pegId) {
         auto it = pegins_.find(pegId);
         if (it == pegins_.end()) return false;
 
-        if (it->second->completeMint()) {
-            auto& data = it->second->getData();
-            uint64_t duration = data.completedTime - data.initiatedTime;
-            statistics_->recordPegin(data.btcAmount, duration);
-            return true;
+        // A peg-in left MINTED by a failed archive write is retried here.
+        if (it->second->getStatus() != PegStatus::MINTED && !it->second->completeMint()) {
+            return false;
         }
 
-        return false;
+        auto& data = it->second->getData();
+        std::vector<ailee::storage::PersistentStorage::BatchOp> ops;
+        archive_.append(BridgeArchive::Kind::PEGIN, pegId, pegInRecord(data), ops);
+        if (!commitArchiveOps(ops)) return false;
+
+        uint64_t duration = data.completedTime - data.initiatedTime;
+        statistics_->recordPegin(data.btcAmount, duration);
+        pegins_.erase(it);
+        return true;
     }
 
     // Peg-out operations
@@ -942,8 +1528,7 @@ void persistSigners(const std::vector<std::string>& signerIds) {
         uint64_t amount,
         const std::string& anchorCommitmentHash
     ) {
-        if (anchorCommitmentHash.empty()) return "";
-        if (anchorCommitments_.find(anchorCommitmentHash) == anchorCommitments_.end()) return "";
+        if (!isAnchorKnown(anchorCommitmentHash)) return "";
 
         auto pegout = std::make_shared<PegOutTransaction>(
             aileeSource, btcDest, amount, anchorCommitmentHash
@@ -963,67 +1548,166 @@ void persistSigners(const std::vector<std::string>& signerIds) {
         auto it = pegouts_.find(pegId);
         if (it == pegouts_.end()) return false;
 
-        return it->second->updateConfirmations(burnHeight, currentHeight);
+        if (!it->second->updateConfirmations(burnHeight, currentHeight)) return false;
+        pegOutMaturity_.untrack(pegId);
+        return true;
     }
 
-bool verifyPegOutSignature(
-        const std::string& pegId,
-        const std::string& aileeSourceAddress,
-        const std::string& btcDestAddress,
-        uint64_t aileeBurnAmount,
-        uint64_t btcReleaseAmount,
-        const std::string& anchorCommitmentHash,
-        const std::string& signerPubKeyHex,
-        const std::vector<uint8_t>& signature
-    ) const {
-        if (signature.size() < 64) return false;
+    // Height-driven confirmation tracking. Pegs are queued by the height at
+    // which they mature; each new tip promotes only the pegs that matured.
+    // Bitcoin and AILEE heights are separate chains, hence separate queues.
 
-        std::string payload = pegId + "|" + aileeSourceAddress + "|" + btcDestAddress + "|" +
-                              std::to_string(aileeBurnAmount) + "|" + std::to_string(btcReleaseAmount) + "|" +
-                              anchorCommitmentHash;
+    /**
+     * Queue a peg-in awaiting confirmations, included at `btcBlockHeight`.
+     * Tracking again at another height (e.g. after a reorg) re-buckets it.
+     * Promotes at once if the known tip is already deep enough.
+     */
+    bool trackPegInInclusion(const std::string& pegId, uint64_t btcBlockHeight) {
+        auto it = pegins_.find(pegId);
+        if (it == pegins_.end()) return false;
+        if (it->second->getStatus() != PegStatus::PENDING_BTC_CONF) return false;
 
-        unsigned char hash1[SHA256_DIGEST_LENGTH];
-        SHA256(reinterpret_cast<const unsigned char*>(payload.data()), payload.size(), hash1);
-        unsigned char hash2[SHA256_DIGEST_LENGTH];
-        SHA256(hash1, SHA256_DIGEST_LENGTH, hash2);
+        if (btcTip_ >= pegInMaturity_.maturityHeight(btcBlockHeight)) {
+            pegInMaturity_.untrack(pegId);
+            it->second->updateConfirmations(btcBlockHeight, btcTip_);
+        } else {
+            pegInMaturity_.track(pegId, btcBlockHeight);
+        }
+        return true;
+    }
 
-        secp256k1_context* ctx = getBridgeSecp256k1VerifyContext();
+    // Peg-out counterpart of trackPegInInclusion, against AILEE heights.
+    // The burn height is persisted so recoverState can re-queue the burn.
+    bool trackPegOutBurn(const std::string& pegId, uint64_t burnHeight) {
+        auto it = pegouts_.find(pegId);
+        if (it == pegouts_.end()) return false;
+        if (it->second->getStatus() != PegStatus::BURN_INITIATED) return false;
+
+        it->second->recordBurnHeight(burnHeight);
+        if (aileeTip_ >= pegOutMaturity_.maturityHeight(burnHeight)) {
+            pegOutMaturity_.untrack(pegId);
+            it->second->updateConfirmations(burnHeight, aileeTip_);
+        } else {
+            pegOutMaturity_.track(pegId, burnHeight);
+        }
 
-        std::vector<uint8_t> pubKeyBytes;
-        pubKeyBytes.reserve(signerPubKeyHex.length() / 2);
-        for (size_t i = 0; i < signerPubKeyHex.length(); i += 2) {
-            std::string byteString = signerPubKeyHex.substr(i, 2);
-            pubKeyBytes.push_back(static_cast<uint8_t>(strtol(byteString.c_str(), nullptr, 16)));
+        if (storage_) {
+            std::vector<ailee::storage::PersistentStorage::BatchOp> ops;
+            ailee::storage::PersistentStorage::BatchOp op;
+            op.type = ailee::storage::PersistentStorage::BatchOpType::PUT;
+            op.key = "bridge/pegout/" + pegId;
+            op.value = it->second->to_json().dump();
+            ops.push_back(op);
+            appendPegOutIndexOp(ops);
+            storage_->executeBatch(ops);
         }
+        return true;
+    }
 
-        secp256k1_pubkey pubkey;
-        if (secp256k1_ec_pubkey_parse(ctx, &pubkey, pubKeyBytes.data(), pubKeyBytes.size()) != 1) {
-            return false;
+    /**
+     * Advance the Bitcoin tip and return the peg-ins promoted to
+     * BTC_CONFIRMED. Report reorgs through onBitcoinReorg first; a tip lower
+     * than the last one without that call is handled as a reorg forking at
+     * the new tip, and the orphaned ids are not reported.
+     */
+    std::vector<std::string> onNewBitcoinTip(uint64_t height) {
+        if (height < btcTip_) onBitcoinReorg(height);
+        btcTip_ = height;
+
+        std::vector<std::string> promoted;
+        for (auto& [pegId, inclusionHeight] : pegInMaturity_.popMatured(height)) {
+            auto it = pegins_.find(pegId);
+            if (it != pegins_.end() && it->second->updateConfirmations(inclusionHeight, height)) {
+                promoted.push_back(std::move(pegId));
+            }
         }
+        return promoted;
+    }
 
-        secp256k1_ecdsa_signature sig;
-        bool parsed = false;
+    // Peg-out counterpart of onNewBitcoinTip; promotes to PENDING_PEGOUT.
+    std::vector<std::string> onNewAileeTip(uint64_t height) {
+        if (height < aileeTip_) onAileeReorg(height);
+        aileeTip_ = height;
 
-        if (signature.size() == 64) {
-            if (secp256k1_ecdsa_signature_parse_compact(ctx, &sig, signature.data()) == 1) {
-                parsed = true;
+        std::vector<std::string> promoted;
+        for (auto& [pegId, burnHeight] : pegOutMaturity_.popMatured(height)) {
+            auto it = pegouts_.find(pegId);
+            if (it != pegouts_.end() && it->second->updateConfirmations(burnHeight, height)) {
+                promoted.push_back(std::move(pegId));
             }
         }
+        return promoted;
+    }
 
-        if (!parsed) {
-            if (secp256k1_ecdsa_signature_parse_der(ctx, &sig, signature.data(), signature.size()) == 1) {
-                parsed = true;
+    /**
+     * Handle a Bitcoin reorg that replaced every block above `forkHeight`,
+     * the last block both chains share. Follow with onNewBitcoinTip for the
+     * new chain, whatever its height.
+     *
+     * Peg-ins promoted on confirmations above the fork go back to
+     * PENDING_BTC_CONF. Those included at or below the fork are queued again
+     * at the same height. Those included above it, queued or promoted, are
+     * dropped from the queue and returned; track them again once they are
+     * re-included. Minted peg-ins are final and are not touched.
+     */
+    std::vector<std::string> onBitcoinReorg(uint64_t forkHeight) {
+        std::vector<std::string> orphaned = pegInMaturity_.rewind(forkHeight);
+        for (const auto& [pegId, pegin] : pegins_) {
+            const uint64_t inclusionHeight = pegin->getData().btcBlockHeight;
+            if (pegInMaturity_.maturityHeight(inclusionHeight) <= forkHeight) continue;
+            if (!pegin->revertConfirmation()) continue;
+            if (inclusionHeight > forkHeight) {
+                orphaned.push_back(pegId);
+            } else {
+                pegInMaturity_.track(pegId, inclusionHeight);
             }
         }
+        btcTip_ = std::min(btcTip_, forkHeight);
+        return orphaned;
+    }
 
-        if (!parsed) {
-            return false;
+    // Peg-out counterpart of onBitcoinReorg, against AILEE heights. Released
+    // peg-outs are final and are not touched.
+    std::vector<std::string> onAileeReorg(uint64_t forkHeight) {
+        std::vector<std::string> orphaned = pegOutMaturity_.rewind(forkHeight);
+        for (const auto& [pegId, pegout] : pegouts_) {
+            const uint64_t burnHeight = pegout->getData().aileeBurnTxHeight;
+            if (pegOutMaturity_.maturityHeight(burnHeight) <= forkHeight) continue;
+            if (!pegout->revertConfirmation()) continue;
+            if (burnHeight > forkHeight) {
+                orphaned.push_back(pegId);
+            } else {
+                pegOutMaturity_.track(pegId, burnHeight);
+            }
         }
+        aileeTip_ = std::min(aileeTip_, forkHeight);
+        return orphaned;
+    }
 
-        secp256k1_ecdsa_signature normalized_sig;
-        secp256k1_ecdsa_signature_normalize(ctx, &normalized_sig, &sig);
+    size_t getMaturingPegInCount() const { return pegInMaturity_.size(); }
+    size_t getMaturingPegOutCount() const { return pegOutMaturity_.size(); }
 
-        return secp256k1_ecdsa_verify(ctx, &normalized_sig, hash2, &pubkey) == 1;
+bool verifyPegOutSignature(
+        const std::string& pegId,
+        const std::string& aileeSourceAddress,
+        const std::string& btcDestAddress,
+        uint64_t aileeBurnAmount,
+        uint64_t btcReleaseAmount,
+        const std::string& anchorCommitmentHash,
+        const std::string& signerPubKeyHex,
+        const std::vector<uint8_t>& signature
+    ) const {
+        PegOutTransaction::PegOutData fields;
+        fields.pegId = pegId;
+        fields.aileeSourceAddress = aileeSourceAddress;
+        fields.btcDestAddress = btcDestAddress;
+        fields.aileeBurnAmount = aileeBurnAmount;
+        fields.btcReleaseAmount = btcReleaseAmount;
+        fields.anchorCommitmentHash = anchorCommitmentHash;
+
+        secp256k1_pubkey pubkey;
+        if (!parseBridgePubKeyHex(signerPubKeyHex, pubkey)) return false;
+        return verifyBridgeSignature(PegOutTransaction::computeSigningDigest(fields), pubkey, signature);
     }
 
     bool signPegOut(
@@ -1038,10 +1722,8 @@ bool verifyPegOutSignature(
         auto signer = federation_->getSigner(signerId);
         if (!signer || !signer->isActive()) return false;
 
-        const auto& data = pegoutIt->second->getData();
-        if (!verifyPegOutSignature(pegId, data.aileeSourceAddress, data.btcDestAddress,
-                                   data.aileeBurnAmount, data.btcReleaseAmount,
-                                   data.anchorCommitmentHash, signer->getData().publicKey, signature)) {
+        const secp256k1_pubkey* pubkey = federation_->getParsedPubKey(signerId);
+        if (!pubkey || !verifyBridgeSignature(pegoutIt->second->getSigningDigest(), *pubkey, signature)) {
             return false;
         }
 
@@ -1060,49 +1742,47 @@ bool verifyPegOutSignature(
 
         size_t threshold = federation_->getRequiredSignatures();
         if (!it->second->hasRequiredSignatures(threshold)) return false;
+        if (countValidSignatures(*it->second) < threshold) return false;
+
+        // A peg-out left COMPLETED by a failed archive write is retried
+        // here with the same release transaction.
+        auto pegout = it->second;
+        if (pegout->getStatus() == PegStatus::COMPLETED) {
+            if (pegout->getData().btcReleaseTxId != btcTxId) return false;
+        } else if (!pegout->completeRelease(btcTxId)) {
+            return false;
+        }
 
-        if (it->second->completeRelease(btcTxId)) {
-            auto& data = it->second->getData();
-            uint64_t duration = data.completedTime - data.initiatedTime;
-            statistics_->recordPegout(data.aileeBurnAmount, duration);
-
-            if (storage_) {
-                std::vector<ailee::storage::PersistentStorage::BatchOp> ops;
-
-                ailee::storage::PersistentStorage::BatchOp pegOp;
-                pegOp.type = ailee::storage::PersistentStorage::BatchOpType::PUT;
-                pegOp.key = "bridge/pegout/" + pegId;
-                pegOp.value = it->second->to_json().dump();
-                ops.push_back(pegOp);
+        auto& data = pegout->getData();
+        std::vector<ailee::storage::PersistentStorage::BatchOp> ops;
+        archivePegOut(pegId, *pegout, ops);
+        pegouts_.erase(it);
+        const bool retireAnchor = archiveAnchorIfUnused(data.anchorCommitmentHash, ops);
 
-                nlohmann::json arr = nlohmann::json::array_t{};
-                for (const auto& [id, _] : pegouts_) {
-                    arr.push_back(id);
-                }
-                ailee::storage::PersistentStorage::BatchOp idxOp;
-                idxOp.type = ailee::storage::PersistentStorage::BatchOpType::PUT;
-                idxOp.key = "bridge/pegout_index";
-                idxOp.value = arr.dump();
-                ops.push_back(idxOp);
-
-                for (const auto& [signerId, signature] : data.signatures) {
-                    auto signer = federation_->getSigner(signerId);
-                    if (signer) {
-                        ailee::storage::PersistentStorage::BatchOp sigOp;
-                        sigOp.type = ailee::storage::PersistentStorage::BatchOpType::PUT;
-                        sigOp.key = "bridge/federation/signer/" + signerId;
-                        sigOp.value = signer->to_json().dump();
-                        ops.push_back(sigOp);
-                    }
+        if (storage_) {
+            appendPegOutIndexOp(ops);
+
+            for (const auto& [signerId, signature] : data.signatures) {
+                auto signer = federation_->getSigner(signerId);
+                if (signer) {
+                    ailee::storage::PersistentStorage::BatchOp sigOp;
+                    sigOp.type = ailee::storage::PersistentStorage::BatchOpType::PUT;
+                    sigOp.key = "bridge/federation/signer/" + signerId;
+                    sigOp.value = signer->to_json().dump();
+                    ops.push_back(sigOp);
                 }
-
-                storage_->executeBatch(ops);
             }
+        }
 
-            return true;
+        if (!commitArchiveOps(ops)) {
+            pegouts_[pegId] = pegout;
+            return false;
         }
+        if (retireAnchor) anchorCommitments_.erase(data.anchorCommitmentHash);
 
-        return false;
+        uint64_t duration = data.completedTime - data.initiatedTime;
+        statistics_->recordPegout(data.aileeBurnAmount, duration);
+        return true;
     }
 
     // Atomic swap operations
@@ -1134,14 +1814,18 @@ bool verifyPegOutSignature(
         auto it = atomicSwaps_.find(swapId);
         if (it == atomicSwaps_.end()) return false;
 
-        return it->second->claim(party, secret);
+        if (!it->second->claim(party, secret)) return false;
+        archiveSwapIfSettled(it);
+        return true;
     }
 
     bool refundAtomicSwap(const std::string& swapId, const std::string& party) {
         auto it = atomicSwaps_.find(swapId);
         if (it == atomicSwaps_.end()) return false;
 
-        return it->second->refund(party);
+        if (!it->second->refund(party)) return false;
+        archiveSwapIfSettled(it);
+        return true;
     }
 
     // Emergency operations
@@ -1200,6 +1884,9 @@ bool verifyPegOutSignature(
 
     FederationManager* getFederation() { return federation_.get(); }
 
+    // Pegs, swaps and anchors that reached a terminal state.
+    const BridgeArchive& getArchive() const { return archive_; }
+
     bool registerAnchorCommitment(const ailee::global_seven::AnchorCommitment& anchor,
                                   const std::string& expectedStateRoot) {
         if (anchor.l2StateRoot != expectedStateRoot) return false;
@@ -1246,6 +1933,8 @@ bool verifyPegOutSignature(
                 data.anchorCommitmentHash
             });
         }
+        snapshot.archiveRoot = archive_.rootHex();
+        snapshot.archivedCount = archive_.size();
         return snapshot;
     }
 
@@ -1256,6 +1945,11 @@ private:
     std::map<std::string, std::shared_ptr<PegOutTransaction>> pegouts_;
     std::map<std::string, std::shared_ptr<AtomicSwap>> atomicSwaps_;
     std::map<std::string, ailee::global_seven::AnchorCommitment> anchorCommitments_;
+    BridgeArchive archive_;
+    PegMaturityQueue pegInMaturity_{MIN_CONFIRMATIONS_PEGIN};
+    PegMaturityQueue pegOutMaturity_{MIN_CONFIRMATIONS_PEGOUT};
+    uint64_t btcTip_ = 0;
+    uint64_t aileeTip_ = 0;
     bool emergencyMode_;
     ailee::storage::PersistentStorage* storage_;
 
@@ -1265,9 +1959,182 @@ private:
         );
     }
 
+    // Checks for the stored signatures on `pegout` against the current
+    // federation keys, optionally only those from active signers. Borrows
+    // from the peg-out and the federation.
+    void collectSignatureChecks(const PegOutTransaction& pegout, bool activeOnly,
+                                std::vector<BridgeSignatureCheck>& checks) const {
+        const auto& digest = pegout.getSigningDigest();
+        for (const auto& [signerId, signature] : pegout.getData().signatures) {
+            if (activeOnly && !federation_->isActiveSigner(signerId)) continue;
+            checks.push_back({&digest, federation_->getParsedPubKey(signerId), &signature, false});
+        }
+    }
+
+    // Signatures from active signers that still verify; only these count
+    // toward the release threshold.
+    size_t countValidSignatures(const PegOutTransaction& pegout) const {
+        std::vector<BridgeSignatureCheck> checks;
+        checks.reserve(pegout.getData().signatures.size());
+        collectSignatureChecks(pegout, true, checks);
+        verifyBridgeSignatures(checks);
+        return static_cast<size_t>(std::count_if(checks.begin(), checks.end(),
+                                                 [](const BridgeSignatureCheck& c) { return c.valid; }));
+    }
+
+    // Re-verifies signatures on recovered peg-outs that are still awaiting
+    // release, all in one parallel pass. A signature is dropped only if its
+    // signer is loaded with a key that parses and the signature fails
+    // against it. Signatures from unknown or unparseable signers are kept;
+    // countValidSignatures ignores them, as it does inactive signers'.
+    // Peg-outs that lost a signature are written back.
+    void dropInvalidPendingSignatures() {
+        std::vector<BridgeSignatureCheck> checks;
+        std::vector<std::pair<const std::string*, std::string>> owners;
+        for (const auto& [pegId, pegout] : pegouts_) {
+            PegStatus status = pegout->getStatus();
+            if (status != PegStatus::BURN_INITIATED && status != PegStatus::PENDING_PEGOUT) continue;
+            collectSignatureChecks(*pegout, false, checks);
+            for (const auto& [signerId, signature] : pegout->getData().signatures) {
+                owners.emplace_back(&pegId, signerId);
+            }
+        }
+        if (checks.empty()) return;
+
+        verifyBridgeSignatures(checks);
+        // Collect first: removing a signature invalidates the checks' borrows.
+        std::vector<size_t> invalid;
+        for (size_t i = 0; i < checks.size(); ++i) {
+            if (checks[i].pubkey && !checks[i].valid) invalid.push_back(i);
+        }
+
+        std::set<std::string> changed;
+        for (size_t i : invalid) {
+            const std::string& pegId = *owners[i].first;
+            if (pegouts_[pegId]->removeSignature(owners[i].second)) changed.insert(pegId);
+        }
+        if (!storage_ || changed.empty()) return;
+
+        std::vector<ailee::storage::PersistentStorage::BatchOp> ops;
+        for (const auto& pegId : changed) {
+            ailee::storage::PersistentStorage::BatchOp op;
+            op.type = ailee::storage::PersistentStorage::BatchOpType::PUT;
+            op.key = "bridge/pegout/" + pegId;
+            op.value = pegouts_[pegId]->to_json().dump();
+            ops.push_back(op);
+        }
+        storage_->executeBatch(ops);
+    }
+
+    bool isAnchorKnown(const std::string& anchorHash) const {
+        if (anchorHash.empty()) return false;
+        return anchorCommitments_.find(anchorHash) != anchorCommitments_.end() ||
+               archive_.contains(BridgeArchive::Kind::ANCHOR, anchorHash);
+    }
+
     bool isPegOutAnchorAuthorized(const PegOutTransaction& pegout) const {
-        const auto& anchorHash = pegout.getData().anchorCommitmentHash;
-        return !anchorHash.empty() && anchorCommitments_.find(anchorHash) != anchorCommitments_.end();
+        return isAnchorKnown(pegout.getData().anchorCommitmentHash);
+    }
+
+    // Caller erases the peg-out from pegouts_ afterwards.
+    void archivePegOut(const std::string& pegId, const PegOutTransaction& pegout,
+                       std::vector<ailee::storage::PersistentStorage::BatchOp>& ops) {
+        archive_.append(BridgeArchive::Kind::PEGOUT, pegId, pegOutRecord(pegout.getData()), ops);
+        if (storage_) {
+            ailee::storage::PersistentStorage::BatchOp delOp;
+            delOp.type = ailee::storage::PersistentStorage::BatchOpType::DEL;
+            delOp.key = "bridge/pegout/" + pegId;
+            ops.push_back(delOp);
+        }
+    }
+
+    // An anchor stays live while an in-flight peg-out references it.
+    // Archived anchors still authorize new peg-outs via isAnchorKnown.
+    // Returns true if the anchor was queued; the caller drops it from
+    // anchorCommitments_ once the batch is committed.
+    bool archiveAnchorIfUnused(const std::string& anchorHash,
+                               std::vector<ailee::storage::PersistentStorage::BatchOp>& ops) {
+        auto anchorIt = anchorCommitments_.find(anchorHash);
+        if (anchorIt == anchorCommitments_.end()) return false;
+        for (const auto& [pegId, pegout] : pegouts_) {
+            if (pegout->getData().anchorCommitmentHash == anchorHash) return false;
+        }
+        return archive_.append(BridgeArchive::Kind::ANCHOR, anchorHash,
+                               anchorRecord(anchorIt->second), ops);
+    }
+
+    // A settled swap whose archive write fails stays in atomicSwaps_.
+    void archiveSwapIfSettled(std::map<std::string, std::shared_ptr<AtomicSwap>>::iterator it) {
+        if (!it->second->isSettled()) return;
+        std::vector<ailee::storage::PersistentStorage::BatchOp> ops;
+        archive_.append(BridgeArchive::Kind::SWAP, it->first, swapRecord(it->second->getData()), ops);
+        if (commitArchiveOps(ops)) atomicSwaps_.erase(it);
+    }
+
+    // Write a batch that carries archive entries. The archive head only
+    // advances if the write succeeds, so a failure cannot leave a hole.
+    bool commitArchiveOps(const std::vector<ailee::storage::PersistentStorage::BatchOp>& ops) {
+        if (storage_ && !ops.empty() && !storage_->executeBatch(ops)) {
+            archive_.rollback();
+            return false;
+        }
+        archive_.commit();
+        return true;
+    }
+
+    void appendPegOutIndexOp(std::vector<ailee::storage::PersistentStorage::BatchOp>& ops) const {
+        nlohmann::json arr = nlohmann::json::array_t{};
+        for (const auto& [id, _] : pegouts_) {
+            arr.push_back(id);
+        }
+        ailee::storage::PersistentStorage::BatchOp idxOp;
+        idxOp.type = ailee::storage::PersistentStorage::BatchOpType::PUT;
+        idxOp.key = "bridge/pegout_index";
+        idxOp.value = arr.dump();
+        ops.push_back(idxOp);
+    }
+
+    // Canonical archive records. Field order matches the L2 state
+    // canonicalization; large or transient fields (SPV proofs, signatures)
+    // are left out. Each field is written as <length>:<bytes>, so no value
+    // can move a field boundary.
+    static std::string encodeRecord(std::initializer_list<std::string> fields) {
+        std::string out;
+        for (const auto& field : fields) {
+            out += std::to_string(field.size());
+            out += ':';
+            out += field;
+        }
+        return out;
+    }
+
+    static std::string pegInRecord(const PegInTransaction::PegInData& data) {
+        return encodeRecord({data.pegId, data.btcTxId, std::to_string(data.btcVout),
+                             std::to_string(data.btcAmount), data.btcSourceAddress,
+                             data.aileeDestAddress, std::to_string(static_cast<int>(data.status)),
+                             std::to_string(data.btcConfirmations), std::to_string(data.initiatedTime),
+                             std::to_string(data.completedTime)});
+    }
+
+    static std::string pegOutRecord(const PegOutTransaction::PegOutData& data) {
+        return encodeRecord({data.pegId, data.aileeSourceAddress, data.btcDestAddress,
+                             std::to_string(data.aileeBurnAmount), std::to_string(data.btcReleaseAmount),
+                             std::to_string(static_cast<int>(data.status)), data.anchorCommitmentHash,
+                             std::to_string(data.initiatedTime), std::to_string(data.completedTime),
+                             data.btcReleaseTxId});
+    }
+
+    static std::string swapRecord(const AtomicSwap::SwapData& data) {
+        auto flag = [](bool b) { return b ? "1" : "0"; };
+        return encodeRecord({data.swapId, data.partyA, data.partyB,
+                             std::to_string(data.amountA), std::to_string(data.amountB),
+                             data.hashLock, std::to_string(data.timelock),
+                             std::string(flag(data.claimedByA)) + flag(data.claimedByB) +
+                                 flag(data.refundedA) + flag(data.refundedB)});
+    }
+
+    static std::string anchorRecord(const ailee::global_seven::AnchorCommitment& anchor) {
+        return encodeRecord({anchor.hash, anchor.l2StateRoot, std::to_string(anchor.timestampMs)});
     }
 };
 
@@ -1,6 +1,11 @@
 #include "l3/NetworkDriver.h"
 #include <iostream>
+#include <algorithm>
 #include <cstring>
+#include <future>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
 #include <curl/curl.h>
 #include <json/json.h>
 
@@ -14,89 +19,157 @@ size_t WriteCallback(void* contents, size_t size, size_t nmemb, std::string* use
     return size * nmemb;
 }
 
-std::string do_rpc_call(const NetworkConfig& config, const std::string& method, const std::string& params_json = "[]") {
-    CURL* curl;
-    CURLcode res;
-    std::string readBuffer;
-
-    curl = curl_easy_init();
-    if(curl) {
-        curl_easy_setopt(curl, CURLOPT_URL, config.rpc_url.c_str());
-
-        std::string auth = config.rpc_user + ":" + config.rpc_password;
-        curl_easy_setopt(curl, CURLOPT_USERPWD, auth.c_str());
+bool is_mock(const NetworkConfig& config) {
+    return config.rpc_url.empty() || config.rpc_url == "mock";
+}
 
-        struct curl_slist *headers = NULL;
-        headers = curl_slist_append(headers, "Content-Type: application/json");
-        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+NetworkSnapshot mock_network_snapshot(uint32_t step) {
+    NetworkSnapshot snap;
+    std::memset(&snap, 0, sizeof(snap));
+    snap.block.height = step;
+    snap.block.timestamp = 1600000000 + step;
+    snap.mempool.transaction_count = 100 + step;
+    snap.peer.peer_count = 8;
+    snap.peer.active_connections = 4;
+    return snap;
+}
 
-        std::string payload = "{\"jsonrpc\": \"1.0\", \"id\":\"curltest\", \"method\": \"" + method + "\", \"params\": " + params_json + " }";
-        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, payload.c_str());
+Json::Value make_request(uint32_t id, const char* method, Json::Value params = Json::Value(Json::arrayValue)) {
+    Json::Value req(Json::objectValue);
+    req["jsonrpc"] = "1.0";
+    req["id"] = id;
+    req["method"] = method;
+    req["params"] = std::move(params);
+    return req;
+}
 
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &readBuffer);
+} // anonymous namespace
 
-        res = curl_easy_perform(curl);
-        if(res != CURLE_OK) {
-            std::cerr << "curl_easy_perform() failed: " << curl_easy_strerror(res) << std::endl;
+// One curl easy handle per run, so every batch after the first reuses the
+// same keep-alive connection.
+class NetworkRpcSession {
+public:
+    explicit NetworkRpcSession(const NetworkConfig& config) : curl_(curl_easy_init()), headers_(nullptr) {
+        if (!curl_) {
+            throw std::runtime_error("curl_easy_init() failed");
         }
+        auth_ = config.rpc_user + ":" + config.rpc_password;
+        headers_ = curl_slist_append(headers_, "Content-Type: application/json");
 
-        curl_slist_free_all(headers);
-        curl_easy_cleanup(curl);
+        curl_easy_setopt(curl_, CURLOPT_URL, config.rpc_url.c_str());
+        curl_easy_setopt(curl_, CURLOPT_USERPWD, auth_.c_str());
+        curl_easy_setopt(curl_, CURLOPT_HTTPHEADER, headers_);
+        curl_easy_setopt(curl_, CURLOPT_TCP_KEEPALIVE, 1L);
+        curl_easy_setopt(curl_, CURLOPT_WRITEFUNCTION, WriteCallback);
+        curl_easy_setopt(curl_, CURLOPT_WRITEDATA, &response_);
+
+        writer_["indentation"] = ""; // compact
     }
 
-    Json::Value root;
-    Json::CharReaderBuilder builder;
-    std::string errs;
-    std::istringstream s(readBuffer);
-    if (Json::parseFromStream(builder, s, &root, &errs) && root.isMember("result")) {
-        Json::StreamWriterBuilder writer;
-        writer["indentation"] = ""; // compact
-        return Json::writeString(writer, root["result"]);
+    ~NetworkRpcSession() {
+        curl_slist_free_all(headers_);
+        curl_easy_cleanup(curl_);
     }
 
-    return readBuffer; // fallback
-}
+    NetworkRpcSession(const NetworkRpcSession&) = delete;
+    NetworkRpcSession& operator=(const NetworkRpcSession&) = delete;
 
-} // anonymous namespace
+    // Posts a JSON-RPC batch and returns each call's `result` indexed by its
+    // request id. Throws if the transport fails or any call returns an error.
+    std::vector<Json::Value> call_batch(const Json::Value& batch) {
+        payload_ = Json::writeString(writer_, batch);
+        response_.clear();
+        curl_easy_setopt(curl_, CURLOPT_POSTFIELDS, payload_.c_str());
+        curl_easy_setopt(curl_, CURLOPT_POSTFIELDSIZE, static_cast<long>(payload_.size()));
 
-NetworkSnapshot NetworkDriver::fetch_network_snapshot(const NetworkConfig& config, uint32_t step) {
-    NetworkSnapshot snap;
-    std::memset(&snap, 0, sizeof(snap));
+        CURLcode res = curl_easy_perform(curl_);
+        if (res != CURLE_OK) {
+            std::cerr << "curl_easy_perform() failed: " << curl_easy_strerror(res) << std::endl;
+            throw std::runtime_error(std::string("RPC batch failed: ") + curl_easy_strerror(res));
+        }
 
-    // For tests/offline simulation without a real node, we can fallback if URL is empty or 'mock'
-    if (config.rpc_url.empty() || config.rpc_url == "mock") {
-        snap.block.height = step;
-        snap.block.timestamp = 1600000000 + step;
-        snap.mempool.transaction_count = 100 + step;
-        snap.peer.peer_count = 8;
-        snap.peer.active_connections = 4;
-        return snap;
+        Json::Value root;
+        std::string errs;
+        std::istringstream s(response_);
+        if (!Json::parseFromStream(reader_, s, &root, &errs) || !root.isArray()) {
+            throw std::runtime_error("Failed to parse RPC batch response: " + errs);
+        }
+
+        // Batch replies may arrive in any order; match them up by id.
+        std::vector<Json::Value> results(batch.size());
+        std::vector<bool> seen(batch.size(), false);
+        for (auto& reply : root) {
+            if (!reply.isObject() || !reply["id"].isUInt()) {
+                throw std::runtime_error("Malformed RPC batch reply");
+            }
+            const Json::ArrayIndex id = reply["id"].asUInt();
+            if (id >= results.size() || seen[id]) {
+                throw std::runtime_error("Unexpected RPC batch reply id");
+            }
+            if (!reply["error"].isNull()) {
+                throw std::runtime_error("RPC error: " + Json::writeString(writer_, reply["error"]));
+            }
+            results[id].swap(reply["result"]);
+            seen[id] = true;
+        }
+        for (bool got : seen) {
+            if (!got) {
+                throw std::runtime_error("Missing reply in RPC batch response");
+            }
+        }
+        return results;
     }
 
-    // Real RPC calls
-    // 1. Get block hash by height (using step as height for the sequence)
-    std::string block_hash_res = do_rpc_call(config, "getblockhash", "[" + std::to_string(step) + "]");
+private:
+    CURL* curl_;
+    struct curl_slist* headers_;
+    std::string auth_;
+    std::string payload_;
+    std::string response_;
+    Json::CharReaderBuilder reader_;
+    Json::StreamWriterBuilder writer_;
+};
 
-    // The result might be quoted "hash..." because json_write converts string to quoted string. Trim quotes.
-    std::string block_hash = block_hash_res;
-    if (block_hash.length() >= 2 && block_hash.front() == '"' && block_hash.back() == '"') {
-        block_hash = block_hash.substr(1, block_hash.length() - 2);
+NetworkSnapshot NetworkDriver::fetch_network_snapshot(const NetworkConfig& config, uint32_t step) {
+    // For tests/offline simulation without a real node, we can fallback if URL is empty or 'mock'
+    if (is_mock(config)) {
+        return mock_network_snapshot(step);
     }
 
-    // 2. Get block info
-    std::string block_info_res = do_rpc_call(config, "getblock", "[\"" + block_hash + "\", 1]");
-    snap.block = parse_network_block_snapshot(block_info_res);
-
-    // 3. Get mempool info
-    std::string mempool_info_res = do_rpc_call(config, "getmempoolinfo");
-    snap.mempool = parse_network_mempool_snapshot(mempool_info_res);
+    NetworkRpcSession session(config);
+    return fetch_network_snapshots(session, step, 1).front();
+}
 
-    // 4. Get peer info
-    std::string peer_info_res = do_rpc_call(config, "getpeerinfo");
-    snap.peer = parse_network_peer_snapshot(peer_info_res);
+std::vector<NetworkSnapshot> NetworkDriver::fetch_network_snapshots(
+    NetworkRpcSession& session, uint32_t first_step, uint32_t count) {
+    // 1. Block hashes for every height in the window (using step as height for the sequence)
+    Json::Value hash_batch(Json::arrayValue);
+    for (uint32_t i = 0; i < count; ++i) {
+        Json::Value params(Json::arrayValue);
+        params.append(first_step + i);
+        hash_batch.append(make_request(i, "getblockhash", std::move(params)));
+    }
+    std::vector<Json::Value> hashes = session.call_batch(hash_batch);
+
+    // 2. Block, mempool and peer info for every step, as one batch
+    Json::Value info_batch(Json::arrayValue);
+    for (uint32_t i = 0; i < count; ++i) {
+        Json::Value params(Json::arrayValue);
+        params.append(hashes[i].asString());
+        params.append(1);
+        info_batch.append(make_request(i * 3, "getblock", std::move(params)));
+        info_batch.append(make_request(i * 3 + 1, "getmempoolinfo"));
+        info_batch.append(make_request(i * 3 + 2, "getpeerinfo"));
+    }
+    std::vector<Json::Value> infos = session.call_batch(info_batch);
 
-    return snap;
+    std::vector<NetworkSnapshot> snaps(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        snaps[i].block = parse_network_block_snapshot(infos[i * 3]);
+        snaps[i].mempool = parse_network_mempool_snapshot(infos[i * 3 + 1]);
+        snaps[i].peer = parse_network_peer_snapshot(infos[i * 3 + 2]);
+    }
+    return snaps;
 }
 
 NetworkRunSummary NetworkDriver::run_offline(
@@ -109,43 +182,76 @@ NetworkRunSummary NetworkDriver::run_offline(
     summary.final_network_height = 0;
     summary.envelopes_produced = 0;
     summary.sequence.count = 0;
+    summary.sequence.envelopes.reserve(config.max_steps);
 
     l2::DeterministicEngine engine;
 
-    for (uint32_t step = 0; step < config.max_steps; ++step) {
-        // 1. Fetch Network Snapshot
-        NetworkSnapshot net_snap = fetch_network_snapshot(config, step);
-
-        // 2. Bind L3 -> L2 Deterministically
-        reflection::ReflectionSnapshot l2_reflection = bind_network_block(net_snap.block);
-        l1::SettlementIngestion l2_settlement = bind_network_mempool(net_snap.mempool, net_snap.block);
-        mesh::MeshCoherenceResult l2_coherence = bind_network_peer(net_snap.peer);
-
-        // 3. Step Deterministic Engine
-        l2::EngineStepResult step_result = engine.step(
-            l2_reflection,
-            l2_settlement,
-            l2_coherence,
-            node_id,
-            protocol_version
-        );
-
-        // 4. Extract Envelope
-        l2::ExecutionEnvelope envelope;
-        std::memset(&envelope, 0, sizeof(envelope));
-
-        envelope.context = l2::build_execution_context(
-            node_id,
-            step_result.new_state.epoch,
-            step_result.new_state.state_root,
-            l2_coherence
-        );
-
-        // Push to sequence
-        summary.sequence.envelopes.push_back(envelope);
-        summary.sequence.count++;
-
-        summary.final_network_height = static_cast<uint32_t>(net_snap.block.height);
+    const uint32_t window = config.prefetch_window > 0 ? config.prefetch_window : 1;
+    std::unique_ptr<NetworkRpcSession> session;
+    if (!is_mock(config)) {
+        session = std::make_unique<NetworkRpcSession>(config);
+    }
+
+    // Fetches one window. Only one fetch is in flight at a time, so the
+    // session is never used concurrently.
+    auto fetch_window = [&](uint32_t first_step) {
+        const uint32_t count = std::min(window, config.max_steps - first_step);
+        if (!session) {
+            std::vector<NetworkSnapshot> snaps;
+            snaps.reserve(count);
+            for (uint32_t i = 0; i < count; ++i) {
+                snaps.push_back(mock_network_snapshot(first_step + i));
+            }
+            return snaps;
+        }
+        return fetch_network_snapshots(*session, first_step, count);
+    };
+
+    std::future<std::vector<NetworkSnapshot>> pending;
+    if (config.max_steps > 0) {
+        pending = std::async(std::launch::async, fetch_window, 0u);
+    }
+
+    for (uint64_t window_start = 0; window_start < config.max_steps; window_start += window) {
+        // 1. Fetch Network Snapshots, starting the next window before stepping this one
+        std::vector<NetworkSnapshot> snaps = pending.get();
+        const uint64_t next_start = window_start + window;
+        if (next_start < config.max_steps) {
+            pending = std::async(std::launch::async, fetch_window, static_cast<uint32_t>(next_start));
+        }
+
+        for (const NetworkSnapshot& net_snap : snaps) {
+            // 2. Bind L3 -> L2 Deterministically
+            reflection::ReflectionSnapshot l2_reflection = bind_network_block(net_snap.block);
+            l1::SettlementIngestion l2_settlement = bind_network_mempool(net_snap.mempool, net_snap.block);
+            mesh::MeshCoherenceResult l2_coherence = bind_network_peer(net_snap.peer);
+
+            // 3. Step Deterministic Engine
+            l2::EngineStepResult step_result = engine.step(
+                l2_reflection,
+                l2_settlement,
+                l2_coherence,
+                node_id,
+                protocol_version
+            );
+
+            // 4. Extract Envelope
+            l2::ExecutionEnvelope envelope;
+            std::memset(&envelope, 0, sizeof(envelope));
+
+            envelope.context = l2::build_execution_context(
+                node_id,
+                step_result.new_state.epoch,
+                step_result.new_state.state_root,
+                l2_coherence
+            );
+
+            // Push to sequence
+            summary.sequence.envelopes.push_back(envelope);
+            summary.sequence.count++;
+
+            summary.final_network_height = static_cast<uint32_t>(net_snap.block.height);
+        }
     }
 
     summary.total_steps_executed = config.max_steps;
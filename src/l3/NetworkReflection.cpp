@@ -46,7 +46,10 @@ NetworkBlockSnapshot parse_network_block_snapshot(const std::string& json_data)
     if (!Json::parseFromStream(builder, s, &root, &errs)) {
         throw std::runtime_error("Failed to parse block snapshot JSON: " + errs);
     }
+    return parse_network_block_snapshot(root);
+}
 
+NetworkBlockSnapshot parse_network_block_snapshot(const Json::Value& root) {
     NetworkBlockSnapshot snap;
     std::memset(&snap, 0, sizeof(snap));
 
@@ -93,7 +96,10 @@ NetworkMempoolSnapshot parse_network_mempool_snapshot(const std::string& json_da
     if (!Json::parseFromStream(builder, s, &root, &errs)) {
         throw std::runtime_error("Failed to parse mempool snapshot JSON: " + errs);
     }
+    return parse_network_mempool_snapshot(root);
+}
 
+NetworkMempoolSnapshot parse_network_mempool_snapshot(const Json::Value& root) {
     NetworkMempoolSnapshot snap;
     std::memset(&snap, 0, sizeof(snap));
 
@@ -125,7 +131,10 @@ NetworkPeerSnapshot parse_network_peer_snapshot(const std::string& json_data) {
     if (!Json::parseFromStream(builder, s, &root, &errs)) {
         throw std::runtime_error("Failed to parse peer snapshot JSON: " + errs);
     }
+    return parse_network_peer_snapshot(root);
+}
 
+NetworkPeerSnapshot parse_network_peer_snapshot(const Json::Value& root) {
     NetworkPeerSnapshot snap;
     std::memset(&snap, 0, sizeof(snap));
 
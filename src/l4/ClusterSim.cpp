@@ -175,7 +175,7 @@ ClusterView run_cluster_simulation(
         
         SchedulerPhase phase = static_cast<SchedulerPhase>((scheduler.state.tick_count - 1) % 9);
         if (phase == SchedulerPhase::COHERENCE_UPDATE) {
-            replay_buffer.record_tick(scheduler.state, view, scheduler.telemetry.samples.back());
+            replay_buffer.record_tick(scheduler.state, view, scheduler.telemetry.samples().back());
         }
     }
 
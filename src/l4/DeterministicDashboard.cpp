@@ -4,12 +4,22 @@
 namespace ailee {
 namespace l4 {
 
-DashboardSnapshot DashboardBuilder::build_snapshot(const TelemetryBuffer& buffer) const {
+namespace {
+
+const char* const METRIC_NAMES[TELEMETRY_METRIC_COUNT] = {
+    "total_nodes",
+    "in_sync_nodes",
+    "consistent_state_root_nodes",
+    "inconsistent_state_root_nodes",
+    "global_coherence_score"
+};
+
+DashboardSnapshot samples_snapshot(const TelemetryRing& samples, TelemetryRange range) {
     std::ostringstream oss;
     oss << "{ \"telemetry\": [";
 
-    for (size_t i = 0; i < buffer.samples.size(); ++i) {
-        const auto& sample = buffer.samples[i];
+    for (size_t i = range.begin; i < range.end; ++i) {
+        const TelemetrySample sample = samples[i];
         oss << "{";
         oss << "\"tick\":" << sample.tick_count << ",";
         oss << "\"epoch\":" << sample.epoch_height << ",";
@@ -19,7 +29,7 @@ DashboardSnapshot DashboardBuilder::build_snapshot(const TelemetryBuffer& buffer
         oss << "\"inconsistent_state_root_nodes\":" << sample.inconsistent_state_root_nodes << ",";
         oss << "\"global_coherence_score\":" << sample.global_coherence_score;
         oss << "}";
-        if (i < buffer.samples.size() - 1) {
+        if (i < range.end - 1) {
             oss << ",";
         }
     }
@@ -28,5 +38,50 @@ DashboardSnapshot DashboardBuilder::build_snapshot(const TelemetryBuffer& buffer
     return { oss.str() };
 }
 
+void write_rollups(std::ostringstream& oss, const TelemetryRollupRing& rollups) {
+    oss << "[";
+    for (size_t i = 0; i < rollups.size(); ++i) {
+        const TelemetryRollup& rollup = rollups[i];
+        oss << "{";
+        oss << "\"key\":" << rollup.key << ",";
+        oss << "\"first_tick\":" << rollup.first_tick << ",";
+        oss << "\"last_tick\":" << rollup.last_tick << ",";
+        oss << "\"samples\":" << rollup.sample_count;
+        for (size_t m = 0; m < TELEMETRY_METRIC_COUNT; ++m) {
+            const TelemetryStat& stat = rollup.stats[m];
+            oss << ",\"" << METRIC_NAMES[m] << "\":{"
+                << "\"min\":" << stat.min << ","
+                << "\"max\":" << stat.max << ","
+                << "\"mean\":" << rollup.mean(static_cast<TelemetryMetric>(m)) << "}";
+        }
+        oss << "}";
+        if (i + 1 < rollups.size()) {
+            oss << ",";
+        }
+    }
+    oss << "]";
+}
+
+} // anonymous namespace
+
+DashboardSnapshot DashboardBuilder::build_snapshot(const TelemetryBuffer& buffer) const {
+    return samples_snapshot(buffer.samples(), TelemetryRange{0, buffer.samples().size()});
+}
+
+DashboardSnapshot DashboardBuilder::build_snapshot(
+    const TelemetryBuffer& buffer, uint64_t first_tick, uint64_t last_tick) const {
+    return samples_snapshot(buffer.samples(), buffer.samples().tick_range(first_tick, last_tick));
+}
+
+DashboardSnapshot DashboardBuilder::build_rollup_snapshot(const TelemetryBuffer& buffer) const {
+    std::ostringstream oss;
+    oss << "{ \"epochs\": ";
+    write_rollups(oss, buffer.epoch_rollups());
+    oss << ", \"blocks\": ";
+    write_rollups(oss, buffer.block_rollups());
+    oss << " }";
+    return { oss.str() };
+}
+
 } // namespace l4
 } // namespace ailee
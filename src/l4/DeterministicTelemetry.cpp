@@ -1,10 +1,201 @@
 #include "l4/DeterministicTelemetry.h"
 #include "l4/DeterministicScheduler.h" // For DeterministicSchedulerState
+#include <algorithm>
 #include <cstring>
 
 namespace ailee {
 namespace l4 {
 
+namespace {
+
+void sample_metrics(const TelemetrySample& sample, uint64_t out[TELEMETRY_METRIC_COUNT]) {
+    out[TELEMETRY_TOTAL_NODES] = sample.total_nodes;
+    out[TELEMETRY_IN_SYNC_NODES] = sample.in_sync_nodes;
+    out[TELEMETRY_CONSISTENT_STATE_ROOT_NODES] = sample.consistent_state_root_nodes;
+    out[TELEMETRY_INCONSISTENT_STATE_ROOT_NODES] = sample.inconsistent_state_root_nodes;
+    out[TELEMETRY_GLOBAL_COHERENCE_SCORE] = sample.global_coherence_score;
+}
+
+// First position in [0, count) whose key is >= bound; key(pos) must be
+// non-decreasing in pos.
+template <typename KeyAt>
+size_t lower_bound_pos(size_t count, uint64_t bound, KeyAt key_at) {
+    size_t lo = 0;
+    size_t hi = count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (key_at(mid) < bound) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+template <typename KeyAt>
+TelemetryRange key_range(size_t count, uint64_t first, uint64_t last, KeyAt key_at) {
+    TelemetryRange range = {0, 0};
+    if (count == 0 || first > last) {
+        return range;
+    }
+    range.begin = lower_bound_pos(count, first, key_at);
+    range.end = last == UINT64_MAX ? count : lower_bound_pos(count, last + 1, key_at);
+    if (range.end < range.begin) {
+        range.end = range.begin;
+    }
+    return range;
+}
+
+} // anonymous namespace
+
+TelemetryRing::TelemetryRing(size_t capacity)
+    : capacity_(std::max<size_t>(capacity, 1)), head_(0), size_(0), evicted_(0) {}
+
+void TelemetryRing::push_back(const TelemetrySample& sample) {
+    uint64_t metrics[TELEMETRY_METRIC_COUNT];
+    sample_metrics(sample, metrics);
+
+    // Columns grow until the ring is full and are overwritten in place after.
+    if (size_ < capacity_) {
+        tick_.push_back(sample.tick_count);
+        epoch_.push_back(sample.epoch_height);
+        for (size_t m = 0; m < TELEMETRY_METRIC_COUNT; ++m) {
+            metrics_[m].push_back(metrics[m]);
+        }
+        size_++;
+        return;
+    }
+
+    tick_[head_] = sample.tick_count;
+    epoch_[head_] = sample.epoch_height;
+    for (size_t m = 0; m < TELEMETRY_METRIC_COUNT; ++m) {
+        metrics_[m][head_] = metrics[m];
+    }
+    head_ = head_ + 1 == capacity_ ? 0 : head_ + 1;
+    evicted_++;
+}
+
+void TelemetryRing::clear() {
+    head_ = 0;
+    size_ = 0;
+    evicted_ = 0;
+    tick_.clear();
+    epoch_.clear();
+    for (auto& column : metrics_) {
+        column.clear();
+    }
+}
+
+TelemetrySample TelemetryRing::operator[](size_t pos) const {
+    const size_t p = physical(pos);
+
+    TelemetrySample sample;
+    std::memset(&sample, 0, sizeof(sample));
+    sample.tick_count = tick_[p];
+    sample.epoch_height = epoch_[p];
+    sample.total_nodes = metrics_[TELEMETRY_TOTAL_NODES][p];
+    sample.in_sync_nodes = metrics_[TELEMETRY_IN_SYNC_NODES][p];
+    sample.consistent_state_root_nodes = metrics_[TELEMETRY_CONSISTENT_STATE_ROOT_NODES][p];
+    sample.inconsistent_state_root_nodes = metrics_[TELEMETRY_INCONSISTENT_STATE_ROOT_NODES][p];
+    sample.global_coherence_score = metrics_[TELEMETRY_GLOBAL_COHERENCE_SCORE][p];
+    return sample;
+}
+
+TelemetryRange TelemetryRing::tick_range(uint64_t first_tick, uint64_t last_tick) const {
+    return key_range(size_, first_tick, last_tick, [this](size_t pos) { return tick_at(pos); });
+}
+
+TelemetryRange TelemetryRing::epoch_range(uint64_t first_epoch, uint64_t last_epoch) const {
+    return key_range(size_, first_epoch, last_epoch, [this](size_t pos) { return epoch_at(pos); });
+}
+
+bool TelemetryRing::find_tick(uint64_t tick, TelemetrySample& out) const {
+    TelemetryRange range = tick_range(tick, tick);
+    if (range.empty()) {
+        return false;
+    }
+    out = (*this)[range.begin];
+    return true;
+}
+
+TelemetryRollupRing::TelemetryRollupRing(size_t capacity)
+    : capacity_(std::max<size_t>(capacity, 1)), head_(0), size_(0), evicted_(0) {}
+
+void TelemetryRollupRing::add(uint64_t key, const TelemetrySample& sample) {
+    uint64_t metrics[TELEMETRY_METRIC_COUNT];
+    sample_metrics(sample, metrics);
+
+    // Samples arrive in key order, so only the newest rollup can be open.
+    if (size_ > 0 && rollups_[physical(size_ - 1)].key >= key) {
+        TelemetryRollup& open = rollups_[physical(size_ - 1)];
+        for (size_t m = 0; m < TELEMETRY_METRIC_COUNT; ++m) {
+            open.stats[m].min = std::min(open.stats[m].min, metrics[m]);
+            open.stats[m].max = std::max(open.stats[m].max, metrics[m]);
+            open.stats[m].sum += metrics[m];
+        }
+        open.last_tick = sample.tick_count;
+        open.sample_count++;
+        return;
+    }
+
+    TelemetryRollup rollup;
+    std::memset(&rollup, 0, sizeof(rollup));
+    rollup.key = key;
+    rollup.first_tick = sample.tick_count;
+    rollup.last_tick = sample.tick_count;
+    rollup.sample_count = 1;
+    for (size_t m = 0; m < TELEMETRY_METRIC_COUNT; ++m) {
+        rollup.stats[m].min = metrics[m];
+        rollup.stats[m].max = metrics[m];
+        rollup.stats[m].sum = metrics[m];
+    }
+
+    if (size_ < capacity_) {
+        rollups_.push_back(rollup);
+        size_++;
+        return;
+    }
+    rollups_[head_] = rollup;
+    head_ = head_ + 1 == capacity_ ? 0 : head_ + 1;
+    evicted_++;
+}
+
+void TelemetryRollupRing::clear() {
+    head_ = 0;
+    size_ = 0;
+    evicted_ = 0;
+    rollups_.clear();
+}
+
+TelemetryRange TelemetryRollupRing::range(uint64_t first_key, uint64_t last_key) const {
+    return key_range(size_, first_key, last_key, [this](size_t pos) { return (*this)[pos].key; });
+}
+
+bool TelemetryRollupRing::find(uint64_t key, TelemetryRollup& out) const {
+    TelemetryRange r = range(key, key);
+    if (r.empty()) {
+        return false;
+    }
+    out = (*this)[r.begin];
+    return true;
+}
+
+TelemetryBuffer::TelemetryBuffer(size_t sample_capacity)
+    : samples_(sample_capacity) {}
+
+void TelemetryBuffer::record(const TelemetrySample& sample) {
+    samples_.push_back(sample);
+    epoch_rollups_.add(sample.epoch_height, sample);
+    block_rollups_.add(sample.tick_count / TELEMETRY_BLOCK_TICKS, sample);
+}
+
+void TelemetryBuffer::clear() {
+    samples_.clear();
+    epoch_rollups_.clear();
+    block_rollups_.clear();
+}
+
 void record_telemetry_sample(
     const ClusterView& view,
     const DeterministicSchedulerState& scheduler_state,
@@ -23,7 +214,7 @@ void record_telemetry_sample(
     sample.inconsistent_state_root_nodes = view.coherence_summary.inconsistent_state_root_nodes;
     sample.global_coherence_score = view.coherence_summary.global_coherence_score;
 
-    buffer.samples.push_back(sample);
+    buffer.record(sample);
 }
 
 } // namespace l4
@@ -24,8 +24,151 @@ void serialize_uint64_le(uint64_t val, uint8_t out[8]) {
     out[7] = static_cast<uint8_t>((val >> 56) & 0xFF);
 }
 
+void hash_mesh_leaf(uint64_t node_id_hash, const uint8_t state_root[32], uint8_t out[32]) {
+    uint8_t buf[1 + 8 + 32];
+    buf[0] = 0x00;
+    serialize_uint64_le(node_id_hash, buf + 1);
+    std::memcpy(buf + 9, state_root, 32);
+    SHA256(buf, sizeof(buf), out);
+}
+
+void hash_mesh_pair(const uint8_t left[32], const uint8_t right[32], uint8_t out[32]) {
+    uint8_t buf[1 + 32 + 32];
+    buf[0] = 0x01;
+    std::memcpy(buf + 1, left, 32);
+    std::memcpy(buf + 33, right, 32);
+    SHA256(buf, sizeof(buf), out);
+}
+
 } // anonymous namespace
 
+void MeshStateTree::build(const ClusterView& view) {
+    std::vector<const ClusterNodeState*> sorted_nodes;
+    sorted_nodes.reserve(view.nodes.size());
+    for (const auto& node : view.nodes) {
+        sorted_nodes.push_back(&node);
+    }
+    std::sort(sorted_nodes.begin(), sorted_nodes.end(),
+              [](const ClusterNodeState* a, const ClusterNodeState* b) {
+                  return a->node_id_hash < b->node_id_hash;
+              });
+
+    node_ids_.clear();
+    state_roots_.clear();
+    levels_.clear();
+    if (sorted_nodes.empty()) {
+        return;
+    }
+
+    node_ids_.reserve(sorted_nodes.size());
+    state_roots_.resize(sorted_nodes.size());
+    levels_.emplace_back(sorted_nodes.size());
+    for (size_t i = 0; i < sorted_nodes.size(); ++i) {
+        node_ids_.push_back(sorted_nodes[i]->node_id_hash);
+        std::memcpy(state_roots_[i].data(), sorted_nodes[i]->last_envelope.context.state_root_hash, 32);
+        hash_mesh_leaf(node_ids_[i], state_roots_[i].data(), levels_[0][i].data());
+    }
+
+    while (levels_.back().size() > 1) {
+        const size_t level = levels_.size() - 1;
+        levels_.emplace_back((levels_[level].size() + 1) / 2);
+        for (size_t i = 0; i < levels_[level + 1].size(); ++i) {
+            rehash_parent(level, i * 2);
+        }
+    }
+}
+
+void MeshStateTree::rehash_parent(size_t level, size_t index) {
+    const std::vector<Digest>& children = levels_[level];
+    Digest& parent = levels_[level + 1][index / 2];
+    const size_t left = index & ~static_cast<size_t>(1);
+    if (left + 1 < children.size()) {
+        hash_mesh_pair(children[left].data(), children[left + 1].data(), parent.data());
+    } else {
+        parent = children[left];
+    }
+}
+
+bool MeshStateTree::update(uint64_t node_id_hash, const uint8_t state_root[32]) {
+    auto it = std::lower_bound(node_ids_.begin(), node_ids_.end(), node_id_hash);
+    if (it == node_ids_.end() || *it != node_id_hash) {
+        return false;
+    }
+
+    size_t index = static_cast<size_t>(it - node_ids_.begin());
+    std::memcpy(state_roots_[index].data(), state_root, 32);
+    hash_mesh_leaf(node_id_hash, state_root, levels_[0][index].data());
+    for (size_t level = 0; level + 1 < levels_.size(); ++level) {
+        rehash_parent(level, index);
+        index /= 2;
+    }
+    return true;
+}
+
+bool MeshStateTree::prove(uint64_t node_id_hash, MeshInclusionProof& out) const {
+    std::memset(&out, 0, sizeof(out));
+    auto it = std::lower_bound(node_ids_.begin(), node_ids_.end(), node_id_hash);
+    if (it == node_ids_.end() || *it != node_id_hash) {
+        return false;
+    }
+
+    size_t index = static_cast<size_t>(it - node_ids_.begin());
+    out.node_id_hash = node_id_hash;
+    out.leaf_index = index;
+    out.leaf_count = node_ids_.size();
+    std::memcpy(out.state_root, state_roots_[index].data(), 32);
+
+    for (size_t level = 0; level + 1 < levels_.size(); ++level) {
+        const size_t sibling = index ^ 1;
+        if (sibling < levels_[level].size()) {
+            std::memcpy(out.siblings[out.sibling_count], levels_[level][sibling].data(), 32);
+            out.sibling_count++;
+        }
+        index /= 2;
+    }
+    return true;
+}
+
+void MeshStateTree::root(uint8_t out[32]) const {
+    if (levels_.empty()) {
+        std::memset(out, 0, 32);
+        return;
+    }
+    std::memcpy(out, levels_.back()[0].data(), 32);
+}
+
+bool verify_mesh_inclusion(const MeshInclusionProof& proof, const MeshAnchor& anchor) {
+    if (proof.leaf_count == 0 || proof.leaf_index >= proof.leaf_count ||
+        proof.sibling_count > MESH_PROOF_MAX_DEPTH) {
+        return false;
+    }
+
+    uint8_t hash[32];
+    hash_mesh_leaf(proof.node_id_hash, proof.state_root, hash);
+
+    uint64_t index = proof.leaf_index;
+    uint64_t count = proof.leaf_count;
+    uint32_t used = 0;
+    while (count > 1) {
+        if ((index ^ 1) < count) {
+            if (used == proof.sibling_count) {
+                return false;
+            }
+            if (index & 1) {
+                hash_mesh_pair(proof.siblings[used], hash, hash);
+            } else {
+                hash_mesh_pair(hash, proof.siblings[used], hash);
+            }
+            used++;
+        }
+        index /= 2;
+        count = (count + 1) / 2;
+    }
+
+    return used == proof.sibling_count &&
+           std::memcmp(hash, anchor.epoch.mesh_state_root, 32) == 0;
+}
+
 MeshEpoch build_mesh_epoch(const ClusterView& view) {
     MeshEpoch epoch = {};
     std::memset(&epoch, 0, sizeof(epoch));
@@ -64,16 +207,11 @@ MeshEpoch build_mesh_epoch(const ClusterView& view) {
         SHA256_Final(epoch.epoch_hash, &ctx);
     }
 
-    // Hash concatenated state_roots for mesh_state_root
+    // Merkle root over the sorted node state_roots for mesh_state_root
     {
-        SHA256_CTX ctx;
-        SHA256_Init(&ctx);
-
-        for (const auto* node : sorted_nodes) {
-            SHA256_Update(&ctx, node->last_envelope.context.state_root_hash, 32);
-        }
-
-        SHA256_Final(epoch.mesh_state_root, &ctx);
+        MeshStateTree tree;
+        tree.build(view);
+        tree.root(epoch.mesh_state_root);
     }
 
     return epoch;
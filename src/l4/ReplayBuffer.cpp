@@ -1,9 +1,111 @@
 #include "l4/ReplayBuffer.h"
 #include "l6/JsonBindings.h"
+#include <openssl/sha.h>
+#include <cstring>
 
 namespace ailee {
 namespace l4 {
 
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+
+void compute_replay_node_digest(const ClusterNodeState& node, uint8_t out[32]) {
+    // Hash the node as it is laid out on disk: raw bytes with the peer-sync
+    // vector footprint zeroed, then the peer-sync array itself.
+    uint8_t raw[sizeof(ClusterNodeState)];
+    std::memcpy(raw, &node, sizeof(ClusterNodeState));
+    const size_t sync_offset = static_cast<size_t>(
+        reinterpret_cast<const uint8_t*>(&node.peer_sync_states) - reinterpret_cast<const uint8_t*>(&node));
+    std::memset(raw + sync_offset, 0, sizeof(node.peer_sync_states));
+
+    SHA256_CTX ctx;
+    SHA256_Init(&ctx);
+    SHA256_Update(&ctx, raw, sizeof(raw));
+    uint64_t sync_size = node.peer_sync_states.size();
+    SHA256_Update(&ctx, &sync_size, sizeof(sync_size));
+    if (sync_size > 0) {
+        SHA256_Update(&ctx, node.peer_sync_states.data(), sync_size * sizeof(l3::PeerSyncState));
+    }
+    SHA256_Final(out, &ctx);
+}
+
+ReplayTickDigest compute_replay_tick_digest(
+    const DeterministicSchedulerState& scheduler_state,
+    const ReplayClusterViewSnapshot& view,
+    const TelemetrySample& telemetry_sample,
+    const uint8_t previous_chain[32]
+) {
+    ReplayTickDigest digest;
+    std::memset(&digest, 0, sizeof(ReplayTickDigest));
+    auto component = [&](ReplayComponent c) { return digest.components[static_cast<size_t>(c)]; };
+
+    SHA256(reinterpret_cast<const uint8_t*>(&scheduler_state), sizeof(DeterministicSchedulerState),
+           component(ReplayComponent::SCHEDULER));
+    SHA256(reinterpret_cast<const uint8_t*>(&telemetry_sample), sizeof(TelemetrySample),
+           component(ReplayComponent::TELEMETRY));
+    SHA256(reinterpret_cast<const uint8_t*>(&view.clock), sizeof(l1_sync::BitcoinClockState),
+           component(ReplayComponent::CLOCK));
+
+    SHA256_CTX ctx;
+
+    SHA256_Init(&ctx);
+    SHA256_Update(&ctx, &view.total_nodes, sizeof(view.total_nodes));
+    SHA256_Update(&ctx, &view.total_steps, sizeof(view.total_steps));
+    SHA256_Update(&ctx, &view.coherence_summary, sizeof(ClusterCoherenceSummary));
+    SHA256_Final(component(ReplayComponent::SUMMARY), &ctx);
+
+    // Events are hashed field by field, as they are serialized.
+    SHA256_Init(&ctx);
+    uint64_t events_size = view.replay_events.size();
+    SHA256_Update(&ctx, &events_size, sizeof(events_size));
+    for (const auto& ev : view.replay_events) {
+        uint8_t type_val = static_cast<uint8_t>(ev.type);
+        SHA256_Update(&ctx, &type_val, sizeof(type_val));
+        SHA256_Update(&ctx, &ev.height, sizeof(ev.height));
+        SHA256_Update(&ctx, ev.block_hash.data(), ev.block_hash.size());
+        SHA256_Update(&ctx, ev.txid.data(), ev.txid.size());
+    }
+    SHA256_Final(component(ReplayComponent::EVENTS), &ctx);
+
+    // The nodes component chains the per-node digests so a divergence can be
+    // narrowed to one node by recomputing them for a single tick.
+    SHA256_Init(&ctx);
+    uint64_t nodes_size = view.nodes.size();
+    SHA256_Update(&ctx, &nodes_size, sizeof(nodes_size));
+    for (const auto& node : view.nodes) {
+        uint8_t node_digest[32];
+        compute_replay_node_digest(node, node_digest);
+        SHA256_Update(&ctx, node_digest, 32);
+    }
+    SHA256_Final(component(ReplayComponent::NODES), &ctx);
+
+    SHA256_Init(&ctx);
+    uint64_t env_size = view.mesh_envelopes.size();
+    SHA256_Update(&ctx, &env_size, sizeof(env_size));
+    if (env_size > 0) {
+        SHA256_Update(&ctx, view.mesh_envelopes.data(), env_size * sizeof(MeshPropagationEnvelope));
+    }
+    SHA256_Final(component(ReplayComponent::MESH_ENVELOPES), &ctx);
+
+    SHA256_Init(&ctx);
+    uint64_t msg_size = view.transport_queue.messages.size();
+    SHA256_Update(&ctx, &msg_size, sizeof(msg_size));
+    if (msg_size > 0) {
+        SHA256_Update(&ctx, view.transport_queue.messages.data(), msg_size * sizeof(TransportMessage));
+    }
+    SHA256_Update(&ctx, view.transport_queue.padding, sizeof(view.transport_queue.padding));
+    SHA256_Final(component(ReplayComponent::TRANSPORT_QUEUE), &ctx);
+
+    SHA256_Init(&ctx);
+    SHA256_Update(&ctx, previous_chain, 32);
+    SHA256_Update(&ctx, digest.components, sizeof(digest.components));
+    SHA256_Final(digest.chain, &ctx);
+
+    return digest;
+}
+
+#pragma GCC diagnostic pop
+
 void ReplayBuffer::record_tick(
     const DeterministicSchedulerState& scheduler_state,
     const ClusterView& view,
@@ -41,10 +143,28 @@ void ReplayBuffer::record_tick(
     snap.clock = view.clock;
     snap.replay_events = view.replay_events;
     
+    uint8_t previous_chain[32] = {0};
+    if (!tick_digests.empty()) {
+        std::memcpy(previous_chain, tick_digests.back().chain, 32);
+    }
+    tick_digests.push_back(compute_replay_tick_digest(scheduler_state, snap, telemetry_sample, previous_chain));
+
     view_snapshots.push_back(std::move(snap));
     
     telemetry_snapshots.push_back(telemetry_sample);
 }
 
+void ReplayBuffer::rebuild_digests() {
+    tick_digests.clear();
+    tick_digests.reserve(scheduler_snapshots.size());
+
+    uint8_t previous_chain[32] = {0};
+    for (size_t i = 0; i < scheduler_snapshots.size(); ++i) {
+        tick_digests.push_back(compute_replay_tick_digest(
+            scheduler_snapshots[i].state, view_snapshots[i], telemetry_snapshots[i], previous_chain));
+        std::memcpy(previous_chain, tick_digests.back().chain, 32);
+    }
+}
+
 } // namespace l4
 } // namespace ailee
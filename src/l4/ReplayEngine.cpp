@@ -3,12 +3,13 @@
 #include <cstring>
 #include <stdexcept>
 #include <iostream>
+#include <algorithm>
 
 namespace ailee {
 namespace l4 {
 
 static const char REPLAY_MAGIC[10] = "AILEE-RPL";
-static constexpr uint32_t REPLAY_VERSION = 2;
+static constexpr uint32_t REPLAY_VERSION = 3;
 
 ReplayTick ReplayEngine::step(const l1_sync::ReplayState& previous, const l1_sync::ReplayInput& input) const {
     ReplayTick tick;
@@ -61,6 +62,21 @@ void ReplayEngine::write_replay_file(const std::string& path, const ReplayBuffer
     uint64_t tick_count = replay_buffer.scheduler_snapshots.size();
     ofs.write(reinterpret_cast<const char*>(&tick_count), sizeof(tick_count));
 
+    // Buffers filled without record_tick carry no digests; derive them here.
+    std::vector<ReplayTickDigest> derived_digests;
+    const std::vector<ReplayTickDigest>* digests = &replay_buffer.tick_digests;
+    if (digests->size() != tick_count) {
+        derived_digests.reserve(tick_count);
+        uint8_t previous_chain[32] = {0};
+        for (uint64_t i = 0; i < tick_count; ++i) {
+            derived_digests.push_back(compute_replay_tick_digest(
+                replay_buffer.scheduler_snapshots[i].state, replay_buffer.view_snapshots[i],
+                replay_buffer.telemetry_snapshots[i], previous_chain));
+            std::memcpy(previous_chain, derived_digests.back().chain, 32);
+        }
+        digests = &derived_digests;
+    }
+
     for (uint64_t i = 0; i < tick_count; ++i) {
         ofs.write(reinterpret_cast<const char*>(&replay_buffer.scheduler_snapshots[i]), sizeof(ReplaySchedulerSnapshot));
         
@@ -117,6 +133,8 @@ void ReplayEngine::write_replay_file(const std::string& path, const ReplayBuffer
         }
 
         ofs.write(reinterpret_cast<const char*>(&replay_buffer.telemetry_snapshots[i]), sizeof(TelemetrySample));
+
+        ofs.write(reinterpret_cast<const char*>(&(*digests)[i]), sizeof(ReplayTickDigest));
     }
 }
 
@@ -144,6 +162,7 @@ void ReplayEngine::load_replay_file(const std::string& path) {
     buffer.scheduler_snapshots.resize(tick_count);
     buffer.view_snapshots.resize(tick_count);
     buffer.telemetry_snapshots.resize(tick_count);
+    buffer.tick_digests.resize(tick_count);
     
     for (uint64_t i = 0; i < tick_count; ++i) {
         ifs.read(reinterpret_cast<char*>(&buffer.scheduler_snapshots[i]), sizeof(ReplaySchedulerSnapshot));
@@ -215,6 +234,14 @@ void ReplayEngine::load_replay_file(const std::string& path) {
         }
 
         ifs.read(reinterpret_cast<char*>(&buffer.telemetry_snapshots[i]), sizeof(TelemetrySample));
+
+        if (version >= 3) {
+            ifs.read(reinterpret_cast<char*>(&buffer.tick_digests[i]), sizeof(ReplayTickDigest));
+        }
+    }
+
+    if (version < 3) {
+        buffer.rebuild_digests();
     }
 }
 
@@ -297,5 +324,141 @@ bool ReplayEngine::verify_tick(
     return true;
 }
 
+namespace {
+
+// Digests can only stand in for tick data if there is one per tick and the
+// newest still matches its tick. Older entries are covered by the chain.
+bool digests_current(const ReplayBuffer& buffer) {
+    const size_t count = buffer.scheduler_snapshots.size();
+    if (buffer.tick_digests.size() != count || buffer.view_snapshots.size() != count ||
+        buffer.telemetry_snapshots.size() != count) {
+        return false;
+    }
+    if (count == 0) {
+        return true;
+    }
+    uint8_t previous_chain[32] = {0};
+    if (count > 1) {
+        std::memcpy(previous_chain, buffer.tick_digests[count - 2].chain, 32);
+    }
+    const ReplayTickDigest last = compute_replay_tick_digest(
+        buffer.scheduler_snapshots[count - 1].state, buffer.view_snapshots[count - 1],
+        buffer.telemetry_snapshots[count - 1], previous_chain);
+    return std::memcmp(&last, &buffer.tick_digests[count - 1], sizeof(ReplayTickDigest)) == 0;
+}
+
+// Chain over the full tick data, for buffers whose stored chain can't be used.
+std::vector<ReplayTickDigest> rehash_ticks(const ReplayBuffer& buffer) {
+    const size_t count = std::min({buffer.scheduler_snapshots.size(), buffer.view_snapshots.size(),
+                                   buffer.telemetry_snapshots.size()});
+    std::vector<ReplayTickDigest> digests;
+    digests.reserve(count);
+    uint8_t previous_chain[32] = {0};
+    for (size_t i = 0; i < count; ++i) {
+        digests.push_back(compute_replay_tick_digest(
+            buffer.scheduler_snapshots[i].state, buffer.view_snapshots[i],
+            buffer.telemetry_snapshots[i], previous_chain));
+        std::memcpy(previous_chain, digests.back().chain, 32);
+    }
+    return digests;
+}
+
+} // namespace
+
+ReplayDivergence ReplayEngine::find_divergence(const ReplayBuffer& a, const ReplayBuffer& b, bool rehash) {
+    ReplayDivergence result;
+    std::memset(&result, 0, sizeof(ReplayDivergence));
+    result.component = ReplayComponent::NONE;
+
+    std::vector<ReplayTickDigest> a_rebuilt;
+    std::vector<ReplayTickDigest> b_rebuilt;
+    const std::vector<ReplayTickDigest>* a_digests = &a.tick_digests;
+    const std::vector<ReplayTickDigest>* b_digests = &b.tick_digests;
+    if (rehash || !digests_current(a)) {
+        a_rebuilt = rehash_ticks(a);
+        a_digests = &a_rebuilt;
+        result.digests_rebuilt = true;
+    }
+    if (rehash || !digests_current(b)) {
+        b_rebuilt = rehash_ticks(b);
+        b_digests = &b_rebuilt;
+        result.digests_rebuilt = true;
+    }
+
+    const size_t a_count = a_digests->size();
+    const size_t b_count = b_digests->size();
+    const size_t common = std::min(a_count, b_count);
+
+    auto chain_equal = [&](size_t i) {
+        ++result.chain_comparisons;
+        return std::memcmp((*a_digests)[i].chain, (*b_digests)[i].chain, 32) == 0;
+    };
+
+    // Chains agree on a prefix and disagree from the first divergent tick on,
+    // so the boundary is found by binary search over [0, common).
+    size_t lo = 0;
+    size_t hi = common;
+    if (common > 0 && chain_equal(common - 1)) {
+        lo = common;
+    }
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (chain_equal(mid)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    if (lo == common) {
+        if (a_count != b_count) {
+            result.diverged = true;
+            result.tick = common;
+            result.component = ReplayComponent::TICK_COUNT;
+        }
+        return result;
+    }
+
+    result.diverged = true;
+    result.tick = lo;
+
+    const ReplayTickDigest& da = (*a_digests)[lo];
+    const ReplayTickDigest& db = (*b_digests)[lo];
+    for (size_t c = 0; c < REPLAY_COMPONENT_COUNT; ++c) {
+        if (std::memcmp(da.components[c], db.components[c], 32) != 0) {
+            result.component = static_cast<ReplayComponent>(c);
+            break;
+        }
+    }
+
+    if (result.component == ReplayComponent::NODES) {
+        const auto& a_nodes = a.view_snapshots[lo].nodes;
+        const auto& b_nodes = b.view_snapshots[lo].nodes;
+        const size_t node_common = std::min(a_nodes.size(), b_nodes.size());
+        size_t n = 0;
+        for (; n < node_common; ++n) {
+            uint8_t a_digest[32];
+            uint8_t b_digest[32];
+            compute_replay_node_digest(a_nodes[n], a_digest);
+            compute_replay_node_digest(b_nodes[n], b_digest);
+            if (std::memcmp(a_digest, b_digest, 32) != 0) {
+                break;
+            }
+        }
+        result.node_index = n;
+        result.node_id_hash = n < a_nodes.size() ? a_nodes[n].node_id_hash : 0;
+    }
+
+    return result;
+}
+
+ReplayDivergence ReplayEngine::find_divergence(const std::string& path_a, const std::string& path_b) {
+    ReplayEngine a;
+    ReplayEngine b;
+    a.load_replay_file(path_a);
+    b.load_replay_file(path_b);
+    return find_divergence(a.buffer, b.buffer);
+}
+
 } // namespace l4
 } // namespace ailee
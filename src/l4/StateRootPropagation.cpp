@@ -65,21 +65,73 @@ std::vector<StateRootValidationResult> validate_state_roots(
     const MeshAnchor& anchor,
     const std::vector<StateRootAnnouncement>& announcements) {
 
+    StateRootValidationSummary summary;
+    return validate_state_roots(view, anchor, announcements, summary);
+}
+
+std::vector<StateRootValidationResult> validate_state_roots(
+    const ClusterView& view,
+    const MeshAnchor& anchor,
+    const std::vector<StateRootAnnouncement>& announcements,
+    StateRootValidationSummary& summary) {
+
+    std::memset(&summary, 0, sizeof(summary));
+
+    auto by_source = [](const StateRootAnnouncement* a, const StateRootAnnouncement* b) {
+        return a->source_node_id_hash < b->source_node_id_hash;
+    };
+
+    // Stable order keeps the first announcement per source first, matching
+    // the earliest-wins lookup of a linear scan.
+    std::vector<const StateRootAnnouncement*> sorted_anns;
+    sorted_anns.reserve(announcements.size());
+    for (const auto& ann : announcements) {
+        sorted_anns.push_back(&ann);
+    }
+    if (!std::is_sorted(sorted_anns.begin(), sorted_anns.end(), by_source)) {
+        std::stable_sort(sorted_anns.begin(), sorted_anns.end(), by_source);
+    }
+
+    std::vector<const ClusterNodeState*> sorted_nodes;
+    sorted_nodes.reserve(view.nodes.size());
+    for (const auto& node : view.nodes) {
+        sorted_nodes.push_back(&node);
+    }
+    std::sort(sorted_nodes.begin(), sorted_nodes.end(),
+              [](const ClusterNodeState* a, const ClusterNodeState* b) {
+                  return a->node_id_hash < b->node_id_hash;
+              });
+
     std::vector<StateRootValidationResult> results;
     results.reserve(view.nodes.size());
 
-    for (const auto& node : view.nodes) {
+    // Announcements below the current node hash belong to no node, unless
+    // they repeat the source the previous node already matched.
+    size_t a = 0;
+    bool have_matched = false;
+    uint64_t matched_source = 0;
+    auto skip_below = [&](uint64_t bound) {
+        while (a < sorted_anns.size() && sorted_anns[a]->source_node_id_hash < bound) {
+            if (!have_matched || sorted_anns[a]->source_node_id_hash != matched_source) {
+                summary.unknown_source_count++;
+            }
+            ++a;
+        }
+    };
+
+    for (const auto* node : sorted_nodes) {
         StateRootValidationResult res = {};
         std::memset(&res, 0, sizeof(res));
-        res.node_id_hash = node.node_id_hash;
+        res.node_id_hash = node->node_id_hash;
         res.epoch_height = anchor.epoch.epoch_height;
 
+        skip_below(node->node_id_hash);
+
         const StateRootAnnouncement* my_ann = nullptr;
-        for (const auto& ann : announcements) {
-            if (ann.source_node_id_hash == node.node_id_hash) {
-                my_ann = &ann;
-                break;
-            }
+        if (a < sorted_anns.size() && sorted_anns[a]->source_node_id_hash == node->node_id_hash) {
+            my_ann = sorted_anns[a];
+            have_matched = true;
+            matched_source = node->node_id_hash;
         }
 
         if (my_ann) {
@@ -98,38 +150,49 @@ std::vector<StateRootValidationResult> validate_state_roots(
                 }
             }
         } else {
-            // Find if there's any announcement at all with unknown source
-            [[maybe_unused]] bool has_unknown = false;
-            for (const auto& ann : announcements) {
-                bool found = false;
-                for (const auto& vnode : view.nodes) {
-                    if (vnode.node_id_hash == ann.source_node_id_hash) {
-                        found = true;
-                        break;
-                    }
-                }
-                if (!found) {
-                    has_unknown = true;
-                    break;
-                }
-            }
-
+            // No matching announcement is treated as UNKNOWN_SOURCE
             res.accepted = false;
             res.rejected = true;
-            // Either way, if there's no matching announcement, we treat it as UNKNOWN_SOURCE
             res.reason_code = 3; // UNKNOWN_SOURCE
+            summary.missing_count++;
+        }
+
+        if (res.accepted) {
+            summary.accepted_count++;
+        } else {
+            summary.rejected_count++;
         }
 
         results.push_back(res);
     }
 
-    // Sort by node_id_hash ascending
-    std::sort(results.begin(), results.end(), [](const StateRootValidationResult& a, const StateRootValidationResult& b) {
-        return a.node_id_hash < b.node_id_hash;
-    });
+    // Announcements past the last node.
+    for (; a < sorted_anns.size(); ++a) {
+        if (!have_matched || sorted_anns[a]->source_node_id_hash != matched_source) {
+            summary.unknown_source_count++;
+        }
+    }
 
+    // Results are emitted in ascending node_id_hash order by construction.
     return results;
 }
 
+bool verify_state_root_announcement(
+    const StateRootAnnouncement& announcement,
+    const MeshInclusionProof& proof,
+    const MeshAnchor& anchor) {
+
+    if (announcement.source_node_id_hash != proof.node_id_hash) {
+        return false;
+    }
+    if (announcement.epoch_height != anchor.epoch.epoch_height) {
+        return false;
+    }
+    if (std::memcmp(announcement.state_root, proof.state_root, 32) != 0) {
+        return false;
+    }
+    return verify_mesh_inclusion(proof, anchor);
+}
+
 } // namespace l4
 } // namespace ailee
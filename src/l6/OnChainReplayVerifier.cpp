@@ -1,8 +1,68 @@
 #include "l6/OnChainReplayVerifier.h"
 
+#include <algorithm>
+#include <cstring>
+
 namespace ailee {
 namespace l6 {
 
+namespace {
+
+constexpr uint8_t kOpReturn = 0x6a;
+constexpr uint8_t kOpPushData1 = 0x4c;
+constexpr char kAnchorTag[] = "AILEE";
+constexpr std::size_t kAnchorTagLen = sizeof(kAnchorTag) - 1;
+constexpr std::size_t kAnchorRecordLen = 49;
+constexpr std::size_t kAnchorPayloadLen = kAnchorTagLen + kAnchorRecordLen;
+
+// Anchored stretches are compared this many epochs per memcmp; a mismatching
+// block falls back to per-epoch comparison to find the bad epochs.
+constexpr std::size_t kBulkCompareEpochs = 64;
+
+static_assert(sizeof(EpochHash) == 32, "EpochHash must be tightly packed for bulk compares");
+
+void append_run(ReconciliationReport& report, ReplayStatus status, uint64_t first, uint64_t last) {
+    const uint64_t count = last - first + 1;
+    switch (status) {
+        case ReplayStatus::OK: report.ok_epochs += count; break;
+        case ReplayStatus::MISMATCH: report.mismatched_epochs += count; break;
+        case ReplayStatus::MISSING_ANCHOR: report.missing_epochs += count; break;
+        case ReplayStatus::CONFLICTING_ANCHOR: report.conflicting_epochs += count; break;
+    }
+    if (!report.runs.empty()) {
+        ReplayRun& back = report.runs.back();
+        if (back.status == status && back.last_epoch + 1 == first) {
+            back.last_epoch = last;
+            return;
+        }
+    }
+    report.runs.push_back(ReplayRun{status, first, last});
+}
+
+// Returns the pushed payload of an OP_RETURN script with a single push.
+bool op_return_payload(const std::vector<uint8_t>& script, const uint8_t*& data, std::size_t& len) {
+    if (script.size() < 2 || script[0] != kOpReturn) {
+        return false;
+    }
+    std::size_t offset = 0;
+    if (script[1] <= 75) {
+        len = script[1];
+        offset = 2;
+    } else if (script[1] == kOpPushData1 && script.size() >= 3) {
+        len = script[2];
+        offset = 3;
+    } else {
+        return false;
+    }
+    if (offset + len != script.size()) {
+        return false;
+    }
+    data = script.data() + offset;
+    return true;
+}
+
+} // namespace
+
 ReplayVerdict verify_epoch_against_anchor(
     uint64_t epoch_id,
     const std::string& local_epoch_hash,
@@ -26,5 +86,212 @@ ReplayVerdict verify_epoch_against_anchor(
     return verdict;
 }
 
+// -----------------------------
+// EpochAnchorIndex
+// -----------------------------
+
+bool EpochAnchorIndex::insert(uint64_t epoch_id, const EpochHash& hash, uint64_t l1_height) {
+    // Anchors arrive in epoch order when blocks are scanned in height order.
+    if (epochs_.empty() || epoch_id > epochs_.back()) {
+        epochs_.push_back(epoch_id);
+        hashes_.push_back(hash);
+        heights_.push_back(l1_height);
+        disputed_.push_back(0);
+        return true;
+    }
+    auto it = std::lower_bound(epochs_.begin(), epochs_.end(), epoch_id);
+    const auto pos = it - epochs_.begin();
+    if (it != epochs_.end() && *it == epoch_id) {
+        later_[epoch_id].push_back(LaterAnchor{hash, l1_height});
+        if (hashes_[pos] != hash && !disputed_[pos]) {
+            disputed_[pos] = 1;
+            ++conflicts_;
+        }
+        return false;
+    }
+    epochs_.insert(it, epoch_id);
+    hashes_.insert(hashes_.begin() + pos, hash);
+    heights_.insert(heights_.begin() + pos, l1_height);
+    disputed_.insert(disputed_.begin() + pos, 0);
+    return true;
+}
+
+bool EpochAnchorIndex::differs_from_later(uint64_t epoch_id, const EpochHash& hash) const {
+    auto it = later_.find(epoch_id);
+    if (it == later_.end()) {
+        return false;
+    }
+    return std::any_of(it->second.begin(), it->second.end(),
+                       [&hash](const LaterAnchor& later) { return later.hash != hash; });
+}
+
+std::size_t EpochAnchorIndex::unscan_from(uint64_t l1_height) {
+    std::size_t removed = 0;
+    for (auto it = later_.begin(); it != later_.end();) {
+        auto& anchors = it->second;
+        const std::size_t before = anchors.size();
+        anchors.erase(std::remove_if(anchors.begin(), anchors.end(),
+                                     [l1_height](const LaterAnchor& a) { return a.l1_height >= l1_height; }),
+                      anchors.end());
+        removed += before - anchors.size();
+        it = anchors.empty() ? later_.erase(it) : std::next(it);
+    }
+
+    // Compact the parallel arrays in one pass, promoting the earliest
+    // surviving later anchor where the first one was rolled back.
+    std::size_t out = 0;
+    conflicts_ = 0;
+    for (std::size_t k = 0; k < epochs_.size(); ++k) {
+        const uint64_t epoch = epochs_[k];
+        EpochHash hash = hashes_[k];
+        uint64_t height = heights_[k];
+        if (height >= l1_height) {
+            ++removed;
+            auto later = later_.find(epoch);
+            if (later == later_.end()) {
+                continue;
+            }
+            hash = later->second.front().hash;
+            height = later->second.front().l1_height;
+            later->second.erase(later->second.begin());
+            if (later->second.empty()) {
+                later_.erase(later);
+            }
+        }
+        epochs_[out] = epoch;
+        hashes_[out] = hash;
+        heights_[out] = height;
+        disputed_[out] = differs_from_later(epoch, hash) ? 1 : 0;
+        conflicts_ += disputed_[out];
+        ++out;
+    }
+    epochs_.resize(out);
+    hashes_.resize(out);
+    heights_.resize(out);
+    disputed_.resize(out);
+    return removed;
+}
+
+std::size_t EpochAnchorIndex::scan_block(uint64_t l1_height,
+                                         const std::vector<std::vector<uint8_t>>& output_scripts) {
+    std::size_t added = 0;
+    for (const auto& script : output_scripts) {
+        const uint8_t* data = nullptr;
+        std::size_t len = 0;
+        if (!op_return_payload(script, data, len) || len != kAnchorPayloadLen ||
+            std::memcmp(data, kAnchorTag, kAnchorTagLen) != 0) {
+            continue;
+        }
+        AnchorRecord record;
+        if (!deserialize(std::vector<uint8_t>(data + kAnchorTagLen, data + len), record)) {
+            continue;
+        }
+        if (insert(record.replay_height, record.state_root, l1_height)) {
+            ++added;
+        }
+    }
+    return added;
+}
+
+std::optional<EpochHash> EpochAnchorIndex::find(uint64_t epoch_id) const {
+    auto it = std::lower_bound(epochs_.begin(), epochs_.end(), epoch_id);
+    if (it == epochs_.end() || *it != epoch_id || disputed_[it - epochs_.begin()]) {
+        return std::nullopt;
+    }
+    return hashes_[it - epochs_.begin()];
+}
+
+bool EpochAnchorIndex::disputed(uint64_t epoch_id) const {
+    auto it = std::lower_bound(epochs_.begin(), epochs_.end(), epoch_id);
+    return it != epochs_.end() && *it == epoch_id && disputed_[it - epochs_.begin()];
+}
+
+std::optional<uint64_t> EpochAnchorIndex::anchor_height(uint64_t epoch_id) const {
+    auto it = std::lower_bound(epochs_.begin(), epochs_.end(), epoch_id);
+    if (it == epochs_.end() || *it != epoch_id) {
+        return std::nullopt;
+    }
+    return heights_[it - epochs_.begin()];
+}
+
+std::vector<uint8_t> build_epoch_anchor_script(const AnchorRecord& record) {
+    const std::vector<uint8_t> body = serialize(record);
+    std::vector<uint8_t> script;
+    script.reserve(2 + kAnchorTagLen + body.size());
+    script.push_back(kOpReturn);
+    script.push_back(static_cast<uint8_t>(kAnchorTagLen + body.size()));
+    script.insert(script.end(), kAnchorTag, kAnchorTag + kAnchorTagLen);
+    script.insert(script.end(), body.begin(), body.end());
+    return script;
+}
+
+// -----------------------------
+// Range reconciliation
+// -----------------------------
+
+ReconciliationReport reconcile_epoch_range(
+    uint64_t first_epoch,
+    const std::vector<EpochHash>& local_hashes,
+    const EpochAnchorIndex& index
+) {
+    ReconciliationReport report;
+    const std::vector<uint64_t>& epochs = index.epochs();
+    const std::vector<EpochHash>& hashes = index.hashes();
+    const std::vector<uint8_t>& disputed = index.disputed_flags();
+    const bool any_disputed = index.conflicts() > 0;
+    const std::size_t n = local_hashes.size();
+    const std::size_t m = epochs.size();
+
+    std::size_t j = std::lower_bound(epochs.begin(), epochs.end(), first_epoch) - epochs.begin();
+    std::size_t i = 0;
+    while (i < n) {
+        const uint64_t epoch = first_epoch + i;
+        if (j == m || epochs[j] != epoch) {
+            // Unanchored gap up to the next anchor (or the end of the range).
+            const std::size_t gap = (j == m)
+                ? n - i
+                : static_cast<std::size_t>(std::min<uint64_t>(n - i, epochs[j] - epoch));
+            append_run(report, ReplayStatus::MISSING_ANCHOR, epoch, epoch + gap - 1);
+            i += gap;
+            continue;
+        }
+
+        // Epochs are sorted and unique, so the first k entries are
+        // consecutive iff epochs[j + k - 1] - epoch == k - 1.
+        std::size_t lo = 1;
+        std::size_t hi = std::min(n - i, m - j);
+        while (lo < hi) {
+            const std::size_t mid = lo + (hi - lo + 1) / 2;
+            if (epochs[j + mid - 1] - epoch == mid - 1) {
+                lo = mid;
+            } else {
+                hi = mid - 1;
+            }
+        }
+        const std::size_t stretch = lo;
+
+        for (std::size_t off = 0; off < stretch;) {
+            const std::size_t block = std::min(kBulkCompareEpochs, stretch - off);
+            const bool block_disputed = any_disputed &&
+                std::memchr(disputed.data() + j + off, 1, block) != nullptr;
+            if (!block_disputed && std::memcmp(local_hashes[i + off].data(), hashes[j + off].data(),
+                                               block * sizeof(EpochHash)) == 0) {
+                append_run(report, ReplayStatus::OK, epoch + off, epoch + off + block - 1);
+            } else {
+                for (std::size_t b = 0; b < block; ++b) {
+                    const ReplayStatus status = disputed[j + off + b] ? ReplayStatus::CONFLICTING_ANCHOR
+                        : local_hashes[i + off + b] == hashes[j + off + b] ? ReplayStatus::OK
+                        : ReplayStatus::MISMATCH;
+                    append_run(report, status, epoch + off + b, epoch + off + b);
+                }
+            }
+            off += block;
+        }
+        i += stretch;
+        j += stretch;
+    }
+    return report;
+}
+
 } // namespace l6
 } // namespace ailee
@@ -0,0 +1,823 @@
+// SPDX-License-Identifier: MIT
+// AmbientRequesterClient.cpp — Pipelined task submission over IPubSub
+
+#include "AmbientClient.h"
+#include "AmbientWire.h"
+
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <iomanip>
+#include <limits>
+#include <stdexcept>
+
+namespace ailee::net {
+
+namespace {
+
+constexpr std::uint64_t kWheelTickMs = 10;
+constexpr std::size_t kWheelSlots = 512;
+constexpr std::uint64_t kRetryBackoffMs = 50;
+constexpr std::uint64_t kMaxRetryBackoffMs = 5000;
+// Workers silent for this many discovery intervals are not selected.
+constexpr std::uint64_t kWorkerStaleIntervals = 3;
+
+std::uint64_t steadyMs() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+std::uint64_t wallClockMs() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+bool isTerminal(TaskStatus status) {
+    return status == TaskStatus::COMPLETED || status == TaskStatus::FAILED ||
+           status == TaskStatus::CANCELLED || status == TaskStatus::TIMEOUT;
+}
+
+std::uint64_t toMs(std::chrono::milliseconds d) {
+    return d.count() > 0 ? static_cast<std::uint64_t>(d.count()) : 0;
+}
+
+} // namespace
+
+// Hashed timer wheel: scheduling and firing are O(1) per timer; each tick
+// only touches one slot. Timers further out than one revolution carry a
+// round count. Guarded by tasks_mutex_.
+struct AmbientRequesterClient::TimerWheel {
+    enum class Kind : std::uint8_t { DEADLINE, RETRY, EXPIRE };
+
+    struct Timer {
+        std::string taskId;
+        std::uint32_t attempt;
+        Kind kind;
+        std::uint64_t rounds;
+    };
+
+    explicit TimerWheel(std::uint64_t originMs) : origin(originMs), slots(kWheelSlots) {}
+
+    void schedule(std::uint64_t nowMs, std::uint64_t delayMs, const std::string& taskId,
+                  std::uint32_t attempt, Kind kind) {
+        std::uint64_t due = (nowMs - origin + delayMs + kWheelTickMs - 1) / kWheelTickMs;
+        if (due <= cursor) {
+            due = cursor + 1;
+        }
+        const std::uint64_t ticks = due - cursor;
+        slots[due % slots.size()].push_back(Timer{taskId, attempt, kind, (ticks - 1) / slots.size()});
+    }
+
+    void advance(std::uint64_t nowMs, std::vector<Timer>& fired) {
+        const std::uint64_t target = (nowMs - origin) / kWheelTickMs;
+        while (cursor < target) {
+            ++cursor;
+            auto& slot = slots[cursor % slots.size()];
+            for (std::size_t i = 0; i < slot.size();) {
+                if (slot[i].rounds == 0) {
+                    fired.push_back(std::move(slot[i]));
+                    slot[i] = std::move(slot.back());
+                    slot.pop_back();
+                } else {
+                    --slot[i].rounds;
+                    ++i;
+                }
+            }
+        }
+    }
+
+    std::uint64_t origin;
+    std::uint64_t cursor = 0;
+    std::vector<std::vector<Timer>> slots;
+};
+
+// ============================================================================
+// Construction / Lifecycle
+// ============================================================================
+
+AmbientRequesterClient::AmbientRequesterClient(std::shared_ptr<IPubSub> pubsub,
+                                               const RequesterOptions& opts)
+    : pubsub_(std::move(pubsub))
+    , options_(opts)
+    , wheel_(std::make_unique<TimerWheel>(steadyMs())) {
+    if (!pubsub_) {
+        throw std::invalid_argument("AmbientRequesterClient requires a pubsub transport");
+    }
+    if (options_.maxConcurrentTasks == 0) {
+        options_.maxConcurrentTasks = 1;
+    }
+
+    std::random_device rd;
+    std::uint64_t nonce = (static_cast<std::uint64_t>(rd()) << 32) | rd();
+    std::ostringstream oss;
+    oss << "requester-" << std::hex << std::setw(16) << std::setfill('0') << nonce;
+    requester_id_ = oss.str();
+}
+
+AmbientRequesterClient::~AmbientRequesterClient() {
+    stop();
+    if (timer_thread_.joinable()) {
+        // Still set when stop() ran from a callback on the timer thread.
+        if (timer_thread_.get_id() == std::this_thread::get_id()) {
+            timer_thread_.detach();
+        } else {
+            timer_thread_.join();
+        }
+    }
+}
+
+NetworkError AmbientRequesterClient::start() {
+    if (running_.load()) {
+        return NetworkError();
+    }
+    if (timer_thread_.joinable()) {
+        // Left behind by a stop() issued from one of our own callbacks.
+        if (timer_thread_.get_id() == std::this_thread::get_id()) {
+            return NetworkError(NetworkErrorCode::UNKNOWN_ERROR, "Cannot restart from a requester callback");
+        }
+        timer_thread_.join();
+    }
+    if (!pubsub_->isConnected()) {
+        auto err = pubsub_->connect();
+        if (err) {
+            return err;
+        }
+    }
+
+    SubscriptionOptions subOpts;
+    auto err = pubsub_->subscribe(kResultTopicPrefix + requester_id_,
+                                  [this](const Message& m) { handleTaskResult(m); },
+                                  subOpts, &result_subscription_id_);
+    if (err) {
+        return err;
+    }
+    err = pubsub_->subscribe(kWorkerAnnounceTopic,
+                             [this](const Message& m) { handleWorkerAnnouncement(m); },
+                             subOpts, &worker_announcement_subscription_id_);
+    if (err) {
+        pubsub_->unsubscribe(result_subscription_id_);
+        return err;
+    }
+
+    running_.store(true);
+    timer_thread_ = std::thread(&AmbientRequesterClient::timerLoop, this);
+    requestWorkerDiscovery();
+    return NetworkError();
+}
+
+void AmbientRequesterClient::stop() noexcept {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(timer_mutex_);
+    }
+    timer_cv_.notify_all();
+    // Callbacks run on the timer thread too; from there it cannot join
+    // itself, and it exits on its own once the callback returns.
+    if (timer_thread_.joinable() && timer_thread_.get_id() != std::this_thread::get_id()) {
+        timer_thread_.join();
+    }
+    pubsub_->unsubscribe(result_subscription_id_);
+    pubsub_->unsubscribe(worker_announcement_subscription_id_);
+
+    // Nothing will answer outstanding futures any more.
+    Outbox out;
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex_);
+        for (auto& [taskId, state] : tasks_) {
+            TaskResult result;
+            result.taskId = taskId;
+            result.status = TaskStatus::CANCELLED;
+            result.error = NetworkError(NetworkErrorCode::NODE_NOT_RUNNING, "Requester stopped");
+            finishLocked(*state, std::move(result), out);
+        }
+        pending_ = {};
+    }
+    try {
+        flush(out);
+    } catch (...) {
+    }
+}
+
+bool AmbientRequesterClient::isRunning() const {
+    return running_.load();
+}
+
+void AmbientRequesterClient::timerLoop() {
+    std::uint64_t lastDiscovery = steadyMs();
+    std::unique_lock<std::mutex> lock(timer_mutex_);
+    while (running_.load()) {
+        timer_cv_.wait_for(lock, std::chrono::milliseconds(kWheelTickMs),
+                           [&] { return !running_.load(); });
+        if (!running_.load()) {
+            break;
+        }
+        lock.unlock();
+        cleanupExpiredTasks();
+        const std::uint64_t now = steadyMs();
+        if (now - lastDiscovery >= toMs(options_.workerDiscoveryInterval)) {
+            requestWorkerDiscovery();
+            lastDiscovery = now;
+        }
+        lock.lock();
+    }
+}
+
+// ============================================================================
+// Submission
+// ============================================================================
+
+std::string AmbientRequesterClient::generateTaskId() {
+    return requester_id_ + "-" + std::to_string(task_counter_.fetch_add(1) + 1);
+}
+
+NetworkError AmbientRequesterClient::postTask(const TaskRequest& request) {
+    return submit(request, nullptr);
+}
+
+NetworkError AmbientRequesterClient::postTask(const std::vector<std::uint8_t>& payload,
+                                              std::string* outTaskId) {
+    TaskRequest request = createSimpleTask(payload);
+    request.taskId = generateTaskId();
+    request.timeout = options_.defaultTimeout;
+    request.maxRetries = options_.maxRetries;
+    if (outTaskId) {
+        *outTaskId = request.taskId;
+    }
+    return submit(std::move(request), nullptr);
+}
+
+std::future<TaskResult> AmbientRequesterClient::postTaskAsync(const TaskRequest& request) {
+    std::future<TaskResult> future;
+    auto err = submit(request, &future);
+    if (err) {
+        std::promise<TaskResult> failed;
+        TaskResult result;
+        result.taskId = request.taskId;
+        result.status = TaskStatus::FAILED;
+        result.error = err;
+        failed.set_value(std::move(result));
+        return failed.get_future();
+    }
+    return future;
+}
+
+NetworkError AmbientRequesterClient::submit(TaskRequest request, std::future<TaskResult>* outFuture) {
+    if (!running_.load()) {
+        return NetworkError(NetworkErrorCode::NODE_NOT_RUNNING, "Requester not started");
+    }
+    if (request.payload.empty()) {
+        return NetworkError(NetworkErrorCode::INVALID_DATA, "Task payload is empty");
+    }
+    if (request.taskId.empty()) {
+        request.taskId = generateTaskId();
+    }
+    if (request.timeout.count() <= 0) {
+        request.timeout = options_.defaultTimeout;
+    }
+
+    Outbox out;
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex_);
+        if (tasks_.count(request.taskId)) {
+            return NetworkError(NetworkErrorCode::TASK_REJECTED, "Duplicate task id: " + request.taskId);
+        }
+        auto state = std::make_shared<TaskState>(std::move(request));
+        state->seq = next_seq_++;
+        if (outFuture) {
+            *outFuture = state->promise.get_future();
+        }
+        const std::uint8_t priority = options_.enableTaskPriority ? state->request.priority : 0;
+        pending_.insert(PendingEntry{priority, state->seq, state->request.taskId});
+        tasks_.emplace(state->request.taskId, state);
+        ++active_count_;
+        out.progress.emplace_back(state->request.taskId, TaskStatus::PENDING);
+        fillSlotsLocked(out);
+    }
+    flush(out);
+    return NetworkError();
+}
+
+void AmbientRequesterClient::fillSlotsLocked(Outbox& out) {
+    while (in_flight_ < options_.maxConcurrentTasks && !pending_.empty()) {
+        auto top = std::prev(pending_.end());
+        auto it = tasks_.find(top->taskId);
+        pending_.erase(top);
+        if (it == tasks_.end() || isTerminal(it->second->status) || it->second->inFlight) {
+            continue;
+        }
+        TaskState& state = *it->second;
+        state.inFlight = true;
+        ++in_flight_;
+        dispatchLocked(state, out);
+    }
+}
+
+void AmbientRequesterClient::dispatchLocked(TaskState& state, Outbox& out) {
+    ++state.attempt;
+    if (state.submittedAt == 0) {
+        state.submittedAt = wallClockMs();
+    }
+    state.assignedWorker = selectWorker(state.request.requiredCapabilities);
+    state.status = state.assignedWorker ? TaskStatus::ASSIGNED : TaskStatus::SUBMITTED;
+
+    TaskEnvelope env;
+    env.taskId = state.request.taskId;
+    env.requesterId = requester_id_;
+    env.payload = state.request.payload;
+    env.timeoutMs = toMs(state.request.timeout);
+    env.attempt = state.attempt;
+    env.priority = state.request.priority;
+
+    // Without a suitable worker the task is offered to every worker; the
+    // first result for this attempt wins and later ones are ignored.
+    Message msg(state.assignedWorker ? kTaskTopicPrefix + *state.assignedWorker : kTaskBroadcastTopic,
+                encodeTask(env));
+    msg.senderId = requester_id_;
+    msg.timestamp = wallClockMs();
+    msg.correlationId = state.request.taskId;
+    out.messages.emplace_back(std::move(msg), state.request.priority);
+    out.progress.emplace_back(state.request.taskId, state.status);
+
+    wheel_->schedule(steadyMs(), env.timeoutMs, state.request.taskId, state.attempt,
+                     TimerWheel::Kind::DEADLINE);
+}
+
+bool AmbientRequesterClient::retryLocked(TaskState& state, Outbox& out) {
+    if (state.retryCount >= state.request.maxRetries) {
+        return false;
+    }
+    ++state.retryCount;
+    ++state.attempt;  // Results and deadlines of the abandoned attempt no longer match
+    state.status = TaskStatus::SUBMITTED;
+    state.assignedWorker.reset();
+    const std::uint64_t backoff =
+        std::min(kRetryBackoffMs << std::min<std::uint32_t>(state.retryCount - 1, 16), kMaxRetryBackoffMs);
+    wheel_->schedule(steadyMs(), backoff, state.request.taskId, state.attempt, TimerWheel::Kind::RETRY);
+    out.progress.emplace_back(state.request.taskId, state.status);
+    return true;
+}
+
+bool AmbientRequesterClient::finishLocked(TaskState& state, TaskResult result, Outbox& out) {
+    if (isTerminal(state.status)) {
+        return false;
+    }
+    result.taskId = state.request.taskId;
+    result.submittedAt = state.submittedAt;
+    result.completedAt = wallClockMs();
+    result.retryCount = state.retryCount;
+    if (!result.workerPeerId && state.assignedWorker) {
+        result.workerPeerId = state.assignedWorker;
+    }
+
+    if (state.attempt == 0) {
+        // Never dispatched, so it is still queued.
+        const std::uint8_t priority = options_.enableTaskPriority ? state.request.priority : 0;
+        pending_.erase(PendingEntry{priority, state.seq, state.request.taskId});
+    }
+    state.status = result.status;
+    state.result = result;
+    if (state.inFlight) {
+        state.inFlight = false;
+        --in_flight_;
+    }
+    --active_count_;
+    if (result.status == TaskStatus::COMPLETED) {
+        completed_count_.fetch_add(1);
+    } else if (result.status == TaskStatus::FAILED || result.status == TaskStatus::TIMEOUT) {
+        failed_count_.fetch_add(1);
+    }
+
+    state.promise.set_value(result);
+    state.cv->notify_all();
+    wheel_->schedule(steadyMs(), toMs(options_.resultRetention), state.request.taskId, state.attempt,
+                     TimerWheel::Kind::EXPIRE);
+    out.progress.emplace_back(state.request.taskId, result.status);
+    out.finished.push_back(std::move(result));
+    return true;
+}
+
+void AmbientRequesterClient::flush(Outbox& out) {
+    for (auto& [msg, priority] : out.messages) {
+        PublishOptions opts;
+        opts.priority = priority;
+        // A lost publish is recovered by the attempt deadline.
+        pubsub_->publish(msg, opts);
+    }
+    for (const auto& [taskId, status] : out.progress) {
+        emitProgress(taskId, status);
+    }
+    if (!out.finished.empty()) {
+        TaskCompletionCallback callback;
+        {
+            std::lock_guard<std::mutex> lock(callback_mutex_);
+            callback = completion_callback_;
+        }
+        if (callback) {
+            for (const auto& result : out.finished) {
+                callback(result);
+            }
+        }
+    }
+}
+
+// ============================================================================
+// Results and Timers
+// ============================================================================
+
+void AmbientRequesterClient::handleTaskResult(const Message& msg) {
+    std::vector<ResultEnvelope> results;
+    if (!decodeResults(msg.data, results)) {
+        return;
+    }
+
+    Outbox out;
+    std::vector<std::string> finishedWorkers;
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex_);
+        for (auto& res : results) {
+            auto it = tasks_.find(res.taskId);
+            if (it == tasks_.end()) {
+                continue;
+            }
+            TaskState& state = *it->second;
+            if (isTerminal(state.status) || res.attempt != state.attempt) {
+                continue;  // Duplicate, late or from an abandoned attempt
+            }
+            finishedWorkers.push_back(res.workerId);
+            if (!res.success && options_.autoRetryOnFailure && retryLocked(state, out)) {
+                continue;
+            }
+            TaskResult result;
+            result.status = res.success ? TaskStatus::COMPLETED : TaskStatus::FAILED;
+            result.result = std::move(res.result);
+            result.workerPeerId = res.workerId;
+            if (!res.success) {
+                result.error = NetworkError(NetworkErrorCode::TASK_REJECTED, res.error);
+            }
+            finishLocked(state, std::move(result), out);
+        }
+        fillSlotsLocked(out);
+    }
+
+    // The worker freed a slot; count it before its next heartbeat says so.
+    releaseWorkerSlots(finishedWorkers);
+    flush(out);
+}
+
+void AmbientRequesterClient::releaseWorkerSlots(const std::vector<std::string>& workerIds) {
+    if (workerIds.empty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(workers_mutex_);
+    for (const auto& workerId : workerIds) {
+        auto it = workers_.find(workerId);
+        if (it != workers_.end() && it->second.freeSlots < it->second.capabilities.maxConcurrentTasks) {
+            ++it->second.freeSlots;
+        }
+    }
+}
+
+void AmbientRequesterClient::cleanupExpiredTasks() {
+    Outbox out;
+    std::vector<std::string> abandonedWorkers;
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex_);
+        std::vector<TimerWheel::Timer> fired;
+        wheel_->advance(steadyMs(), fired);
+        for (const auto& timer : fired) {
+            auto it = tasks_.find(timer.taskId);
+            if (it == tasks_.end()) {
+                continue;
+            }
+            TaskState& state = *it->second;
+            switch (timer.kind) {
+            case TimerWheel::Kind::EXPIRE:
+                if (isTerminal(state.status) && timer.attempt == state.attempt) {
+                    tasks_.erase(it);
+                }
+                break;
+            case TimerWheel::Kind::DEADLINE:
+                if (isTerminal(state.status) || timer.attempt != state.attempt) {
+                    break;
+                }
+                // Otherwise the slot taken by selectWorker() stays gone until
+                // the worker's next heartbeat.
+                if (state.assignedWorker) {
+                    abandonedWorkers.push_back(*state.assignedWorker);
+                }
+                if (!retryLocked(state, out)) {
+                    TaskResult result;
+                    result.status = TaskStatus::TIMEOUT;
+                    result.error = NetworkError(NetworkErrorCode::TIMEOUT, "Task timed out");
+                    finishLocked(state, std::move(result), out);
+                }
+                break;
+            case TimerWheel::Kind::RETRY:
+                if (!isTerminal(state.status) && timer.attempt == state.attempt) {
+                    dispatchLocked(state, out);
+                }
+                break;
+            }
+        }
+        fillSlotsLocked(out);
+    }
+    releaseWorkerSlots(abandonedWorkers);
+    flush(out);
+}
+
+// ============================================================================
+// Task Management
+// ============================================================================
+
+bool AmbientRequesterClient::cancelTask(const std::string& taskId) {
+    Outbox out;
+    std::vector<std::string> abandonedWorkers;
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex_);
+        auto it = tasks_.find(taskId);
+        if (it == tasks_.end()) {
+            return false;
+        }
+        TaskState& state = *it->second;
+        const bool dispatched = state.attempt > 0;
+        const std::optional<std::string> worker = state.assignedWorker;
+        TaskResult result;
+        result.status = TaskStatus::CANCELLED;
+        if (!finishLocked(state, std::move(result), out)) {
+            return false;
+        }
+        if (worker) {
+            abandonedWorkers.push_back(*worker);
+        }
+        if (dispatched) {
+            Message msg(kTaskCancelTopic, encodeCancel(taskId));
+            msg.senderId = requester_id_;
+            msg.timestamp = wallClockMs();
+            out.messages.emplace_back(std::move(msg), std::numeric_limits<std::uint8_t>::max());
+        }
+        fillSlotsLocked(out);
+    }
+    releaseWorkerSlots(abandonedWorkers);
+    flush(out);
+    return true;
+}
+
+std::optional<TaskResult> AmbientRequesterClient::getTaskResult(const std::string& taskId) const {
+    std::lock_guard<std::mutex> lock(tasks_mutex_);
+    auto it = tasks_.find(taskId);
+    if (it == tasks_.end()) {
+        return std::nullopt;
+    }
+    return it->second->result;
+}
+
+TaskStatus AmbientRequesterClient::getTaskStatus(const std::string& taskId) const {
+    std::lock_guard<std::mutex> lock(tasks_mutex_);
+    auto it = tasks_.find(taskId);
+    return it != tasks_.end() ? it->second->status : TaskStatus::FAILED;
+}
+
+std::vector<std::string> AmbientRequesterClient::getActiveTasks() const {
+    std::vector<std::string> active;
+    std::lock_guard<std::mutex> lock(tasks_mutex_);
+    active.reserve(active_count_);
+    for (const auto& [taskId, state] : tasks_) {
+        if (!isTerminal(state->status)) {
+            active.push_back(taskId);
+        }
+    }
+    return active;
+}
+
+std::optional<TaskResult> AmbientRequesterClient::waitForResult(const std::string& taskId,
+                                                                std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(tasks_mutex_);
+    auto it = tasks_.find(taskId);
+    if (it == tasks_.end()) {
+        return std::nullopt;
+    }
+    auto state = it->second;  // Keeps the state alive if it expires while we wait
+    auto cv = state->cv;
+    cv->wait_for(lock, timeout, [&] { return isTerminal(state->status); });
+    return state->result;
+}
+
+// ============================================================================
+// Worker Discovery
+// ============================================================================
+
+void AmbientRequesterClient::indexWorker(const WorkerInfo& info, bool add) {
+    auto update = [&](std::unordered_map<std::string, std::unordered_set<std::string>>& index,
+                      const std::string& key) {
+        if (add) {
+            index[key].insert(info.peerId);
+            return;
+        }
+        auto it = index.find(key);
+        if (it != index.end()) {
+            it->second.erase(info.peerId);
+            if (it->second.empty()) {
+                index.erase(it);
+            }
+        }
+    };
+    update(workers_by_type_, info.capabilities.type);
+    update(workers_by_capacity_, info.capabilities.capacity);
+    for (const auto& format : info.capabilities.supportedFormats) {
+        update(workers_by_format_, format);
+    }
+}
+
+void AmbientRequesterClient::handleWorkerAnnouncement(const Message& msg) {
+    WorkerAnnouncement ann;
+    if (!decodeAnnouncement(msg.data, ann) || ann.peerId.empty()) {
+        return;
+    }
+
+    bool discovered = false;
+    {
+        std::lock_guard<std::mutex> lock(workers_mutex_);
+        auto it = workers_.find(ann.peerId);
+        if (it != workers_.end()) {
+            indexWorker(it->second, false);
+        }
+        if (ann.state == WorkerState::SHUTDOWN) {
+            if (it != workers_.end()) {
+                workers_.erase(it);
+            }
+            return;
+        }
+        if (it == workers_.end()) {
+            it = workers_.emplace(ann.peerId, WorkerInfo{}).first;
+            it->second.peerId = ann.peerId;
+            discovered = true;
+        }
+        WorkerInfo& info = it->second;
+        info.capabilities = ann.capabilities;
+        info.state = ann.state;
+        info.lastSeen = steadyMs();
+        info.freeSlots = ann.freeSlots;
+        indexWorker(info, true);
+    }
+
+    if (discovered) {
+        WorkerDiscoveryCallback callback;
+        {
+            std::lock_guard<std::mutex> lock(callback_mutex_);
+            callback = worker_discovery_callback_;
+        }
+        if (callback) {
+            callback(ann.peerId, ann.capabilities);
+        }
+    }
+}
+
+std::optional<std::string> AmbientRequesterClient::selectWorker(const WorkerCapabilities& required) {
+    std::lock_guard<std::mutex> lock(workers_mutex_);
+    const std::uint64_t now = steadyMs();
+    const std::uint64_t staleAfter = kWorkerStaleIntervals * toMs(options_.workerDiscoveryInterval);
+
+    // Every requirement names one index bucket; walk the smallest and probe
+    // the others by hash lookup.
+    std::vector<const std::unordered_set<std::string>*> buckets;
+    auto requireBucket = [&](const std::unordered_map<std::string, std::unordered_set<std::string>>& index,
+                             const std::string& key) {
+        auto it = index.find(key);
+        if (it == index.end()) {
+            return false;
+        }
+        buckets.push_back(&it->second);
+        return true;
+    };
+    if (!required.type.empty() && !requireBucket(workers_by_type_, required.type)) {
+        return std::nullopt;
+    }
+    if (!required.capacity.empty() && !requireBucket(workers_by_capacity_, required.capacity)) {
+        return std::nullopt;
+    }
+    for (const auto& format : required.supportedFormats) {
+        if (!requireBucket(workers_by_format_, format)) {
+            return std::nullopt;
+        }
+    }
+
+    WorkerInfo* best = nullptr;
+    auto consider = [&](const std::string& peerId, WorkerInfo& info) {
+        if (!info.isAvailable() || now - info.lastSeen > staleAfter) {
+            return;
+        }
+        for (const auto* bucket : buckets) {
+            if (!bucket->count(peerId)) {
+                return;
+            }
+        }
+        if (!best || info.freeSlots > best->freeSlots ||
+            (info.freeSlots == best->freeSlots && info.peerId < best->peerId)) {
+            best = &info;
+        }
+    };
+
+    if (buckets.empty()) {
+        for (auto& [peerId, info] : workers_) {
+            consider(peerId, info);
+        }
+    } else {
+        const auto* smallest = *std::min_element(buckets.begin(), buckets.end(),
+            [](const auto* a, const auto* b) { return a->size() < b->size(); });
+        for (const auto& peerId : *smallest) {
+            auto it = workers_.find(peerId);
+            if (it != workers_.end()) {
+                consider(peerId, it->second);
+            }
+        }
+    }
+
+    if (!best) {
+        return std::nullopt;
+    }
+    --best->freeSlots;
+    return best->peerId;
+}
+
+std::vector<std::string> AmbientRequesterClient::getAvailableWorkers() const {
+    std::vector<std::string> available;
+    {
+        std::lock_guard<std::mutex> lock(workers_mutex_);
+        const std::uint64_t now = steadyMs();
+        const std::uint64_t staleAfter = kWorkerStaleIntervals * toMs(options_.workerDiscoveryInterval);
+        for (const auto& [peerId, info] : workers_) {
+            if (info.isAvailable() && now - info.lastSeen <= staleAfter) {
+                available.push_back(peerId);
+            }
+        }
+    }
+    std::sort(available.begin(), available.end());
+    return available;
+}
+
+std::optional<WorkerCapabilities> AmbientRequesterClient::getWorkerCapabilities(const std::string& peerId) const {
+    std::lock_guard<std::mutex> lock(workers_mutex_);
+    auto it = workers_.find(peerId);
+    if (it == workers_.end()) {
+        return std::nullopt;
+    }
+    return it->second.capabilities;
+}
+
+void AmbientRequesterClient::requestWorkerDiscovery() {
+    if (!running_.load()) {
+        return;
+    }
+    Message msg(kWorkerDiscoverTopic,
+                std::vector<std::uint8_t>(requester_id_.begin(), requester_id_.end()));
+    msg.senderId = requester_id_;
+    msg.timestamp = wallClockMs();
+    pubsub_->publish(msg);
+}
+
+// ============================================================================
+// Callbacks and Statistics
+// ============================================================================
+
+void AmbientRequesterClient::setCompletionCallback(TaskCompletionCallback callback) {
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    completion_callback_ = std::move(callback);
+}
+
+void AmbientRequesterClient::setProgressCallback(TaskProgressCallback callback) {
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    progress_callback_ = std::move(callback);
+}
+
+void AmbientRequesterClient::setWorkerDiscoveryCallback(WorkerDiscoveryCallback callback) {
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    worker_discovery_callback_ = std::move(callback);
+}
+
+void AmbientRequesterClient::emitProgress(const std::string& taskId, TaskStatus status) {
+    TaskProgressCallback callback;
+    {
+        std::lock_guard<std::mutex> lock(callback_mutex_);
+        callback = progress_callback_;
+    }
+    if (callback) {
+        callback(taskId, status);
+    }
+}
+
+std::size_t AmbientRequesterClient::getPendingTaskCount() const {
+    std::lock_guard<std::mutex> lock(tasks_mutex_);
+    return active_count_;
+}
+
+std::size_t AmbientRequesterClient::getCompletedTaskCount() const {
+    return completed_count_.load();
+}
+
+std::size_t AmbientRequesterClient::getFailedTaskCount() const {
+    return failed_count_.load();
+}
+
+} // namespace ailee::net
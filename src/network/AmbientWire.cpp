@@ -0,0 +1,235 @@
+// SPDX-License-Identifier: MIT
+// AmbientWire.cpp — Binary encodings for requester/worker traffic
+
+#include "AmbientWire.h"
+
+namespace ailee::net {
+
+namespace {
+
+enum class WireKind : std::uint8_t {
+    TASK = 1,
+    RESULTS = 2,
+    ANNOUNCEMENT = 3,
+    CANCEL = 4
+};
+
+void writeUint8(std::vector<std::uint8_t>& buf, std::uint8_t val) {
+    buf.push_back(val);
+}
+
+void writeUint32(std::vector<std::uint8_t>& buf, std::uint32_t val) {
+    for (int i = 3; i >= 0; --i) {
+        buf.push_back(static_cast<std::uint8_t>((val >> (i * 8)) & 0xFF));
+    }
+}
+
+void writeUint64(std::vector<std::uint8_t>& buf, std::uint64_t val) {
+    for (int i = 7; i >= 0; --i) {
+        buf.push_back(static_cast<std::uint8_t>((val >> (i * 8)) & 0xFF));
+    }
+}
+
+void writeString(std::vector<std::uint8_t>& buf, const std::string& str) {
+    writeUint32(buf, static_cast<std::uint32_t>(str.size()));
+    buf.insert(buf.end(), str.begin(), str.end());
+}
+
+void writeBytes(std::vector<std::uint8_t>& buf, const std::vector<std::uint8_t>& bytes) {
+    writeUint32(buf, static_cast<std::uint32_t>(bytes.size()));
+    buf.insert(buf.end(), bytes.begin(), bytes.end());
+}
+
+class Reader {
+public:
+    explicit Reader(const std::vector<std::uint8_t>& data) : data_(data.data()), len_(data.size()) {}
+
+    bool readUint8(std::uint8_t& val) {
+        if (len_ < 1) return false;
+        val = data_[0];
+        advance(1);
+        return true;
+    }
+
+    bool readUint32(std::uint32_t& val) {
+        if (len_ < 4) return false;
+        val = 0;
+        for (int i = 0; i < 4; ++i) {
+            val = (val << 8) | data_[i];
+        }
+        advance(4);
+        return true;
+    }
+
+    bool readUint64(std::uint64_t& val) {
+        if (len_ < 8) return false;
+        val = 0;
+        for (int i = 0; i < 8; ++i) {
+            val = (val << 8) | data_[i];
+        }
+        advance(8);
+        return true;
+    }
+
+    bool readString(std::string& str) {
+        std::uint32_t n = 0;
+        if (!readUint32(n) || len_ < n) return false;
+        str.assign(reinterpret_cast<const char*>(data_), n);
+        advance(n);
+        return true;
+    }
+
+    bool readBytes(std::vector<std::uint8_t>& bytes) {
+        std::uint32_t n = 0;
+        if (!readUint32(n) || len_ < n) return false;
+        bytes.assign(data_, data_ + n);
+        advance(n);
+        return true;
+    }
+
+    bool expectKind(WireKind kind) {
+        std::uint8_t tag = 0;
+        return readUint8(tag) && tag == static_cast<std::uint8_t>(kind);
+    }
+
+    std::size_t remaining() const { return len_; }
+
+private:
+    void advance(std::size_t n) {
+        data_ += n;
+        len_ -= n;
+    }
+
+    const std::uint8_t* data_;
+    std::size_t len_;
+};
+
+} // namespace
+
+std::vector<std::uint8_t> encodeTask(const TaskEnvelope& task) {
+    std::vector<std::uint8_t> buf;
+    buf.reserve(32 + task.taskId.size() + task.requesterId.size() + task.payload.size());
+    writeUint8(buf, static_cast<std::uint8_t>(WireKind::TASK));
+    writeString(buf, task.taskId);
+    writeString(buf, task.requesterId);
+    writeBytes(buf, task.payload);
+    writeUint64(buf, task.timeoutMs);
+    writeUint32(buf, task.attempt);
+    writeUint8(buf, task.priority);
+    return buf;
+}
+
+bool decodeTask(const std::vector<std::uint8_t>& data, TaskEnvelope& out) {
+    Reader r(data);
+    return r.expectKind(WireKind::TASK) &&
+           r.readString(out.taskId) &&
+           r.readString(out.requesterId) &&
+           r.readBytes(out.payload) &&
+           r.readUint64(out.timeoutMs) &&
+           r.readUint32(out.attempt) &&
+           r.readUint8(out.priority);
+}
+
+std::vector<std::uint8_t> encodeResults(const std::vector<ResultEnvelope>& results) {
+    std::size_t size = 5;
+    for (const auto& res : results) {
+        size += 25 + res.taskId.size() + res.workerId.size() + res.result.size() + res.error.size();
+    }
+    std::vector<std::uint8_t> buf;
+    buf.reserve(size);
+    writeUint8(buf, static_cast<std::uint8_t>(WireKind::RESULTS));
+    writeUint32(buf, static_cast<std::uint32_t>(results.size()));
+    for (const auto& res : results) {
+        writeString(buf, res.taskId);
+        writeString(buf, res.workerId);
+        writeUint32(buf, res.attempt);
+        writeUint8(buf, res.success ? 1 : 0);
+        writeBytes(buf, res.result);
+        writeString(buf, res.error);
+    }
+    return buf;
+}
+
+bool decodeResults(const std::vector<std::uint8_t>& data, std::vector<ResultEnvelope>& out) {
+    Reader r(data);
+    std::uint32_t count = 0;
+    if (!r.expectKind(WireKind::RESULTS) || !r.readUint32(count)) {
+        return false;
+    }
+    // Every entry takes at least 21 bytes; reject counts the buffer cannot hold.
+    if (count > r.remaining() / 21) {
+        return false;
+    }
+    out.clear();
+    out.resize(count);
+    for (auto& res : out) {
+        std::uint8_t success = 0;
+        if (!r.readString(res.taskId) || !r.readString(res.workerId) ||
+            !r.readUint32(res.attempt) || !r.readUint8(success) ||
+            !r.readBytes(res.result) || !r.readString(res.error)) {
+            out.clear();
+            return false;
+        }
+        res.success = success != 0;
+    }
+    return true;
+}
+
+std::vector<std::uint8_t> encodeAnnouncement(const WorkerAnnouncement& announcement) {
+    const auto& caps = announcement.capabilities;
+    std::vector<std::uint8_t> buf;
+    writeUint8(buf, static_cast<std::uint8_t>(WireKind::ANNOUNCEMENT));
+    writeString(buf, announcement.peerId);
+    writeString(buf, caps.type);
+    writeString(buf, caps.capacity);
+    writeUint32(buf, caps.maxConcurrentTasks);
+    writeUint32(buf, static_cast<std::uint32_t>(caps.supportedFormats.size()));
+    for (const auto& format : caps.supportedFormats) {
+        writeString(buf, format);
+    }
+    writeUint8(buf, static_cast<std::uint8_t>(announcement.state));
+    writeUint32(buf, announcement.activeTasks);
+    writeUint32(buf, announcement.freeSlots);
+    writeUint64(buf, announcement.timestamp);
+    return buf;
+}
+
+bool decodeAnnouncement(const std::vector<std::uint8_t>& data, WorkerAnnouncement& out) {
+    Reader r(data);
+    auto& caps = out.capabilities;
+    std::uint32_t formats = 0;
+    if (!r.expectKind(WireKind::ANNOUNCEMENT) || !r.readString(out.peerId) ||
+        !r.readString(caps.type) || !r.readString(caps.capacity) ||
+        !r.readUint32(caps.maxConcurrentTasks) || !r.readUint32(formats) ||
+        formats > r.remaining() / 4) {
+        return false;
+    }
+    caps.supportedFormats.resize(formats);
+    for (auto& format : caps.supportedFormats) {
+        if (!r.readString(format)) {
+            return false;
+        }
+    }
+    std::uint8_t state = 0;
+    if (!r.readUint8(state) || state > static_cast<std::uint8_t>(WorkerState::SHUTDOWN)) {
+        return false;
+    }
+    out.state = static_cast<WorkerState>(state);
+    return r.readUint32(out.activeTasks) &&
+           r.readUint32(out.freeSlots) &&
+           r.readUint64(out.timestamp);
+}
+
+std::vector<std::uint8_t> encodeCancel(const std::string& taskId) {
+    std::vector<std::uint8_t> buf;
+    writeUint8(buf, static_cast<std::uint8_t>(WireKind::CANCEL));
+    writeString(buf, taskId);
+    return buf;
+}
+
+bool decodeCancel(const std::vector<std::uint8_t>& data, std::string& taskId) {
+    Reader r(data);
+    return r.expectKind(WireKind::CANCEL) && r.readString(taskId);
+}
+
+} // namespace ailee::net
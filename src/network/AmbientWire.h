@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: MIT
+// AmbientWire.h — Topics and binary encodings exchanged between
+// AmbientRequesterClient and AmbientWorkerNode over IPubSub.
+
+#pragma once
+
+#include "AmbientNode.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ailee::net {
+
+// Tasks directed at one worker go to kTaskTopicPrefix + peerId; tasks no
+// known worker can take go to kTaskBroadcastTopic. Results for a requester
+// go to kResultTopicPrefix + requesterId.
+constexpr const char* kTaskTopicPrefix = "ailee/ambient/task/";
+constexpr const char* kTaskBroadcastTopic = "ailee/ambient/broadcast/task";
+constexpr const char* kTaskCancelTopic = "ailee/ambient/cancel";
+constexpr const char* kResultTopicPrefix = "ailee/ambient/result/";
+constexpr const char* kWorkerAnnounceTopic = "ailee/ambient/worker/announce";
+constexpr const char* kWorkerDiscoverTopic = "ailee/ambient/worker/discover";
+
+struct TaskEnvelope {
+    std::string taskId;
+    std::string requesterId;
+    std::vector<std::uint8_t> payload;
+    std::uint64_t timeoutMs = 0;
+    std::uint32_t attempt = 0;
+    std::uint8_t priority = 0;
+};
+
+struct ResultEnvelope {
+    std::string taskId;
+    std::string workerId;
+    std::uint32_t attempt = 0;
+    bool success = false;
+    std::vector<std::uint8_t> result;
+    std::string error;
+};
+
+struct WorkerAnnouncement {
+    std::string peerId;
+    WorkerCapabilities capabilities;
+    WorkerState state = WorkerState::UNINITIALIZED;
+    std::uint32_t activeTasks = 0;
+    std::uint32_t freeSlots = 0;     // Tasks the worker can still start right now
+    std::uint64_t timestamp = 0;
+};
+
+// All encodings are big-endian, length-prefixed and start with a one-byte
+// kind tag, so a payload sent to the wrong decoder is rejected.
+std::vector<std::uint8_t> encodeTask(const TaskEnvelope& task);
+bool decodeTask(const std::vector<std::uint8_t>& data, TaskEnvelope& out);
+
+// Results travel in batches; a single result is a batch of one.
+std::vector<std::uint8_t> encodeResults(const std::vector<ResultEnvelope>& results);
+bool decodeResults(const std::vector<std::uint8_t>& data, std::vector<ResultEnvelope>& out);
+
+std::vector<std::uint8_t> encodeAnnouncement(const WorkerAnnouncement& announcement);
+bool decodeAnnouncement(const std::vector<std::uint8_t>& data, WorkerAnnouncement& out);
+
+std::vector<std::uint8_t> encodeCancel(const std::string& taskId);
+bool decodeCancel(const std::vector<std::uint8_t>& data, std::string& taskId);
+
+} // namespace ailee::net
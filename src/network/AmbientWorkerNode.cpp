@@ -0,0 +1,649 @@
+// SPDX-License-Identifier: MIT
+// AmbientWorkerNode.cpp — Bounded task executor behind IPubSub
+
+#include "AmbientNode.h"
+#include "AmbientWire.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+namespace ailee::net {
+
+namespace {
+
+constexpr auto kResultFlushInterval = std::chrono::milliseconds(5);
+constexpr auto kHeartbeatInterval = std::chrono::milliseconds(2000);
+constexpr std::size_t kMaxResultBatch = 64;
+
+std::uint64_t wallClockMs() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+} // namespace
+
+std::optional<WorkerCapabilities> WorkerCapabilities::parse(const std::string& str) {
+    WorkerCapabilities caps;
+    std::istringstream iss(str);
+    std::string field;
+    while (std::getline(iss, field, ',')) {
+        const auto eq = field.find('=');
+        if (eq == std::string::npos) {
+            return std::nullopt;
+        }
+        const std::string key = field.substr(0, eq);
+        const std::string value = field.substr(eq + 1);
+        if (key == "TYPE") {
+            caps.type = value;
+        } else if (key == "CAP") {
+            caps.capacity = value;
+        } else if (key == "MAX_TASKS") {
+            try {
+                caps.maxConcurrentTasks = static_cast<std::uint32_t>(std::stoul(value));
+            } catch (const std::exception&) {
+                return std::nullopt;
+            }
+        } else {
+            caps.customAttributes[key] = value;
+        }
+    }
+    if (!caps.isValid()) {
+        return std::nullopt;
+    }
+    return caps;
+}
+
+// Results waiting to be published, grouped by requester so each flush sends
+// one message per requester.
+struct AmbientWorkerNode::ResultOutbox {
+    std::mutex mu;
+    std::condition_variable cv;
+    std::unordered_map<std::string, std::vector<ResultEnvelope>> byRequester;
+    std::size_t queued = 0;
+    bool stopping = false;
+};
+
+// ============================================================================
+// Construction / Lifecycle
+// ============================================================================
+
+AmbientWorkerNode::AmbientWorkerNode(std::shared_ptr<IPubSub> pubsub,
+                                     const WorkerCapabilities& caps)
+    : pubsub_(std::move(pubsub))
+    , capabilities_(caps)
+    , outbox_(std::make_unique<ResultOutbox>()) {
+    if (!pubsub_) {
+        throw std::invalid_argument("AmbientWorkerNode requires a pubsub transport");
+    }
+    std::random_device rd;
+    std::uint64_t nonce = (static_cast<std::uint64_t>(rd()) << 32) | rd();
+    std::ostringstream oss;
+    oss << "worker-" << std::hex << std::setw(16) << std::setfill('0') << nonce;
+    worker_id_ = oss.str();
+}
+
+AmbientWorkerNode::~AmbientWorkerNode() {
+    stop();
+}
+
+NetworkError AmbientWorkerNode::start() {
+    std::lock_guard<std::mutex> lifecycle(state_mutex_);
+    if (isRunning()) {
+        return NetworkError();
+    }
+    WorkerCapabilities caps;
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex_);
+        caps = capabilities_;
+    }
+    if (!caps.isValid()) {
+        return NetworkError(NetworkErrorCode::INVALID_CAPABILITIES, "Invalid capabilities: " + caps.toString());
+    }
+    if (!pubsub_->isConnected()) {
+        auto err = pubsub_->connect();
+        if (err) {
+            return err;
+        }
+    }
+
+    SubscriptionOptions opts;
+    std::vector<SubscriptionId*> subscribed;
+    auto subscribe = [&](const std::string& topic, MessageHandler handler, SubscriptionId* id) {
+        auto err = pubsub_->subscribe(topic, std::move(handler), opts, id);
+        if (!err) {
+            subscribed.push_back(id);
+        }
+        return err;
+    };
+    NetworkError err = subscribe(kTaskTopicPrefix + worker_id_,
+                                 [this](const Message& m) { handleIncomingTask(m, true); },
+                                 &task_subscription_id_);
+    if (!err) {
+        err = subscribe(kTaskBroadcastTopic,
+                        [this](const Message& m) { handleIncomingTask(m, false); },
+                        &broadcast_subscription_id_);
+    }
+    if (!err) {
+        err = subscribe(kTaskCancelTopic, [this](const Message& m) { handleCancel(m); },
+                        &cancel_subscription_id_);
+    }
+    if (!err) {
+        err = subscribe(kWorkerDiscoverTopic, [this](const Message&) { sendHeartbeat(); },
+                        &discover_subscription_id_);
+    }
+    if (err) {
+        for (auto* id : subscribed) {
+            pubsub_->unsubscribe(*id);
+        }
+        return err;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex_);
+        stopping_ = false;
+        slots_ = caps.maxConcurrentTasks;
+    }
+    {
+        std::lock_guard<std::mutex> lock(outbox_->mu);
+        outbox_->stopping = false;
+    }
+    start_time_ = std::chrono::steady_clock::now();
+    executors_.reserve(slots_);
+    for (std::uint32_t i = 0; i < slots_; ++i) {
+        executors_.emplace_back(&AmbientWorkerNode::executorLoop, this);
+    }
+    reporter_ = std::thread(&AmbientWorkerNode::reporterLoop, this);
+
+    changeState(WorkerState::IDLE);
+    sendHeartbeat();
+    return NetworkError();
+}
+
+void AmbientWorkerNode::stop() noexcept {
+    std::lock_guard<std::mutex> lifecycle(state_mutex_);
+    if (!isRunning()) {
+        return;
+    }
+    pubsub_->unsubscribe(task_subscription_id_);
+    pubsub_->unsubscribe(broadcast_subscription_id_);
+    pubsub_->unsubscribe(cancel_subscription_id_);
+    pubsub_->unsubscribe(discover_subscription_id_);
+
+    // Tasks that never started are handed back; running ones finish and
+    // report normally.
+    std::vector<std::pair<std::string, ActiveTask>> abandoned;
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex_);
+        stopping_ = true;
+        for (const auto& taskId : ready_) {
+            auto it = active_tasks_.find(taskId);
+            if (it != active_tasks_.end()) {
+                abandoned.emplace_back(taskId, std::move(it->second));
+                active_tasks_.erase(it);
+            }
+        }
+        ready_.clear();
+    }
+    exec_cv_.notify_all();
+    for (auto& t : executors_) {
+        t.join();
+    }
+    executors_.clear();
+
+    for (auto& [taskId, task] : abandoned) {
+        queueResult(task.info.requesterPeerId, taskId, task.attempt, false, {}, "Worker stopped");
+    }
+    {
+        std::lock_guard<std::mutex> lock(outbox_->mu);
+        outbox_->stopping = true;
+    }
+    outbox_->cv.notify_all();
+    if (reporter_.joinable()) {
+        reporter_.join();
+    }
+
+    changeState(WorkerState::SHUTDOWN);
+    try {
+        sendHeartbeat();
+    } catch (...) {
+    }
+}
+
+void AmbientWorkerNode::pause() {
+    // Running tasks carry on and report; queued ones wait for resume().
+    WorkerState old = state_.load();
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex_);
+        while ((old == WorkerState::IDLE || old == WorkerState::WORKING) &&
+               !state_.compare_exchange_weak(old, WorkerState::PAUSED)) {
+        }
+    }
+    if (old == WorkerState::IDLE || old == WorkerState::WORKING) {
+        notifyStateChange(old, WorkerState::PAUSED);
+        sendHeartbeat();
+    }
+}
+
+void AmbientWorkerNode::resume() {
+    WorkerState expected = WorkerState::PAUSED;
+    WorkerState next;
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex_);
+        next = running_tasks_ > 0 ? WorkerState::WORKING : WorkerState::IDLE;
+        if (!state_.compare_exchange_strong(expected, next)) {
+            return;
+        }
+    }
+    notifyStateChange(WorkerState::PAUSED, next);
+    exec_cv_.notify_all();
+    sendHeartbeat();
+}
+
+// ============================================================================
+// Status
+// ============================================================================
+
+WorkerStatus AmbientWorkerNode::status() const {
+    WorkerStatus st;
+    st.state = state_.load();
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex_);
+        st.capabilities = capabilities_;
+        st.activeTasks = running_tasks_;
+        st.totalTasksProcessed = total_tasks_processed_;
+        st.totalTasksFailed = total_tasks_failed_;
+    }
+    st.uptime = getUptime();
+    st.lastHeartbeat = last_heartbeat_.load();
+    return st;
+}
+
+WorkerState AmbientWorkerNode::getState() const {
+    return state_.load();
+}
+
+bool AmbientWorkerNode::isRunning() const {
+    const WorkerState st = state_.load();
+    return st == WorkerState::IDLE || st == WorkerState::WORKING || st == WorkerState::PAUSED;
+}
+
+void AmbientWorkerNode::setCapabilities(const WorkerCapabilities& caps) {
+    // The executor pool keeps its size until the next start().
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex_);
+        capabilities_ = caps;
+    }
+    if (isRunning()) {
+        sendHeartbeat();
+    }
+}
+
+WorkerCapabilities AmbientWorkerNode::getCapabilities() const {
+    std::lock_guard<std::mutex> lock(tasks_mutex_);
+    return capabilities_;
+}
+
+std::chrono::milliseconds AmbientWorkerNode::getUptime() const {
+    if (!isRunning()) {
+        return std::chrono::milliseconds(0);
+    }
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start_time_);
+}
+
+std::uint32_t AmbientWorkerNode::freeSlotsLocked() const {
+    const std::uint32_t used = running_tasks_ + static_cast<std::uint32_t>(ready_.size());
+    return used < slots_ ? slots_ - used : 0;
+}
+
+void AmbientWorkerNode::sendHeartbeat() {
+    WorkerAnnouncement ann;
+    ann.peerId = worker_id_;
+    ann.state = state_.load();
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex_);
+        ann.capabilities = capabilities_;
+        ann.activeTasks = running_tasks_;
+        // Paused or stopping workers cannot start anything.
+        ann.freeSlots = (ann.state == WorkerState::IDLE || ann.state == WorkerState::WORKING) && !stopping_
+            ? freeSlotsLocked() : 0;
+    }
+    ann.timestamp = wallClockMs();
+    last_heartbeat_.store(ann.timestamp);
+
+    Message msg(kWorkerAnnounceTopic, encodeAnnouncement(ann));
+    msg.senderId = worker_id_;
+    msg.timestamp = ann.timestamp;
+    pubsub_->publish(msg);
+}
+
+// ============================================================================
+// Task Intake
+// ============================================================================
+
+void AmbientWorkerNode::handleIncomingTask(const Message& msg, bool directed) {
+    TaskEnvelope env;
+    if (!decodeTask(msg.data, env) || env.taskId.empty() || env.requesterId.empty()) {
+        emitError(NetworkErrorCode::SERIALIZATION_ERROR, "Malformed task on " + msg.topic);
+        return;
+    }
+
+    bool rejected = false;
+    bool saturated = false;
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex_);
+        if (stopping_ || !isRunning()) {
+            return;
+        }
+        auto it = active_tasks_.find(env.taskId);
+        if (it != active_tasks_.end()) {
+            // A re-dispatch of work we already hold: answer for the newest attempt.
+            it->second.attempt = std::max(it->second.attempt, env.attempt);
+            return;
+        }
+        const bool paused = state_.load() == WorkerState::PAUSED;
+        if (!directed && (paused || freeSlotsLocked() == 0)) {
+            return;  // Leave broadcast work to workers that can start it
+        }
+        // Directed work may wait in a backlog of one task per slot.
+        if (running_tasks_ + ready_.size() >= 2u * slots_) {
+            rejected = true;
+        } else {
+            ActiveTask task;
+            task.info.taskId = env.taskId;
+            task.info.requesterPeerId = env.requesterId;
+            task.info.payload = std::move(env.payload);
+            task.info.submittedAt = msg.timestamp != 0 ? msg.timestamp : wallClockMs();
+            task.attempt = env.attempt;
+            active_tasks_.emplace(env.taskId, std::move(task));
+            ready_.push_back(env.taskId);
+            saturated = freeSlotsLocked() == 0;
+        }
+    }
+
+    if (rejected) {
+        queueResult(env.requesterId, env.taskId, env.attempt, false, {}, "Worker saturated");
+        return;
+    }
+    exec_cv_.notify_one();
+    if (saturated) {
+        sendHeartbeat();
+    }
+}
+
+void AmbientWorkerNode::handleCancel(const Message& msg) {
+    std::string taskId;
+    if (decodeCancel(msg.data, taskId)) {
+        cancel(taskId, false);
+    }
+}
+
+bool AmbientWorkerNode::cancelTask(const std::string& taskId) {
+    return cancel(taskId, true);
+}
+
+bool AmbientWorkerNode::cancel(const std::string& taskId, bool report) {
+    ActiveTask dropped;
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex_);
+        auto it = active_tasks_.find(taskId);
+        if (it == active_tasks_.end() || it->second.cancelled) {
+            return false;
+        }
+        if (it->second.running) {
+            // The handler sees isCancelled() and its result is discarded.
+            it->second.cancelled = true;
+            it->second.reportCancel = report;
+            return true;
+        }
+        auto queued = std::find(ready_.begin(), ready_.end(), taskId);
+        if (queued != ready_.end()) {
+            ready_.erase(queued);
+        }
+        dropped = std::move(it->second);
+        active_tasks_.erase(it);
+    }
+    if (report) {
+        queueResult(dropped.info.requesterPeerId, taskId, dropped.attempt, false, {}, "Cancelled by worker");
+    }
+    return true;
+}
+
+bool AmbientWorkerNode::isCancelled(const std::string& taskId) const {
+    std::lock_guard<std::mutex> lock(tasks_mutex_);
+    auto it = active_tasks_.find(taskId);
+    return it == active_tasks_.end() || it->second.cancelled;
+}
+
+std::vector<TaskInfo> AmbientWorkerNode::getActiveTasks() const {
+    std::vector<TaskInfo> tasks;
+    std::lock_guard<std::mutex> lock(tasks_mutex_);
+    tasks.reserve(active_tasks_.size());
+    for (const auto& [taskId, task] : active_tasks_) {
+        (void)taskId;
+        tasks.push_back(task.info);
+    }
+    return tasks;
+}
+
+// ============================================================================
+// Execution
+// ============================================================================
+
+void AmbientWorkerNode::executorLoop() {
+    std::unique_lock<std::mutex> lock(tasks_mutex_);
+    for (;;) {
+        exec_cv_.wait(lock, [&] {
+            return stopping_ || (!ready_.empty() && state_.load() != WorkerState::PAUSED);
+        });
+        if (stopping_) {
+            return;
+        }
+        const std::string taskId = std::move(ready_.front());
+        ready_.pop_front();
+        auto it = active_tasks_.find(taskId);
+        if (it == active_tasks_.end()) {
+            continue;
+        }
+        it->second.running = true;
+        it->second.info.startedAt = wallClockMs();
+        // Entries are only erased by reportTaskResult once the handler is
+        // done, so this reference stays valid while unlocked.
+        const TaskInfo& info = it->second.info;
+        // State moves with running_tasks_ under tasks_mutex_; callbacks run unlocked.
+        WorkerState expected = WorkerState::IDLE;
+        const bool nowWorking = ++running_tasks_ == 1 &&
+                                state_.compare_exchange_strong(expected, WorkerState::WORKING);
+        lock.unlock();
+        if (nowWorking) {
+            notifyStateChange(WorkerState::IDLE, WorkerState::WORKING);
+        }
+
+        processTask(info);
+
+        lock.lock();
+        expected = WorkerState::WORKING;
+        if (--running_tasks_ == 0 && state_.compare_exchange_strong(expected, WorkerState::IDLE)) {
+            lock.unlock();
+            notifyStateChange(WorkerState::WORKING, WorkerState::IDLE);
+            lock.lock();
+        }
+    }
+}
+
+void AmbientWorkerNode::processTask(const TaskInfo& taskInfo) {
+    TaskHandler handler;
+    {
+        std::lock_guard<std::mutex> lock(callback_mutex_);
+        handler = task_handler_;
+    }
+    std::vector<std::uint8_t> result;
+    bool ok = false;
+    if (!handler) {
+        emitError(NetworkErrorCode::TASK_REJECTED, "No task handler set");
+    } else {
+        try {
+            ok = handler(taskInfo, &result);
+        } catch (const std::exception& e) {
+            emitError(NetworkErrorCode::UNKNOWN_ERROR, "Task " + taskInfo.taskId + " threw: " + e.what());
+        } catch (...) {
+            emitError(NetworkErrorCode::UNKNOWN_ERROR, "Task " + taskInfo.taskId + " threw");
+        }
+    }
+    reportTaskResult(taskInfo.taskId, ok, result);
+}
+
+void AmbientWorkerNode::reportTaskResult(const std::string& taskId, bool success,
+                                         const std::vector<std::uint8_t>& result) {
+    ActiveTask task;
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex_);
+        auto it = active_tasks_.find(taskId);
+        if (it == active_tasks_.end()) {
+            return;
+        }
+        task = std::move(it->second);
+        active_tasks_.erase(it);
+        if (success && !task.cancelled) {
+            ++total_tasks_processed_;
+        } else {
+            ++total_tasks_failed_;
+        }
+    }
+    // `taskId` may alias the entry just moved from; use the moved copy.
+    const std::string& id = task.info.taskId;
+    if (task.cancelled) {
+        if (task.reportCancel) {
+            queueResult(task.info.requesterPeerId, id, task.attempt, false, {}, "Cancelled by worker");
+        }
+        return;
+    }
+    queueResult(task.info.requesterPeerId, id, task.attempt, success, result,
+                success ? std::string() : std::string("Task handler failed"));
+}
+
+// ============================================================================
+// Result Batching
+// ============================================================================
+
+void AmbientWorkerNode::queueResult(const std::string& requesterId, const std::string& taskId,
+                                    std::uint32_t attempt, bool success,
+                                    std::vector<std::uint8_t> result, std::string error) {
+    ResultEnvelope res;
+    res.taskId = taskId;
+    res.workerId = worker_id_;
+    res.attempt = attempt;
+    res.success = success;
+    res.result = std::move(result);
+    res.error = std::move(error);
+
+    bool full = false;
+    {
+        std::lock_guard<std::mutex> lock(outbox_->mu);
+        auto& batch = outbox_->byRequester[requesterId];
+        batch.push_back(std::move(res));
+        ++outbox_->queued;
+        full = batch.size() >= kMaxResultBatch;
+    }
+    if (full) {
+        outbox_->cv.notify_one();
+    }
+}
+
+void AmbientWorkerNode::flushResults() {
+    std::unordered_map<std::string, std::vector<ResultEnvelope>> batches;
+    {
+        std::lock_guard<std::mutex> lock(outbox_->mu);
+        if (outbox_->queued == 0) {
+            return;
+        }
+        batches.swap(outbox_->byRequester);
+        outbox_->queued = 0;
+    }
+    for (const auto& [requesterId, results] : batches) {
+        for (std::size_t i = 0; i < results.size(); i += kMaxResultBatch) {
+            const auto end = results.begin() + std::min(results.size(), i + kMaxResultBatch);
+            Message msg(kResultTopicPrefix + requesterId,
+                        encodeResults(std::vector<ResultEnvelope>(results.begin() + i, end)));
+            msg.senderId = worker_id_;
+            msg.timestamp = wallClockMs();
+            auto err = pubsub_->publish(msg);
+            if (err) {
+                emitError(err.code, "Result publish failed: " + err.message);
+            }
+        }
+    }
+}
+
+void AmbientWorkerNode::reporterLoop() {
+    auto nextHeartbeat = std::chrono::steady_clock::now() + kHeartbeatInterval;
+    for (;;) {
+        bool stopping = false;
+        {
+            std::unique_lock<std::mutex> lock(outbox_->mu);
+            outbox_->cv.wait_for(lock, kResultFlushInterval, [&] { return outbox_->stopping; });
+            stopping = outbox_->stopping;
+        }
+        flushResults();
+        if (stopping) {
+            return;
+        }
+        if (std::chrono::steady_clock::now() >= nextHeartbeat) {
+            sendHeartbeat();
+            nextHeartbeat += kHeartbeatInterval;
+        }
+    }
+}
+
+// ============================================================================
+// Callbacks
+// ============================================================================
+
+void AmbientWorkerNode::changeState(WorkerState newState) {
+    const WorkerState oldState = state_.exchange(newState);
+    if (oldState != newState) {
+        notifyStateChange(oldState, newState);
+    }
+}
+
+void AmbientWorkerNode::notifyStateChange(WorkerState oldState, WorkerState newState) {
+    StatusChangeCallback callback;
+    {
+        std::lock_guard<std::mutex> lock(callback_mutex_);
+        callback = status_callback_;
+    }
+    if (callback) {
+        callback(oldState, newState);
+    }
+}
+
+void AmbientWorkerNode::setTaskHandler(TaskHandler handler) {
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    task_handler_ = std::move(handler);
+}
+
+void AmbientWorkerNode::setStatusChangeCallback(StatusChangeCallback callback) {
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    status_callback_ = std::move(callback);
+}
+
+void AmbientWorkerNode::setErrorCallback(ErrorCallback callback) {
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    error_callback_ = std::move(callback);
+}
+
+void AmbientWorkerNode::emitError(NetworkErrorCode code, const std::string& message) {
+    ErrorCallback callback;
+    {
+        std::lock_guard<std::mutex> lock(callback_mutex_);
+        callback = error_callback_;
+    }
+    if (callback) {
+        callback(NetworkError(code, message));
+    }
+}
+
+} // namespace ailee::net
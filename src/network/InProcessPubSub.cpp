@@ -0,0 +1,767 @@
+// SPDX-License-Identifier: MIT
+// InProcessPubSub.cpp — Topic-trie broker with bounded priority queues and a
+// dispatcher pool.
+
+#include "InProcessPubSub.h"
+
+#include <algorithm>
+
+namespace ailee::net {
+
+namespace {
+
+bool isSingleWildcard(const std::string& level) {
+    return level == "+" || level == "*";
+}
+
+bool isMultiWildcard(const std::string& level) {
+    return level == "#";
+}
+
+// The broker and subscription whose handler the current thread is running.
+thread_local const void* t_handlerBroker = nullptr;
+thread_local void* t_handlerSub = nullptr;
+
+} // namespace
+
+// Outstanding deliveries of one acknowledged publish.
+struct InProcessPubSub::AckState {
+    std::mutex mu;
+    std::condition_variable cv;
+    std::size_t remaining;
+    std::size_t failed = 0;
+
+    explicit AckState(std::size_t n) : remaining(n) {}
+
+    void resolve(bool ok) {
+        std::lock_guard<std::mutex> lock(mu);
+        if (!ok) {
+            ++failed;
+        }
+        if (--remaining == 0) {
+            cv.notify_all();
+        }
+    }
+};
+
+struct InProcessPubSub::Subscription {
+    SubscriptionId id = 0;
+    std::string topic;      // Key reported by getSubscribedTopics / unsubscribe(topic)
+    std::string matchKey;   // Exact topic or filter pattern
+    bool isPattern = false;
+    MessageHandler handler;
+    SubscriptionOptions opts;
+
+    std::mutex mu;
+    std::condition_variable space_cv;
+    std::condition_variable idle_cv;
+    std::deque<Envelope> lanes[kPriorityLanes];
+    std::size_t queued = 0;
+    bool scheduled = false;  // In the ready queue or being drained
+    bool active = true;
+    bool in_handler = false;
+    std::thread::id handler_thread;
+    // Set while this subscription's handler is blocked in retire() on
+    // another subscription; guarded by wait_graph_mutex_.
+    Subscription* waiting_on = nullptr;
+};
+
+struct InProcessPubSub::TrieNode {
+    std::unordered_map<std::string, std::unique_ptr<TrieNode>> children;
+    std::unique_ptr<TrieNode> single;   // '+' / '*'
+    std::unique_ptr<TrieNode> multi;    // '#', terminal
+    std::vector<std::shared_ptr<Subscription>> subs;
+
+    bool empty() const {
+        return children.empty() && !single && !multi && subs.empty();
+    }
+};
+
+InProcessPubSub::InProcessPubSub(const InProcessPubSubConfig& config)
+    : config_(config), root_(std::make_unique<TrieNode>()) {
+    if (config_.dispatcherThreads == 0) {
+        config_.dispatcherThreads = 1;
+    }
+    if (config_.queueCapacity == 0) {
+        config_.queueCapacity = 1;
+    }
+    if (config_.dispatchBatch == 0) {
+        config_.dispatchBatch = 1;
+    }
+}
+
+InProcessPubSub::~InProcessPubSub() {
+    disconnect();
+    std::lock_guard<std::mutex> lifecycle(lifecycle_mutex_);
+    joinRetiredDispatchers();
+    for (auto& t : retired_dispatchers_) {
+        t.detach();  // Only reachable when a handler destroys its own broker
+    }
+}
+
+// ============================================================================
+// Topics
+// ============================================================================
+
+std::vector<std::string> InProcessPubSub::splitLevels(const std::string& topic) {
+    std::vector<std::string> levels;
+    std::size_t start = 0;
+    for (;;) {
+        const std::size_t slash = topic.find('/', start);
+        if (slash == std::string::npos) {
+            levels.emplace_back(topic, start);
+            return levels;
+        }
+        levels.emplace_back(topic, start, slash - start);
+        start = slash + 1;
+    }
+}
+
+bool InProcessPubSub::validTopic(const std::string& topic) {
+    if (topic.empty()) {
+        return false;
+    }
+    for (const auto& level : splitLevels(topic)) {
+        if (isSingleWildcard(level) || isMultiWildcard(level)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool InProcessPubSub::validPattern(const std::string& pattern) {
+    if (pattern.empty()) {
+        return false;
+    }
+    const auto levels = splitLevels(pattern);
+    for (std::size_t i = 0; i + 1 < levels.size(); ++i) {
+        if (isMultiWildcard(levels[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool InProcessPubSub::topicMatches(const std::string& pattern, const std::string& topic) {
+    const auto p = splitLevels(pattern);
+    const auto t = splitLevels(topic);
+    std::size_t i = 0;
+    for (; i < p.size(); ++i) {
+        if (isMultiWildcard(p[i])) {
+            return i + 1 == p.size();
+        }
+        if (i >= t.size() || (!isSingleWildcard(p[i]) && p[i] != t[i])) {
+            return false;
+        }
+    }
+    return i == t.size();
+}
+
+void InProcessPubSub::collectMatches(const std::string& topic,
+                                     std::vector<std::shared_ptr<Subscription>>& out) const {
+    // Each subscription sits on exactly one trie node and a topic reaches a
+    // node along at most one path, so no deduplication is needed.
+    struct Walker {
+        const std::vector<std::string>& levels;
+        std::vector<std::shared_ptr<Subscription>>& out;
+
+        void walk(const TrieNode& node, std::size_t i) {
+            if (node.multi) {
+                out.insert(out.end(), node.multi->subs.begin(), node.multi->subs.end());
+            }
+            if (i == levels.size()) {
+                out.insert(out.end(), node.subs.begin(), node.subs.end());
+                return;
+            }
+            auto it = node.children.find(levels[i]);
+            if (it != node.children.end()) {
+                walk(*it->second, i + 1);
+            }
+            if (node.single) {
+                walk(*node.single, i + 1);
+            }
+        }
+    };
+
+    const auto levels = splitLevels(topic);
+    Walker{levels, out}.walk(*root_, 0);
+}
+
+// ============================================================================
+// Subscriptions
+// ============================================================================
+
+NetworkError InProcessPubSub::subscribe(const std::string& topic, MessageHandler handler) {
+    return addSubscription(topic, std::move(handler), SubscriptionOptions{}, nullptr, true);
+}
+
+NetworkError InProcessPubSub::subscribe(const std::string& topic, MessageHandler handler,
+                                        const SubscriptionOptions& opts, SubscriptionId* outId) {
+    return addSubscription(topic, std::move(handler), opts, outId, false);
+}
+
+NetworkError InProcessPubSub::addSubscription(const std::string& topic, MessageHandler handler,
+                                              const SubscriptionOptions& opts, SubscriptionId* outId,
+                                              bool rejectDuplicate) {
+    if (!handler) {
+        return NetworkError(NetworkErrorCode::SUBSCRIPTION_FAILED, "Handler is empty");
+    }
+    auto sub = std::make_shared<Subscription>();
+    sub->topic = topic;
+    sub->handler = std::move(handler);
+    sub->opts = opts;
+    if (opts.filterPattern) {
+        if (topic.empty() || !validPattern(*opts.filterPattern)) {
+            return NetworkError(NetworkErrorCode::INVALID_TOPIC,
+                                "Invalid filter pattern: " + *opts.filterPattern);
+        }
+        sub->matchKey = *opts.filterPattern;
+        sub->isPattern = true;
+    } else {
+        if (!validTopic(topic)) {
+            return NetworkError(NetworkErrorCode::INVALID_TOPIC, "Invalid topic: " + topic);
+        }
+        sub->matchKey = topic;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(subs_mutex_);
+    if (rejectDuplicate) {
+        for (const auto& [id, existing] : subs_) {
+            (void)id;
+            if (existing->topic == topic) {
+                return NetworkError(NetworkErrorCode::ALREADY_SUBSCRIBED, "Already subscribed: " + topic);
+            }
+        }
+    }
+
+    // Exact subscriptions take every level literally; only patterns branch
+    // into the wildcard children.
+    TrieNode* node = root_.get();
+    for (const auto& level : splitLevels(sub->matchKey)) {
+        std::unique_ptr<TrieNode>* next;
+        if (sub->isPattern && isMultiWildcard(level)) {
+            next = &node->multi;
+        } else if (sub->isPattern && isSingleWildcard(level)) {
+            next = &node->single;
+        } else {
+            next = &node->children[level];
+        }
+        if (!*next) {
+            *next = std::make_unique<TrieNode>();
+        }
+        node = next->get();
+    }
+    node->subs.push_back(sub);
+
+    sub->id = next_id_++;
+    subs_.emplace(sub->id, sub);
+    if (outId) {
+        *outId = sub->id;
+    }
+    return NetworkError();
+}
+
+void InProcessPubSub::removeSubscription(const std::shared_ptr<Subscription>& sub) {
+    // Caller holds subs_mutex_ exclusively.
+    const auto levels = splitLevels(sub->matchKey);
+
+    struct Remover {
+        const Subscription& sub;
+        const std::vector<std::string>& levels;
+
+        // Returns true if `slot` became empty and was released.
+        bool remove(std::unique_ptr<TrieNode>& slot, std::size_t i) {
+            if (!slot) {
+                return false;
+            }
+            TrieNode& node = *slot;
+            if (i == levels.size()) {
+                auto it = std::find_if(node.subs.begin(), node.subs.end(),
+                                       [&](const auto& s) { return s.get() == &sub; });
+                if (it != node.subs.end()) {
+                    node.subs.erase(it);
+                }
+            } else {
+                const std::string& level = levels[i];
+                if (sub.isPattern && isMultiWildcard(level)) {
+                    remove(node.multi, i + 1);
+                } else if (sub.isPattern && isSingleWildcard(level)) {
+                    remove(node.single, i + 1);
+                } else {
+                    auto it = node.children.find(level);
+                    if (it != node.children.end() && remove(it->second, i + 1)) {
+                        node.children.erase(it);
+                    }
+                }
+            }
+            if (node.empty()) {
+                slot.reset();
+                return true;
+            }
+            return false;
+        }
+    };
+
+    Remover{*sub, levels}.remove(root_, 0);
+    if (!root_) {
+        root_ = std::make_unique<TrieNode>();
+    }
+    subs_.erase(sub->id);
+}
+
+void InProcessPubSub::discardQueued(Subscription& sub) {
+    std::vector<std::shared_ptr<AckState>> acks;
+    {
+        std::lock_guard<std::mutex> lock(sub.mu);
+        for (auto& lane : sub.lanes) {
+            for (auto& env : lane) {
+                if (env.ack) {
+                    acks.push_back(std::move(env.ack));
+                }
+            }
+            dropped_.fetch_add(lane.size(), std::memory_order_relaxed);
+            lane.clear();
+        }
+        sub.queued = 0;
+        sub.scheduled = false;
+    }
+    sub.space_cv.notify_all();
+    for (auto& ack : acks) {
+        ack->resolve(false);
+    }
+}
+
+void InProcessPubSub::retire(Subscription& sub) {
+    // The subscription whose handler is making this call, if any.
+    Subscription* self = t_handlerBroker == this ? static_cast<Subscription*>(t_handlerSub) : nullptr;
+    {
+        // Once this returns the handler is not running and never will again,
+        // so its owner may be destroyed. A handler unsubscribing itself
+        // cannot wait for its own return.
+        std::unique_lock<std::mutex> lock(sub.mu);
+        sub.active = false;
+        bool wait = sub.in_handler && sub.handler_thread != std::this_thread::get_id();
+        if (wait && self) {
+            // Follow the chain of handlers blocked in retire(); if it leads
+            // back to us, waiting would deadlock, so this call gives way.
+            std::lock_guard<std::mutex> graph(wait_graph_mutex_);
+            for (const Subscription* s = &sub; s; s = s->waiting_on) {
+                if (s == self) {
+                    wait = false;
+                    break;
+                }
+            }
+            if (wait) {
+                self->waiting_on = &sub;
+            }
+        }
+        if (wait) {
+            sub.idle_cv.wait(lock, [&] { return !sub.in_handler; });
+            if (self) {
+                std::lock_guard<std::mutex> graph(wait_graph_mutex_);
+                self->waiting_on = nullptr;
+            }
+        }
+    }
+    discardQueued(sub);
+}
+
+NetworkError InProcessPubSub::unsubscribe(const std::string& topic) {
+    std::vector<std::shared_ptr<Subscription>> removed;
+    {
+        std::unique_lock<std::shared_mutex> lock(subs_mutex_);
+        for (const auto& [id, sub] : subs_) {
+            (void)id;
+            if (sub->topic == topic) {
+                removed.push_back(sub);
+            }
+        }
+        for (const auto& sub : removed) {
+            removeSubscription(sub);
+        }
+    }
+    if (removed.empty()) {
+        return NetworkError(NetworkErrorCode::INVALID_TOPIC, "Not subscribed: " + topic);
+    }
+    for (const auto& sub : removed) {
+        retire(*sub);
+    }
+    return NetworkError();
+}
+
+NetworkError InProcessPubSub::unsubscribe(SubscriptionId id) {
+    std::shared_ptr<Subscription> sub;
+    {
+        std::unique_lock<std::shared_mutex> lock(subs_mutex_);
+        auto it = subs_.find(id);
+        if (it == subs_.end()) {
+            return NetworkError(NetworkErrorCode::INVALID_TOPIC,
+                                "Unknown subscription: " + std::to_string(id));
+        }
+        sub = it->second;
+        removeSubscription(sub);
+    }
+    retire(*sub);
+    return NetworkError();
+}
+
+std::vector<std::string> InProcessPubSub::getSubscribedTopics() const {
+    std::vector<std::string> topics;
+    {
+        std::shared_lock<std::shared_mutex> lock(subs_mutex_);
+        topics.reserve(subs_.size());
+        for (const auto& [id, sub] : subs_) {
+            (void)id;
+            topics.push_back(sub->topic);
+        }
+    }
+    std::sort(topics.begin(), topics.end());
+    topics.erase(std::unique(topics.begin(), topics.end()), topics.end());
+    return topics;
+}
+
+std::size_t InProcessPubSub::getSubscriptionCount() const {
+    std::shared_lock<std::shared_mutex> lock(subs_mutex_);
+    return subs_.size();
+}
+
+// ============================================================================
+// Publishing
+// ============================================================================
+
+NetworkError InProcessPubSub::publish(const Message& m) {
+    PublishOptions opts;
+    opts.timeout = config_.defaultBlockTimeout;
+    return publish(m, opts);
+}
+
+NetworkError InProcessPubSub::publish(const Message& m, const PublishOptions& opts) {
+    if (!connected_.load(std::memory_order_acquire)) {
+        return NetworkError(NetworkErrorCode::NOT_CONNECTED, "Broker not connected");
+    }
+    if (!validTopic(m.topic)) {
+        return NetworkError(NetworkErrorCode::INVALID_TOPIC, "Invalid topic: " + m.topic);
+    }
+    if (!m.isValid()) {
+        return NetworkError(NetworkErrorCode::INVALID_DATA, "Message has no payload");
+    }
+    published_.fetch_add(1, std::memory_order_relaxed);
+
+    std::vector<std::shared_ptr<Subscription>> targets;
+    {
+        std::shared_lock<std::shared_mutex> lock(subs_mutex_);
+        collectMatches(m.topic, targets);
+    }
+    if (targets.empty()) {
+        if (opts.requireAck) {
+            return NetworkError(NetworkErrorCode::PUBLISH_FAILED, "No subscribers for " + m.topic);
+        }
+        return NetworkError();
+    }
+
+    // One immutable copy is shared by every subscriber's queue.
+    auto message = std::make_shared<const Message>(m);
+    auto ack = opts.requireAck ? std::make_shared<AckState>(targets.size()) : nullptr;
+    const std::size_t lane = std::min<std::size_t>(opts.priority, kPriorityLanes - 1);
+    const auto deadline = std::chrono::steady_clock::now() + opts.timeout;
+
+    std::size_t accepted = 0;
+    for (const auto& sub : targets) {
+        if (enqueue(sub, Envelope{message, ack}, lane, deadline)) {
+            ++accepted;
+        } else if (ack) {
+            ack->resolve(false);
+        }
+    }
+
+    if (ack) {
+        std::unique_lock<std::mutex> lock(ack->mu);
+        if (!ack->cv.wait_until(lock, deadline, [&] { return ack->remaining == 0; })) {
+            return NetworkError(NetworkErrorCode::TIMEOUT,
+                                std::to_string(ack->remaining) + " of " +
+                                std::to_string(targets.size()) + " subscribers did not acknowledge");
+        }
+        if (ack->failed > 0) {
+            return NetworkError(NetworkErrorCode::PUBLISH_FAILED,
+                                std::to_string(ack->failed) + " of " +
+                                std::to_string(targets.size()) + " subscribers failed");
+        }
+        return NetworkError();
+    }
+    if (accepted == 0) {
+        return NetworkError(NetworkErrorCode::PUBLISH_FAILED, "All subscriber queues full");
+    }
+    return NetworkError();
+}
+
+bool InProcessPubSub::enqueue(const std::shared_ptr<Subscription>& sub, Envelope env, std::size_t lane,
+                              std::chrono::steady_clock::time_point deadline) {
+    std::shared_ptr<AckState> evicted;
+    bool wake = false;
+    {
+        std::unique_lock<std::mutex> lock(sub->mu);
+        if (sub->queued >= config_.queueCapacity && sub->active) {
+            switch (config_.overflowPolicy) {
+            case OverflowPolicy::DROP_NEWEST:
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            case OverflowPolicy::DROP_OLDEST:
+                for (auto& queue : sub->lanes) {
+                    if (!queue.empty()) {
+                        evicted = std::move(queue.front().ack);
+                        queue.pop_front();
+                        --sub->queued;
+                        break;
+                    }
+                }
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                break;
+            case OverflowPolicy::BLOCK:
+                if (!sub->space_cv.wait_until(lock, deadline, [&] {
+                        return sub->queued < config_.queueCapacity || !sub->active;
+                    })) {
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                break;
+            }
+        }
+        if (!sub->active) {
+            return false;
+        }
+        sub->lanes[lane].push_back(std::move(env));
+        ++sub->queued;
+        if (!sub->scheduled) {
+            sub->scheduled = true;
+            wake = true;
+        }
+    }
+    enqueued_.fetch_add(1, std::memory_order_relaxed);
+    if (evicted) {
+        evicted->resolve(false);
+    }
+    if (wake) {
+        schedule(sub);
+    }
+    return true;
+}
+
+// ============================================================================
+// Dispatch
+// ============================================================================
+
+void InProcessPubSub::schedule(const std::shared_ptr<Subscription>& sub) {
+    {
+        std::lock_guard<std::mutex> lock(ready_mutex_);
+        ready_.push_back(sub);
+    }
+    ready_cv_.notify_one();
+}
+
+void InProcessPubSub::dispatchLoop(std::uint64_t generation) {
+    for (;;) {
+        std::shared_ptr<Subscription> sub;
+        {
+            std::unique_lock<std::mutex> lock(ready_mutex_);
+            ready_cv_.wait(lock, [&] {
+                return stopping_ || generation_ != generation || !ready_.empty();
+            });
+            if (stopping_ || generation_ != generation) {
+                return;
+            }
+            sub = std::move(ready_.front());
+            ready_.pop_front();
+        }
+        drain(sub);
+    }
+}
+
+void InProcessPubSub::drain(const std::shared_ptr<Subscription>& sub) {
+    for (std::size_t n = 0; n < config_.dispatchBatch; ++n) {
+        Envelope env;
+        {
+            std::lock_guard<std::mutex> lock(sub->mu);
+            if (!sub->active || sub->queued == 0) {
+                sub->scheduled = false;
+                return;
+            }
+            for (std::size_t lane = kPriorityLanes; lane-- > 0;) {
+                if (!sub->lanes[lane].empty()) {
+                    env = std::move(sub->lanes[lane].front());
+                    sub->lanes[lane].pop_front();
+                    break;
+                }
+            }
+            --sub->queued;
+            sub->in_handler = true;
+            sub->handler_thread = std::this_thread::get_id();
+        }
+        sub->space_cv.notify_one();
+
+        const std::uint32_t attempts = sub->opts.allowRedelivery ? sub->opts.maxRetries + 1 : 1;
+        bool ok = false;
+        t_handlerBroker = this;
+        t_handlerSub = sub.get();
+        for (std::uint32_t attempt = 0; attempt < attempts && !ok; ++attempt) {
+            try {
+                sub->handler(*env.message);
+                ok = true;
+            } catch (...) {
+            }
+        }
+        t_handlerBroker = nullptr;
+        t_handlerSub = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(sub->mu);
+            sub->in_handler = false;
+        }
+        sub->idle_cv.notify_all();
+        if (ok) {
+            delivered_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            handler_failures_.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (env.ack) {
+            env.ack->resolve(ok);
+        }
+    }
+
+    // Batch exhausted: go to the back of the ready queue so one busy
+    // subscription cannot monopolise a dispatcher.
+    {
+        std::lock_guard<std::mutex> lock(sub->mu);
+        if (!sub->active || sub->queued == 0) {
+            sub->scheduled = false;
+            return;
+        }
+    }
+    schedule(sub);
+}
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+bool InProcessPubSub::isConnected() const {
+    return connected_.load(std::memory_order_acquire);
+}
+
+NetworkError InProcessPubSub::connect() {
+    std::lock_guard<std::mutex> lifecycle(lifecycle_mutex_);
+    if (connected_.load()) {
+        return NetworkError();
+    }
+
+    joinRetiredDispatchers();
+
+    // Rebuild the ready queue from the queues themselves so no subscription
+    // is listed twice.
+    std::uint64_t generation;
+    {
+        std::lock_guard<std::mutex> lock(ready_mutex_);
+        ready_.clear();
+        stopping_ = false;
+        generation = ++generation_;
+    }
+    std::vector<std::shared_ptr<Subscription>> pending;
+    {
+        std::shared_lock<std::shared_mutex> lock(subs_mutex_);
+        for (const auto& [id, sub] : subs_) {
+            (void)id;
+            std::lock_guard<std::mutex> sub_lock(sub->mu);
+            sub->scheduled = sub->queued > 0;
+            if (sub->scheduled) {
+                pending.push_back(sub);
+            }
+        }
+    }
+    for (const auto& sub : pending) {
+        schedule(sub);
+    }
+
+    try {
+        dispatchers_.reserve(config_.dispatcherThreads);
+        for (std::size_t i = 0; i < config_.dispatcherThreads; ++i) {
+            dispatchers_.emplace_back(&InProcessPubSub::dispatchLoop, this, generation);
+        }
+    } catch (const std::system_error& e) {
+        {
+            std::lock_guard<std::mutex> lock(ready_mutex_);
+            stopping_ = true;
+        }
+        ready_cv_.notify_all();
+        for (auto& t : dispatchers_) {
+            t.join();
+        }
+        dispatchers_.clear();
+        return NetworkError(NetworkErrorCode::UNKNOWN_ERROR,
+                            std::string("Failed to start dispatchers: ") + e.what());
+    }
+    connected_.store(true, std::memory_order_release);
+    return NetworkError();
+}
+
+void InProcessPubSub::disconnect() noexcept {
+    std::lock_guard<std::mutex> lifecycle(lifecycle_mutex_);
+    if (!connected_.exchange(false)) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(ready_mutex_);
+        stopping_ = true;
+    }
+    ready_cv_.notify_all();
+    for (auto& t : dispatchers_) {
+        // Called from a handler: this dispatcher exits once the handler
+        // returns, and is joined later.
+        if (t.get_id() == std::this_thread::get_id()) {
+            retired_dispatchers_.push_back(std::move(t));
+        } else {
+            t.join();
+        }
+    }
+    dispatchers_.clear();
+    {
+        std::lock_guard<std::mutex> lock(ready_mutex_);
+        ready_.clear();
+    }
+
+    std::vector<std::shared_ptr<Subscription>> subs;
+    {
+        std::shared_lock<std::shared_mutex> lock(subs_mutex_);
+        subs.reserve(subs_.size());
+        for (const auto& [id, sub] : subs_) {
+            (void)id;
+            subs.push_back(sub);
+        }
+    }
+    for (const auto& sub : subs) {
+        discardQueued(*sub);
+    }
+}
+
+void InProcessPubSub::joinRetiredDispatchers() {
+    // Caller holds lifecycle_mutex_. A retired dispatcher calling back in
+    // from its handler stays listed; it cannot join itself.
+    auto keep = retired_dispatchers_.begin();
+    for (auto it = retired_dispatchers_.begin(); it != retired_dispatchers_.end(); ++it) {
+        if (it->get_id() == std::this_thread::get_id()) {
+            *keep++ = std::move(*it);
+        } else {
+            it->join();
+        }
+    }
+    retired_dispatchers_.erase(keep, retired_dispatchers_.end());
+}
+
+PubSubStats InProcessPubSub::stats() const {
+    PubSubStats s;
+    s.published = published_.load(std::memory_order_relaxed);
+    s.enqueued = enqueued_.load(std::memory_order_relaxed);
+    s.delivered = delivered_.load(std::memory_order_relaxed);
+    s.dropped = dropped_.load(std::memory_order_relaxed);
+    s.handlerFailures = handler_failures_.load(std::memory_order_relaxed);
+    return s;
+}
+
+} // namespace ailee::net
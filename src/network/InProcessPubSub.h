@@ -0,0 +1,169 @@
+// SPDX-License-Identifier: MIT
+// InProcessPubSub.h — In-process IPubSub broker for AmbientWorkerNode and
+// AmbientRequesterClient when both ends live in the same process (tests,
+// single-host deployments, simulations).
+
+#pragma once
+
+#include "AmbientNode.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace ailee::net {
+
+// What a publisher sees when a subscriber's queue is full.
+enum class OverflowPolicy {
+    DROP_NEWEST,   // Reject the incoming message for that subscriber
+    DROP_OLDEST,   // Evict the oldest queued message of the lowest priority lane
+    BLOCK          // Wait for space up to the publish timeout (backpressure)
+};
+
+struct InProcessPubSubConfig {
+    std::size_t dispatcherThreads = 2;
+    std::size_t queueCapacity = 1024;        // Per subscription, across all lanes
+    OverflowPolicy overflowPolicy = OverflowPolicy::DROP_NEWEST;
+    std::size_t dispatchBatch = 32;          // Messages drained per scheduling turn
+    // Publish timeout for BLOCK when publish() is called without options.
+    std::chrono::milliseconds defaultBlockTimeout = std::chrono::milliseconds(3000);
+};
+
+struct PubSubStats {
+    std::uint64_t published = 0;
+    std::uint64_t enqueued = 0;
+    std::uint64_t delivered = 0;
+    std::uint64_t dropped = 0;
+    std::uint64_t handlerFailures = 0;
+};
+
+/**
+ * Broker that delivers messages between IPubSub users in the same process.
+ *
+ * Topics are '/'-separated. A subscription either matches its topic exactly
+ * or, when SubscriptionOptions::filterPattern is set, matches the pattern,
+ * where '+' (or '*') stands for one level and a trailing '#' for any number
+ * of remaining levels. Both kinds live in one topic trie, so a publish costs
+ * one walk over the topic's levels rather than a scan over subscriptions.
+ *
+ * Every subscription owns a bounded queue split into priority lanes
+ * (PublishOptions::priority, higher first). A fixed pool of dispatcher
+ * threads drains ready subscriptions; a subscription is never run by two
+ * dispatchers at once, so its handler sees messages one at a time and, per
+ * lane, in publish order.
+ *
+ * With PublishOptions::requireAck, publish() returns only after every
+ * matched subscriber has run its handler, or TIMEOUT once opts.timeout
+ * elapses. Acking publishes from inside a handler can starve the pool and
+ * will then time out rather than deadlock.
+ */
+class InProcessPubSub : public IPubSub {
+public:
+    static constexpr std::size_t kPriorityLanes = 4;
+
+    explicit InProcessPubSub(const InProcessPubSubConfig& config = InProcessPubSubConfig{});
+    ~InProcessPubSub() override;
+
+    InProcessPubSub(const InProcessPubSub&) = delete;
+    InProcessPubSub& operator=(const InProcessPubSub&) = delete;
+
+    NetworkError publish(const Message& m) override;
+    NetworkError publish(const Message& m, const PublishOptions& opts) override;
+
+    // Rejects a second plain subscription to the same topic.
+    NetworkError subscribe(const std::string& topic, MessageHandler handler) override;
+    // Always creates a new subscription; several may share a topic.
+    NetworkError subscribe(const std::string& topic, MessageHandler handler,
+                           const SubscriptionOptions& opts, SubscriptionId* outId) override;
+
+    // Removes every subscription registered under `topic`. Both overloads
+    // wait for a handler call already in progress to return, except that a
+    // handler never waits for itself, and when two handlers unsubscribe each
+    // other the call that would close the cycle returns without waiting.
+    NetworkError unsubscribe(const std::string& topic) override;
+    NetworkError unsubscribe(SubscriptionId id) override;
+
+    bool isConnected() const override;
+    std::vector<std::string> getSubscribedTopics() const override;
+    std::size_t getSubscriptionCount() const override;
+
+    // Starts the dispatcher pool. Subscriptions survive disconnect/connect;
+    // messages still queued at disconnect are dropped. disconnect() may be
+    // called from a handler: the calling dispatcher is then left to finish
+    // its handler and is joined by the next connect() or the destructor.
+    NetworkError connect() override;
+    void disconnect() noexcept override;
+
+    PubSubStats stats() const;
+
+    // True if `topic` matches `pattern` under the wildcard rules above.
+    static bool topicMatches(const std::string& pattern, const std::string& topic);
+
+private:
+    struct AckState;
+    struct Envelope {
+        std::shared_ptr<const Message> message;
+        std::shared_ptr<AckState> ack;
+    };
+    struct Subscription;
+    struct TrieNode;
+
+    static bool validTopic(const std::string& topic);
+    static bool validPattern(const std::string& pattern);
+    static std::vector<std::string> splitLevels(const std::string& topic);
+
+    NetworkError addSubscription(const std::string& topic, MessageHandler handler,
+                                 const SubscriptionOptions& opts, SubscriptionId* outId,
+                                 bool rejectDuplicate);
+    void removeSubscription(const std::shared_ptr<Subscription>& sub);
+    void collectMatches(const std::string& topic,
+                        std::vector<std::shared_ptr<Subscription>>& out) const;
+
+    // Returns false if the envelope was dropped for this subscriber.
+    bool enqueue(const std::shared_ptr<Subscription>& sub, Envelope env, std::size_t lane,
+                 std::chrono::steady_clock::time_point deadline);
+    void schedule(const std::shared_ptr<Subscription>& sub);
+    void dispatchLoop(std::uint64_t generation);
+    void joinRetiredDispatchers();
+    void drain(const std::shared_ptr<Subscription>& sub);
+    void discardQueued(Subscription& sub);
+    void retire(Subscription& sub);
+
+    InProcessPubSubConfig config_;
+
+    mutable std::shared_mutex subs_mutex_;
+    std::unique_ptr<TrieNode> root_;
+    std::unordered_map<SubscriptionId, std::shared_ptr<Subscription>> subs_;
+    SubscriptionId next_id_ = 1;
+
+    std::mutex ready_mutex_;
+    std::condition_variable ready_cv_;
+    std::deque<std::shared_ptr<Subscription>> ready_;
+    bool stopping_ = false;
+    std::uint64_t generation_ = 0;  // Bumped by connect(); older dispatchers exit
+
+    // Which handler each handler-running thread is blocked on in retire().
+    std::mutex wait_graph_mutex_;
+
+    std::mutex lifecycle_mutex_;
+    std::vector<std::thread> dispatchers_;
+    std::vector<std::thread> retired_dispatchers_;  // Disconnected from their own handler
+    std::atomic<bool> connected_{false};
+
+    std::atomic<std::uint64_t> published_{0};
+    std::atomic<std::uint64_t> enqueued_{0};
+    std::atomic<std::uint64_t> delivered_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+    std::atomic<std::uint64_t> handler_failures_{0};
+};
+
+} // namespace ailee::net
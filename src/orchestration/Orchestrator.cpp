@@ -2,10 +2,13 @@
 // Minimal, compile-safe orchestrator implementations for WeightedOrchestrator.
 
 #include "Orchestrator.h"
+#include "Ledger.h"
 #include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <deque>
 #include <unordered_map>
+#include <unordered_set>
 #include <json/json.h> 
 
 #include "protocol/ProtocolFrame.hpp"
@@ -135,6 +138,25 @@ Assignment buildAssignment(const TaskPayload& task, const NodeMetrics& node, dou
     return assignment;
 }
 
+// Tasks with equal keys see the same requirement/region/cost filter.
+std::string requirementKey(const TaskPayload& task) {
+    const auto& r = task.requirements;
+    std::string key;
+    key.reserve(64);
+    key += std::to_string(r.minCpuCores) + '|' + std::to_string(r.minMemoryGB) + '|' +
+           std::to_string(r.minStorageGB) + '|' + std::to_string(r.minBandwidthMbps) + '|' +
+           (r.requiresGPU ? '1' : '0') + std::to_string(r.minGpuMemoryGB) + '|' +
+           (r.requiresTPU ? '1' : '0') + '|' + std::to_string(task.maxCostTokens) + '|';
+    if (task.preferredRegion) {
+        key += '@' + *task.preferredRegion;
+    }
+    return key;
+}
+
+bool withinCost(const NodeMetrics& node, const TaskPayload& task) {
+    return task.maxCostTokens == 0 || node.costPerHour <= static_cast<double>(task.maxCostTokens);
+}
+
 } // namespace
 
 // ---------------------------------------------------------
@@ -232,11 +254,11 @@ Assignment WeightedOrchestrator::assignBestWorker(const TaskPayload& task,
 
     double bestScore = -1.0;
     const NodeMetrics* bestNode = nullptr;
-    for (const auto& node : filtered) {
-        double score = scoreNode(node, task, trustW, speedW, powerW);
+    for (const NodeMetrics* node : filtered) {
+        double score = scoreNode(*node, task, trustW, speedW, powerW);
         if (score > bestScore) {
             bestScore = score;
-            bestNode = &node;
+            bestNode = node;
         }
     }
 
@@ -281,6 +303,17 @@ Assignment WeightedOrchestrator::assignWithStrategy(const TaskPayload& task,
 std::vector<Assignment> WeightedOrchestrator::assignParallel(
     const std::vector<TaskPayload>& tasks,
     const std::vector<NodeMetrics>& candidates) const {
+    switch (strategy_) {
+        case SchedulingStrategy::GEOGRAPHIC_AFFINITY:
+        case SchedulingStrategy::LOAD_BALANCING:
+            return assignBatchGlobal(tasks, candidates, 0.4, 0.4, 0.2);
+        case SchedulingStrategy::WEIGHTED_SCORE:
+        case SchedulingStrategy::GENETIC_ALGORITHM:
+            return assignBatchGlobal(tasks, candidates, 0.5, 0.3, 0.2);
+        default:
+            break;
+    }
+
     std::vector<Assignment> assignments;
     assignments.reserve(tasks.size());
     for (const auto& task : tasks) {
@@ -289,12 +322,191 @@ std::vector<Assignment> WeightedOrchestrator::assignParallel(
     return assignments;
 }
 
+// ---------------------------------------------------------
+// Global batch assignment
+// ---------------------------------------------------------
+// Tasks bid for worker slots (Bertsekas' auction with similar objects). A
+// worker with c free slots holds the c highest bids; its price is the lowest
+// held bid once full. Each bid raises the price by the bidder's margin over
+// its next-best option plus eps, so the result is within tasks * eps of the
+// maximum total value. A task's value for a worker is its score plus an
+// offset larger than any score, which makes assigning one more task always
+// worth more than any reshuffle; a task drops out once no slot is worth its
+// price.
+std::vector<Assignment> WeightedOrchestrator::assignBatchGlobal(
+    const std::vector<TaskPayload>& tasks,
+    const std::vector<NodeMetrics>& candidates,
+    double trustW,
+    double speedW,
+    double powerW) const {
+    const std::size_t taskCount = tasks.size();
+    const std::size_t workerCount = candidates.size();
+
+    // Per-worker score terms and free slots, computed once per batch.
+    struct WorkerTerms {
+        double base = 0.0;      // trust + latency + capacity terms
+        double green = 0.0;     // extra power term for preferGreenEnergy tasks
+        std::size_t slots = 0;
+    };
+    std::vector<WorkerTerms> terms(workerCount);
+
+    // Snapshot reputation and latency once up front, so the whole batch
+    // sees one consistent view and each lock is taken once per worker.
+    std::vector<double> trust(workerCount);
+    std::vector<double> speed(workerCount);
+    for (std::size_t j = 0; j < workerCount; ++j) {
+        trust[j] = rep_.get(candidates[j].peerId).score();
+        speed[j] = latencyScoreFor(candidates[j], lat_);
+    }
+
+    for (std::size_t j = 0; j < workerCount; ++j) {
+        const NodeMetrics& node = candidates[j];
+        terms[j].base = trustW * trust[j] + speedW * speed[j] + powerW * node.capacityScore;
+        terms[j].green = node.carbonIntensity > 0.0
+                             ? powerW * (1.0 / (1.0 + node.carbonIntensity))
+                             : 0.0;
+        if (node.maxConcurrentTasks == 0) {
+            terms[j].slots = taskCount;
+        } else if (node.maxConcurrentTasks > node.activeTaskCount) {
+            terms[j].slots = std::min<std::size_t>(taskCount,
+                                                   node.maxConcurrentTasks - node.activeTaskCount);
+        }
+    }
+
+    // Requirement buckets: workers by region, then one eligible list per
+    // distinct requirement key, shared by every task with that key.
+    std::unordered_map<std::string, std::vector<uint32_t>> byRegion;
+    std::vector<uint32_t> allWorkers;
+    allWorkers.reserve(workerCount);
+    for (std::size_t j = 0; j < workerCount; ++j) {
+        if (terms[j].slots == 0) continue;
+        allWorkers.push_back(static_cast<uint32_t>(j));
+        byRegion[candidates[j].region].push_back(static_cast<uint32_t>(j));
+    }
+
+    std::unordered_map<std::string, std::size_t> groupOf;
+    std::vector<std::size_t> taskGroup(taskCount);
+    std::vector<const TaskPayload*> groupExemplar;
+    for (std::size_t i = 0; i < taskCount; ++i) {
+        auto [it, inserted] = groupOf.emplace(requirementKey(tasks[i]), groupExemplar.size());
+        if (inserted) {
+            groupExemplar.push_back(&tasks[i]);
+        }
+        taskGroup[i] = it->second;
+    }
+
+    std::vector<std::vector<uint32_t>> eligible(groupExemplar.size());
+    for (std::size_t g = 0; g < groupExemplar.size(); ++g) {
+        const TaskPayload& task = *groupExemplar[g];
+        const std::vector<uint32_t>* pool = &allWorkers;
+        if (task.preferredRegion) {
+            auto it = byRegion.find(*task.preferredRegion);
+            if (it == byRegion.end()) continue;
+            pool = &it->second;
+        }
+        for (uint32_t j : *pool) {
+            if (meetsRequirements(candidates[j], task.requirements) && withinCost(candidates[j], task)) {
+                eligible[g].push_back(j);
+            }
+        }
+    }
+
+    // Per-task (worker, score) rows with blacklists applied.
+    std::vector<std::vector<std::pair<uint32_t, double>>> rows(taskCount);
+    std::vector<double> rowMax(taskCount, 0.0);
+    for (std::size_t i = 0; i < taskCount; ++i) {
+        const TaskPayload& task = tasks[i];
+        std::unordered_set<std::string> blacklist(task.blacklistedNodes.begin(), task.blacklistedNodes.end());
+        auto& row = rows[i];
+        row.reserve(eligible[taskGroup[i]].size());
+        for (uint32_t j : eligible[taskGroup[i]]) {
+            if (!blacklist.empty() && blacklist.count(candidates[j].peerId)) continue;
+            const double score = terms[j].base + (task.preferGreenEnergy ? terms[j].green : 0.0);
+            row.emplace_back(j, score);
+            rowMax[i] = std::max(rowMax[i], score);
+        }
+    }
+
+    double maxScore = 0.0;
+    for (double m : rowMax) maxScore = std::max(maxScore, m);
+    const double offset = maxScore + 1.0;
+    const double eps = offset / (4.0 * static_cast<double>(taskCount + 1));
+
+    // Min-heap of (bid, task) per worker.
+    using Held = std::pair<double, std::size_t>;
+    std::vector<std::priority_queue<Held, std::vector<Held>, std::greater<Held>>> held(workerCount);
+    auto priceOf = [&](uint32_t j) {
+        return held[j].size() < terms[j].slots ? 0.0 : held[j].top().first;
+    };
+
+    std::vector<int64_t> owner(taskCount, -1);
+    std::deque<std::size_t> unassigned;
+    for (std::size_t i = 0; i < taskCount; ++i) {
+        if (!rows[i].empty()) unassigned.push_back(i);
+    }
+
+    while (!unassigned.empty()) {
+        const std::size_t i = unassigned.front();
+        unassigned.pop_front();
+
+        double best = -std::numeric_limits<double>::infinity();
+        double second = 0.0; // staying unassigned is worth 0
+        uint32_t bestWorker = 0;
+        for (const auto& [j, score] : rows[i]) {
+            const double value = score + offset - priceOf(j);
+            if (value > best) {
+                second = std::max(second, best);
+                best = value;
+                bestWorker = j;
+            } else if (value > second) {
+                second = value;
+            }
+        }
+        if (best <= 0.0) {
+            continue; // priced out of every eligible worker
+        }
+
+        const double bid = priceOf(bestWorker) + (best - second) + eps;
+        held[bestWorker].emplace(bid, i);
+        owner[i] = bestWorker;
+        if (held[bestWorker].size() > terms[bestWorker].slots) {
+            const std::size_t evicted = held[bestWorker].top().second;
+            held[bestWorker].pop();
+            owner[evicted] = -1;
+            unassigned.push_back(evicted);
+        }
+    }
+
+    std::vector<Assignment> assignments(taskCount);
+    for (std::size_t i = 0; i < taskCount; ++i) {
+        metrics_.totalAssignments++;
+        if (owner[i] < 0) {
+            assignments[i].assigned = false;
+            assignments[i].reason = rows[i].empty() ? "no viable candidates" : "no worker capacity";
+            metrics_.failedAssignments++;
+            continue;
+        }
+        const NodeMetrics& node = candidates[static_cast<std::size_t>(owner[i])];
+        double score = 0.0;
+        for (const auto& [j, s] : rows[i]) {
+            if (j == static_cast<uint32_t>(owner[i])) {
+                score = s;
+                break;
+            }
+        }
+        assignments[i] = buildAssignment(tasks[i], node, score);
+        metrics_.successfulAssignments++;
+        metrics_.assignmentsByWorker[node.peerId]++;
+    }
+    return assignments;
+}
+
 std::vector<std::pair<std::string, double>> WeightedOrchestrator::rankCandidates(
     const TaskPayload& task,
     const std::vector<NodeMetrics>& candidates) const {
     std::vector<std::pair<std::string, double>> ranked;
-    for (const auto& node : filterCandidates(candidates, task)) {
-        ranked.emplace_back(node.peerId, scoreNode(node, task, 0.5, 0.3, 0.2));
+    for (const NodeMetrics* node : filterCandidates(candidates, task)) {
+        ranked.emplace_back(node->peerId, scoreNode(*node, task, 0.5, 0.3, 0.2));
     }
     std::sort(ranked.begin(), ranked.end(),
               [](const auto& a, const auto& b) { return a.second > b.second; });
@@ -307,12 +519,12 @@ std::optional<Assignment> WeightedOrchestrator::findBackupWorker(
     const std::string& excludePeerId) const {
     double bestScore = -1.0;
     const NodeMetrics* bestNode = nullptr;
-    for (const auto& node : filterCandidates(candidates, task)) {
-        if (node.peerId == excludePeerId) continue;
-        double score = scoreNode(node, task, 0.4, 0.4, 0.2);
+    for (const NodeMetrics* node : filterCandidates(candidates, task)) {
+        if (node->peerId == excludePeerId) continue;
+        double score = scoreNode(*node, task, 0.4, 0.4, 0.2);
         if (score > bestScore) {
             bestScore = score;
-            bestNode = &node;
+            bestNode = node;
         }
     }
     if (!bestNode) return std::nullopt;
@@ -329,10 +541,10 @@ std::vector<std::pair<std::string, std::string>> WeightedOrchestrator::rebalance
     const std::vector<TaskPayload>& tasks,
     const std::vector<NodeMetrics>& candidates) const {
     std::vector<std::pair<std::string, std::string>> rebalanced;
-    for (const auto& task : tasks) {
-        auto assignment = assignWithStrategy(task, candidates, strategy_);
-        if (assignment.assigned) {
-            rebalanced.emplace_back(task.taskId, assignment.workerPeerId);
+    auto assignments = assignParallel(tasks, candidates);
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+        if (assignments[i].assigned) {
+            rebalanced.emplace_back(tasks[i].taskId, assignments[i].workerPeerId);
         }
     }
     return rebalanced;
@@ -342,9 +554,9 @@ std::optional<Assignment> WeightedOrchestrator::findCheapestWorker(
     const TaskPayload& task,
     const std::vector<NodeMetrics>& candidates) const {
     const NodeMetrics* bestNode = nullptr;
-    for (const auto& node : filterCandidates(candidates, task)) {
-        if (!bestNode || node.costPerHour < bestNode->costPerHour) {
-            bestNode = &node;
+    for (const NodeMetrics* node : filterCandidates(candidates, task)) {
+        if (!bestNode || node->costPerHour < bestNode->costPerHour) {
+            bestNode = node;
         }
     }
     if (!bestNode) return std::nullopt;
@@ -360,12 +572,12 @@ Assignment WeightedOrchestrator::optimizeCostPerformance(
     const std::vector<NodeMetrics>& candidates) const {
     double bestScore = -1.0;
     const NodeMetrics* bestNode = nullptr;
-    for (const auto& node : filterCandidates(candidates, task)) {
-        double costScore = node.costPerHour > 0.0 ? 1.0 / node.costPerHour : 0.0;
-        double score = 0.6 * scoreNode(node, task, 0.4, 0.4, 0.2) + 0.4 * costScore;
+    for (const NodeMetrics* node : filterCandidates(candidates, task)) {
+        double costScore = node->costPerHour > 0.0 ? 1.0 / node->costPerHour : 0.0;
+        double score = 0.6 * scoreNode(*node, task, 0.4, 0.4, 0.2) + 0.4 * costScore;
         if (score > bestScore) {
             bestScore = score;
-            bestNode = &node;
+            bestNode = node;
         }
     }
     if (!bestNode) {
@@ -492,10 +704,12 @@ Assignment WeightedOrchestrator::projectActivationToMainnet(
     return assignment;
 }
 
-std::vector<NodeMetrics> WeightedOrchestrator::filterCandidates(
+std::vector<const NodeMetrics*> WeightedOrchestrator::filterCandidates(
     const std::vector<NodeMetrics>& candidates,
     const TaskPayload& task) const {
-    std::vector<NodeMetrics> filtered;
+    std::unordered_set<std::string> blacklist(task.blacklistedNodes.begin(), task.blacklistedNodes.end());
+    std::vector<const NodeMetrics*> filtered;
+    filtered.reserve(candidates.size());
     for (const auto& node : candidates) {
         if (!meetsRequirements(node, task.requirements)) {
             continue;
@@ -503,17 +717,29 @@ std::vector<NodeMetrics> WeightedOrchestrator::filterCandidates(
         if (task.preferredRegion && node.region != *task.preferredRegion) {
             continue;
         }
-        if (!task.blacklistedNodes.empty() &&
-            std::find(task.blacklistedNodes.begin(), task.blacklistedNodes.end(), node.peerId) !=
-                task.blacklistedNodes.end()) {
+        if (!blacklist.empty() && blacklist.count(node.peerId)) {
             continue;
         }
-        if (task.maxCostTokens > 0 && node.costPerHour > static_cast<double>(task.maxCostTokens)) {
+        if (!withinCost(node, task)) {
             continue;
         }
-        filtered.push_back(node);
+        filtered.push_back(&node);
     }
     return filtered;
 }
 
+void Engine::sweepExpiredEscrows() {
+    auto* ledger = escrowLedger_.load();
+    if (!ledger) {
+        return;
+    }
+    const auto nowMs = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+    // Bounded passes so the escrow lock is released between batches
+    const std::size_t limit = std::max<std::size_t>(config_.economic.escrowSweepLimit, 1);
+    while (running_.load() && ledger->sweepExpired(nowMs, limit).more) {
+    }
+}
+
 } // namespace ailee::sched
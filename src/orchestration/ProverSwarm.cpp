@@ -8,6 +8,15 @@
 #include <iostream>
 #include <algorithm>
 
+namespace {
+
+std::uint64_t nowMs() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+} // namespace
+
 namespace ailee::orchestration {
 
 ProverSwarm::ProverSwarm(const ProverSwarmConfig& config)
@@ -70,9 +79,16 @@ bool ProverSwarm::initialize(std::string* err) {
         return false;
     }
 
-    // Recover metrics
+    // Recover metrics and which queued jobs are already leased
     std::lock_guard<std::mutex> lock(mu_);
     metrics_.queue_depth = queue_order_.size();
+    assigned_.clear();
+    for (const auto& job_id : queue_order_) {
+        auto job = fetchJobInternal(job_id);
+        if (job && !job->assigned_prover.empty()) {
+            assigned_.insert(job_id);
+        }
+    }
 
     return true;
 }
@@ -85,6 +101,8 @@ void ProverSwarm::close() {
         if (state_cf_) { db_->DestroyColumnFamilyHandle(state_cf_); state_cf_ = nullptr; }
         db_.reset();
     }
+    // Wake long-polling leases; they see the closed DB and return empty.
+    jobs_cv_.notify_all();
 }
 
 bool ProverSwarm::submitJob(const std::string& job_id, const std::string& payload_json, std::string* err) {
@@ -110,12 +128,7 @@ bool ProverSwarm::submitJob(const std::string& job_id, const std::string& payloa
     batch.Put(jobs_cf_, job_key, job_val);
 
     // Serialize queue order
-    nlohmann::json queue_j = nlohmann::json::array_t{};
-    for (size_t i = 0; i < queue_order_.size(); ++i) {
-        queue_j[i] = queue_order_[i];
-    }
-    std::string queue_val = queue_j.dump();
-    batch.Put(jobs_cf_, "queue_order", queue_val);
+    batch.Put(jobs_cf_, "queue_order", queueOrderJson(queue_order_).dump());
 
     rocksdb::Status s = db_->Write(rocksdb::WriteOptions(), &batch);
     if (!s.ok()) {
@@ -125,6 +138,7 @@ bool ProverSwarm::submitJob(const std::string& job_id, const std::string& payloa
     }
 
     metrics_.queue_depth = queue_order_.size();
+    jobs_cv_.notify_one();
     return true;
 }
 
@@ -169,6 +183,7 @@ std::optional<ProverJob> ProverSwarm::assignJob() {
                    std::chrono::system_clock::now().time_since_epoch()).count();
 
     for (const auto& job_id : queue_order_) {
+        if (assigned_.count(job_id)) continue;
         auto job_opt = fetchJobInternal(job_id);
         if (!job_opt) continue;
 
@@ -181,6 +196,7 @@ std::optional<ProverJob> ProverSwarm::assignJob() {
             job.retry_count++;
 
             if (saveJob(job)) {
+                assigned_.insert(job_id);
                 return job;
             }
         }
@@ -229,12 +245,7 @@ bool ProverSwarm::recordJobSuccess(const std::string& job_id, double latency_ms,
     auto it = std::find(queue_order_.begin(), queue_order_.end(), job_id);
     if (it != queue_order_.end()) {
         queue_order_.erase(it);
-
-        nlohmann::json queue_j = nlohmann::json::array_t{};
-        for (size_t i = 0; i < queue_order_.size(); ++i) {
-            queue_j[i] = queue_order_[i];
-        }
-        batch.Put(jobs_cf_, "queue_order", queue_j.dump());
+        batch.Put(jobs_cf_, "queue_order", queueOrderJson(queue_order_).dump());
     }
 
     rocksdb::Status s = db_->Write(rocksdb::WriteOptions(), &batch);
@@ -242,6 +253,7 @@ bool ProverSwarm::recordJobSuccess(const std::string& job_id, double latency_ms,
         if (err) *err = "Failed to record job success: " + s.ToString();
         return false;
     }
+    assigned_.erase(job_id);
 
     metrics_.completed_jobs++;
     metrics_.queue_depth = queue_order_.size();
@@ -288,6 +300,8 @@ bool ProverSwarm::recordJobFailure(const std::string& job_id, std::string* err)
     }
 
     metrics_.failed_jobs++;
+    assigned_.erase(job_id);
+    jobs_cv_.notify_one();
     return true;
 }
 
@@ -364,11 +378,243 @@ std::vector<std::string> ProverSwarm::checkTimeouts(std::uint64_t current_time_m
         if (!s.ok()) {
             timed_out_jobs.clear();
         }
+        for (const auto& job_id : timed_out_jobs) {
+            assigned_.erase(job_id);
+        }
+        if (!timed_out_jobs.empty()) {
+            jobs_cv_.notify_all();
+        }
     }
 
     return timed_out_jobs;
 }
 
+// ---------------------------------------------------------
+// Bulk prover API
+// ---------------------------------------------------------
+
+BatchOutcome ProverSwarm::registerProvers(const std::vector<ProverIdentity>& provers, std::string* err) {
+    std::lock_guard<std::mutex> lock(mu_);
+    BatchOutcome outcome;
+    rocksdb::WriteBatch batch;
+    std::unordered_set<std::string> seen;
+    std::size_t added = 0;
+
+    for (const auto& prover : provers) {
+        if (prover.pubkey.empty()) {
+            outcome.rejected.emplace_back(prover.pubkey, "Empty pubkey.");
+            continue;
+        }
+        if (!seen.insert(prover.pubkey).second) {
+            outcome.rejected.emplace_back(prover.pubkey, "Duplicate in batch.");
+            continue;
+        }
+        outcome.accepted++;
+        if (fetchProverInternal(prover.pubkey)) {
+            continue;
+        }
+        batch.Put(state_cf_, prover.pubkey, prover.toJson().dump());
+        added++;
+    }
+
+    if (added > 0) {
+        rocksdb::Status s = db_->Write(rocksdb::WriteOptions(), &batch);
+        if (!s.ok()) {
+            if (err) *err = "Failed to register provers: " + s.ToString();
+            return BatchOutcome{};
+        }
+        metrics_.active_provers += added;
+    }
+    return outcome;
+}
+
+BatchOutcome ProverSwarm::heartbeat(const std::vector<std::string>& pubkeys, std::uint64_t now_ms) {
+    std::lock_guard<std::mutex> lock(mu_);
+    BatchOutcome outcome;
+    for (const auto& pubkey : pubkeys) {
+        auto prover = fetchProverInternal(pubkey);
+        if (!prover) {
+            outcome.rejected.emplace_back(pubkey, "Unknown prover.");
+        } else if (prover->banned) {
+            outcome.rejected.emplace_back(pubkey, "Prover is banned.");
+        } else {
+            heartbeats_[pubkey] = now_ms;
+            outcome.accepted++;
+        }
+    }
+    return outcome;
+}
+
+std::optional<std::uint64_t> ProverSwarm::lastHeartbeat(const std::string& pubkey) const {
+    std::lock_guard<std::mutex> lock(mu_);
+    auto it = heartbeats_.find(pubkey);
+    if (it == heartbeats_.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+std::vector<ProverJob> ProverSwarm::leaseJobs(const std::string& pubkey, std::size_t max_jobs,
+                                              std::chrono::milliseconds wait, std::string* err) {
+    std::unique_lock<std::mutex> lock(mu_);
+    std::vector<ProverJob> leased;
+    if (!db_) {
+        if (err) *err = "Swarm is closed.";
+        return leased;
+    }
+    auto prover = fetchProverInternal(pubkey);
+    if (!prover) {
+        if (err) *err = "Unknown prover.";
+        return leased;
+    }
+    if (prover->banned) {
+        if (err) *err = "Prover is banned.";
+        return leased;
+    }
+    if (max_jobs == 0) {
+        return leased;
+    }
+    if (wait.count() > 0) {
+        jobs_cv_.wait_for(lock, wait, [&] { return !db_ || hasLeasableJobLocked(); });
+        if (!db_) {
+            if (err) *err = "Swarm is closed.";
+            return leased;
+        }
+    }
+
+    const std::uint64_t now = nowMs();
+    rocksdb::WriteBatch batch;
+    for (const auto& job_id : queue_order_) {
+        if (leased.size() >= max_jobs) break;
+        if (assigned_.count(job_id)) continue;
+        auto job_opt = fetchJobInternal(job_id);
+        if (!job_opt || job_opt->completed || !job_opt->assigned_prover.empty()) continue;
+
+        ProverJob job = std::move(*job_opt);
+        job.assigned_prover = pubkey;
+        job.assigned_at_ms = now;
+        job.retry_count++;
+        batch.Put(jobs_cf_, "jobs/" + job.job_id, job.toJson().dump());
+        leased.push_back(std::move(job));
+    }
+    if (leased.empty()) {
+        return leased;
+    }
+
+    rocksdb::Status s = db_->Write(rocksdb::WriteOptions(), &batch);
+    if (!s.ok()) {
+        if (err) *err = "Failed to lease jobs: " + s.ToString();
+        leased.clear();
+        return leased;
+    }
+    for (const auto& job : leased) {
+        assigned_.insert(job.job_id);
+    }
+    heartbeats_[pubkey] = now;
+    return leased;
+}
+
+BatchOutcome ProverSwarm::submitResults(const std::string& pubkey, const std::vector<ProofResult>& results,
+                                        std::string* err) {
+    std::lock_guard<std::mutex> lock(mu_);
+    BatchOutcome outcome;
+    if (!db_) {
+        if (err) *err = "Swarm is closed.";
+        return outcome;
+    }
+
+    rocksdb::WriteBatch batch;
+    std::unordered_set<std::string> seen;
+    std::unordered_set<std::string> completed;
+    std::vector<std::string> released;
+    double latency_sum = 0.0;
+
+    // Reputation moves per result, so keep one running copy of the prover.
+    auto prover = fetchProverInternal(pubkey);
+
+    for (const auto& result : results) {
+        if (!seen.insert(result.job_id).second) {
+            outcome.rejected.emplace_back(result.job_id, "Duplicate in batch.");
+            continue;
+        }
+        auto job_opt = fetchJobInternal(result.job_id);
+        if (!job_opt) {
+            outcome.rejected.emplace_back(result.job_id, "Job not found.");
+            continue;
+        }
+        auto job = std::move(*job_opt);
+        if (job.completed) {
+            outcome.accepted++;
+            continue;
+        }
+        if (job.assigned_prover.empty() || job.assigned_prover != pubkey) {
+            outcome.rejected.emplace_back(result.job_id, "Job is not leased by this prover.");
+            continue;
+        }
+
+        if (result.success) {
+            job.completed = true;
+            completed.insert(job.job_id);
+            latency_sum += result.latency_ms;
+            if (prover) {
+                prover->reputation += config_.alpha / (1.0 + result.latency_ms);
+                prover->latency_ms = (prover->latency_ms + result.latency_ms) / 2.0; // Moving avg
+            }
+        } else {
+            job.assigned_prover = "";
+            job.assigned_at_ms = 0;
+            released.push_back(job.job_id);
+            if (prover) {
+                prover->reputation -= config_.beta;
+                if (prover->reputation < 0) prover->reputation = 0;
+            }
+        }
+        batch.Put(jobs_cf_, "jobs/" + job.job_id, job.toJson().dump());
+        outcome.accepted++;
+    }
+
+    if (completed.empty() && released.empty()) {
+        return outcome;
+    }
+    if (prover) {
+        batch.Put(state_cf_, prover->pubkey, prover->toJson().dump());
+    }
+    std::vector<std::string> remaining;
+    if (!completed.empty()) {
+        remaining.reserve(queue_order_.size() - std::min(queue_order_.size(), completed.size()));
+        for (const auto& job_id : queue_order_) {
+            if (!completed.count(job_id)) remaining.push_back(job_id);
+        }
+        batch.Put(jobs_cf_, "queue_order", queueOrderJson(remaining).dump());
+    }
+
+    rocksdb::Status s = db_->Write(rocksdb::WriteOptions(), &batch);
+    if (!s.ok()) {
+        if (err) *err = "Failed to submit results: " + s.ToString();
+        return BatchOutcome{};
+    }
+
+    if (!completed.empty()) {
+        queue_order_ = std::move(remaining);
+        for (const auto& job_id : completed) {
+            assigned_.erase(job_id);
+        }
+        metrics_.completed_jobs += completed.size();
+        metrics_.queue_depth = queue_order_.size();
+        total_latency_ms_ += latency_sum;
+        metrics_.avg_proof_latency_ms = total_latency_ms_ / static_cast<double>(metrics_.completed_jobs);
+    }
+    if (!released.empty()) {
+        for (const auto& job_id : released) {
+            assigned_.erase(job_id);
+        }
+        metrics_.failed_jobs += released.size();
+        jobs_cv_.notify_all();
+    }
+    heartbeats_[pubkey] = nowMs();
+    return outcome;
+}
+
 std::optional<ProverIdentity> ProverSwarm::getProver(const std::string& pubkey) const {
     std::lock_guard<std::mutex> lock(mu_);
     return fetchProverInternal(pubkey);
@@ -402,12 +648,16 @@ std::vector<std::string> ProverSwarm::getQueueOrder() const {
 // Internal persistence helpers
 // ---------------------------------------------------------
 
-bool ProverSwarm::saveQueueOrder(std::string* err) {
+nlohmann::json ProverSwarm::queueOrderJson(const std::vector<std::string>& order) {
     nlohmann::json j = nlohmann::json::array_t{};
-    for (size_t i = 0; i < queue_order_.size(); ++i) {
-        j[i] = queue_order_[i];
+    for (size_t i = 0; i < order.size(); ++i) {
+        j[i] = order[i];
     }
-    std::string val = j.dump();
+    return j;
+}
+
+bool ProverSwarm::saveQueueOrder(std::string* err) {
+    std::string val = queueOrderJson(queue_order_).dump();
     rocksdb::Status s = db_->Put(rocksdb::WriteOptions(), jobs_cf_, "queue_order", val);
     if (!s.ok()) {
         if (err) *err = "Failed to save queue_order: " + s.ToString();
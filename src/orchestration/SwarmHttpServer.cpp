@@ -1,7 +1,514 @@
+// SPDX-License-Identifier: MIT
+// SwarmHttpServer.cpp — Batched HTTP API for provers joining a ProverSwarm
+
 #include "SwarmHttpServer.h"
 #include "ProverSwarm.h"
+#include "ZKVerifier.h"
+#include "third_party/httplib.h"
+#include "webserver/RouteRegistry.h"
+#include "nlohmann/json.hpp"
+
+#include <openssl/sha.h>
+#include <secp256k1.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <future>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace ailee::orchestration {
+
+namespace {
+
+using json = nlohmann::json;
+
+// Largest integer a JSON number (a double here) holds exactly.
+constexpr double kMaxExactInteger = 9007199254740992.0;  // 2^53
+constexpr std::size_t kMaxEndpointLength = 512;
+
+void sendJson(httplib::Response& res, int status, const json& body) {
+    res.status = status;
+    res.set_content(body.dump(), "application/json");
+}
+
+void sendError(httplib::Response& res, int status, const std::string& error, const std::string& message) {
+    json body;
+    body = {
+        {"error", error},
+        {"message", message}
+    };
+    sendJson(res, status, body);
+}
+
+// Parses the body as a JSON object; answers 400 and returns false otherwise.
+bool parseBody(const httplib::Request& req, httplib::Response& res, json& out) {
+    try {
+        out = json::parse(req.body);
+    } catch (const std::exception& e) {
+        sendError(res, 400, "Bad Request", std::string("Invalid JSON: ") + e.what());
+        return false;
+    }
+    if (!out.is_object()) {
+        sendError(res, 400, "Bad Request", "Expected a JSON object");
+        return false;
+    }
+    return true;
+}
+
+// Returns the array under `key`; answers 400/413 and returns nullptr when it
+// is missing or larger than one batch.
+const json* batchArray(const json& body, const std::string& key, const SwarmHttpConfig& config,
+                       httplib::Response& res) {
+    const json& arr = body[key];
+    if (!arr.is_array()) {
+        sendError(res, 400, "Bad Request", "Expected array field '" + key + "'");
+        return nullptr;
+    }
+    std::size_t count = 0;
+    for (auto it = arr.begin(); it != arr.end(); ++it) {
+        ++count;
+    }
+    if (count > config.max_batch) {
+        sendError(res, 413, "Payload Too Large",
+                  "At most " + std::to_string(config.max_batch) + " entries per request");
+        return nullptr;
+    }
+    return &arr;
+}
+
+// A whole, non-negative number small enough to convert exactly.
+std::optional<std::uint64_t> wholeNumber(const json& value) {
+    if (!value.is_number()) return std::nullopt;
+    const double d = value.get<double>();
+    if (!std::isfinite(d) || d < 0.0 || d > kMaxExactInteger || std::floor(d) != d) {
+        return std::nullopt;
+    }
+    return static_cast<std::uint64_t>(d);
+}
+
+// Reads `key` as a whole number, or `fallback` when absent; answers 400 and
+// returns false when it is malformed or missing without a fallback.
+bool readWholeNumber(const json& body, const std::string& key, std::optional<std::uint64_t> fallback,
+                     std::uint64_t& out, httplib::Response& res) {
+    if (!body.contains(key)) {
+        if (!fallback) {
+            sendError(res, 400, "Bad Request", "Missing field '" + key + "'");
+            return false;
+        }
+        out = *fallback;
+        return true;
+    }
+    auto value = wholeNumber(body[key]);
+    if (!value) {
+        sendError(res, 400, "Bad Request", "Field '" + key + "' must be a non-negative integer");
+        return false;
+    }
+    out = *value;
+    return true;
+}
+
+bool decodeHex(const std::string& hex, std::vector<std::uint8_t>& out) {
+    if (hex.size() % 2 != 0) return false;
+    auto nibble = [](char c) -> int {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    };
+    out.clear();
+    out.reserve(hex.size() / 2);
+    for (std::size_t i = 0; i < hex.size(); i += 2) {
+        const int hi = nibble(hex[i]);
+        const int lo = nibble(hex[i + 1]);
+        if (hi < 0 || lo < 0) return false;
+        out.push_back(static_cast<std::uint8_t>((hi << 4) | lo));
+    }
+    return true;
+}
+
+const secp256k1_context* verifyContext() {
+    static secp256k1_context* ctx = secp256k1_context_create(SECP256K1_CONTEXT_VERIFY);
+    return ctx;
+}
+
+bool parsePubkey(const std::string& pubkey_hex, secp256k1_pubkey& out) {
+    std::vector<std::uint8_t> raw;
+    return decodeHex(pubkey_hex, raw) && !raw.empty() &&
+           secp256k1_ec_pubkey_parse(verifyContext(), &out, raw.data(), raw.size()) == 1;
+}
+
+// True when `signature_hex` is a DER signature by `pubkey_hex` over `digest`.
+bool verifySignature(const std::string& pubkey_hex, const std::string& signature_hex,
+                     const std::array<std::uint8_t, 32>& digest) {
+    secp256k1_pubkey pubkey;
+    std::vector<std::uint8_t> der;
+    secp256k1_ecdsa_signature sig;
+    if (!parsePubkey(pubkey_hex, pubkey) || !decodeHex(signature_hex, der) || der.empty() ||
+        secp256k1_ecdsa_signature_parse_der(verifyContext(), &sig, der.data(), der.size()) != 1) {
+        return false;
+    }
+    return secp256k1_ecdsa_verify(verifyContext(), &sig, digest.data(), &pubkey) == 1;
+}
+
+// Why a signed request from `pubkey` is refused, or empty when it is signed
+// by that registered, unbanned prover with a nonce it has not used before.
+std::string checkSigned(ProverSwarm& swarm, zk::NonceManager& nonces, const std::string& route,
+                        const std::string& pubkey, std::uint64_t nonce, const std::string& signature,
+                        const std::vector<std::string>& fields) {
+    auto prover = swarm.getProver(pubkey);
+    if (!prover) return "Unknown prover.";
+    if (prover->banned) return "Prover is banned.";
+    if (!verifySignature(prover->pubkey, signature,
+                         SwarmHttpServer::signingDigest(route, prover->pubkey, nonce, fields))) {
+        return "Bad signature.";
+    }
+    // Marked only once the signature holds, so forged requests cannot burn
+    // a prover's nonces.
+    if (!nonces.checkAndMark(nonce, pubkey)) return "Replayed nonce.";
+    return {};
+}
+
+// Reads pubkey, nonce and signature from a single-prover request and checks
+// them; answers 400/401/403 and returns false when the request is refused.
+bool authenticate(ProverSwarm& swarm, zk::NonceManager& nonces, const std::string& route,
+                  const json& body, const std::vector<std::string>& fields, std::string& pubkey,
+                  httplib::Response& res) {
+    std::uint64_t nonce = 0;
+    if (!body["pubkey"].is_string() || !body["signature"].is_string()) {
+        sendError(res, 400, "Bad Request", "Expected string fields 'pubkey' and 'signature'");
+        return false;
+    }
+    if (!readWholeNumber(body, "nonce", std::nullopt, nonce, res)) return false;
+    pubkey = body["pubkey"].get<std::string>();
+    const std::string reason =
+        checkSigned(swarm, nonces, route, pubkey, nonce, body["signature"].get<std::string>(), fields);
+    if (reason.empty()) return true;
+    const bool forbidden = reason == "Unknown prover." || reason == "Prover is banned.";
+    sendError(res, forbidden ? 403 : 401, forbidden ? "Forbidden" : "Unauthorized", reason);
+    return false;
+}
 
-void SwarmHttpServer::attach(ProverSwarm& /*swarm*/) {
-    // TODO: integrate with AILEEWebServer to expose /prover/register, etc.
-    // For now, this is a stub so the build succeeds.
+// Runs every proof through the verifier in one batch; entry i is true when
+// proofs[i] checks out for jobs[i] leased by `pubkey`.
+std::vector<bool> verifyProofs(const SwarmHttpConfig& config, const std::string& pubkey,
+                               const std::vector<ProverJob>& jobs,
+                               const std::vector<std::vector<std::uint8_t>>& proofs) {
+    std::vector<bool> verified(jobs.size(), false);
+    if (!config.verifier || !config.verification_key || jobs.empty()) {
+        return verified;
+    }
+    const zk::VerificationKey& vk = *config.verification_key;
+    std::vector<zk::ProofBundle> bundles;
+    bundles.reserve(jobs.size());
+    for (std::size_t i = 0; i < jobs.size(); ++i) {
+        zk::ProofBundle bundle;
+        bundle.proofBytes = proofs[i];
+        bundle.publicInputs.assign(jobs[i].payload.begin(), jobs[i].payload.end());
+        bundle.taskId = jobs[i].job_id;
+        bundle.workerId = pubkey;
+        bundle.circuitId = vk.id;
+        bundle.proofSystem = vk.proofSystem;
+        bundle.timestamp = std::chrono::system_clock::now();
+        bundle.proverPubkey = pubkey;
+        bundles.push_back(std::move(bundle));
+    }
+    std::promise<std::vector<zk::VerifyResult>> done;
+    auto future = done.get_future();
+    config.verifier->submitBatchAsync(bundles, vk, [&done](std::vector<zk::VerifyResult> results) {
+        done.set_value(std::move(results));
+    });
+    const auto results = future.get();
+    for (std::size_t i = 0; i < results.size() && i < verified.size(); ++i) {
+        verified[i] = results[i].verified;
+    }
+    return verified;
 }
+
+void sendOutcome(httplib::Response& res, const BatchOutcome& outcome) {
+    json rejected = json::array();
+    for (const auto& [id, reason] : outcome.rejected) {
+        json entry;
+        entry["id"] = id;
+        entry["reason"] = reason;
+        rejected.push_back(std::move(entry));
+    }
+    json body;
+    body["accepted"] = outcome.accepted;
+    body["rejected"] = rejected;
+    sendJson(res, 200, body);
+}
+
+std::uint64_t nowMs() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+// Holds one of the long-poll slots for the duration of a lease.
+class LongPollSlot {
+public:
+    LongPollSlot(std::atomic<std::size_t>& in_use, std::size_t limit) : in_use_(in_use) {
+        held_ = in_use_.fetch_add(1) < limit;
+        if (!held_) in_use_.fetch_sub(1);
+    }
+    ~LongPollSlot() {
+        if (held_) in_use_.fetch_sub(1);
+    }
+    LongPollSlot(const LongPollSlot&) = delete;
+    LongPollSlot& operator=(const LongPollSlot&) = delete;
+
+    bool held() const { return held_; }
+
+private:
+    std::atomic<std::size_t>& in_use_;
+    bool held_ = false;
+};
+
+using Handler = std::function<void(const httplib::Request&, httplib::Response&)>;
+
+std::vector<std::pair<std::string, Handler>> buildRoutes(ProverSwarm& swarm, const SwarmHttpConfig& config) {
+    std::vector<std::pair<std::string, Handler>> routes;
+    // Shared by every route of this attachment.
+    auto nonces = std::make_shared<zk::NonceManager>();
+    auto long_polls = std::make_shared<std::atomic<std::size_t>>(0);
+
+    routes.emplace_back("/prover/register", [&swarm, config](const httplib::Request& req, httplib::Response& res) {
+        json body;
+        if (!parseBody(req, res, body)) return;
+        const json* entries = batchArray(body, "provers", config, res);
+        if (!entries) return;
+
+        // Only the key and where to reach it come from the prover; the swarm
+        // owns reputation, capacity and ban state.
+        std::vector<ProverIdentity> provers;
+        std::vector<std::pair<std::string, std::string>> invalid;
+        for (const auto& entry : *entries) {
+            const json& pubkey = entry["pubkey"];
+            const json& endpoint = entry["endpoint"];
+            const std::string id = pubkey.is_string() ? pubkey.get<std::string>() : std::string();
+            secp256k1_pubkey parsed;
+            if (!pubkey.is_string() || !parsePubkey(id, parsed)) {
+                invalid.emplace_back(id, "Invalid pubkey.");
+                continue;
+            }
+            if (!endpoint.is_null() &&
+                (!endpoint.is_string() || endpoint.get<std::string>().size() > kMaxEndpointLength)) {
+                invalid.emplace_back(id, "Invalid endpoint.");
+                continue;
+            }
+            ProverIdentity prover;
+            prover.pubkey = id;
+            if (endpoint.is_string()) prover.endpoint = endpoint.get<std::string>();
+            provers.push_back(std::move(prover));
+        }
+        std::string err;
+        auto outcome = swarm.registerProvers(provers, &err);
+        if (!err.empty()) {
+            sendError(res, 500, "Internal Server Error", err);
+            return;
+        }
+        outcome.rejected.insert(outcome.rejected.end(), invalid.begin(), invalid.end());
+        sendOutcome(res, outcome);
+    });
+
+    routes.emplace_back("/prover/heartbeat", [&swarm, config, nonces](const httplib::Request& req,
+                                                                      httplib::Response& res) {
+        json body;
+        if (!parseBody(req, res, body)) return;
+        const json* entries = batchArray(body, "heartbeats", config, res);
+        if (!entries) return;
+
+        std::vector<std::string> pubkeys;
+        std::vector<std::pair<std::string, std::string>> refused;
+        for (const auto& entry : *entries) {
+            const json& pubkey = entry["pubkey"];
+            const json& signature = entry["signature"];
+            auto nonce = wholeNumber(entry["nonce"]);
+            const std::string id = pubkey.is_string() ? pubkey.get<std::string>() : std::string();
+            if (!pubkey.is_string() || !signature.is_string() || !nonce) {
+                refused.emplace_back(id, "Malformed heartbeat.");
+                continue;
+            }
+            std::string reason = checkSigned(swarm, *nonces, "/prover/heartbeat", id, *nonce,
+                                             signature.get<std::string>(), {});
+            if (!reason.empty()) {
+                refused.emplace_back(id, std::move(reason));
+                continue;
+            }
+            pubkeys.push_back(id);
+        }
+        auto outcome = swarm.heartbeat(pubkeys, nowMs());
+        outcome.rejected.insert(outcome.rejected.end(), refused.begin(), refused.end());
+        sendOutcome(res, outcome);
+    });
+
+    routes.emplace_back("/prover/jobs/lease", [&swarm, config, nonces, long_polls](const httplib::Request& req,
+                                                                                   httplib::Response& res) {
+        json body;
+        if (!parseBody(req, res, body)) return;
+
+        std::string pubkey;
+        std::uint64_t max_jobs = 1;
+        std::uint64_t wait_ms = 0;
+        if (!readWholeNumber(body, "max_jobs", 1, max_jobs, res) ||
+            !readWholeNumber(body, "wait_ms", 0, wait_ms, res)) {
+            return;
+        }
+        if (!authenticate(swarm, *nonces, "/prover/jobs/lease", body, {}, pubkey, res)) return;
+
+        // Past max_long_polls waiting leases, further ones answer at once
+        // rather than tying up another server thread.
+        LongPollSlot slot(*long_polls, config.max_long_polls);
+        if (!slot.held()) wait_ms = 0;
+
+        std::string err;
+        auto jobs = swarm.leaseJobs(pubkey, static_cast<std::size_t>(std::min<std::uint64_t>(max_jobs, config.max_batch)),
+                                    std::chrono::milliseconds(std::min(wait_ms, config.max_lease_wait_ms)),
+                                    &err);
+        if (!err.empty()) {
+            sendError(res, 500, "Internal Server Error", err);
+            return;
+        }
+        json leased = json::array();
+        for (const auto& job : jobs) {
+            json entry;
+            entry["job_id"] = job.job_id;
+            entry["payload"] = job.payload;
+            entry["retry_count"] = static_cast<double>(job.retry_count);
+            leased.push_back(std::move(entry));
+        }
+        json response;
+        response["jobs"] = leased;
+        sendJson(res, 200, response);
+    });
+
+    routes.emplace_back("/prover/results", [&swarm, config, nonces](const httplib::Request& req,
+                                                                    httplib::Response& res) {
+        json body;
+        if (!parseBody(req, res, body)) return;
+        const json* entries = batchArray(body, "results", config, res);
+        if (!entries) return;
+
+        auto proofOf = [](const json& entry) {
+            return entry["proof"].is_string() ? entry["proof"].get<std::string>() : std::string();
+        };
+        std::vector<std::string> fields;
+        for (const auto& entry : *entries) {
+            if (!entry["job_id"].is_string() || !entry["success"].is_boolean() ||
+                !(entry["proof"].is_null() || entry["proof"].is_string()) ||
+                !(entry["latency_ms"].is_null() || entry["latency_ms"].is_number())) {
+                sendError(res, 400, "Bad Request", "Invalid result entry");
+                return;
+            }
+            fields.push_back(entry["job_id"].get<std::string>());
+            fields.push_back(entry["success"].get<bool>() ? "1" : "0");
+            fields.push_back(proofOf(entry));
+        }
+        std::string pubkey;
+        if (!authenticate(swarm, *nonces, "/prover/results", body, fields, pubkey, res)) return;
+
+        BatchOutcome refused;
+        std::vector<ProofResult> results;
+        std::vector<ProverJob> proven_jobs;
+        std::vector<std::vector<std::uint8_t>> proofs;
+        std::vector<std::size_t> proven_index;  // Into results
+        for (const auto& entry : *entries) {
+            ProofResult result;
+            result.job_id = entry["job_id"].get<std::string>();
+            result.success = entry["success"].get<bool>();
+            const double latency = entry["latency_ms"].is_number() ? entry["latency_ms"].get<double>() : 0.0;
+            if (!std::isfinite(latency) || latency < 0.0) {
+                refused.rejected.emplace_back(result.job_id, "Invalid latency.");
+                continue;
+            }
+            result.latency_ms = std::min(latency, config.max_latency_ms);
+            if (result.success) {
+                std::vector<std::uint8_t> proof;
+                if (!decodeHex(proofOf(entry), proof) || proof.empty()) {
+                    refused.rejected.emplace_back(result.job_id, "Missing proof.");
+                    continue;
+                }
+                // Only spend verification on jobs this prover actually holds.
+                auto job = swarm.getJob(result.job_id);
+                if (job && !job->completed && job->assigned_prover == pubkey) {
+                    proven_jobs.push_back(std::move(*job));
+                    proofs.push_back(std::move(proof));
+                    proven_index.push_back(results.size());
+                }
+            }
+            results.push_back(std::move(result));
+        }
+
+        const auto verified = verifyProofs(config, pubkey, proven_jobs, proofs);
+        std::vector<bool> drop(results.size(), false);
+        for (std::size_t i = 0; i < proven_index.size(); ++i) {
+            if (!verified[i]) {
+                drop[proven_index[i]] = true;
+                refused.rejected.emplace_back(results[proven_index[i]].job_id,
+                                              config.verifier ? "Proof failed verification."
+                                                              : "No proof verifier configured.");
+            }
+        }
+        std::vector<ProofResult> accepted;
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            if (!drop[i]) accepted.push_back(std::move(results[i]));
+        }
+
+        std::string err;
+        auto outcome = swarm.submitResults(pubkey, accepted, &err);
+        if (!err.empty()) {
+            sendError(res, 500, "Internal Server Error", err);
+            return;
+        }
+        outcome.rejected.insert(outcome.rejected.end(), refused.rejected.begin(), refused.rejected.end());
+        sendOutcome(res, outcome);
+    });
+
+    return routes;
+}
+
+} // namespace
+
+void SwarmHttpServer::attach(ProverSwarm& swarm, const SwarmHttpConfig& config) {
+    for (auto& [path, handler] : buildRoutes(swarm, config)) {
+        Route route;
+        route.path = path;
+        route.method = HttpMethod::POST;
+        route.handler = std::move(handler);
+        route.signature_metadata = "prover_swarm";
+        RouteRegistry::getInstance().registerRoute(route);
+    }
+}
+
+void SwarmHttpServer::attach(ProverSwarm& swarm, httplib::Server& server, const SwarmHttpConfig& config) {
+    for (auto& [path, handler] : buildRoutes(swarm, config)) {
+        server.Post(path, std::move(handler));
+    }
+}
+
+std::array<std::uint8_t, 32> SwarmHttpServer::signingDigest(const std::string& route, const std::string& pubkey,
+                                                            std::uint64_t nonce,
+                                                            const std::vector<std::string>& fields) {
+    std::string message;
+    auto append = [&message](const std::string& part) {
+        const auto len = static_cast<std::uint32_t>(part.size());
+        for (int shift = 24; shift >= 0; shift -= 8) {
+            message.push_back(static_cast<char>((len >> shift) & 0xFF));
+        }
+        message += part;
+    };
+    append(route);
+    append(pubkey);
+    append(std::to_string(nonce));
+    for (const auto& field : fields) {
+        append(field);
+    }
+    std::array<std::uint8_t, 32> digest{};
+    SHA256(reinterpret_cast<const unsigned char*>(message.data()), message.size(), digest.data());
+    return digest;
+}
+
+} // namespace ailee::orchestration
@@ -6,8 +6,10 @@
 #include "ProverSwarm.h"  // your existing swarm implementation
 
 #include <iostream>
+#include <string>
+#include <vector>
 
-void SwarmRuntime::initialize(ProverSwarm& swarm) {
+void SwarmRuntime::initialize(ailee::orchestration::ProverSwarm& swarm) {
     SwarmConfig cfg = SwarmConfigLoader::load("config/ailee.toml");
 
     ProverRegistry::instance().loadFromConfig(cfg);
@@ -17,16 +19,28 @@ void SwarmRuntime::initialize(ProverSwarm& swarm) {
         return;
     }
 
-    std::cout << "[Swarm] Loading provers from config...\n";
+    // One batch for the whole config; provers that join later use
+    // SwarmHttpServer's /prover/register.
+    std::vector<ailee::orchestration::ProverIdentity> provers;
+    provers.reserve(cfg.provers.size());
     for (const auto& p : cfg.provers) {
-        // You may need to adjust this depending on ProverSwarm API.
-        // Example: swarm.addProver(p.pubkey, p.capacity, p.latency_ms, p.reputation);
-        swarm.addProver(p.pubkey, p.capacity, p.latency_ms, p.reputation);
+        ailee::orchestration::ProverIdentity identity;
+        identity.pubkey = p.pubkey;
+        identity.capacity = p.capacity;
+        identity.latency_ms = p.latency_ms;
+        identity.reputation = p.reputation;
+        provers.push_back(std::move(identity));
+    }
 
-        std::cout << "[Swarm] Loaded prover " << p.pubkey
-                  << " (capacity=" << p.capacity
-                  << ", latency_ms=" << p.latency_ms
-                  << ", reputation=" << p.reputation
-                  << ")\n";
+    std::string err;
+    auto outcome = swarm.registerProvers(provers, &err);
+    if (!err.empty()) {
+        std::cout << "[Swarm] Failed to load provers from config: " << err << "\n";
+        return;
+    }
+    std::cout << "[Swarm] Loaded " << outcome.accepted << " of " << provers.size()
+              << " provers from config\n";
+    for (const auto& [pubkey, reason] : outcome.rejected) {
+        std::cout << "[Swarm] Skipped prover '" << pubkey << "': " << reason << "\n";
     }
 }
@@ -0,0 +1,271 @@
+// SPDX-License-Identifier: MIT
+// NonceManager.cpp — Sliding-window replay protection for proof submissions
+//
+// Workers are spread over a fixed set of shards, each with its own mutex.
+// Within a shard, windows sit on a list ordered by last activity, so expiry
+// and capacity eviction pop from the front without scanning. A dropped
+// window leaves its high-water mark behind, so the worker cannot replay
+// anything at or below it once it comes back. Those marks are themselves
+// capped per shard; the least recently retired ones fold into a single
+// shard-wide floor that applies to every worker the shard does not track.
+
+#include "ZKVerifier.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+namespace ailee::zk {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t kShards = 16;
+// Retired floors kept per live window slot before folding into the shard
+// floor. A floor costs a worker id and 8 bytes against a window's 32-byte
+// bitmap, so this keeps them within the same order as the windows.
+constexpr std::size_t kRetiredPerWindow = 4;
+constexpr std::size_t kWords = NonceManager::kWindowBits / 64;
+static_assert(NonceManager::kWindowBits % 64 == 0, "window must be whole words");
+
+std::size_t popcount(uint64_t word) {
+    return std::bitset<64>(word).count();
+}
+
+// Bit i marks nonce (highWater - i) as used. Nonces at or below `floor`
+// were covered by an earlier, dropped window.
+struct Window {
+    std::string workerId;
+    uint64_t highWater = 0;
+    bool empty = true;
+    std::optional<uint64_t> floor;
+    std::array<uint64_t, kWords> bits{};
+    std::size_t tracked = 0;
+    Clock::time_point lastSeen;
+
+    bool seen(uint64_t nonce) const {
+        if (floor && nonce <= *floor) return true;
+        if (empty || nonce > highWater) return false;
+        const uint64_t age = highWater - nonce;
+        if (age >= NonceManager::kWindowBits) return true; // Too old to accept
+        return (bits[age / 64] >> (age % 64)) & 1;
+    }
+
+    // Returns false if the nonce was already used or is below the window.
+    bool mark(uint64_t nonce) {
+        if (floor && nonce <= *floor) return false;
+        if (empty) {
+            empty = false;
+            highWater = nonce;
+            bits[0] = 1;
+            tracked = 1;
+            return true;
+        }
+        if (nonce > highWater) {
+            advance(nonce - highWater);
+            highWater = nonce;
+            bits[0] |= 1;
+            ++tracked;
+            return true;
+        }
+        const uint64_t age = highWater - nonce;
+        if (age >= NonceManager::kWindowBits) return false;
+        uint64_t& word = bits[age / 64];
+        const uint64_t mask = uint64_t{1} << (age % 64);
+        if (word & mask) return false;
+        word |= mask;
+        ++tracked;
+        return true;
+    }
+
+    // Everything this window has ruled out: its high-water mark or floor.
+    std::optional<uint64_t> retiredFloor() const {
+        if (empty) return floor;
+        return floor ? std::max(*floor, highWater) : highWater;
+    }
+
+    // Ages every bit by `shift` nonces, dropping those that leave the window.
+    void advance(uint64_t shift) {
+        if (shift >= NonceManager::kWindowBits) {
+            bits.fill(0);
+            tracked = 0;
+            return;
+        }
+        const std::size_t wordShift = static_cast<std::size_t>(shift / 64);
+        const unsigned bitShift = static_cast<unsigned>(shift % 64);
+        for (std::size_t i = kWords; i-- > 0;) {
+            uint64_t v = 0;
+            if (i >= wordShift) {
+                v = bits[i - wordShift] << bitShift;
+                if (bitShift != 0 && i > wordShift) {
+                    v |= bits[i - wordShift - 1] >> (64 - bitShift);
+                }
+            }
+            bits[i] = v;
+        }
+        tracked = 0;
+        for (uint64_t word : bits) tracked += popcount(word);
+    }
+};
+
+using Retired = std::pair<std::string, uint64_t>;
+
+struct Shard {
+    mutable std::mutex mutex;
+    std::list<Window> byActivity; // Least recently active first
+    std::unordered_map<std::string, std::list<Window>::iterator> index;
+    // Floors of workers whose windows were dropped, least recently retired
+    // first; 8 bytes a worker instead of a whole window.
+    std::list<Retired> retiredOrder;
+    std::unordered_map<std::string, std::list<Retired>::iterator> retired;
+    // Highest floor folded out of `retired`. Rejects nonces at or below it
+    // for any worker not in `index` or `retired`.
+    std::optional<uint64_t> evictedFloor;
+
+    // Floor a worker without a live window starts from.
+    std::optional<uint64_t> floorFor(const std::string& workerId) const {
+        auto it = retired.find(workerId);
+        if (it != retired.end()) return it->second->second;
+        return evictedFloor;
+    }
+};
+
+} // namespace
+
+struct NonceManager::Impl {
+    std::array<Shard, kShards> shards;
+    std::size_t maxWorkersPerShard = 1;
+    std::size_t maxRetiredPerShard = kRetiredPerWindow;
+
+    std::atomic<std::size_t> totalTracked{0};
+    std::atomic<std::size_t> replayAttempts{0};
+    std::atomic<std::size_t> uniqueWorkers{0};
+
+    Shard& shardFor(const std::string& workerId) {
+        return shards[std::hash<std::string>{}(workerId) % kShards];
+    }
+    const Shard& shardFor(const std::string& workerId) const {
+        return shards[std::hash<std::string>{}(workerId) % kShards];
+    }
+
+    // Caller holds shard.mutex.
+    void retire(Shard& shard, const std::string& workerId, uint64_t floor) {
+        shard.retiredOrder.emplace_back(workerId, floor);
+        shard.retired[workerId] = std::prev(shard.retiredOrder.end());
+        while (shard.retired.size() > maxRetiredPerShard) {
+            const Retired& oldest = shard.retiredOrder.front();
+            shard.evictedFloor = std::max(shard.evictedFloor.value_or(0), oldest.second);
+            shard.retired.erase(oldest.first);
+            shard.retiredOrder.pop_front();
+        }
+    }
+
+    // Caller holds shard.mutex.
+    void erase(Shard& shard, std::list<Window>::iterator it) {
+        if (auto floor = it->retiredFloor()) {
+            retire(shard, it->workerId, *floor);
+        }
+        totalTracked.fetch_sub(it->tracked, std::memory_order_relaxed);
+        uniqueWorkers.fetch_sub(1, std::memory_order_relaxed);
+        shard.index.erase(it->workerId);
+        shard.byActivity.erase(it);
+    }
+
+    // Marks under the shard lock and moves the window to the back of the
+    // activity list. Returns false on replay.
+    bool mark(uint64_t nonce, const std::string& workerId) {
+        Shard& shard = shardFor(workerId);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto found = shard.index.find(workerId);
+        std::list<Window>::iterator it;
+        if (found == shard.index.end()) {
+            if (shard.index.size() >= maxWorkersPerShard) {
+                erase(shard, shard.byActivity.begin());
+            }
+            shard.byActivity.emplace_back();
+            it = std::prev(shard.byActivity.end());
+            it->workerId = workerId;
+            it->floor = shard.floorFor(workerId);
+            auto retired = shard.retired.find(workerId);
+            if (retired != shard.retired.end()) {
+                shard.retiredOrder.erase(retired->second);
+                shard.retired.erase(retired);
+            }
+            shard.index.emplace(workerId, it);
+            uniqueWorkers.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            it = found->second;
+            shard.byActivity.splice(shard.byActivity.end(), shard.byActivity, it);
+        }
+        it->lastSeen = Clock::now();
+
+        const std::size_t before = it->tracked;
+        const bool fresh = it->mark(nonce);
+        if (!fresh) {
+            replayAttempts.fetch_add(1, std::memory_order_relaxed);
+        } else if (it->tracked >= before) {
+            totalTracked.fetch_add(it->tracked - before, std::memory_order_relaxed);
+        } else {
+            totalTracked.fetch_sub(before - it->tracked, std::memory_order_relaxed);
+        }
+        return fresh;
+    }
+};
+
+NonceManager::NonceManager(std::size_t maxTrackedNonces)
+    : pImpl_(std::make_unique<Impl>()) {
+    const std::size_t maxWorkers = std::max<std::size_t>(maxTrackedNonces / kWindowBits, 1);
+    pImpl_->maxWorkersPerShard = std::max<std::size_t>((maxWorkers + kShards - 1) / kShards, 1);
+    pImpl_->maxRetiredPerShard = pImpl_->maxWorkersPerShard * kRetiredPerWindow;
+}
+
+NonceManager::~NonceManager() = default;
+
+bool NonceManager::hasNonce(uint64_t nonce, const std::string& workerId) const {
+    const Shard& shard = pImpl_->shardFor(workerId);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.index.find(workerId);
+    if (it != shard.index.end()) {
+        return it->second->seen(nonce);
+    }
+    auto floor = shard.floorFor(workerId);
+    return floor && nonce <= *floor;
+}
+
+void NonceManager::markNonceUsed(uint64_t nonce, const std::string& workerId) {
+    pImpl_->mark(nonce, workerId);
+}
+
+bool NonceManager::checkAndMark(uint64_t nonce, const std::string& workerId) {
+    return pImpl_->mark(nonce, workerId);
+}
+
+void NonceManager::cleanupOldNonces(std::chrono::seconds maxAge) {
+    const auto cutoff = Clock::now() - maxAge;
+    for (auto& shard : pImpl_->shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        while (!shard.byActivity.empty() && shard.byActivity.front().lastSeen <= cutoff) {
+            pImpl_->erase(shard, shard.byActivity.begin());
+        }
+    }
+}
+
+NonceManager::NonceStats NonceManager::getStats() const {
+    NonceStats stats;
+    stats.totalTracked = pImpl_->totalTracked.load(std::memory_order_relaxed);
+    stats.replayAttempts = pImpl_->replayAttempts.load(std::memory_order_relaxed);
+    stats.uniqueWorkers = pImpl_->uniqueWorkers.load(std::memory_order_relaxed);
+    for (const auto& shard : pImpl_->shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        stats.retiredWorkers += shard.retired.size();
+    }
+    return stats;
+}
+
+} // namespace ailee::zk
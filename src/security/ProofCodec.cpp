@@ -0,0 +1,445 @@
+// SPDX-License-Identifier: MIT
+// ProofCodec.cpp — Binary codec for ProofBundle and VerificationKey
+
+#include "ProofCodec.h"
+
+#include <algorithm>
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+
+namespace ailee::zk {
+
+namespace {
+
+constexpr std::uint8_t kBundleMagic[3] = {'A', 'P', 'B'};
+constexpr std::uint8_t kKeyMagic[3] = {'A', 'V', 'K'};
+
+// ProofBundle optional-field flags
+constexpr std::uint8_t kHasNonce = 1 << 0;
+constexpr std::uint8_t kHasSignature = 1 << 1;
+constexpr std::uint8_t kHasPubkey = 1 << 2;
+constexpr std::uint8_t kHasProofGenTime = 1 << 3;
+constexpr std::uint8_t kHasProofSize = 1 << 4;
+constexpr std::uint8_t kHasGas = 1 << 5;
+constexpr std::uint8_t kBundleFlagMask = 0x3F;
+
+// VerificationKey flags
+constexpr std::uint8_t kTrustedSetup = 1 << 0;
+constexpr std::uint8_t kHasCircuitCommitment = 1 << 1;
+constexpr std::uint8_t kHasExpiry = 1 << 2;
+constexpr std::uint8_t kHasCeremonyHash = 1 << 3;
+constexpr std::uint8_t kKeyFlagMask = 0x0F;
+
+constexpr std::size_t kLengthPrefix = 4;
+
+using std::chrono::system_clock;
+
+std::int64_t toMicros(system_clock::time_point tp) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(tp.time_since_epoch()).count();
+}
+
+// True when `micros` converts to a system_clock::time_point without
+// overflowing its (typically nanosecond) duration.
+bool representableMicros(std::int64_t micros) {
+    constexpr std::int64_t kMax =
+        std::chrono::duration_cast<std::chrono::microseconds>(system_clock::duration::max()).count();
+    constexpr std::int64_t kMin =
+        std::chrono::duration_cast<std::chrono::microseconds>(system_clock::duration::min()).count();
+    return micros >= kMin && micros <= kMax;
+}
+
+system_clock::time_point fromMicros(std::int64_t micros) {
+    return system_clock::time_point(
+        std::chrono::duration_cast<system_clock::duration>(std::chrono::microseconds(micros)));
+}
+
+bool validProofSystem(std::uint8_t v) {
+    return v <= static_cast<std::uint8_t>(ProofSystem::AUTO);
+}
+
+bool validHashFunction(std::uint8_t v) {
+    return v <= static_cast<std::uint8_t>(HashFunction::KECCAK256);
+}
+
+// Appends into a buffer sized up front, so encoding allocates once.
+class Writer {
+public:
+    explicit Writer(std::size_t size) { buf_.reserve(size); }
+
+    void uint8(std::uint8_t val) { buf_.push_back(val); }
+
+    void uint32(std::uint32_t val) {
+        for (int i = 3; i >= 0; --i) {
+            buf_.push_back(static_cast<std::uint8_t>((val >> (i * 8)) & 0xFF));
+        }
+    }
+
+    void uint64(std::uint64_t val) {
+        for (int i = 7; i >= 0; --i) {
+            buf_.push_back(static_cast<std::uint8_t>((val >> (i * 8)) & 0xFF));
+        }
+    }
+
+    void bytes(const std::uint8_t* data, std::size_t size) {
+        if (size > std::numeric_limits<std::uint32_t>::max()) {
+            throw std::length_error("Field too large for proof codec");
+        }
+        uint32(static_cast<std::uint32_t>(size));
+        buf_.insert(buf_.end(), data, data + size);
+    }
+
+    void bytes(const std::vector<std::uint8_t>& v) { bytes(v.data(), v.size()); }
+    void string(const std::string& s) { bytes(reinterpret_cast<const std::uint8_t*>(s.data()), s.size()); }
+
+    std::vector<std::uint8_t> take() { return std::move(buf_); }
+
+private:
+    std::vector<std::uint8_t> buf_;
+};
+
+// Bounds-checked cursor; every read fails rather than running past the end.
+class Reader {
+public:
+    Reader(const std::uint8_t* data, std::size_t len) : data_(data), len_(len) {}
+
+    bool uint8(std::uint8_t& val) {
+        if (len_ < 1) return false;
+        val = data_[0];
+        advance(1);
+        return true;
+    }
+
+    bool uint32(std::uint32_t& val) {
+        if (len_ < 4) return false;
+        val = 0;
+        for (int i = 0; i < 4; ++i) {
+            val = (val << 8) | data_[i];
+        }
+        advance(4);
+        return true;
+    }
+
+    bool uint64(std::uint64_t& val) {
+        if (len_ < 8) return false;
+        val = 0;
+        for (int i = 0; i < 8; ++i) {
+            val = (val << 8) | data_[i];
+        }
+        advance(8);
+        return true;
+    }
+
+    bool int64(std::int64_t& val) {
+        std::uint64_t raw = 0;
+        if (!uint64(raw)) return false;
+        val = static_cast<std::int64_t>(raw);
+        return true;
+    }
+
+    bool bytes(BytesRef& out) {
+        std::uint32_t n = 0;
+        if (!uint32(n) || len_ < n) return false;
+        out = BytesRef{data_, n};
+        advance(n);
+        return true;
+    }
+
+    bool magic(const std::uint8_t (&expected)[3]) {
+        if (len_ < 3) return false;
+        for (int i = 0; i < 3; ++i) {
+            if (data_[i] != expected[i]) return false;
+        }
+        advance(3);
+        return true;
+    }
+
+    bool done() const { return len_ == 0; }
+
+private:
+    void advance(std::size_t n) {
+        data_ += n;
+        len_ -= n;
+    }
+
+    const std::uint8_t* data_;
+    std::size_t len_;
+};
+
+std::string toString(BytesRef ref) {
+    return std::string(ref.str());
+}
+
+} // namespace
+
+std::uint8_t BytesRef::at(std::size_t i) const {
+    if (i >= size) {
+        throw std::out_of_range("BytesRef index out of range");
+    }
+    return data[i];
+}
+
+// ==================== PROOF BUNDLE ====================
+
+std::optional<ProofBundleView> ProofBundleView::parse(const std::uint8_t* data, std::size_t size) {
+    if (!data && size != 0) return std::nullopt;
+    Reader r(data, size);
+    ProofBundleView v;
+    std::uint8_t system = 0;
+    std::uint8_t flags = 0;
+    if (!r.magic(kBundleMagic) || !r.uint8(v.version_) || v.version_ != kProofBundleCodecVersion ||
+        !r.uint8(system) || !validProofSystem(system) ||
+        !r.uint8(flags) || (flags & ~kBundleFlagMask) != 0 ||
+        !r.uint32(v.protocolVersion_) || !r.int64(v.timestampMicros_) ||
+        !representableMicros(v.timestampMicros_)) {
+        return std::nullopt;
+    }
+    v.proofSystem_ = static_cast<ProofSystem>(system);
+
+    if (!r.bytes(v.proofBytes_) || !r.bytes(v.publicInputs_) ||
+        !r.bytes(v.modelHash_) || !r.bytes(v.inputHash_) || !r.bytes(v.outputHash_) ||
+        !r.bytes(v.executionHash_) || !r.bytes(v.taskId_) || !r.bytes(v.workerId_) ||
+        !r.bytes(v.circuitId_)) {
+        return std::nullopt;
+    }
+
+    std::uint64_t u64 = 0;
+    BytesRef ref;
+    if (flags & kHasNonce) {
+        if (!r.uint64(u64)) return std::nullopt;
+        v.nonce_ = u64;
+    }
+    if (flags & kHasSignature) {
+        if (!r.bytes(ref)) return std::nullopt;
+        v.proverSignature_ = ref;
+    }
+    if (flags & kHasPubkey) {
+        if (!r.bytes(ref)) return std::nullopt;
+        v.proverPubkey_ = ref;
+    }
+    if (flags & kHasProofGenTime) {
+        if (!r.uint64(u64) || u64 > static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max())) {
+            return std::nullopt;
+        }
+        v.proofGenTime_ = std::chrono::milliseconds(static_cast<std::int64_t>(u64));
+    }
+    if (flags & kHasProofSize) {
+        if (!r.uint64(u64)) return std::nullopt;
+        v.proofSizeBytes_ = static_cast<std::size_t>(u64);
+    }
+    if (flags & kHasGas) {
+        if (!r.uint64(u64)) return std::nullopt;
+        v.gasConsumed_ = u64;
+    }
+    if (!r.done()) return std::nullopt;
+    return v;
+}
+
+std::chrono::system_clock::time_point ProofBundleView::timestamp() const {
+    return fromMicros(timestampMicros_);
+}
+
+std::optional<std::string_view> ProofBundleView::proverPubkey() const {
+    if (!proverPubkey_) return std::nullopt;
+    return proverPubkey_->str();
+}
+
+ProofBundle ProofBundleView::materialize() const {
+    ProofBundle b;
+    b.proofBytes = proofBytes_.toVector();
+    b.publicInputs = publicInputs_.toVector();
+    b.modelHash = toString(modelHash_);
+    b.inputHash = toString(inputHash_);
+    b.outputHash = toString(outputHash_);
+    b.executionHash = toString(executionHash_);
+    b.taskId = toString(taskId_);
+    b.workerId = toString(workerId_);
+    b.circuitId = toString(circuitId_);
+    b.proofSystem = proofSystem_;
+    b.protocolVersion = protocolVersion_;
+    b.timestamp = timestamp();
+    b.nonce = nonce_;
+    if (proverSignature_) b.proverSignature = proverSignature_->toVector();
+    if (proverPubkey_) b.proverPubkey = toString(*proverPubkey_);
+    b.proofGenTime = proofGenTime_;
+    b.proofSizeBytes = proofSizeBytes_;
+    b.gasConsumed = gasConsumed_;
+    return b;
+}
+
+// ==================== VERIFICATION KEY ====================
+
+std::optional<VerificationKeyView> VerificationKeyView::parse(const std::uint8_t* data, std::size_t size) {
+    if (!data && size != 0) return std::nullopt;
+    Reader r(data, size);
+    VerificationKeyView v;
+    std::uint8_t system = 0;
+    std::uint8_t hash = 0;
+    std::uint8_t flags = 0;
+    if (!r.magic(kKeyMagic) || !r.uint8(v.version_) || v.version_ != kVerificationKeyCodecVersion ||
+        !r.uint8(system) || !validProofSystem(system) ||
+        !r.uint8(hash) || !validHashFunction(hash) ||
+        !r.uint8(flags) || (flags & ~kKeyFlagMask) != 0 ||
+        !r.uint32(v.securityBits_) || !r.int64(v.createdAtMicros_) ||
+        !representableMicros(v.createdAtMicros_) ||
+        !r.bytes(v.id_) || !r.bytes(v.data_) || !r.bytes(v.vkHash_)) {
+        return std::nullopt;
+    }
+    v.proofSystem_ = static_cast<ProofSystem>(system);
+    v.hashFunction_ = static_cast<HashFunction>(hash);
+    v.isTrustedSetup_ = (flags & kTrustedSetup) != 0;
+
+    BytesRef ref;
+    if (flags & kHasCircuitCommitment) {
+        if (!r.bytes(ref)) return std::nullopt;
+        v.circuitCommitment_ = ref;
+    }
+    if (flags & kHasExpiry) {
+        std::int64_t micros = 0;
+        if (!r.int64(micros) || !representableMicros(micros)) return std::nullopt;
+        v.expiresAtMicros_ = micros;
+    }
+    if (flags & kHasCeremonyHash) {
+        if (!r.bytes(ref)) return std::nullopt;
+        v.setupCeremonyHash_ = ref;
+    }
+    if (!r.done()) return std::nullopt;
+    return v;
+}
+
+std::chrono::system_clock::time_point VerificationKeyView::createdAt() const {
+    return fromMicros(createdAtMicros_);
+}
+
+std::optional<std::string_view> VerificationKeyView::circuitCommitment() const {
+    if (!circuitCommitment_) return std::nullopt;
+    return circuitCommitment_->str();
+}
+
+std::optional<std::chrono::system_clock::time_point> VerificationKeyView::expiresAt() const {
+    if (!expiresAtMicros_) return std::nullopt;
+    return fromMicros(*expiresAtMicros_);
+}
+
+std::optional<std::string_view> VerificationKeyView::setupCeremonyHash() const {
+    if (!setupCeremonyHash_) return std::nullopt;
+    return setupCeremonyHash_->str();
+}
+
+VerificationKey VerificationKeyView::materialize() const {
+    VerificationKey vk;
+    vk.id = toString(id_);
+    vk.data = data_.toVector();
+    vk.proofSystem = proofSystem_;
+    vk.hashFunction = hashFunction_;
+    vk.vkHash = toString(vkHash_);
+    if (circuitCommitment_) vk.circuitCommitment = toString(*circuitCommitment_);
+    vk.createdAt = createdAt();
+    vk.expiresAt = expiresAt();
+    vk.isTrustedSetup = isTrustedSetup_;
+    vk.securityBits = securityBits_;
+    if (setupCeremonyHash_) vk.setupCeremonyHash = toString(*setupCeremonyHash_);
+    return vk;
+}
+
+// ==================== UTILS ====================
+
+namespace utils {
+
+std::vector<std::uint8_t> serializeProofBundle(const ProofBundle& bundle) {
+    std::uint8_t flags = 0;
+    std::size_t size = 3 + 1 + 1 + 1 + 4 + 8 + 9 * kLengthPrefix +
+        bundle.proofBytes.size() + bundle.publicInputs.size() +
+        bundle.modelHash.size() + bundle.inputHash.size() + bundle.outputHash.size() +
+        bundle.executionHash.size() + bundle.taskId.size() + bundle.workerId.size() +
+        bundle.circuitId.size();
+    if (bundle.nonce) { flags |= kHasNonce; size += 8; }
+    if (bundle.proverSignature) { flags |= kHasSignature; size += kLengthPrefix + bundle.proverSignature->size(); }
+    if (bundle.proverPubkey) { flags |= kHasPubkey; size += kLengthPrefix + bundle.proverPubkey->size(); }
+    if (bundle.proofGenTime) { flags |= kHasProofGenTime; size += 8; }
+    if (bundle.proofSizeBytes) { flags |= kHasProofSize; size += 8; }
+    if (bundle.gasConsumed) { flags |= kHasGas; size += 8; }
+
+    Writer w(size);
+    for (std::uint8_t c : kBundleMagic) w.uint8(c);
+    w.uint8(kProofBundleCodecVersion);
+    w.uint8(static_cast<std::uint8_t>(bundle.proofSystem));
+    w.uint8(flags);
+    w.uint32(bundle.protocolVersion);
+    w.uint64(static_cast<std::uint64_t>(toMicros(bundle.timestamp)));
+    w.bytes(bundle.proofBytes);
+    w.bytes(bundle.publicInputs);
+    w.string(bundle.modelHash);
+    w.string(bundle.inputHash);
+    w.string(bundle.outputHash);
+    w.string(bundle.executionHash);
+    w.string(bundle.taskId);
+    w.string(bundle.workerId);
+    w.string(bundle.circuitId);
+    if (bundle.nonce) w.uint64(*bundle.nonce);
+    if (bundle.proverSignature) w.bytes(*bundle.proverSignature);
+    if (bundle.proverPubkey) w.string(*bundle.proverPubkey);
+    if (bundle.proofGenTime) w.uint64(static_cast<std::uint64_t>(std::max<std::int64_t>(bundle.proofGenTime->count(), 0)));
+    if (bundle.proofSizeBytes) w.uint64(*bundle.proofSizeBytes);
+    if (bundle.gasConsumed) w.uint64(*bundle.gasConsumed);
+    return w.take();
+}
+
+std::optional<ProofBundle> deserializeProofBundle(const std::vector<std::uint8_t>& data) {
+    auto view = ProofBundleView::parse(data);
+    if (!view) return std::nullopt;
+    return view->materialize();
+}
+
+std::vector<std::uint8_t> serializeVerificationKey(const VerificationKey& vk) {
+    std::uint8_t flags = vk.isTrustedSetup ? kTrustedSetup : 0;
+    std::size_t size = 3 + 1 + 1 + 1 + 1 + 4 + 8 + 3 * kLengthPrefix +
+        vk.id.size() + vk.data.size() + vk.vkHash.size();
+    if (vk.circuitCommitment) { flags |= kHasCircuitCommitment; size += kLengthPrefix + vk.circuitCommitment->size(); }
+    if (vk.expiresAt) { flags |= kHasExpiry; size += 8; }
+    if (vk.setupCeremonyHash) { flags |= kHasCeremonyHash; size += kLengthPrefix + vk.setupCeremonyHash->size(); }
+
+    Writer w(size);
+    for (std::uint8_t c : kKeyMagic) w.uint8(c);
+    w.uint8(kVerificationKeyCodecVersion);
+    w.uint8(static_cast<std::uint8_t>(vk.proofSystem));
+    w.uint8(static_cast<std::uint8_t>(vk.hashFunction));
+    w.uint8(flags);
+    w.uint32(vk.securityBits);
+    w.uint64(static_cast<std::uint64_t>(toMicros(vk.createdAt)));
+    w.string(vk.id);
+    w.bytes(vk.data);
+    w.string(vk.vkHash);
+    if (vk.circuitCommitment) w.string(*vk.circuitCommitment);
+    if (vk.expiresAt) w.uint64(static_cast<std::uint64_t>(toMicros(*vk.expiresAt)));
+    if (vk.setupCeremonyHash) w.string(*vk.setupCeremonyHash);
+    return w.take();
+}
+
+std::optional<VerificationKey> deserializeVerificationKey(const std::vector<std::uint8_t>& data) {
+    auto view = VerificationKeyView::parse(data);
+    if (!view) return std::nullopt;
+    return view->materialize();
+}
+
+bool isWellFormedProof(const ProofBundle& bundle) {
+    if (bundle.proofBytes.empty() || bundle.taskId.empty()) return false;
+    if (!validProofSystem(static_cast<std::uint8_t>(bundle.proofSystem))) return false;
+    if (bundle.proofSizeBytes && *bundle.proofSizeBytes != bundle.proofBytes.size()) return false;
+    // A signature is meaningless without the key that made it.
+    if (bundle.proverSignature && (bundle.proverSignature->empty() || !bundle.proverPubkey)) return false;
+    if (bundle.proofGenTime && bundle.proofGenTime->count() < 0) return false;
+
+    // Every variable-length field must fit the codec's u32 length prefix.
+    constexpr std::size_t kMaxField = std::numeric_limits<std::uint32_t>::max();
+    for (std::size_t n : {bundle.proofBytes.size(), bundle.publicInputs.size(), bundle.modelHash.size(),
+                          bundle.inputHash.size(), bundle.outputHash.size(), bundle.executionHash.size(),
+                          bundle.taskId.size(), bundle.workerId.size(), bundle.circuitId.size()}) {
+        if (n > kMaxField) return false;
+    }
+    return true;
+}
+
+} // namespace utils
+
+} // namespace ailee::zk
@@ -0,0 +1,155 @@
+// SPDX-License-Identifier: MIT
+// ProofCodec.h — Zero-copy views over binary ProofBundle / VerificationKey
+// encodings produced by utils::serializeProofBundle and
+// utils::serializeVerificationKey.
+//
+// Wire format (all integers big-endian, byte and string fields carry a u32
+// length prefix):
+//
+//   ProofBundle v1:  "APB" u8 version, u8 proofSystem, u8 flags,
+//                    u32 protocolVersion, i64 timestamp (us since epoch),
+//                    proofBytes, publicInputs, modelHash, inputHash,
+//                    outputHash, executionHash, taskId, workerId, circuitId,
+//                    then, when flagged: u64 nonce, proverSignature,
+//                    proverPubkey, u64 proofGenTime (ms), u64 proofSizeBytes,
+//                    u64 gasConsumed
+//
+//   VerificationKey v1: "AVK" u8 version, u8 proofSystem, u8 hashFunction,
+//                    u8 flags, u32 securityBits, i64 createdAt (us),
+//                    id, data, vkHash, then, when flagged:
+//                    circuitCommitment, i64 expiresAt (us), setupCeremonyHash
+//
+// Timestamps round-trip at microsecond precision.
+
+#pragma once
+
+#include "ZKVerifier.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace ailee::zk {
+
+constexpr std::uint8_t kProofBundleCodecVersion = 1;
+constexpr std::uint8_t kVerificationKeyCodecVersion = 1;
+
+// Bytes inside a parsed buffer.
+struct BytesRef {
+    const std::uint8_t* data = nullptr;
+    std::size_t size = 0;
+
+    // Throws std::out_of_range past the end.
+    std::uint8_t at(std::size_t i) const;
+    std::string_view str() const { return {reinterpret_cast<const char*>(data), size}; }
+    std::vector<std::uint8_t> toVector() const { return {data, data + size}; }
+    const std::uint8_t* begin() const { return data; }
+    const std::uint8_t* end() const { return data + size; }
+};
+
+/**
+ * Read-only view of an encoded ProofBundle. parse() checks the whole buffer
+ * in one pass without allocating and rejects anything malformed, truncated
+ * or with trailing bytes; accessors then read straight from the buffer,
+ * which must outlive the view.
+ */
+class ProofBundleView {
+public:
+    static std::optional<ProofBundleView> parse(const std::uint8_t* data, std::size_t size);
+    static std::optional<ProofBundleView> parse(const std::vector<std::uint8_t>& data) {
+        return parse(data.data(), data.size());
+    }
+
+    std::uint8_t version() const { return version_; }
+    ProofSystem proofSystem() const { return proofSystem_; }
+    std::uint32_t protocolVersion() const { return protocolVersion_; }
+    std::chrono::system_clock::time_point timestamp() const;
+
+    BytesRef proofBytes() const { return proofBytes_; }
+    BytesRef publicInputs() const { return publicInputs_; }
+    std::string_view modelHash() const { return modelHash_.str(); }
+    std::string_view inputHash() const { return inputHash_.str(); }
+    std::string_view outputHash() const { return outputHash_.str(); }
+    std::string_view executionHash() const { return executionHash_.str(); }
+    std::string_view taskId() const { return taskId_.str(); }
+    std::string_view workerId() const { return workerId_.str(); }
+    std::string_view circuitId() const { return circuitId_.str(); }
+
+    std::optional<std::uint64_t> nonce() const { return nonce_; }
+    std::optional<BytesRef> proverSignature() const { return proverSignature_; }
+    std::optional<std::string_view> proverPubkey() const;
+    std::optional<std::chrono::milliseconds> proofGenTime() const { return proofGenTime_; }
+    std::optional<std::size_t> proofSizeBytes() const { return proofSizeBytes_; }
+    std::optional<std::uint64_t> gasConsumed() const { return gasConsumed_; }
+
+    // Copies the view into an owning ProofBundle.
+    ProofBundle materialize() const;
+
+private:
+    ProofBundleView() = default;
+
+    std::uint8_t version_ = 0;
+    ProofSystem proofSystem_ = ProofSystem::AUTO;
+    std::uint32_t protocolVersion_ = 0;
+    std::int64_t timestampMicros_ = 0;
+    BytesRef proofBytes_;
+    BytesRef publicInputs_;
+    BytesRef modelHash_;
+    BytesRef inputHash_;
+    BytesRef outputHash_;
+    BytesRef executionHash_;
+    BytesRef taskId_;
+    BytesRef workerId_;
+    BytesRef circuitId_;
+    std::optional<std::uint64_t> nonce_;
+    std::optional<BytesRef> proverSignature_;
+    std::optional<BytesRef> proverPubkey_;
+    std::optional<std::chrono::milliseconds> proofGenTime_;
+    std::optional<std::size_t> proofSizeBytes_;
+    std::optional<std::uint64_t> gasConsumed_;
+};
+
+// Read-only view of an encoded VerificationKey; same contract as ProofBundleView.
+class VerificationKeyView {
+public:
+    static std::optional<VerificationKeyView> parse(const std::uint8_t* data, std::size_t size);
+    static std::optional<VerificationKeyView> parse(const std::vector<std::uint8_t>& data) {
+        return parse(data.data(), data.size());
+    }
+
+    std::uint8_t version() const { return version_; }
+    ProofSystem proofSystem() const { return proofSystem_; }
+    HashFunction hashFunction() const { return hashFunction_; }
+    std::uint32_t securityBits() const { return securityBits_; }
+    bool isTrustedSetup() const { return isTrustedSetup_; }
+    std::chrono::system_clock::time_point createdAt() const;
+
+    std::string_view id() const { return id_.str(); }
+    BytesRef data() const { return data_; }
+    std::string_view vkHash() const { return vkHash_.str(); }
+    std::optional<std::string_view> circuitCommitment() const;
+    std::optional<std::chrono::system_clock::time_point> expiresAt() const;
+    std::optional<std::string_view> setupCeremonyHash() const;
+
+    VerificationKey materialize() const;
+
+private:
+    VerificationKeyView() = default;
+
+    std::uint8_t version_ = 0;
+    ProofSystem proofSystem_ = ProofSystem::AUTO;
+    HashFunction hashFunction_ = HashFunction::SHA3_256;
+    std::uint32_t securityBits_ = 0;
+    bool isTrustedSetup_ = false;
+    std::int64_t createdAtMicros_ = 0;
+    BytesRef id_;
+    BytesRef data_;
+    BytesRef vkHash_;
+    std::optional<BytesRef> circuitCommitment_;
+    std::optional<std::int64_t> expiresAtMicros_;
+    std::optional<BytesRef> setupCeremonyHash_;
+};
+
+} // namespace ailee::zk
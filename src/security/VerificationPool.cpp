@@ -0,0 +1,443 @@
+// SPDX-License-Identifier: MIT
+// VerificationPool.cpp — Shared worker pool for proof verification
+//
+// Each worker owns one IVerifier and the set of keys loaded into it, so a key
+// is loaded once per worker rather than once per proof. Submissions go
+// through a bounded ring guarded by one mutex; producers block (or fail, for
+// trySubmitAsync) when it is full. Latency is recorded into power-of-two
+// buckets with relaxed atomics so getStats() never contends with workers.
+
+#include "ZKVerifier.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace ailee::zk {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Largest chunk a batch submission hands to one worker, so a huge batch
+// still interleaves with other traffic.
+constexpr std::size_t kMaxBatchChunk = 256;
+
+VerifyResult errorResult(VerificationError code, const std::string& reason) {
+    VerifyResult result;
+    result.verified = false;
+    result.reason = reason;
+    result.errorCode = static_cast<uint32_t>(code);
+    return result;
+}
+
+VerifyResult shutdownResult() {
+    return errorResult(VerificationError::VERIFIER_ERROR, "Verification pool is shut down");
+}
+
+bool sameKey(const VerificationKey& a, const VerificationKey& b) {
+    if (a.proofSystem != b.proofSystem || a.vkHash != b.vkHash || a.data.size() != b.data.size()) {
+        return false;
+    }
+    // The hash stands in for the blob when present.
+    return !a.vkHash.empty() || a.data == b.data;
+}
+
+class LatencyHistogram {
+public:
+    static constexpr std::size_t kBuckets = 40;
+
+    void record(uint64_t micros, uint64_t count) {
+        buckets_[bucketFor(micros)].fetch_add(count, std::memory_order_relaxed);
+        sumMicros_.fetch_add(micros * count, std::memory_order_relaxed);
+        count_.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    uint64_t sumMicros() const { return sumMicros_.load(std::memory_order_relaxed); }
+
+    // Upper bound of the bucket holding quantile q, from a relaxed snapshot.
+    uint64_t quantileUpperBound(double q) const {
+        uint64_t snapshot[kBuckets];
+        uint64_t total = 0;
+        for (std::size_t i = 0; i < kBuckets; ++i) {
+            snapshot[i] = buckets_[i].load(std::memory_order_relaxed);
+            total += snapshot[i];
+        }
+        if (total == 0) return 0;
+        const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(q * static_cast<double>(total) + 0.999999));
+        uint64_t seen = 0;
+        for (std::size_t i = 0; i < kBuckets; ++i) {
+            seen += snapshot[i];
+            if (seen >= rank) return upperBound(i);
+        }
+        return upperBound(kBuckets - 1);
+    }
+
+private:
+    // Bucket i holds values with bit width i: 0, 1, 2-3, 4-7, ...
+    static std::size_t bucketFor(uint64_t micros) {
+        std::size_t width = 0;
+        while (micros != 0 && width < kBuckets - 1) {
+            ++width;
+            micros >>= 1;
+        }
+        return width;
+    }
+
+    static uint64_t upperBound(std::size_t bucket) {
+        return bucket == 0 ? 0 : (uint64_t{1} << bucket) - 1;
+    }
+
+    std::atomic<uint64_t> buckets_[kBuckets] = {};
+    std::atomic<uint64_t> sumMicros_{0};
+    std::atomic<uint64_t> count_{0};
+};
+
+struct Task {
+    std::vector<ProofBundle> bundles;
+    std::shared_ptr<const VerificationKey> vk;
+    // Receives one result per bundle, in order.
+    std::function<void(std::vector<VerifyResult>&&)> done;
+};
+
+struct Worker {
+    std::unique_ptr<IVerifier> verifier;
+    std::mutex mutex; // Held while the verifier is in use
+    std::unordered_map<std::string, std::shared_ptr<const VerificationKey>> loaded;
+    std::thread thread;
+};
+
+VerifierFactory::VerifierConstructor systemConstructor(ProofSystem system) {
+    if (!VerifierFactory::isVerifierAvailable(system)) {
+        throw std::runtime_error("No verifier registered for " + VerifierFactory::getProofSystemName(system));
+    }
+    return [system] { return VerifierFactory::create(system); };
+}
+
+} // namespace
+
+struct VerificationPool::Impl {
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    std::mutex queueMutex;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+    std::vector<Task> slots;
+    std::size_t head = 0;
+    std::size_t count = 0;
+    bool stopping = false;
+
+    std::mutex shutdownMutex;
+
+    std::shared_mutex keysMutex;
+    std::unordered_map<std::string, std::shared_ptr<const VerificationKey>> keys;
+
+    LatencyHistogram latency;
+    std::atomic<std::size_t> queued{0};
+    std::atomic<std::size_t> active{0};
+    std::atomic<std::size_t> failed{0};
+
+    static thread_local const Impl* currentPool;
+    static thread_local Worker* currentWorker;
+
+    // Returns the pool's shared copy of vk, so workers can tell by pointer
+    // whether they already hold it.
+    std::shared_ptr<const VerificationKey> intern(const VerificationKey& vk) {
+        {
+            std::shared_lock<std::shared_mutex> lock(keysMutex);
+            auto it = keys.find(vk.id);
+            if (it != keys.end() && sameKey(*it->second, vk)) {
+                return it->second;
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(keysMutex);
+        auto& slot = keys[vk.id];
+        if (!slot || !sameKey(*slot, vk)) {
+            slot = std::make_shared<const VerificationKey>(vk);
+        }
+        return slot;
+    }
+
+    // Caller holds worker.mutex.
+    static bool ensureKey(Worker& worker, const std::shared_ptr<const VerificationKey>& vk, std::string* err) {
+        auto it = worker.loaded.find(vk->id);
+        if (it != worker.loaded.end()) {
+            if (it->second == vk) return true;
+            // Same id, different key material: replace it.
+            worker.verifier->unloadKey(vk->id);
+            worker.loaded.erase(it);
+        }
+        if (!worker.verifier->loadKey(*vk, err)) {
+            return false;
+        }
+        worker.loaded.emplace(vk->id, vk);
+        return true;
+    }
+
+    // Caller holds worker.mutex.
+    static std::vector<VerifyResult> verifyLocked(Worker& worker, const std::vector<ProofBundle>& bundles,
+                                                  const std::shared_ptr<const VerificationKey>& vk) {
+        const std::size_t n = bundles.size();
+        std::string err;
+        if (!ensureKey(worker, vk, &err)) {
+            return std::vector<VerifyResult>(n, errorResult(VerificationError::VK_NOT_LOADED,
+                "Failed to load verification key " + vk->id + (err.empty() ? "" : ": " + err)));
+        }
+        try {
+            if (n == 1) {
+                return {worker.verifier->verify(bundles.front())};
+            }
+            auto results = worker.verifier->verifyBatch(bundles);
+            if (results.size() != n) {
+                results.resize(n, errorResult(VerificationError::VERIFIER_ERROR,
+                                              "Verifier returned no result for this proof"));
+            }
+            return results;
+        } catch (const std::exception& e) {
+            return std::vector<VerifyResult>(n, errorResult(VerificationError::VERIFIER_ERROR, e.what()));
+        }
+    }
+
+    std::vector<VerifyResult> verifyOn(Worker& worker, const std::vector<ProofBundle>& bundles,
+                                       const std::shared_ptr<const VerificationKey>& vk) {
+        active.fetch_add(1, std::memory_order_relaxed);
+        const auto start = Clock::now();
+        std::vector<VerifyResult> results;
+        {
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            results = verifyLocked(worker, bundles, vk);
+        }
+        const auto micros = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count());
+        active.fetch_sub(1, std::memory_order_relaxed);
+
+        const std::size_t n = bundles.size();
+        latency.record(micros / n, n);
+        const auto failures = std::count_if(results.begin(), results.end(),
+                                            [](const VerifyResult& r) { return !r.verified; });
+        failed.fetch_add(static_cast<std::size_t>(failures), std::memory_order_relaxed);
+        return results;
+    }
+
+    // Moves from task only when it is accepted.
+    bool push(Task& task, bool block) {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        if (block) {
+            notFull.wait(lock, [&] { return count < slots.size() || stopping; });
+        }
+        if (stopping || count == slots.size()) {
+            return false;
+        }
+        slots[(head + count) % slots.size()] = std::move(task);
+        ++count;
+        queued.store(count, std::memory_order_relaxed);
+        lock.unlock();
+        notEmpty.notify_one();
+        return true;
+    }
+
+    void workerLoop(Worker& worker) {
+        currentPool = this;
+        currentWorker = &worker;
+        for (;;) {
+            Task task;
+            {
+                std::unique_lock<std::mutex> lock(queueMutex);
+                notEmpty.wait(lock, [&] { return count > 0 || stopping; });
+                if (count == 0) {
+                    return; // Stopping and drained
+                }
+                task = std::move(slots[head]);
+                head = (head + 1) % slots.size();
+                --count;
+                queued.store(count, std::memory_order_relaxed);
+            }
+            notFull.notify_one();
+
+            auto results = verifyOn(worker, task.bundles, task.vk);
+            try {
+                task.done(std::move(results));
+            } catch (...) {
+                // A throwing callback must not take the worker down with it.
+            }
+        }
+    }
+};
+
+thread_local const VerificationPool::Impl* VerificationPool::Impl::currentPool = nullptr;
+thread_local Worker* VerificationPool::Impl::currentWorker = nullptr;
+
+// ==================== LIFECYCLE ====================
+
+VerificationPool::VerificationPool(std::size_t poolSize, ProofSystem system)
+    : VerificationPool(poolSize, systemConstructor(system)) {}
+
+VerificationPool::VerificationPool(std::size_t poolSize,
+                                   VerifierFactory::VerifierConstructor makeVerifier,
+                                   std::size_t queueCapacity)
+    : pImpl_(std::make_unique<Impl>()) {
+    if (!makeVerifier) {
+        throw std::invalid_argument("VerificationPool requires a verifier constructor");
+    }
+    poolSize = std::max<std::size_t>(poolSize, 1);
+    pImpl_->slots.resize(std::max<std::size_t>(queueCapacity, 1));
+
+    // Build every verifier before any thread starts so a failure leaves
+    // nothing running.
+    for (std::size_t i = 0; i < poolSize; ++i) {
+        auto worker = std::make_unique<Worker>();
+        worker->verifier = makeVerifier();
+        if (!worker->verifier) {
+            throw std::runtime_error("Verifier constructor returned null");
+        }
+        pImpl_->workers.push_back(std::move(worker));
+    }
+    for (auto& worker : pImpl_->workers) {
+        Worker* w = worker.get();
+        Impl* impl = pImpl_.get();
+        worker->thread = std::thread([impl, w] { impl->workerLoop(*w); });
+    }
+}
+
+VerificationPool::~VerificationPool() {
+    shutdown();
+}
+
+void VerificationPool::shutdown() {
+    std::lock_guard<std::mutex> guard(pImpl_->shutdownMutex);
+    {
+        std::lock_guard<std::mutex> lock(pImpl_->queueMutex);
+        pImpl_->stopping = true;
+    }
+    pImpl_->notEmpty.notify_all();
+    pImpl_->notFull.notify_all();
+    for (auto& worker : pImpl_->workers) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+}
+
+// ==================== KEYS ====================
+
+bool VerificationPool::preloadKey(const VerificationKey& vk, std::string* err) {
+    auto key = pImpl_->intern(vk);
+    for (auto& worker : pImpl_->workers) {
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        if (!Impl::ensureKey(*worker, key, err)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ==================== SUBMISSION ====================
+
+void VerificationPool::submitAsync(const ProofBundle& bundle,
+                                   const VerificationKey& vk,
+                                   ResultCallback callback) {
+    Task task;
+    task.bundles.push_back(bundle);
+    task.vk = pImpl_->intern(vk);
+    task.done = [cb = std::move(callback)](std::vector<VerifyResult>&& results) {
+        cb(std::move(results.front()));
+    };
+    if (!pImpl_->push(task, true)) {
+        task.done({shutdownResult()});
+    }
+}
+
+bool VerificationPool::trySubmitAsync(const ProofBundle& bundle,
+                                      const VerificationKey& vk,
+                                      ResultCallback callback) {
+    Task task;
+    task.bundles.push_back(bundle);
+    task.vk = pImpl_->intern(vk);
+    task.done = [cb = std::move(callback)](std::vector<VerifyResult>&& results) {
+        cb(std::move(results.front()));
+    };
+    return pImpl_->push(task, false);
+}
+
+VerifyResult VerificationPool::verifySync(const ProofBundle& bundle,
+                                          const VerificationKey& vk) {
+    // From inside a callback, queueing behind ourselves could deadlock.
+    if (Impl::currentPool == pImpl_.get()) {
+        return pImpl_->verifyOn(*Impl::currentWorker, {bundle}, pImpl_->intern(vk)).front();
+    }
+    std::promise<VerifyResult> promise;
+    auto future = promise.get_future();
+    submitAsync(bundle, vk, [&promise](VerifyResult result) {
+        promise.set_value(std::move(result));
+    });
+    return future.get();
+}
+
+void VerificationPool::submitBatchAsync(const std::vector<ProofBundle>& bundles,
+                                        const VerificationKey& vk,
+                                        std::function<void(std::vector<VerifyResult>)> callback) {
+    if (bundles.empty()) {
+        callback({});
+        return;
+    }
+
+    struct BatchState {
+        std::vector<VerifyResult> results;
+        std::atomic<std::size_t> remaining{0};
+        std::function<void(std::vector<VerifyResult>)> callback;
+    };
+
+    const std::size_t n = bundles.size();
+    const std::size_t workers = pImpl_->workers.size();
+    const std::size_t chunk = std::min(kMaxBatchChunk, (n + workers - 1) / workers);
+    const std::size_t chunks = (n + chunk - 1) / chunk;
+
+    auto state = std::make_shared<BatchState>();
+    state->results.resize(n);
+    state->remaining.store(chunks, std::memory_order_relaxed);
+    state->callback = std::move(callback);
+    auto key = pImpl_->intern(vk);
+
+    for (std::size_t offset = 0; offset < n; offset += chunk) {
+        const std::size_t len = std::min(chunk, n - offset);
+        Task task;
+        task.bundles.assign(bundles.begin() + static_cast<std::ptrdiff_t>(offset),
+                            bundles.begin() + static_cast<std::ptrdiff_t>(offset + len));
+        task.vk = key;
+        task.done = [state, offset](std::vector<VerifyResult>&& results) {
+            std::move(results.begin(), results.end(),
+                      state->results.begin() + static_cast<std::ptrdiff_t>(offset));
+            if (state->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                state->callback(std::move(state->results));
+            }
+        };
+        if (!pImpl_->push(task, true)) {
+            task.done(std::vector<VerifyResult>(len, shutdownResult()));
+        }
+    }
+}
+
+// ==================== STATS ====================
+
+VerificationPool::PoolStats VerificationPool::getStats() const {
+    PoolStats stats;
+    const uint64_t total = pImpl_->latency.count();
+    stats.totalVerifications = static_cast<std::size_t>(total);
+    stats.activeWorkers = pImpl_->active.load(std::memory_order_relaxed);
+    stats.queuedTasks = pImpl_->queued.load(std::memory_order_relaxed);
+    stats.failedVerifications = pImpl_->failed.load(std::memory_order_relaxed);
+    if (total > 0) {
+        stats.avgVerificationTime = std::chrono::milliseconds(pImpl_->latency.sumMicros() / total / 1000);
+    }
+    stats.p50VerificationTime = std::chrono::microseconds(pImpl_->latency.quantileUpperBound(0.50));
+    stats.p99VerificationTime = std::chrono::microseconds(pImpl_->latency.quantileUpperBound(0.99));
+    return stats;
+}
+
+} // namespace ailee::zk
@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: MIT
+// VerifierFactory.cpp — Registry of IVerifier implementations by proof system
+
+#include "ZKVerifier.h"
+
+#include <algorithm>
+#include <cctype>
+#include <map>
+#include <mutex>
+
+namespace ailee::zk {
+
+namespace {
+
+struct VerifierRegistry {
+    std::mutex mutex;
+    std::map<ProofSystem, VerifierFactory::VerifierConstructor> constructors;
+};
+
+VerifierRegistry& registry() {
+    static VerifierRegistry instance;
+    return instance;
+}
+
+const std::pair<ProofSystem, const char*> kProofSystemNames[] = {
+    {ProofSystem::RISC_ZERO, "RISC_ZERO"},
+    {ProofSystem::SP1, "SP1"},
+    {ProofSystem::GROTH16, "GROTH16"},
+    {ProofSystem::PLONK, "PLONK"},
+    {ProofSystem::STARK, "STARK"},
+    {ProofSystem::HALO2, "HALO2"},
+    {ProofSystem::BULLETPROOFS, "BULLETPROOFS"},
+    {ProofSystem::CUSTOM_ZKML, "CUSTOM_ZKML"},
+    {ProofSystem::AUTO, "AUTO"},
+};
+
+} // namespace
+
+std::unique_ptr<IVerifier> VerifierFactory::create(ProofSystem system) {
+    VerifierConstructor ctor;
+    {
+        auto& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        auto it = reg.constructors.find(system);
+        if (it == reg.constructors.end()) {
+            return nullptr;
+        }
+        ctor = it->second;
+    }
+    return ctor();
+}
+
+std::unique_ptr<IVerifier> VerifierFactory::createFromString(const std::string& implId) {
+    auto system = parseProofSystem(implId);
+    return system ? create(*system) : nullptr;
+}
+
+std::vector<ProofSystem> VerifierFactory::getAvailableVerifiers() {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    std::vector<ProofSystem> systems;
+    systems.reserve(reg.constructors.size());
+    for (const auto& [system, ctor] : reg.constructors) {
+        systems.push_back(system);
+    }
+    return systems;
+}
+
+bool VerifierFactory::isVerifierAvailable(ProofSystem system) {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    return reg.constructors.count(system) > 0;
+}
+
+std::string VerifierFactory::getProofSystemName(ProofSystem system) {
+    for (const auto& [value, name] : kProofSystemNames) {
+        if (value == system) return name;
+    }
+    return "UNKNOWN";
+}
+
+std::optional<ProofSystem> VerifierFactory::parseProofSystem(const std::string& name) {
+    std::string upper(name);
+    std::transform(upper.begin(), upper.end(), upper.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+    for (const auto& [value, known] : kProofSystemNames) {
+        if (upper == known) return value;
+    }
+    return std::nullopt;
+}
+
+void VerifierFactory::registerVerifier(ProofSystem system, VerifierConstructor ctor) {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    if (ctor) {
+        reg.constructors[system] = std::move(ctor);
+    } else {
+        reg.constructors.erase(system);
+    }
+}
+
+} // namespace ailee::zk
@@ -352,17 +352,37 @@ namespace utils {
 
 // ==================== NONCE MANAGER (REPLAY PROTECTION) ====================
 
+/**
+ * Per-worker sliding replay windows. Each worker keeps the highest nonce it
+ * has used plus a kWindowBits bitmap of the nonces just below it, so checks
+ * are O(1) under one shard lock. Nonces older than the window count as seen.
+ * maxTrackedNonces caps live windows at maxTrackedNonces / kWindowBits;
+ * beyond that, the least recently active worker's window is dropped. A
+ * dropped window (by capacity or cleanupOldNonces) keeps only the worker's
+ * high-water mark, and nonces at or below it stay rejected. At most four
+ * such marks are kept per window slot. Older ones fold into a per-shard floor
+ * that applies to every worker the shard no longer remembers, so memory
+ * stays bounded however many worker ids are seen. The cost is that an
+ * unknown worker's nonces at or below that floor are rejected.
+ */
 class NonceManager {
 public:
+    static constexpr std::size_t kWindowBits = 256;
+
     explicit NonceManager(std::size_t maxTrackedNonces = 100000);
+    ~NonceManager();
     
     // Check if nonce has been seen before
     bool hasNonce(uint64_t nonce, const std::string& workerId) const;
     
     // Mark nonce as used
     void markNonceUsed(uint64_t nonce, const std::string& workerId);
+
+    // Mark nonce as used if it is fresh; returns false on replay. Prefer this
+    // to hasNonce + markNonceUsed, which can race.
+    bool checkAndMark(uint64_t nonce, const std::string& workerId);
     
-    // Cleanup old nonces (garbage collection)
+    // Drop windows of workers idle for longer than maxAge. Costs O(expired).
     void cleanupOldNonces(std::chrono::seconds maxAge);
     
     // Get statistics
@@ -370,6 +390,7 @@ public:
         std::size_t totalTracked = 0;
         std::size_t replayAttempts = 0;
         std::size_t uniqueWorkers = 0;
+        std::size_t retiredWorkers = 0;   // Workers remembered only by a floor
     };
     NonceStats getStats() const;
     
@@ -382,20 +403,43 @@ private:
 
 class VerificationPool {
 public:
+    static constexpr std::size_t kDefaultQueueCapacity = 1024;
+
+    // Workers use verifiers from VerifierFactory::create(system); throws
+    // std::runtime_error when none is registered for the system.
     explicit VerificationPool(std::size_t poolSize, ProofSystem system);
+
+    // Workers use verifiers built by makeVerifier (one per worker).
+    VerificationPool(std::size_t poolSize,
+                     VerifierFactory::VerifierConstructor makeVerifier,
+                     std::size_t queueCapacity = kDefaultQueueCapacity);
     ~VerificationPool();
     
-    // Submit verification task asynchronously
+    // Load a key into every worker's verifier ahead of traffic. Keys seen
+    // only through submissions are loaded by each worker on first use.
+    bool preloadKey(const VerificationKey& vk, std::string* err);
+
+    // Submit verification task asynchronously. Blocks while the queue is
+    // full; after shutdown the callback receives a VERIFIER_ERROR result.
+    // Callbacks run on a worker thread.
     using ResultCallback = std::function<void(VerifyResult)>;
     void submitAsync(const ProofBundle& bundle,
                      const VerificationKey& vk,
                      ResultCallback callback);
+
+    // Non-blocking submit; returns false (callback not invoked) when the
+    // queue is full or the pool is shut down.
+    bool trySubmitAsync(const ProofBundle& bundle,
+                        const VerificationKey& vk,
+                        ResultCallback callback);
     
     // Verify synchronously (blocking)
     VerifyResult verifySync(const ProofBundle& bundle,
                             const VerificationKey& vk);
     
-    // Batch verification (optimized for throughput)
+    // Batch verification (optimized for throughput). The batch is split into
+    // worker-sized chunks run through IVerifier::verifyBatch; the callback
+    // fires once with results in input order.
     void submitBatchAsync(const std::vector<ProofBundle>& bundles,
                           const VerificationKey& vk,
                           std::function<void(std::vector<VerifyResult>)> callback);
@@ -407,6 +451,9 @@ public:
         std::size_t queuedTasks = 0;
         std::chrono::milliseconds avgVerificationTime{0};
         std::size_t failedVerifications = 0;
+        // Upper bounds of the power-of-two latency buckets holding the quantile
+        std::chrono::microseconds p50VerificationTime{0};
+        std::chrono::microseconds p99VerificationTime{0};
     };
     PoolStats getStats() const;
     
@@ -56,6 +56,64 @@ void free_halo2_proof_ffi(Halo2ProofOutput* proof_ptr) {
     }
 }
 
+namespace {
+
+const char kMockProofPrefix[] = "halo2_proof_mock_";
+constexpr size_t kMockProofPrefixLen = sizeof(kMockProofPrefix) - 1;
+// Prefix followed by the hex-encoded computation digest, matching what
+// generate_halo2_proof_ffi produces for the same hash in hex.
+constexpr size_t kMockProofLen = kMockProofPrefixLen + 2 * HALO2_DIGEST_LEN;
+constexpr size_t kMockItemLen = kMockProofLen + HALO2_COMMITMENT_LEN;
+
+} // namespace
+
+size_t halo2_proof_arena_bound_ffi(size_t count) {
+    return count * kMockItemLen;
+}
+
+int generate_halo2_proofs_batch_ffi(const unsigned char* task_digests,
+                                    const unsigned char* computation_digests,
+                                    size_t count,
+                                    Halo2ProofArena* arena,
+                                    Halo2ProofSlice* out_slices,
+                                    int* out_status) {
+    if (count == 0) {
+        return 0;
+    }
+    if (!task_digests || !computation_digests || !arena || !arena->base ||
+        arena->used > arena->capacity || !out_slices || !out_status) {
+        return -1;
+    }
+    static const char* kHex = "0123456789abcdef";
+    int proved = 0;
+    for (size_t i = 0; i < count; ++i) {
+        Halo2ProofSlice& slice = out_slices[i];
+        if (arena->capacity - arena->used < kMockItemLen) {
+            slice = Halo2ProofSlice{0, 0, 0, 0};
+            out_status[i] = HALO2_ITEM_ARENA_FULL;
+            continue;
+        }
+        unsigned char* proof = arena->base + arena->used;
+        std::memcpy(proof, kMockProofPrefix, kMockProofPrefixLen);
+        const unsigned char* digest = computation_digests + i * HALO2_DIGEST_LEN;
+        unsigned char* hex = proof + kMockProofPrefixLen;
+        for (size_t b = 0; b < HALO2_DIGEST_LEN; ++b) {
+            hex[2 * b] = static_cast<unsigned char>(kHex[digest[b] >> 4]);
+            hex[2 * b + 1] = static_cast<unsigned char>(kHex[digest[b] & 0x0F]);
+        }
+        std::memset(proof + kMockProofLen, 0, HALO2_COMMITMENT_LEN);
+
+        slice.proof_offset = arena->used;
+        slice.proof_len = kMockProofLen;
+        slice.commitment_offset = arena->used + kMockProofLen;
+        slice.commitment_len = HALO2_COMMITMENT_LEN;
+        arena->used += kMockItemLen;
+        out_status[i] = HALO2_ITEM_OK;
+        ++proved;
+    }
+    return proved;
+}
+
 int init_network_ffi() {
     return -1;
 }
@@ -6,6 +6,7 @@
  */
 
 #include "zk_proofs.h"
+#include <algorithm>
 #include <iostream>
 #include <chrono>
 #include <functional>
@@ -63,6 +64,82 @@ Proof ZKEngine::generateHalo2Proof(const std::string& taskId, const std::string&
     return proof;
 }
 
+// -----------------------------
+// Batched Halo2 proving
+// -----------------------------
+void Halo2ProofBatch::clear() {
+    taskDigests_.clear();
+    computationDigests_.clear();
+    slices_.clear();
+    status_.clear();
+}
+
+void Halo2ProofBatch::reserve(std::size_t count) {
+    taskDigests_.reserve(count * HALO2_DIGEST_LEN);
+    computationDigests_.reserve(count * HALO2_DIGEST_LEN);
+    slices_.reserve(count);
+    status_.reserve(count);
+}
+
+void Halo2ProofBatch::add(const Digest32& taskDigest, const Digest32& computationDigest) {
+    taskDigests_.insert(taskDigests_.end(), taskDigest.begin(), taskDigest.end());
+    computationDigests_.insert(computationDigests_.end(), computationDigest.begin(), computationDigest.end());
+    slices_.push_back(Halo2ProofSlice{0, 0, 0, 0});
+    status_.push_back(HALO2_ITEM_PROVER_ERROR);
+}
+
+ByteView Halo2ProofBatch::proof(std::size_t i) const {
+    if (!ok(i)) return {};
+    return {arena_.data() + slices_[i].proof_offset, slices_[i].proof_len};
+}
+
+ByteView Halo2ProofBatch::commitment(std::size_t i) const {
+    if (!ok(i)) return {};
+    return {arena_.data() + slices_[i].commitment_offset, slices_[i].commitment_len};
+}
+
+Proof Halo2ProofBatch::toProof(std::size_t i) const {
+    static const char* kHex = "0123456789abcdef";
+    Proof out;
+    out.publicInput.reserve(2 * HALO2_DIGEST_LEN);
+    for (std::size_t b = 0; b < HALO2_DIGEST_LEN; ++b) {
+        uint8_t byte = computationDigests_[i * HALO2_DIGEST_LEN + b];
+        out.publicInput.push_back(kHex[byte >> 4]);
+        out.publicInput.push_back(kHex[byte & 0x0F]);
+    }
+    if (ok(i)) {
+        ByteView p = proof(i);
+        ByteView c = commitment(i);
+        out.proofData.assign(reinterpret_cast<const char*>(p.data), p.size);
+        out.commitmentBytes.assign(c.begin(), c.end());
+        out.verified = true;
+    }
+    return out;
+}
+
+std::size_t ZKEngine::generateHalo2Proofs(Halo2ProofBatch& batch) {
+    const std::size_t count = batch.size();
+    if (count == 0) return 0;
+
+    // Grow-only: a steady epoch size settles into zero allocations per run.
+    const std::size_t bound = halo2_proof_arena_bound_ffi(count);
+    if (batch.arena_.size() < bound) {
+        batch.arena_.resize(bound);
+    }
+    Halo2ProofArena arena{batch.arena_.data(), batch.arena_.size(), 0};
+    int res = generate_halo2_proofs_batch_ffi(batch.taskDigests_.data(),
+                                              batch.computationDigests_.data(),
+                                              count, &arena,
+                                              batch.slices_.data(),
+                                              batch.status_.data());
+    if (res < 0) {
+        std::fill(batch.status_.begin(), batch.status_.end(), HALO2_ITEM_PROVER_ERROR);
+        std::cerr << "Failed to generate batched Halo2 proofs via FFI\n";
+        return 0;
+    }
+    return static_cast<std::size_t>(res);
+}
+
 // -----------------------------
 // Verify Proof (DETERMINISTIC_MOCK_PROOF)
 // -----------------------------
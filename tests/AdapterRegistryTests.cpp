@@ -4,6 +4,7 @@
 
 #include "Global_Seven.h"
 #include <gtest/gtest.h>
+#include <stdexcept>
 
 using namespace ailee::global_seven;
 
@@ -48,7 +49,7 @@ TEST(AdapterRegistryTest, RegisterAndRetrieveAdapter) {
     registry.registerAdapter(Chain::Custom1, std::unique_ptr<IChainAdapter>(new DummyAdapter()));
 
     // Retrieve adapter
-    IChainAdapter* adapter = registry.get(Chain::Custom1);
+    std::shared_ptr<IChainAdapter> adapter = registry.get(Chain::Custom1);
     ASSERT_NE(adapter, nullptr);
 
     // Verify traits
@@ -59,7 +60,7 @@ TEST(AdapterRegistryTest, RegisterAndRetrieveAdapter) {
 
 TEST(AdapterRegistryTest, BroadcastTransactionWorks) {
     auto& registry = AdapterRegistry::instance();
-    IChainAdapter* adapter = registry.get(Chain::Custom1);
+    std::shared_ptr<IChainAdapter> adapter = registry.get(Chain::Custom1);
     ASSERT_NE(adapter, nullptr);
 
     std::string txid;
@@ -70,7 +71,7 @@ TEST(AdapterRegistryTest, BroadcastTransactionWorks) {
 
 TEST(AdapterRegistryTest, GetTransactionReturnsNormalizedTx) {
     auto& registry = AdapterRegistry::instance();
-    IChainAdapter* adapter = registry.get(Chain::Custom1);
+    std::shared_ptr<IChainAdapter> adapter = registry.get(Chain::Custom1);
     ASSERT_NE(adapter, nullptr);
 
     auto tx = adapter->getTransaction("abc123");
@@ -81,7 +82,7 @@ TEST(AdapterRegistryTest, GetTransactionReturnsNormalizedTx) {
 
 TEST(AdapterRegistryTest, GetBlockHeaderReturnsHeader) {
     auto& registry = AdapterRegistry::instance();
-    IChainAdapter* adapter = registry.get(Chain::Custom1);
+    std::shared_ptr<IChainAdapter> adapter = registry.get(Chain::Custom1);
     ASSERT_NE(adapter, nullptr);
 
     auto bh = adapter->getBlockHeader("blockhash");
@@ -92,7 +93,7 @@ TEST(AdapterRegistryTest, GetBlockHeaderReturnsHeader) {
 
 TEST(AdapterRegistryTest, GetBlockHeightReturnsValue) {
     auto& registry = AdapterRegistry::instance();
-    IChainAdapter* adapter = registry.get(Chain::Custom1);
+    std::shared_ptr<IChainAdapter> adapter = registry.get(Chain::Custom1);
     ASSERT_NE(adapter, nullptr);
 
     auto h = adapter->getBlockHeight();
@@ -157,3 +158,191 @@ TEST(AnchorCommitmentTest, BuildTaprootCommitmentKeyPath) {
     EXPECT_EQ(taprootPayload.scriptBytes[1], 0x20); // Push 32 bytes
     EXPECT_TRUE(taprootPayload.description.find("TAPROOT_KEY_PATH") != std::string::npos);
 }
+
+// Records broadcasts; optionally blocks until released.
+class RecordingAdapter : public DummyAdapter {
+public:
+    explicit RecordingAdapter(std::string prefix) : prefix_(std::move(prefix)) {}
+
+    bool broadcastTransaction(const std::vector<TxOut>& outputs,
+                              const std::unordered_map<std::string, std::string>& /*metadata*/,
+                              std::string& outChainTxId) override {
+        entered++;
+        if (blocked) {
+            std::unique_lock<std::mutex> lock(mu);
+            cv.wait(lock, [this]() { return !blocked.load(); });
+        }
+        outputsPerBroadcast.push_back(outputs.size());
+        outChainTxId = prefix_ + std::to_string(outputsPerBroadcast.size());
+        return true;
+    }
+
+    void release() {
+        {
+            std::lock_guard<std::mutex> lock(mu);
+            blocked = false;
+        }
+        cv.notify_all();
+    }
+
+    std::atomic<bool> blocked{false};
+    std::atomic<int> entered{0};
+    std::vector<size_t> outputsPerBroadcast;
+    std::mutex mu;
+    std::condition_variable cv;
+
+private:
+    std::string prefix_;
+};
+
+static SettlementIntent makeIntent(Chain target, const std::string& vault, double slippage = 0.01) {
+    SettlementIntent intent{};
+    intent.kind = SettlementKind::PegOut;
+    intent.sourceChain = Chain::Bitcoin;
+    intent.targetChain = target;
+    intent.slippagePolicy.maxSlippagePct = slippage;
+    intent.params["vaultId"] = vault;
+    intent.params["targetAddress"] = "addr-" + vault;
+    return intent;
+}
+
+TEST(SettlementOrchestratorTest, SlowChainDoesNotBlockOthersAndIntentsCoalesce) {
+    auto slowOwned = std::make_unique<RecordingAdapter>("slow-");
+    auto fastOwned = std::make_unique<RecordingAdapter>("fast-");
+    RecordingAdapter* slow = slowOwned.get();
+    RecordingAdapter* fast = fastOwned.get();
+    slow->blocked = true;
+    AdapterRegistry::instance().registerAdapter(Chain::Kusama, std::move(slowOwned));
+    AdapterRegistry::instance().registerAdapter(Chain::Custom2, std::move(fastOwned));
+
+    SettlementOrchestrator orchestrator([](const AdapterError&) {});
+
+    auto stuck = orchestrator.submit(makeIntent(Chain::Kusama, "v0"));
+
+    // Intents on another chain settle while the slow chain is still blocked.
+    std::vector<std::future<SettlementReceipt>> fastReceipts;
+    for (int i = 0; i < 6; ++i) {
+        fastReceipts.push_back(orchestrator.submit(makeIntent(Chain::Custom2, i % 2 == 0 ? "even" : "odd")));
+    }
+    auto invalid = orchestrator.submit(makeIntent(Chain::Custom2, "even", 0.0));
+
+    for (auto& f : fastReceipts) {
+        SettlementReceipt r = f.get();
+        EXPECT_TRUE(r.ok);
+        EXPECT_EQ(r.targetTxId.rfind("fast-", 0), 0u);
+    }
+    SettlementReceipt bad = invalid.get();
+    EXPECT_FALSE(bad.ok);
+    EXPECT_EQ(bad.risk.reason, "Invalid slippage policy.");
+
+    // Every broadcast carried at least one output and, in total, six.
+    size_t outputs = 0;
+    for (size_t n : fast->outputsPerBroadcast) outputs += n;
+    EXPECT_EQ(outputs, 6u);
+    EXPECT_TRUE(fast->outputsPerBroadcast.size() <= 6u);
+
+    EXPECT_EQ(stuck.wait_for(std::chrono::milliseconds(0)), std::future_status::timeout);
+    slow->release();
+    SettlementReceipt late = stuck.get();
+    EXPECT_TRUE(late.ok);
+    EXPECT_EQ(late.targetTxId, "slow-1");
+}
+
+TEST(SettlementOrchestratorTest, BatchSharesTxidAndBreakerAppliesToWholeBatch) {
+    auto ownedAdapter = std::make_unique<RecordingAdapter>("tx-");
+    RecordingAdapter* adapter = ownedAdapter.get();
+    adapter->blocked = true;
+    AdapterRegistry::instance().registerAdapter(Chain::Dash, std::move(ownedAdapter));
+
+    SettlementOrchestrator orchestrator([](const AdapterError&) {});
+
+    // The first intent occupies the worker; the next three queue behind it
+    // and are settled as one batch with one broadcast.
+    auto first = orchestrator.submit(makeIntent(Chain::Dash, "vault"));
+    while (adapter->entered.load() == 0) {
+        std::this_thread::yield();
+    }
+    std::vector<std::future<SettlementReceipt>> rest;
+    for (int i = 0; i < 3; ++i) {
+        rest.push_back(orchestrator.submit(makeIntent(Chain::Dash, "vault")));
+    }
+    adapter->release();
+
+    EXPECT_TRUE(first.get().ok);
+    std::string txid;
+    for (auto& f : rest) {
+        SettlementReceipt r = f.get();
+        EXPECT_TRUE(r.ok);
+        EXPECT_EQ(r.coalescedIntents, 3u);
+        if (txid.empty()) txid = r.targetTxId;
+        EXPECT_EQ(r.targetTxId, txid);
+    }
+    ASSERT_EQ(adapter->outputsPerBroadcast.size(), 2u);
+    EXPECT_EQ(adapter->outputsPerBroadcast[1], 3u);
+
+    RiskFlags breaker;
+    breaker.circuitBreakerTripped = true;
+    orchestrator.setRisk(breaker);
+    SettlementReceipt blocked = orchestrator.submit(makeIntent(Chain::Dash, "vault")).get();
+    EXPECT_FALSE(blocked.ok);
+    EXPECT_TRUE(blocked.risk.circuitBreakerTripped);
+
+    orchestrator.shutdown();
+    SettlementReceipt afterStop = orchestrator.submit(makeIntent(Chain::Dash, "vault")).get();
+    EXPECT_FALSE(afterStop.ok);
+    EXPECT_EQ(afterStop.risk.reason, "Orchestrator stopped.");
+}
+
+// Throws from broadcastTransaction until told otherwise.
+class ThrowingAdapter : public DummyAdapter {
+public:
+    bool broadcastTransaction(const std::vector<TxOut>& /*outputs*/,
+                              const std::unordered_map<std::string, std::string>& /*metadata*/,
+                              std::string& outChainTxId) override {
+        if (throwing) {
+            throw std::runtime_error("rpc down");
+        }
+        outChainTxId = "recovered";
+        return true;
+    }
+
+    std::atomic<bool> throwing{true};
+};
+
+TEST(SettlementOrchestratorTest, ThrowingAdapterAndCallbackDoNotStrandIntents) {
+    auto ownedAdapter = std::make_unique<ThrowingAdapter>();
+    ThrowingAdapter* adapter = ownedAdapter.get();
+    AdapterRegistry::instance().registerAdapter(Chain::Near, std::move(ownedAdapter));
+
+    std::atomic<int> errors{0};
+    SettlementOrchestrator orchestrator([&errors](const AdapterError&) { errors++; });
+
+    SettlementReceipt failed = orchestrator.submit(makeIntent(Chain::Near, "v")).get();
+    EXPECT_FALSE(failed.ok);
+    EXPECT_EQ(failed.risk.reason, "Broadcast threw at target adapter.");
+    EXPECT_TRUE(errors.load() >= 1);
+
+    // The lane survives the exception and keeps settling.
+    adapter->throwing = false;
+    SettlementReceipt ok = orchestrator.submit(makeIntent(Chain::Near, "v")).get();
+    EXPECT_TRUE(ok.ok);
+    EXPECT_EQ(ok.targetTxId, "recovered");
+
+    // A throwing callback is reported, and later intents still settle.
+    std::promise<void> called;
+    const int before = errors.load();
+    EXPECT_TRUE(orchestrator.submit(makeIntent(Chain::Near, "v"), [&called](const SettlementReceipt&) {
+        called.set_value();
+        throw std::runtime_error("callback bug");
+    }));
+    called.get_future().wait();
+    EXPECT_TRUE(orchestrator.submit(makeIntent(Chain::Near, "v")).get().ok);
+    EXPECT_TRUE(errors.load() > before);
+
+    SettlementIntent bogus = makeIntent(Chain::Near, "v");
+    bogus.targetChain = static_cast<Chain>(kChainCount + 3);
+    SettlementReceipt unknown = orchestrator.submit(bogus).get();
+    EXPECT_FALSE(unknown.ok);
+    EXPECT_EQ(unknown.risk.reason, "Unknown target chain.");
+    EXPECT_TRUE(AdapterRegistry::instance().get(bogus.targetChain) == nullptr);
+}
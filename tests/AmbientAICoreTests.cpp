@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include "AmbientAI-Core.h"
+#include <secp256k1.h>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace ambient;
+
+namespace {
+
+constexpr uint64_t kNowMs = 1'700'000'000'000ULL;
+
+std::array<uint8_t, 32> secretFor(uint8_t seed) {
+    std::array<uint8_t, 32> key{};
+    key.fill(seed);
+    key[0] = 0x01;
+    return key;
+}
+
+// Builds a reading for `serial` and signs its canonical digest with `seed`.
+EnergyProof makeProof(const std::string& serial, uint64_t toGridFp, uint8_t seed, uint64_t ageMs = 0) {
+    EnergyProof proof{};
+    proof.meterSerialNumber = serial;
+    proof.proofTimestampMs = kNowMs - ageMs;
+    proof.kWhGeneratedFp = toGridFp + 10;
+    proof.kWhToGridFp = toGridFp;
+    proof.wasteHeatRecoveredFp = 5;
+    proof.thermodynamicEfficiencyFp = FIXED_POINT_SCALE / 2;
+    proof.oracleAttestation = "oracle";
+    proof.latitudeFp = 515000;
+    proof.longitudeFp = -1200;
+    proof.gridRegion = "eu-west";
+
+    static secp256k1_context* ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
+    const auto secret = secretFor(seed);
+    secp256k1_pubkey pub;
+    EXPECT_EQ(secp256k1_ec_pubkey_create(ctx, &pub, secret.data()), 1);
+    proof.meterPublicKey.resize(33);
+    size_t pubLen = proof.meterPublicKey.size();
+    secp256k1_ec_pubkey_serialize(ctx, proof.meterPublicKey.data(), &pubLen, &pub, SECP256K1_EC_COMPRESSED);
+
+    const auto digest = proof.canonicalDigest();
+    secp256k1_ecdsa_signature sig;
+    EXPECT_EQ(secp256k1_ecdsa_sign(ctx, &sig, digest.data(), secret.data(), nullptr, nullptr), 1);
+    proof.smartMeterSignature.resize(72);
+    size_t sigLen = proof.smartMeterSignature.size();
+    secp256k1_ecdsa_signature_serialize_der(ctx, proof.smartMeterSignature.data(), &sigLen, &sig);
+    proof.smartMeterSignature.resize(sigLen);
+    return proof;
+}
+
+} // namespace
+
+TEST(AmbientAICoreTest, CanonicalDigestCoversEveryField) {
+    const EnergyProof base = makeProof("meter-1", 100, 7);
+    const auto digest = base.canonicalDigest();
+    EXPECT_TRUE(base.verifySignature());
+
+    EnergyProof changed = base;
+    changed.gridRegion = "eu-east";
+    EXPECT_TRUE(changed.canonicalDigest() != digest);
+    EXPECT_FALSE(changed.verifySignature());
+
+    changed = base;
+    changed.longitudeFp = 1200;
+    EXPECT_TRUE(changed.canonicalDigest() != digest);
+
+    // Length prefixes keep the serial/region boundary unambiguous.
+    changed = base;
+    changed.meterSerialNumber = "meter-1e";
+    changed.gridRegion = "u-west";
+    EXPECT_TRUE(changed.canonicalDigest() != digest);
+}
+
+TEST(AmbientAICoreTest, BatchMatchesSequentialVerification) {
+    std::vector<EnergyProof> proofs;
+    for (int i = 0; i < 40; ++i) {
+        proofs.push_back(makeProof("meter-" + std::to_string(i % 5), 100 + i, static_cast<uint8_t>(i % 5 + 2)));
+    }
+    proofs[3].smartMeterSignature[8] ^= 0x01;            // tampered signature
+    proofs[11] = makeProof("meter-1", 100, 9, 10 * 60 * 1000); // stale
+    proofs[17].oracleAttestation.clear();                 // no attestation
+
+    EnergyTelemetry sequential;
+    size_t sequentialAccepted = 0;
+    for (const auto& proof : proofs) {
+        if (sequential.verifyEnergyContribution(proof, kNowMs)) sequentialAccepted++;
+    }
+
+    EnergyTelemetry batched;
+    const auto result = batched.verifyEnergyContributions(proofs, kNowMs, 4);
+    EXPECT_EQ(result.acceptedCount, sequentialAccepted);
+    EXPECT_EQ(result.acceptedCount, proofs.size() - 3);
+    EXPECT_EQ(result.rejectedCount, 3u);
+    EXPECT_EQ(result.accepted[3], 0);
+    EXPECT_EQ(result.accepted[11], 0);
+    EXPECT_EQ(result.accepted[17], 0);
+    EXPECT_EQ(batched.verifiedCount(), sequential.verifiedCount());
+    EXPECT_EQ(batched.rejectedCount(), sequential.rejectedCount());
+    EXPECT_EQ(batched.verifiedKWhFp(), sequential.verifiedKWhFp());
+
+    const auto a = sequential.getContributions();
+    const auto b = batched.getContributions();
+    ASSERT_EQ(a.size(), b.size());
+    for (const auto& [serial, contrib] : a) {
+        const auto it = b.find(serial);
+        ASSERT_TRUE(it != b.end());
+        EXPECT_EQ(it->second.totalKWhContributedFp, contrib.totalKWhContributedFp);
+        EXPECT_EQ(it->second.proofCount, contrib.proofCount);
+        ASSERT_EQ(it->second.proofs.size(), contrib.proofs.size());
+        for (size_t i = 0; i < contrib.proofs.size(); ++i) {
+            EXPECT_EQ(it->second.proofs[i].kWhToGridFp, contrib.proofs[i].kWhToGridFp);
+        }
+    }
+}
+
+TEST(AmbientAICoreTest, PerMeterHistoryIsBounded) {
+    EnergyTelemetry telemetry;
+    const size_t total = EnergyTelemetry::kMaxRecentProofs + 10;
+    std::vector<EnergyProof> proofs;
+    uint64_t expectedKWh = 0;
+    for (size_t i = 0; i < total; ++i) {
+        proofs.push_back(makeProof("meter-x", i + 1, 3));
+        expectedKWh += i + 1;
+    }
+    const auto result = telemetry.verifyEnergyContributions(proofs, kNowMs);
+    EXPECT_EQ(result.acceptedCount, total);
+
+    const auto contrib = telemetry.getContribution("meter-x");
+    ASSERT_TRUE(contrib.has_value());
+    EXPECT_EQ(contrib->proofCount, total);
+    EXPECT_EQ(contrib->totalKWhContributedFp, expectedKWh);
+    ASSERT_EQ(contrib->proofs.size(), EnergyTelemetry::kMaxRecentProofs);
+    EXPECT_EQ(contrib->proofs.front().kWhToGridFp, 11u);
+    EXPECT_EQ(contrib->proofs.back().kWhToGridFp, total);
+    EXPECT_FALSE(telemetry.getContribution("meter-y").has_value());
+}
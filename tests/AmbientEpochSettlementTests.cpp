@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include "AmbientAI.h"
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace ambient;
+
+namespace {
+
+std::unique_ptr<AmbientNode> makeNode(const std::string& key) {
+    return std::make_unique<AmbientNode>(NodeId{key, "eu", "gateway"}, SafetyPolicy{});
+}
+
+void setSample(AmbientNode& node, uint64_t power, uint64_t eff, uint64_t priv) {
+    TelemetrySample s;
+    s.node = node.id();
+    s.compute.instantaneousPower_GFLOPSFp = power;
+    s.energy.computeEfficiency_GFLOPS_WFp = eff;
+    s.privacy.privacyBudgetRemainingFp = priv;
+    node.ingestTelemetry(s);
+}
+
+} // namespace
+
+TEST(EpochSettlementTest, MatchesPerNodeFormulasBitForBit) {
+    std::mt19937_64 rng(42);
+    // Mix protocol-range values with ones wide enough to take the 128-bit paths.
+    auto pick = [&](uint64_t small, uint64_t large) {
+        return (rng() % 4 == 0) ? rng() % large : rng() % small;
+    };
+
+    std::vector<std::unique_ptr<AmbientNode>> nodes;
+    std::vector<EpochParticipant> participants;
+    for (int i = 0; i < 2000; ++i) {
+        auto node = makeNode("node-" + std::to_string(i));
+        if (i % 7 != 0) {
+            setSample(*node, pick(500 * FIXED_POINT_SCALE, 1ULL << 62),
+                      pick(50 * FIXED_POINT_SCALE, 1ULL << 40),
+                      pick(FIXED_POINT_SCALE + 1, 1ULL << 36));
+        }
+        node->loadReputation("{\"scoreFp\": " + std::to_string(pick(FIXED_POINT_SCALE + 1, 1ULL << 52)) + "}");
+        EpochParticipant p;
+        p.node = node.get();
+        p.success = rng() % 3 != 0;
+        p.slaFp = pick(FIXED_POINT_SCALE + 1, 1ULL << 60);
+        p.uptimeMs = static_cast<int64_t>(rng() % 100000000) - 1000;
+        participants.push_back(p);
+        nodes.push_back(std::move(node));
+    }
+
+    const uint64_t baseRateFp = 12345;
+    std::vector<IncentiveRecord> expectedRewards;
+    std::vector<uint64_t> expectedScores;
+    for (const auto& p : participants) {
+        expectedRewards.push_back(calculateTokenReward(*p.node, baseRateFp));
+        expectedScores.push_back(updateReputationScoreFp(*p.node, p.success, p.slaFp, p.uptimeMs));
+    }
+
+    EpochSettlementEngine engine;
+    auto result = engine.settle(participants, baseRateFp);
+    ASSERT_EQ(result.rewardFp.size(), participants.size());
+    ASSERT_EQ(result.reputationFp.size(), participants.size());
+    for (std::size_t i = 0; i < participants.size(); ++i) {
+        EXPECT_EQ(result.rewardFp[i], expectedRewards[i].rewardTokensFp);
+        EXPECT_EQ(result.reputationFp[i], expectedScores[i]);
+        EXPECT_EQ(participants[i].node->reputation().scoreFp, expectedScores[i]);
+    }
+}
+
+TEST(EpochSettlementTest, RewardsUseReputationFromEpochClose) {
+    auto node = makeNode("solo");
+    setSample(*node, 40 * FIXED_POINT_SCALE, 2 * FIXED_POINT_SCALE, FIXED_POINT_SCALE);
+    node->loadReputation("{\"scoreFp\": 8000}");
+    const auto expected = calculateTokenReward(*node, 10);
+
+    EpochParticipant p;
+    p.node = node.get();
+    p.success = false;
+
+    EpochSettlementEngine engine;
+    auto first = engine.settle({p}, 10);
+    EXPECT_EQ(first.rewardFp[0], expected.rewardTokensFp);
+    EXPECT_EQ(node->reputation().scoreFp, first.reputationFp[0]);
+    EXPECT_TRUE(first.reputationFp[0] < 8000);
+
+    // The next epoch sees the lowered score; buffers are reused.
+    auto second = engine.settle({p}, 10);
+    EXPECT_TRUE(second.rewardFp[0] < first.rewardFp[0]);
+    EXPECT_TRUE(engine.settle({}, 10).rewardFp.empty());
+}
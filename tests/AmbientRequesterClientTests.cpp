@@ -0,0 +1,348 @@
+#include <gtest/gtest.h>
+#include "AmbientClient.h"
+#include "network/AmbientWire.h"
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace ailee::net;
+
+namespace {
+
+// Records every publish and lets the test deliver messages synchronously.
+class RecordingPubSub : public IPubSub {
+public:
+    NetworkError publish(const Message& m) override { return publish(m, PublishOptions{}); }
+    NetworkError publish(const Message& m, const PublishOptions&) override {
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            published_.push_back(m);
+        }
+        cv_.notify_all();
+        return NetworkError();
+    }
+    NetworkError subscribe(const std::string& topic, MessageHandler handler) override {
+        return subscribe(topic, std::move(handler), SubscriptionOptions{}, nullptr);
+    }
+    NetworkError subscribe(const std::string& topic, MessageHandler handler,
+                           const SubscriptionOptions&, SubscriptionId* outId) override {
+        std::lock_guard<std::mutex> lock(mu_);
+        const SubscriptionId id = next_id_++;
+        handlers_[id] = {topic, std::move(handler)};
+        if (outId) *outId = id;
+        return NetworkError();
+    }
+    NetworkError unsubscribe(const std::string& topic) override {
+        std::lock_guard<std::mutex> lock(mu_);
+        for (auto it = handlers_.begin(); it != handlers_.end();) {
+            it = it->second.first == topic ? handlers_.erase(it) : std::next(it);
+        }
+        return NetworkError();
+    }
+    NetworkError unsubscribe(SubscriptionId id) override {
+        std::lock_guard<std::mutex> lock(mu_);
+        handlers_.erase(id);
+        return NetworkError();
+    }
+    bool isConnected() const override { return connected_; }
+    std::vector<std::string> getSubscribedTopics() const override { return {}; }
+    std::size_t getSubscriptionCount() const override {
+        std::lock_guard<std::mutex> lock(mu_);
+        return handlers_.size();
+    }
+    NetworkError connect() override { connected_ = true; return NetworkError(); }
+    void disconnect() noexcept override { connected_ = false; }
+
+    void deliver(const Message& m) {
+        std::vector<MessageHandler> targets;
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            for (const auto& [id, entry] : handlers_) {
+                (void)id;
+                if (entry.first == m.topic) targets.push_back(entry.second);
+            }
+        }
+        for (const auto& handler : targets) handler(m);
+    }
+
+    // Published messages on topics starting with `prefix`, waiting up to 2s
+    // for at least `count` of them.
+    std::vector<Message> waitFor(const std::string& prefix, std::size_t count) {
+        std::unique_lock<std::mutex> lock(mu_);
+        std::vector<Message> matching;
+        cv_.wait_for(lock, std::chrono::seconds(2), [&] {
+            matching.clear();
+            for (const auto& m : published_) {
+                if (m.topic.compare(0, prefix.size(), prefix) == 0) matching.push_back(m);
+            }
+            return matching.size() >= count;
+        });
+        return matching;
+    }
+
+private:
+    mutable std::mutex mu_;
+    std::condition_variable cv_;
+    std::vector<Message> published_;
+    std::map<SubscriptionId, std::pair<std::string, MessageHandler>> handlers_;
+    SubscriptionId next_id_ = 1;
+    bool connected_ = false;
+};
+
+TaskEnvelope decodeTaskOrDie(const Message& m) {
+    TaskEnvelope env;
+    EXPECT_TRUE(decodeTask(m.data, env));
+    return env;
+}
+
+Message resultMessage(const AmbientRequesterClient& client, const TaskEnvelope& task,
+                      bool success, const std::string& worker) {
+    ResultEnvelope res;
+    res.taskId = task.taskId;
+    res.workerId = worker;
+    res.attempt = task.attempt;
+    res.success = success;
+    res.result = {0x42};
+    res.error = success ? "" : "boom";
+    return Message(kResultTopicPrefix + client.requesterId(), encodeResults({res}));
+}
+
+void announce(RecordingPubSub& bus, const std::string& peer, const std::string& type,
+              std::vector<std::string> formats, std::uint32_t freeSlots) {
+    WorkerAnnouncement ann;
+    ann.peerId = peer;
+    ann.capabilities.type = type;
+    ann.capabilities.capacity = "high";
+    ann.capabilities.maxConcurrentTasks = 4;
+    ann.capabilities.supportedFormats = std::move(formats);
+    ann.state = WorkerState::IDLE;
+    ann.freeSlots = freeSlots;
+    bus.deliver(Message(kWorkerAnnounceTopic, encodeAnnouncement(ann)));
+}
+
+TaskRequest makeTask(const std::string& id, std::uint8_t priority) {
+    TaskRequest req;
+    req.taskId = id;
+    req.payload = {1, 2, 3};
+    req.priority = priority;
+    return req;
+}
+
+} // namespace
+
+TEST(AmbientRequesterClientTest, PipelinesUpToLimitInPriorityOrder) {
+    auto bus = std::make_shared<RecordingPubSub>();
+    RequesterOptions opts;
+    opts.maxConcurrentTasks = 2;
+    AmbientRequesterClient client(bus, opts);
+    ASSERT_TRUE(client.start().isSuccess());
+
+    auto f1 = client.postTaskAsync(makeTask("t1", 0));
+    auto f2 = client.postTaskAsync(makeTask("t2", 0));
+    ASSERT_TRUE(client.postTask(makeTask("t3", 1)).isSuccess());
+    ASSERT_TRUE(client.postTask(makeTask("t4", 9)).isSuccess());
+    EXPECT_FALSE(client.postTask(makeTask("t4", 9)).isSuccess());
+    EXPECT_EQ(client.getPendingTaskCount(), 4u);
+
+    auto sent = bus->waitFor(kTaskBroadcastTopic, 2);
+    ASSERT_EQ(sent.size(), 2u);
+    EXPECT_EQ(decodeTaskOrDie(sent[0]).taskId, "t1");
+    EXPECT_EQ(decodeTaskOrDie(sent[1]).taskId, "t2");
+    EXPECT_TRUE(client.getTaskStatus("t4") == TaskStatus::PENDING);
+
+    // Completing t1 frees a slot for the highest-priority pending task.
+    bus->deliver(resultMessage(client, decodeTaskOrDie(sent[0]), true, "w1"));
+    auto r1 = f1.get();
+    EXPECT_TRUE(r1.isSuccess());
+    ASSERT_EQ(r1.result.size(), 1u);
+    EXPECT_EQ(r1.result[0], 0x42);
+
+    sent = bus->waitFor(kTaskBroadcastTopic, 3);
+    ASSERT_EQ(sent.size(), 3u);
+    EXPECT_EQ(decodeTaskOrDie(sent[2]).taskId, "t4");
+
+    // A duplicate result for a finished task is ignored.
+    bus->deliver(resultMessage(client, decodeTaskOrDie(sent[0]), false, "w2"));
+    EXPECT_TRUE(client.getTaskStatus("t1") == TaskStatus::COMPLETED);
+    EXPECT_EQ(client.getCompletedTaskCount(), 1u);
+    EXPECT_EQ(client.getPendingTaskCount(), 3u);
+
+    client.stop();
+    EXPECT_TRUE(f2.get().status == TaskStatus::CANCELLED);
+}
+
+TEST(AmbientRequesterClientTest, SelectsWorkerThroughCapabilityIndex) {
+    auto bus = std::make_shared<RecordingPubSub>();
+    AmbientRequesterClient client(bus);
+    std::vector<std::string> discovered;
+    client.setWorkerDiscoveryCallback([&](const std::string& peer, const WorkerCapabilities&) {
+        discovered.push_back(peer);
+    });
+    ASSERT_TRUE(client.start().isSuccess());
+
+    announce(*bus, "cpu-1", "cpu", {"onnx"}, 4);
+    announce(*bus, "gpu-1", "gpu", {"onnx", "torch"}, 1);
+    announce(*bus, "gpu-2", "gpu", {"onnx"}, 3);
+    ASSERT_EQ(discovered.size(), 3u);
+    EXPECT_EQ(client.getAvailableWorkers().size(), 3u);
+
+    TaskRequest torch = makeTask("torch", 0);
+    torch.requiredCapabilities.type = "gpu";
+    torch.requiredCapabilities.supportedFormats = {"torch"};
+    ASSERT_TRUE(client.postTask(torch).isSuccess());
+    auto sent = bus->waitFor(std::string(kTaskTopicPrefix) + "gpu-1", 1);
+    ASSERT_EQ(sent.size(), 1u);
+    EXPECT_EQ(decodeTaskOrDie(sent[0]).taskId, "torch");
+
+    // gpu-1 has no slot left; the next torch task has nobody to go to.
+    TaskRequest torch2 = makeTask("torch2", 0);
+    torch2.requiredCapabilities = torch.requiredCapabilities;
+    ASSERT_TRUE(client.postTask(torch2).isSuccess());
+    EXPECT_EQ(bus->waitFor(kTaskBroadcastTopic, 1).size(), 1u);
+
+    // Any GPU: the one with the most free slots.
+    TaskRequest anyGpu = makeTask("gpu", 0);
+    anyGpu.requiredCapabilities.type = "gpu";
+    ASSERT_TRUE(client.postTask(anyGpu).isSuccess());
+    EXPECT_EQ(bus->waitFor(std::string(kTaskTopicPrefix) + "gpu-2", 1).size(), 1u);
+
+    TaskRequest tpu = makeTask("tpu", 0);
+    tpu.requiredCapabilities.type = "tpu";
+    ASSERT_TRUE(client.postTask(tpu).isSuccess());
+    EXPECT_EQ(bus->waitFor(kTaskBroadcastTopic, 2).size(), 2u);
+    client.stop();
+}
+
+TEST(AmbientRequesterClientTest, RetriesOnDeadlineThenTimesOut) {
+    auto bus = std::make_shared<RecordingPubSub>();
+    AmbientRequesterClient client(bus);
+    ASSERT_TRUE(client.start().isSuccess());
+
+    TaskRequest req = makeTask("slow", 0);
+    req.timeout = std::chrono::milliseconds(30);
+    req.maxRetries = 1;
+    auto future = client.postTaskAsync(req);
+
+    auto sent = bus->waitFor(kTaskBroadcastTopic, 2);
+    ASSERT_EQ(sent.size(), 2u);
+    const TaskEnvelope first = decodeTaskOrDie(sent[0]);
+    const TaskEnvelope second = decodeTaskOrDie(sent[1]);
+    EXPECT_EQ(second.taskId, "slow");
+    EXPECT_TRUE(second.attempt > first.attempt);
+
+    // The abandoned attempt's result does not complete the task.
+    bus->deliver(resultMessage(client, first, true, "late"));
+    EXPECT_TRUE(client.getTaskStatus("slow") != TaskStatus::COMPLETED);
+
+    auto result = client.waitForResult("slow", std::chrono::milliseconds(2000));
+    ASSERT_TRUE(result.has_value());
+    EXPECT_TRUE(result->status == TaskStatus::TIMEOUT);
+    EXPECT_EQ(result->retryCount, 1u);
+    EXPECT_TRUE(future.get().status == TaskStatus::TIMEOUT);
+    EXPECT_EQ(client.getFailedTaskCount(), 1u);
+    client.stop();
+}
+
+TEST(AmbientRequesterClientTest, FailureRetriesAndCancelNotifiesWorkers) {
+    auto bus = std::make_shared<RecordingPubSub>();
+    AmbientRequesterClient client(bus);
+    ASSERT_TRUE(client.start().isSuccess());
+
+    TaskRequest req = makeTask("flaky", 0);
+    req.maxRetries = 1;
+    auto future = client.postTaskAsync(req);
+    auto sent = bus->waitFor(kTaskBroadcastTopic, 1);
+    ASSERT_EQ(sent.size(), 1u);
+    bus->deliver(resultMessage(client, decodeTaskOrDie(sent[0]), false, "w1"));
+
+    sent = bus->waitFor(kTaskBroadcastTopic, 2);
+    ASSERT_EQ(sent.size(), 2u);
+    bus->deliver(resultMessage(client, decodeTaskOrDie(sent[1]), false, "w1"));
+    auto failed = future.get();
+    EXPECT_TRUE(failed.status == TaskStatus::FAILED);
+    ASSERT_TRUE(failed.error.has_value());
+    EXPECT_EQ(failed.error->message, "boom");
+
+    std::string id;
+    ASSERT_TRUE(client.postTask(std::vector<std::uint8_t>{7}, &id).isSuccess());
+    EXPECT_TRUE(client.cancelTask(id));
+    EXPECT_FALSE(client.cancelTask(id));
+    auto cancels = bus->waitFor(kTaskCancelTopic, 1);
+    ASSERT_EQ(cancels.size(), 1u);
+    std::string cancelled;
+    ASSERT_TRUE(decodeCancel(cancels[0].data, cancelled));
+    EXPECT_EQ(cancelled, id);
+    EXPECT_TRUE(client.getTaskStatus(id) == TaskStatus::CANCELLED);
+    EXPECT_EQ(client.getPendingTaskCount(), 0u);
+    client.stop();
+}
+
+TEST(AmbientRequesterClientTest, CancelledQueuedTaskNeverDispatches) {
+    auto bus = std::make_shared<RecordingPubSub>();
+    RequesterOptions opts;
+    opts.maxConcurrentTasks = 1;
+    AmbientRequesterClient client(bus, opts);
+    ASSERT_TRUE(client.start().isSuccess());
+
+    ASSERT_TRUE(client.postTask(makeTask("running", 0)).isSuccess());
+    ASSERT_TRUE(client.postTask(makeTask("queued", 5)).isSuccess());
+    ASSERT_TRUE(client.postTask(makeTask("next", 1)).isSuccess());
+    EXPECT_TRUE(client.cancelTask("queued"));
+    // Never dispatched, so no worker needs telling.
+    EXPECT_TRUE(bus->waitFor(kTaskCancelTopic, 1).empty());
+
+    auto sent = bus->waitFor(kTaskBroadcastTopic, 1);
+    ASSERT_EQ(sent.size(), 1u);
+    bus->deliver(resultMessage(client, decodeTaskOrDie(sent[0]), true, "w1"));
+    sent = bus->waitFor(kTaskBroadcastTopic, 2);
+    ASSERT_EQ(sent.size(), 2u);
+    EXPECT_EQ(decodeTaskOrDie(sent[1]).taskId, "next");
+    EXPECT_EQ(client.getPendingTaskCount(), 1u);
+    client.stop();
+}
+
+TEST(AmbientRequesterClientTest, DeadlineReturnsWorkerSlot) {
+    auto bus = std::make_shared<RecordingPubSub>();
+    AmbientRequesterClient client(bus);
+    ASSERT_TRUE(client.start().isSuccess());
+    announce(*bus, "gpu-1", "gpu", {"onnx"}, 1);
+
+    TaskRequest req = makeTask("slow", 0);
+    req.requiredCapabilities.type = "gpu";
+    req.timeout = std::chrono::milliseconds(30);
+    req.maxRetries = 1;
+    auto future = client.postTaskAsync(req);
+
+    // The retry goes back to gpu-1 instead of falling back to a broadcast.
+    auto sent = bus->waitFor(std::string(kTaskTopicPrefix) + "gpu-1", 2);
+    ASSERT_EQ(sent.size(), 2u);
+    EXPECT_TRUE(bus->waitFor(kTaskBroadcastTopic, 1).empty());
+    EXPECT_TRUE(future.get().status == TaskStatus::TIMEOUT);
+    EXPECT_EQ(client.getAvailableWorkers().size(), 1u);
+    client.stop();
+}
+
+TEST(AmbientRequesterClientTest, StopFromTimerCallbackDoesNotSelfJoin) {
+    auto bus = std::make_shared<RecordingPubSub>();
+    AmbientRequesterClient client(bus);
+    client.setCompletionCallback([&](const TaskResult&) { client.stop(); });
+    ASSERT_TRUE(client.start().isSuccess());
+
+    TaskRequest req = makeTask("slow", 0);
+    req.timeout = std::chrono::milliseconds(20);
+    req.maxRetries = 0;
+    auto future = client.postTaskAsync(req);
+    auto other = client.postTaskAsync(makeTask("other", 0));
+    EXPECT_TRUE(future.get().status == TaskStatus::TIMEOUT);
+    EXPECT_TRUE(other.get().status != TaskStatus::PENDING);
+    EXPECT_FALSE(client.isRunning());
+
+    // The finished timer thread is reaped on restart.
+    client.setCompletionCallback(nullptr);
+    ASSERT_TRUE(client.start().isSuccess());
+    EXPECT_TRUE(client.isRunning());
+    client.stop();
+}
@@ -0,0 +1,244 @@
+#include <gtest/gtest.h>
+#include "AmbientClient.h"
+#include "network/AmbientWire.h"
+#include "network/InProcessPubSub.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ailee::net;
+
+namespace {
+
+WorkerCapabilities makeCaps(std::uint32_t slots) {
+    WorkerCapabilities caps;
+    caps.type = "cpu";
+    caps.capacity = "medium";
+    caps.maxConcurrentTasks = slots;
+    return caps;
+}
+
+// Collects results and announcements seen on the bus.
+struct Observer {
+    std::mutex mu;
+    std::condition_variable cv;
+    std::vector<ResultEnvelope> results;
+    std::vector<WorkerAnnouncement> announcements;
+
+    void attach(InProcessPubSub& bus, const std::string& requesterId) {
+        SubscriptionOptions opts;
+        SubscriptionId id = 0;
+        bus.subscribe(kResultTopicPrefix + requesterId, [this](const Message& m) {
+            std::vector<ResultEnvelope> batch;
+            ASSERT_TRUE(decodeResults(m.data, batch));
+            std::lock_guard<std::mutex> lock(mu);
+            results.insert(results.end(), batch.begin(), batch.end());
+            cv.notify_all();
+        }, opts, &id);
+        bus.subscribe(kWorkerAnnounceTopic, [this](const Message& m) {
+            WorkerAnnouncement ann;
+            ASSERT_TRUE(decodeAnnouncement(m.data, ann));
+            std::lock_guard<std::mutex> lock(mu);
+            announcements.push_back(ann);
+            cv.notify_all();
+        }, opts, &id);
+    }
+
+    bool waitResults(std::size_t n) {
+        std::unique_lock<std::mutex> lock(mu);
+        return cv.wait_for(lock, std::chrono::seconds(2), [&] { return results.size() >= n; });
+    }
+
+    WorkerAnnouncement lastAnnouncement() {
+        std::lock_guard<std::mutex> lock(mu);
+        return announcements.empty() ? WorkerAnnouncement{} : announcements.back();
+    }
+};
+
+void sendTask(InProcessPubSub& bus, const std::string& topic, const std::string& taskId,
+              std::uint8_t byte) {
+    TaskEnvelope env;
+    env.taskId = taskId;
+    env.requesterId = "req";
+    env.payload = {byte};
+    env.attempt = 1;
+    PublishOptions acked;
+    acked.requireAck = true;
+    ASSERT_TRUE(bus.publish(Message(topic, encodeTask(env)), acked).isSuccess());
+}
+
+} // namespace
+
+TEST(AmbientWorkerNodeTest, ServesRequesterEndToEnd) {
+    auto bus = std::make_shared<InProcessPubSub>();
+    AmbientWorkerNode worker(bus, makeCaps(2));
+    worker.setTaskHandler([](const TaskInfo& task, std::vector<std::uint8_t>* out) {
+        *out = task.payload;
+        out->push_back(static_cast<std::uint8_t>(task.payload.size()));
+        return true;
+    });
+    ASSERT_TRUE(worker.start().isSuccess());
+    EXPECT_TRUE(worker.getState() == WorkerState::IDLE);
+
+    RequesterOptions opts;
+    opts.maxConcurrentTasks = 4;
+    AmbientRequesterClient client(bus, opts);
+    ASSERT_TRUE(client.start().isSuccess());
+
+    std::vector<std::future<TaskResult>> futures;
+    for (int i = 0; i < 32; ++i) {
+        TaskRequest req;
+        req.taskId = "job-" + std::to_string(i);
+        req.payload = {static_cast<std::uint8_t>(i), 7};
+        req.timeout = std::chrono::milliseconds(2000);
+        futures.push_back(client.postTaskAsync(req));
+    }
+    for (int i = 0; i < 32; ++i) {
+        auto result = futures[i].get();
+        ASSERT_TRUE(result.isSuccess());
+        ASSERT_EQ(result.result.size(), 3u);
+        EXPECT_EQ(result.result[0], i);
+        EXPECT_EQ(result.result[2], 2);
+    }
+    EXPECT_EQ(client.getCompletedTaskCount(), 32u);
+    EXPECT_EQ(worker.status().totalTasksProcessed, 32u);
+
+    client.stop();
+    worker.stop();
+    EXPECT_TRUE(worker.getState() == WorkerState::SHUTDOWN);
+}
+
+TEST(AmbientWorkerNodeTest, BoundedBacklogRejectsAndAdvertisesNoCapacity) {
+    auto bus = std::make_shared<InProcessPubSub>();
+    Observer observer;
+    observer.attach(*bus, "req");
+    ASSERT_TRUE(bus->connect().isSuccess());
+
+    std::mutex gate_mutex;
+    std::condition_variable gate_cv;
+    bool open = false;
+    std::atomic<int> started{0};
+    AmbientWorkerNode worker(bus, makeCaps(1));
+    worker.setTaskHandler([&](const TaskInfo&, std::vector<std::uint8_t>* out) {
+        started++;
+        std::unique_lock<std::mutex> lock(gate_mutex);
+        gate_cv.wait(lock, [&] { return open; });
+        out->push_back(1);
+        return true;
+    });
+    ASSERT_TRUE(worker.start().isSuccess());
+    const std::string directed = kTaskTopicPrefix + worker.peerId();
+
+    sendTask(*bus, directed, "a", 1);
+    while (started.load() == 0) {
+        std::this_thread::yield();
+    }
+    sendTask(*bus, directed, "b", 2);   // backlog
+    sendTask(*bus, kTaskBroadcastTopic, "x", 3);  // no free slot: left to others
+    sendTask(*bus, directed, "c", 3);   // over the bound: rejected
+    ASSERT_TRUE(observer.waitResults(1));
+    {
+        std::lock_guard<std::mutex> lock(observer.mu);
+        EXPECT_EQ(observer.results[0].taskId, "c");
+        EXPECT_FALSE(observer.results[0].success);
+        EXPECT_EQ(observer.results[0].error, "Worker saturated");
+    }
+    EXPECT_EQ(worker.getActiveTasks().size(), 2u);
+
+    worker.sendHeartbeat();
+    auto ann = observer.lastAnnouncement();
+    EXPECT_EQ(ann.peerId, worker.peerId());
+    EXPECT_EQ(ann.freeSlots, 0u);
+    EXPECT_EQ(ann.activeTasks, 1u);
+
+    {
+        std::lock_guard<std::mutex> lock(gate_mutex);
+        open = true;
+    }
+    gate_cv.notify_all();
+    ASSERT_TRUE(observer.waitResults(3));
+    worker.stop();
+    EXPECT_EQ(started.load(), 2);
+    EXPECT_EQ(worker.status().totalTasksProcessed, 2u);
+    // The final heartbeat is published without an ack.
+    for (int i = 0; i < 200 && observer.lastAnnouncement().state != WorkerState::SHUTDOWN; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_TRUE(observer.lastAnnouncement().state == WorkerState::SHUTDOWN);
+}
+
+TEST(AmbientWorkerNodeTest, PauseHoldsQueueAndCancellationIsCooperative) {
+    auto bus = std::make_shared<InProcessPubSub>();
+    Observer observer;
+    observer.attach(*bus, "req");
+    ASSERT_TRUE(bus->connect().isSuccess());
+
+    AmbientWorkerNode worker(bus, makeCaps(1));
+    std::atomic<int> handled{0};
+    std::atomic<bool> sawCancel{false};
+    worker.setTaskHandler([&](const TaskInfo& task, std::vector<std::uint8_t>* out) {
+        handled++;
+        if (task.taskId == "long") {
+            while (!worker.isCancelled(task.taskId)) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            sawCancel = true;
+            return false;
+        }
+        out->push_back(9);
+        return true;
+    });
+    ASSERT_TRUE(worker.start().isSuccess());
+    const std::string directed = kTaskTopicPrefix + worker.peerId();
+
+    worker.pause();
+    EXPECT_TRUE(worker.getState() == WorkerState::PAUSED);
+    sendTask(*bus, directed, "held", 1);
+    sendTask(*bus, directed, "dropped", 2);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(handled.load(), 0);
+
+    // Requester-side cancel of a queued task: removed silently.
+    PublishOptions acked;
+    acked.requireAck = true;
+    ASSERT_TRUE(bus->publish(Message(kTaskCancelTopic, encodeCancel("dropped")), acked).isSuccess());
+    EXPECT_EQ(worker.getActiveTasks().size(), 1u);
+
+    worker.resume();
+    ASSERT_TRUE(observer.waitResults(1));
+    EXPECT_EQ(handled.load(), 1);
+
+    // Local cancel of a running task reaches the handler and the requester.
+    sendTask(*bus, directed, "long", 3);
+    while (handled.load() < 2) {
+        std::this_thread::yield();
+    }
+    EXPECT_TRUE(worker.cancelTask("long"));
+    ASSERT_TRUE(observer.waitResults(2));
+    EXPECT_TRUE(sawCancel.load());
+    {
+        std::lock_guard<std::mutex> lock(observer.mu);
+        EXPECT_EQ(observer.results[0].taskId, "held");
+        EXPECT_TRUE(observer.results[0].success);
+        EXPECT_EQ(observer.results[1].taskId, "long");
+        EXPECT_FALSE(observer.results[1].success);
+        EXPECT_EQ(observer.results[1].error, "Cancelled by worker");
+    }
+    worker.stop();
+}
+
+TEST(AmbientWorkerNodeTest, CapabilitiesRoundTripThroughString) {
+    WorkerCapabilities caps = makeCaps(4);
+    auto parsed = WorkerCapabilities::parse(caps.toString());
+    ASSERT_TRUE(parsed.has_value());
+    EXPECT_EQ(parsed->type, "cpu");
+    EXPECT_EQ(parsed->capacity, "medium");
+    EXPECT_EQ(parsed->maxConcurrentTasks, 4u);
+    EXPECT_FALSE(WorkerCapabilities::parse("TYPE=gpu").has_value());
+    EXPECT_FALSE(WorkerCapabilities::parse("TYPE=gpu,CAP=high,MAX_TASKS=x").has_value());
+}
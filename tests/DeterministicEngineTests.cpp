@@ -66,3 +66,114 @@ TEST(DeterministicEngineTest, RunOfflineMismatch) {
     EXPECT_EQ(summary.total_steps, 1);
     EXPECT_TRUE(summary.vector_mismatch);
 }
+
+namespace {
+
+void build_run(size_t steps,
+               std::vector<ReflectionSnapshot>& rss,
+               std::vector<SettlementIngestion>& sis,
+               std::vector<MeshCoherenceResult>& mcs) {
+    rss.resize(steps);
+    sis.resize(steps);
+    mcs.resize(steps);
+    for (size_t i = 0; i < steps; ++i) {
+        std::memset(&rss[i], 0, sizeof(ReflectionSnapshot));
+        std::memset(&sis[i], 0, sizeof(SettlementIngestion));
+        std::memset(&mcs[i], 0, sizeof(MeshCoherenceResult));
+        rss[i].height.height = 800000 + i;
+        mcs[i].score = static_cast<uint32_t>(i % 100);
+    }
+}
+
+} // namespace
+
+TEST(DeterministicEngineTest, RunOfflineRecordsChainedCheckpoints) {
+    std::vector<ReflectionSnapshot> rss;
+    std::vector<SettlementIngestion> sis;
+    std::vector<MeshCoherenceResult> mcs;
+    build_run(25, rss, sis, mcs);
+    NodeId nid;
+    std::memset(&nid, 0, sizeof(nid));
+
+    std::vector<EngineCheckpoint> checkpoints;
+    auto summary = DeterministicEngine::run_offline(rss, sis, mcs, nid, 1, 10, checkpoints);
+    auto plain = DeterministicEngine::run_offline(rss, sis, mcs, nid, 1);
+
+    EXPECT_EQ(std::memcmp(&summary.final_state, &plain.final_state, sizeof(EngineState)), 0);
+    ASSERT_EQ(checkpoints.size(), 4u);  // steps 0, 10, 20, 25
+    EXPECT_EQ(checkpoints[0].step, 0u);
+    EXPECT_EQ(checkpoints[1].step, 10u);
+    EXPECT_EQ(checkpoints[3].step, 25u);
+    EXPECT_EQ(std::memcmp(&checkpoints[3].state, &summary.final_state, sizeof(EngineState)), 0);
+
+    auto verify = DeterministicEngine::verify_offline(rss, sis, mcs, nid, 1, checkpoints, 4);
+    EXPECT_FALSE(verify.diverged);
+    EXPECT_EQ(verify.segments_verified, 3u);
+}
+
+TEST(DeterministicEngineTest, VerifyOfflineLocalizesDivergentSegment) {
+    std::vector<ReflectionSnapshot> rss;
+    std::vector<SettlementIngestion> sis;
+    std::vector<MeshCoherenceResult> mcs;
+    build_run(40, rss, sis, mcs);
+    NodeId nid;
+    std::memset(&nid, 0, sizeof(nid));
+
+    std::vector<EngineCheckpoint> checkpoints;
+    DeterministicEngine::run_offline(rss, sis, mcs, nid, 1, 8, checkpoints);
+
+    // An auditor's inputs disagree at step 20 (inside segment 16..24)
+    // and again later; only the first divergence is reported.
+    mcs[20].score += 1;
+    mcs[35].score += 1;
+
+    auto verify = DeterministicEngine::verify_offline(rss, sis, mcs, nid, 1, checkpoints, 3);
+    EXPECT_TRUE(verify.diverged);
+    EXPECT_EQ(verify.first_divergent_checkpoint, 3u);
+    EXPECT_EQ(verify.segment_start_step, 16u);
+    EXPECT_EQ(verify.first_divergent_step, 24u);
+
+    // Step 20 is not a checkpoint, so only the rolling digest catches it.
+    EXPECT_FALSE(verify.state_mismatch);
+
+    // A tampered checkpoint record fails the segment that ends at it.
+    mcs[20].score -= 1;
+    mcs[35].score -= 1;
+    checkpoints[2].state.context.padding[0] ^= 1;
+    verify = DeterministicEngine::verify_offline(rss, sis, mcs, nid, 1, checkpoints, 3);
+    EXPECT_TRUE(verify.diverged);
+    EXPECT_TRUE(verify.state_mismatch);
+    EXPECT_EQ(verify.first_divergent_step, 16u);
+}
+
+TEST(DeterministicEngineTest, VerifyOfflinePinpointsStepWithDigestTrail) {
+    std::vector<ReflectionSnapshot> rss;
+    std::vector<SettlementIngestion> sis;
+    std::vector<MeshCoherenceResult> mcs;
+    build_run(40, rss, sis, mcs);
+    NodeId nid;
+    std::memset(&nid, 0, sizeof(nid));
+
+    std::vector<EngineCheckpoint> checkpoints;
+    std::vector<EngineStepDigest> trail;
+    DeterministicEngine::run_offline(rss, sis, mcs, nid, 1, 8, checkpoints, &trail);
+    ASSERT_EQ(trail.size(), 40u);
+    EXPECT_EQ(std::memcmp(trail[39].data(), checkpoints.back().digest, 32), 0);
+
+    auto verify = DeterministicEngine::verify_offline(rss, sis, mcs, nid, 1, checkpoints, 3, &trail);
+    EXPECT_FALSE(verify.diverged);
+
+    // Input 20 is consumed by step 21, inside segment 16..24.
+    mcs[20].score += 1;
+    verify = DeterministicEngine::verify_offline(rss, sis, mcs, nid, 1, checkpoints, 3, &trail);
+    EXPECT_TRUE(verify.diverged);
+    EXPECT_EQ(verify.first_divergent_checkpoint, 3u);
+    EXPECT_EQ(verify.segment_start_step, 16u);
+    EXPECT_TRUE(verify.step_exact);
+    EXPECT_EQ(verify.first_divergent_step, 21u);
+
+    // Without the trail only the checkpoint is known.
+    verify = DeterministicEngine::verify_offline(rss, sis, mcs, nid, 1, checkpoints, 3);
+    EXPECT_FALSE(verify.step_exact);
+    EXPECT_EQ(verify.first_divergent_step, 24u);
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include "zk_proofs.h"
+#include "ailee_rust_ffi.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace ailee::zk;
+
+namespace {
+
+Digest32 digestFor(uint32_t seed) {
+    Digest32 d{};
+    for (std::size_t i = 0; i < d.size(); ++i) {
+        d[i] = static_cast<uint8_t>(seed * 31u + i * 7u);
+    }
+    return d;
+}
+
+} // namespace
+
+TEST(Halo2BatchProverTest, BatchProofsVerifyThroughSingleProofPath) {
+    ZKEngine engine;
+    Halo2ProofBatch batch;
+    for (uint32_t i = 0; i < 64; ++i) {
+        batch.add(digestFor(i), digestFor(i + 1000));
+    }
+    ASSERT_EQ(engine.generateHalo2Proofs(batch), 64u);
+
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        ASSERT_TRUE(batch.ok(i));
+        EXPECT_EQ(batch.commitment(i).size, static_cast<std::size_t>(HALO2_COMMITMENT_LEN));
+        Proof proof = batch.toProof(i);
+        EXPECT_EQ(proof.publicInput.size(), 2u * HALO2_DIGEST_LEN);
+        EXPECT_TRUE(engine.verifyHalo2Proof(proof));
+    }
+    // Distinct digests give distinct proofs.
+    EXPECT_FALSE(batch.toProof(0).proofData == batch.toProof(1).proofData);
+}
+
+TEST(Halo2BatchProverTest, ArenaIsReusedAcrossEpochs) {
+    ZKEngine engine;
+    Halo2ProofBatch batch;
+    for (uint32_t i = 0; i < 16; ++i) {
+        batch.add(digestFor(i), digestFor(i));
+    }
+    ASSERT_EQ(engine.generateHalo2Proofs(batch), 16u);
+    const uint8_t* first = batch.proof(0).data;
+
+    batch.clear();
+    EXPECT_EQ(batch.size(), 0u);
+    for (uint32_t i = 0; i < 8; ++i) {
+        batch.add(digestFor(i + 50), digestFor(i + 50));
+    }
+    ASSERT_EQ(engine.generateHalo2Proofs(batch), 8u);
+    EXPECT_EQ(batch.proof(0).data, first);
+    EXPECT_TRUE(engine.verifyHalo2Proof(batch.toProof(7)));
+
+    batch.clear();
+    EXPECT_EQ(engine.generateHalo2Proofs(batch), 0u);
+}
+
+TEST(Halo2BatchProverTest, FfiReportsArenaExhaustionPerItem) {
+    const std::size_t count = 3;
+    std::vector<uint8_t> tasks(count * HALO2_DIGEST_LEN, 1);
+    std::vector<uint8_t> hashes(count * HALO2_DIGEST_LEN, 2);
+    // Room for exactly two items.
+    std::vector<uint8_t> buffer(halo2_proof_arena_bound_ffi(2));
+    Halo2ProofArena arena{buffer.data(), buffer.size(), 0};
+    std::vector<Halo2ProofSlice> slices(count);
+    std::vector<int> status(count, 99);
+
+    int proved = generate_halo2_proofs_batch_ffi(tasks.data(), hashes.data(), count,
+                                                 &arena, slices.data(), status.data());
+    EXPECT_EQ(proved, 2);
+    EXPECT_EQ(status[0], HALO2_ITEM_OK);
+    EXPECT_EQ(status[1], HALO2_ITEM_OK);
+    EXPECT_EQ(status[2], HALO2_ITEM_ARENA_FULL);
+    EXPECT_EQ(arena.used, buffer.size());
+    EXPECT_EQ(slices[1].proof_offset, slices[0].commitment_offset + slices[0].commitment_len);
+    EXPECT_EQ(slices[2].proof_len, 0u);
+
+    EXPECT_EQ(generate_halo2_proofs_batch_ffi(tasks.data(), hashes.data(), count,
+                                              nullptr, slices.data(), status.data()), -1);
+}
@@ -0,0 +1,318 @@
+#include <gtest/gtest.h>
+#include "network/InProcessPubSub.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ailee::net;
+
+namespace {
+
+Message makeMessage(const std::string& topic, std::uint8_t byte) {
+    return Message(topic, std::vector<std::uint8_t>{byte});
+}
+
+// Blocks the handler that calls wait() until open() is called.
+struct Gate {
+    std::mutex mu;
+    std::condition_variable cv;
+    bool opened = false;
+    std::atomic<int> waiting{0};
+
+    void wait() {
+        waiting.fetch_add(1);
+        std::unique_lock<std::mutex> lock(mu);
+        cv.wait(lock, [&] { return opened; });
+    }
+    void open() {
+        {
+            std::lock_guard<std::mutex> lock(mu);
+            opened = true;
+        }
+        cv.notify_all();
+    }
+};
+
+} // namespace
+
+TEST(InProcessPubSubTest, TopicMatchingRules) {
+    EXPECT_TRUE(InProcessPubSub::topicMatches("ailee/tasks", "ailee/tasks"));
+    EXPECT_FALSE(InProcessPubSub::topicMatches("ailee/tasks", "ailee/tasks/x"));
+    EXPECT_TRUE(InProcessPubSub::topicMatches("ailee/+/result", "ailee/t1/result"));
+    EXPECT_TRUE(InProcessPubSub::topicMatches("ailee/*/result", "ailee/t1/result"));
+    EXPECT_FALSE(InProcessPubSub::topicMatches("ailee/+/result", "ailee/t1/t2/result"));
+    EXPECT_TRUE(InProcessPubSub::topicMatches("ailee/#", "ailee"));
+    EXPECT_TRUE(InProcessPubSub::topicMatches("ailee/#", "ailee/a/b/c"));
+    EXPECT_FALSE(InProcessPubSub::topicMatches("ailee/#", "other/a"));
+}
+
+TEST(InProcessPubSubTest, ExactAndPatternSubscriptionsAckedDelivery) {
+    InProcessPubSub bus;
+    ASSERT_TRUE(bus.connect().isSuccess());
+
+    std::atomic<int> exact{0};
+    std::atomic<int> pattern{0};
+    std::atomic<int> all{0};
+    ASSERT_TRUE(bus.subscribe("ailee/tasks/t1/result", [&](const Message&) { exact++; }).isSuccess());
+    EXPECT_TRUE(bus.subscribe("ailee/tasks/t1/result", [](const Message&) {}).code == NetworkErrorCode::ALREADY_SUBSCRIBED);
+
+    SubscriptionOptions wildcard;
+    wildcard.filterPattern = "ailee/tasks/+/result";
+    SubscriptionId patternId = 0;
+    ASSERT_TRUE(bus.subscribe("results", [&](const Message&) { pattern++; }, wildcard, &patternId).isSuccess());
+    SubscriptionOptions everything;
+    everything.filterPattern = "ailee/#";
+    SubscriptionId allId = 0;
+    ASSERT_TRUE(bus.subscribe("firehose", [&](const Message&) { all++; }, everything, &allId).isSuccess());
+    EXPECT_NE(patternId, allId);
+    EXPECT_EQ(bus.getSubscriptionCount(), 3u);
+    EXPECT_EQ(bus.getSubscribedTopics().size(), 3u);
+
+    PublishOptions acked;
+    acked.requireAck = true;
+    ASSERT_TRUE(bus.publish(makeMessage("ailee/tasks/t1/result", 1), acked).isSuccess());
+    ASSERT_TRUE(bus.publish(makeMessage("ailee/tasks/t2/result", 2), acked).isSuccess());
+    ASSERT_TRUE(bus.publish(makeMessage("ailee/heartbeat", 3), acked).isSuccess());
+    EXPECT_EQ(exact.load(), 1);
+    EXPECT_EQ(pattern.load(), 2);
+    EXPECT_EQ(all.load(), 3);
+
+    EXPECT_TRUE(bus.publish(makeMessage("other/topic", 4), acked).code == NetworkErrorCode::PUBLISH_FAILED);
+    EXPECT_TRUE(bus.publish(makeMessage("ailee/+", 5)).code == NetworkErrorCode::INVALID_TOPIC);
+
+    ASSERT_TRUE(bus.unsubscribe(patternId).isSuccess());
+    ASSERT_TRUE(bus.unsubscribe("firehose").isSuccess());
+    EXPECT_TRUE(bus.unsubscribe("firehose").code == NetworkErrorCode::INVALID_TOPIC);
+    EXPECT_TRUE(bus.publish(makeMessage("ailee/tasks/t2/result", 6), acked).code == NetworkErrorCode::PUBLISH_FAILED);
+    EXPECT_EQ(pattern.load(), 2);
+    EXPECT_EQ(bus.getSubscriptionCount(), 1u);
+
+    bus.disconnect();
+    EXPECT_FALSE(bus.isConnected());
+    EXPECT_TRUE(bus.publish(makeMessage("ailee/tasks/t1/result", 7)).code == NetworkErrorCode::NOT_CONNECTED);
+}
+
+TEST(InProcessPubSubTest, PriorityLanesAndDropNewestOverflow) {
+    InProcessPubSubConfig config;
+    config.dispatcherThreads = 1;
+    config.queueCapacity = 4;
+    config.overflowPolicy = OverflowPolicy::DROP_NEWEST;
+    InProcessPubSub bus(config);
+    ASSERT_TRUE(bus.connect().isSuccess());
+
+    Gate gate;
+    std::mutex order_mutex;
+    std::vector<std::uint8_t> order;
+    ASSERT_TRUE(bus.subscribe("jobs", [&](const Message& m) {
+        if (m.data[0] == 0) {
+            gate.wait();
+        }
+        std::lock_guard<std::mutex> lock(order_mutex);
+        order.push_back(m.data[0]);
+    }).isSuccess());
+
+    // Park the dispatcher on the first message so the rest queue up.
+    ASSERT_TRUE(bus.publish(makeMessage("jobs", 0)).isSuccess());
+    while (gate.waiting.load() == 0) {
+        std::this_thread::yield();
+    }
+
+    PublishOptions low;
+    PublishOptions high;
+    high.priority = 200;
+    ASSERT_TRUE(bus.publish(makeMessage("jobs", 1), low).isSuccess());
+    ASSERT_TRUE(bus.publish(makeMessage("jobs", 2), low).isSuccess());
+    ASSERT_TRUE(bus.publish(makeMessage("jobs", 3), high).isSuccess());
+    ASSERT_TRUE(bus.publish(makeMessage("jobs", 4), high).isSuccess());
+    EXPECT_TRUE(bus.publish(makeMessage("jobs", 5), high).code == NetworkErrorCode::PUBLISH_FAILED);
+    gate.open();
+
+    PublishOptions acked;
+    acked.requireAck = true;
+    acked.priority = 0;
+    ASSERT_TRUE(bus.publish(makeMessage("jobs", 6), acked).isSuccess());
+
+    std::lock_guard<std::mutex> lock(order_mutex);
+    ASSERT_EQ(order.size(), 6u);
+    EXPECT_EQ(order[0], 0);
+    EXPECT_EQ(order[1], 3);
+    EXPECT_EQ(order[2], 4);
+    EXPECT_EQ(order[3], 1);
+    EXPECT_EQ(order[4], 2);
+    EXPECT_EQ(order[5], 6);
+    EXPECT_EQ(bus.stats().dropped, 1u);
+}
+
+TEST(InProcessPubSubTest, BlockPolicyAppliesBackpressureAndAckTimesOut) {
+    InProcessPubSubConfig config;
+    config.dispatcherThreads = 2;
+    config.queueCapacity = 1;
+    config.overflowPolicy = OverflowPolicy::BLOCK;
+    InProcessPubSub bus(config);
+    ASSERT_TRUE(bus.connect().isSuccess());
+
+    Gate gate;
+    std::atomic<int> handled{0};
+    ASSERT_TRUE(bus.subscribe("slow", [&](const Message& m) {
+        if (m.data[0] == 0) {
+            gate.wait();
+        }
+        handled++;
+    }).isSuccess());
+
+    ASSERT_TRUE(bus.publish(makeMessage("slow", 0)).isSuccess());
+    while (gate.waiting.load() == 0) {
+        std::this_thread::yield();
+    }
+    ASSERT_TRUE(bus.publish(makeMessage("slow", 1)).isSuccess());  // fills the queue
+
+    // Queue is full and the handler is parked: a short publish times out.
+    PublishOptions quick;
+    quick.timeout = std::chrono::milliseconds(20);
+    EXPECT_TRUE(bus.publish(makeMessage("slow", 2), quick).code == NetworkErrorCode::PUBLISH_FAILED);
+
+    // An acked publish waits for queue space, then for its handler.
+    std::thread opener([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        gate.open();
+    });
+    PublishOptions acked;
+    acked.requireAck = true;
+    acked.timeout = std::chrono::milliseconds(2000);
+    EXPECT_TRUE(bus.publish(makeMessage("slow", 3), acked).isSuccess());
+    opener.join();
+    EXPECT_EQ(handled.load(), 3);
+
+    Gate stuck;
+    SubscriptionOptions opts;
+    SubscriptionId id = 0;
+    ASSERT_TRUE(bus.subscribe("stuck", [&](const Message&) { stuck.wait(); }, opts, &id).isSuccess());
+    acked.timeout = std::chrono::milliseconds(30);
+    EXPECT_TRUE(bus.publish(makeMessage("stuck", 1), acked).code == NetworkErrorCode::TIMEOUT);
+    stuck.open();
+    bus.disconnect();
+}
+
+TEST(InProcessPubSubTest, RedeliveryRetriesThrowingHandler) {
+    InProcessPubSub bus;
+    ASSERT_TRUE(bus.connect().isSuccess());
+
+    std::atomic<int> calls{0};
+    SubscriptionOptions retry;
+    retry.allowRedelivery = true;
+    retry.maxRetries = 2;
+    SubscriptionId id = 0;
+    ASSERT_TRUE(bus.subscribe("flaky", [&](const Message&) {
+        if (calls.fetch_add(1) < 2) {
+            throw std::runtime_error("transient");
+        }
+    }, retry, &id).isSuccess());
+
+    PublishOptions acked;
+    acked.requireAck = true;
+    EXPECT_TRUE(bus.publish(makeMessage("flaky", 1), acked).isSuccess());
+    EXPECT_EQ(calls.load(), 3);
+
+    calls = -10;
+    EXPECT_TRUE(bus.publish(makeMessage("flaky", 2), acked).code == NetworkErrorCode::PUBLISH_FAILED);
+    EXPECT_EQ(bus.stats().handlerFailures, 1u);
+}
+
+TEST(InProcessPubSubTest, UnsubscribeWaitsForBlockedHandler) {
+    InProcessPubSub bus;
+    ASSERT_TRUE(bus.connect().isSuccess());
+
+    Gate gate;
+    std::atomic<int> calls{0};
+    SubscriptionId id = 0;
+    ASSERT_TRUE(bus.subscribe("slow", [&](const Message&) {
+        calls++;
+        gate.wait();
+    }, SubscriptionOptions{}, &id).isSuccess());
+    ASSERT_TRUE(bus.publish(makeMessage("slow", 1)).isSuccess());
+    ASSERT_TRUE(bus.publish(makeMessage("slow", 2)).isSuccess());
+    while (gate.waiting.load() == 0) {
+        std::this_thread::yield();
+    }
+
+    std::atomic<bool> returned{false};
+    std::thread remover([&] {
+        EXPECT_TRUE(bus.unsubscribe(id).isSuccess());
+        returned = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    EXPECT_FALSE(returned.load());
+
+    gate.open();
+    remover.join();
+    EXPECT_TRUE(returned.load());
+    // The queued second message is discarded, never delivered.
+    EXPECT_EQ(calls.load(), 1);
+    EXPECT_EQ(bus.getSubscriptionCount(), 0u);
+}
+
+TEST(InProcessPubSubTest, HandlersUnsubscribingEachOtherDoNotDeadlock) {
+    InProcessPubSubConfig config;
+    config.dispatcherThreads = 2;
+    InProcessPubSub bus(config);
+    ASSERT_TRUE(bus.connect().isSuccess());
+
+    // Both handlers are running before either unsubscribes the other.
+    std::atomic<int> entered{0};
+    std::atomic<int> finished{0};
+    SubscriptionId a = 0;
+    SubscriptionId b = 0;
+    auto handlerFor = [&](const SubscriptionId* other) {
+        return [&, other](const Message&) {
+            entered++;
+            while (entered.load() < 2) {
+                std::this_thread::yield();
+            }
+            EXPECT_TRUE(bus.unsubscribe(*other).isSuccess());
+            finished++;
+        };
+    };
+    ASSERT_TRUE(bus.subscribe("a", handlerFor(&b), SubscriptionOptions{}, &a).isSuccess());
+    ASSERT_TRUE(bus.subscribe("b", handlerFor(&a), SubscriptionOptions{}, &b).isSuccess());
+    ASSERT_TRUE(bus.publish(makeMessage("a", 1)).isSuccess());
+    ASSERT_TRUE(bus.publish(makeMessage("b", 1)).isSuccess());
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (finished.load() < 2 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(finished.load(), 2);
+    EXPECT_EQ(bus.getSubscriptionCount(), 0u);
+}
+
+TEST(InProcessPubSubTest, DisconnectFromHandlerDoesNotSelfJoin) {
+    InProcessPubSub bus;
+    ASSERT_TRUE(bus.connect().isSuccess());
+
+    std::atomic<bool> done{false};
+    std::atomic<int> calls{0};
+    ASSERT_TRUE(bus.subscribe("stop", [&](const Message&) {
+        if (calls.fetch_add(1) == 0) {
+            bus.disconnect();
+            done = true;
+        }
+    }).isSuccess());
+    ASSERT_TRUE(bus.publish(makeMessage("stop", 1)).isSuccess());
+    while (!done.load()) {
+        std::this_thread::yield();
+    }
+    EXPECT_FALSE(bus.isConnected());
+    EXPECT_TRUE(bus.publish(makeMessage("stop", 2)).code == NetworkErrorCode::NOT_CONNECTED);
+
+    // Reconnecting joins the retired dispatcher and delivery resumes.
+    ASSERT_TRUE(bus.connect().isSuccess());
+    PublishOptions acked;
+    acked.requireAck = true;
+    EXPECT_TRUE(bus.publish(makeMessage("stop", 3), acked).isSuccess());
+    EXPECT_EQ(calls.load(), 2);
+}
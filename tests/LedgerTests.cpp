@@ -0,0 +1,229 @@
+#include <gtest/gtest.h>
+#include "Ledger.h"
+#include "L2State.h"
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ailee::econ;
+
+TEST(LedgerTest, SnapshotIsSortedByKey) {
+    InMemoryLedger ledger;
+    const std::vector<std::string> peers = {"peer-m", "peer-a", "peer-z", "peer-c", "peer-q"};
+    for (const auto& peer : peers) {
+        ledger.credit(peer, 100);
+    }
+    ASSERT_TRUE(ledger.putInEscrow({"task-9", "peer-a", 10, false, 0}));
+    ASSERT_TRUE(ledger.putInEscrow({"task-1", "peer-z", 20, false, 0}));
+    ASSERT_TRUE(ledger.putInEscrow({"task-5", "peer-m", 30, false, 0}));
+
+    auto snapshot = ledger.snapshot();
+    ASSERT_EQ(snapshot.balances.size(), peers.size());
+    for (size_t i = 1; i < snapshot.balances.size(); ++i) {
+        EXPECT_TRUE(snapshot.balances[i - 1].peerId < snapshot.balances[i].peerId);
+    }
+    ASSERT_EQ(snapshot.escrows.size(), 3u);
+    EXPECT_EQ(snapshot.escrows[0].taskId, "task-1");
+    EXPECT_EQ(snapshot.escrows[1].taskId, "task-5");
+    EXPECT_EQ(snapshot.escrows[2].taskId, "task-9");
+    EXPECT_EQ(snapshot.escrows[0].clientPeerId, "peer-z");
+    EXPECT_EQ(snapshot.escrows[0].amount, 20u);
+}
+
+TEST(LedgerTest, VersionIsIsolatedFromLaterWrites) {
+    InMemoryLedger ledger;
+    for (int i = 0; i < 64; ++i) {
+        ledger.credit("peer-" + std::to_string(i), 1000);
+    }
+    ASSERT_TRUE(ledger.putInEscrow({"task-a", "peer-1", 500, false, 0}));
+
+    LedgerVersion before = ledger.version();
+
+    ASSERT_TRUE(ledger.transfer("peer-1", "peer-2", 250));
+    ASSERT_TRUE(ledger.debit("peer-3", 1000));  // drops the account
+    ASSERT_TRUE(ledger.releaseEscrow("task-a", "peer-4"));
+    ledger.credit("peer-new", 7);
+
+    ASSERT_NE(before.balances.find("peer-1"), nullptr);
+    EXPECT_EQ(*before.balances.find("peer-1"), 500u);
+    EXPECT_EQ(*before.balances.find("peer-2"), 1000u);
+    EXPECT_NE(before.balances.find("peer-3"), nullptr);
+    EXPECT_EQ(before.balances.find("peer-new"), nullptr);
+    EXPECT_EQ(before.balances.size(), 64u);
+    EXPECT_TRUE(before.escrows.contains("task-a"));
+
+    EXPECT_EQ(ledger.balanceOf("peer-1"), 250u);
+    EXPECT_EQ(ledger.balanceOf("peer-2"), 1250u);
+    EXPECT_EQ(ledger.balanceOf("peer-3"), 0u);
+    EXPECT_EQ(ledger.balanceOf("peer-4"), 1500u);
+    EXPECT_FALSE(ledger.hasEscrow("task-a"));
+    EXPECT_EQ(ledger.getAccountCount(), 64u);
+
+    auto old_snapshot = before.materialize();
+    EXPECT_EQ(old_snapshot.balances.size(), 64u);
+    EXPECT_EQ(old_snapshot.escrows.size(), 1u);
+}
+
+TEST(LedgerTest, VersionBackedSnapshotMatchesMaterializedOne) {
+    InMemoryLedger ledger;
+    for (int i = 0; i < 32; ++i) {
+        ledger.credit("peer-" + std::to_string((i * 7) % 32), 100 + i);
+    }
+    ASSERT_TRUE(ledger.putInEscrow({"task-b", "peer-1", 10, true, 5}));
+    ASSERT_TRUE(ledger.putInEscrow({"task-a", "peer-2", 20, false, 6, 500}));
+
+    ailee::l2::L2StateSnapshot byVersion;
+    byVersion.snapshotTimestampMs = 42;
+    byVersion.ledgerVersion = std::make_shared<const LedgerVersion>(ledger.version());
+    ailee::l2::L2StateSnapshot flat;
+    flat.snapshotTimestampMs = 42;
+    flat.ledger = ledger.snapshot();
+
+    const std::string root = ailee::l2::computeL2StateRoot(flat);
+    EXPECT_EQ(ailee::l2::computeL2StateRoot(byVersion), root);
+
+    // Later writes do not reach the captured version.
+    ledger.credit("peer-late", 1);
+    EXPECT_EQ(ailee::l2::computeL2StateRoot(byVersion), root);
+
+    const std::string path = "/tmp/ailee_ledger_version_snapshot.txt";
+    std::remove(path.c_str());
+    ASSERT_TRUE(ailee::l2::appendSnapshotToFile(byVersion, path, nullptr));
+    auto loaded = ailee::l2::loadLatestSnapshotFromFile(path, nullptr);
+    std::remove(path.c_str());
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(loaded->ledger.balances.size(), 32u);
+    ASSERT_TRUE(loaded->ledger.escrows.size() == 2u);
+    EXPECT_EQ(loaded->ledger.escrows[0].taskId, "task-a");
+    EXPECT_EQ(loaded->ledger.escrows[0].timeoutMs, 500u);
+    EXPECT_EQ(ailee::l2::computeL2StateRoot(*loaded), root);
+}
+
+TEST(LedgerTest, PersistentMapStaysBalancedUnderChurn) {
+    ailee::util::PersistentMap<int, int> map;
+    for (int i = 0; i < 2000; ++i) {
+        map.insert_or_assign((i * 7919) % 2000, i);
+    }
+    EXPECT_EQ(map.size(), 2000u);
+    for (int i = 0; i < 2000; i += 2) {
+        EXPECT_TRUE(map.erase(i));
+    }
+    EXPECT_FALSE(map.erase(0));
+    EXPECT_EQ(map.size(), 1000u);
+
+    int expected = 1;
+    for (const auto& [key, value] : map) {
+        (void)value;
+        EXPECT_EQ(key, expected);
+        expected += 2;
+    }
+    EXPECT_EQ(expected, 2001);
+
+    auto it = map.lower_bound(1000);
+    ASSERT_TRUE(it != map.end());
+    EXPECT_EQ(it.key(), 1001);
+}
+
+TEST(LedgerTest, SweepExpiredRefundsOnlyExpiredUnlockedEscrows) {
+    InMemoryLedger ledger;
+    ledger.credit("client-a", 1000);
+    ledger.credit("client-b", 1000);
+
+    ASSERT_TRUE(ledger.putInEscrow({"short-1", "client-a", 100, false, 0, 1}));
+    ASSERT_TRUE(ledger.putInEscrow({"short-2", "client-b", 200, false, 0, 1}));
+    ASSERT_TRUE(ledger.putInEscrow({"locked", "client-a", 50, true, 0, 1}));
+    ASSERT_TRUE(ledger.putInEscrow({"forever", "client-b", 300, false, 0, 0}));
+    ASSERT_TRUE(ledger.putInEscrow({"long", "client-a", 10, false, 0, 3600000}));
+
+    EXPECT_EQ(ledger.getOutstandingEscrowCount("client-a"), 3u);
+    EXPECT_EQ(ledger.getOutstandingEscrowAmount("client-b"), 500u);
+
+    std::vector<LedgerEvent> events;
+    ledger.registerEventCallback([&](const LedgerEvent& event) { events.push_back(event); });
+
+    const std::uint64_t now = ledger.getEscrow("short-1")->deadline() + 1000;
+    auto result = ledger.sweepExpired(now, 16);
+
+    ASSERT_EQ(result.refundedTaskIds.size(), 2u);
+    EXPECT_EQ(result.refundedAmount, 300u);
+    EXPECT_EQ(result.skippedLocked, 1u);
+    EXPECT_FALSE(result.more);
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_EQ(events[0].type, LedgerEventType::ESCROW_REFUNDED);
+
+    EXPECT_EQ(ledger.balanceOf("client-a"), 1000u - 50u - 10u);
+    EXPECT_EQ(ledger.balanceOf("client-b"), 1000u - 300u);
+    EXPECT_TRUE(ledger.hasEscrow("locked"));
+    EXPECT_TRUE(ledger.hasEscrow("forever"));
+    EXPECT_TRUE(ledger.hasEscrow("long"));
+    EXPECT_EQ(ledger.getOutstandingEscrowCount("client-a"), 2u);
+    EXPECT_EQ(ledger.getOutstandingEscrowCount("client-b"), 1u);
+    EXPECT_EQ(ledger.getOutstandingEscrowAmount("client-b"), 300u);
+}
+
+TEST(LedgerTest, SweepExpiredHonoursLimitAndClientQuota) {
+    InMemoryLedger ledger;
+    ledger.credit("client", 1000);
+    ledger.setMaxEscrowsPerClient(3);
+
+    ASSERT_TRUE(ledger.putInEscrow({"t1", "client", 1, false, 0, 1}));
+    ASSERT_TRUE(ledger.putInEscrow({"t2", "client", 1, false, 0, 1}));
+    ASSERT_TRUE(ledger.putInEscrow({"t3", "client", 1, false, 0, 1}));
+    EXPECT_FALSE(ledger.putInEscrow({"t4", "client", 1, false, 0, 1}));
+
+    const std::uint64_t now = ledger.getEscrow("t3")->deadline() + 1000;
+    auto first = ledger.sweepExpired(now, 2);
+    EXPECT_EQ(first.refundedTaskIds.size(), 2u);
+    EXPECT_TRUE(first.more);
+
+    auto second = ledger.sweepExpired(now, 2);
+    EXPECT_EQ(second.refundedTaskIds.size(), 1u);
+    EXPECT_FALSE(second.more);
+
+    EXPECT_EQ(ledger.getOutstandingEscrowCount("client"), 0u);
+    EXPECT_EQ(ledger.balanceOf("client"), 1000u);
+    EXPECT_TRUE(ledger.putInEscrow({"t4", "client", 1, false, 0, 1}));
+}
+
+TEST(LedgerTest, SweepParksExpiredLockedEscrowsAndSaturatesDeadline) {
+    InMemoryLedger ledger;
+    ledger.credit("client", 1000);
+    ASSERT_TRUE(ledger.putInEscrow({"locked", "client", 50, true, 0, 1}));
+    ASSERT_TRUE(ledger.putInEscrow({"huge", "client", 1, false, 0, std::numeric_limits<std::uint64_t>::max()}));
+    EXPECT_EQ(ledger.getEscrow("huge")->deadline(), std::numeric_limits<std::uint64_t>::max());
+
+    const std::uint64_t now = ledger.getEscrow("locked")->deadline() + 1000;
+    auto first = ledger.sweepExpired(now, 16);
+    EXPECT_EQ(first.skippedLocked, 1u);
+    auto second = ledger.sweepExpired(now, 16);
+    EXPECT_EQ(second.skippedLocked, 0u);
+    EXPECT_TRUE(second.refundedTaskIds.empty());
+    EXPECT_TRUE(ledger.hasEscrow("locked"));
+    EXPECT_TRUE(ledger.hasEscrow("huge"));
+}
+
+TEST(LedgerTest, ConcurrentPutInEscrowRespectsQuota) {
+    InMemoryLedger ledger;
+    ledger.credit("client", 1000000);
+    ledger.setMaxEscrowsPerClient(5);
+
+    std::atomic<int> accepted{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < 50; ++i) {
+                if (ledger.putInEscrow({"task-" + std::to_string(t) + "-" + std::to_string(i), "client", 1, false, 0, 0})) {
+                    ++accepted;
+                }
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    EXPECT_EQ(accepted.load(), 5);
+    EXPECT_EQ(ledger.getOutstandingEscrowCount("client"), 5u);
+    EXPECT_EQ(ledger.balanceOf("client"), 1000000u - 5u);
+}
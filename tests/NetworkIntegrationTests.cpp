@@ -2,7 +2,14 @@
 #include "l3/NetworkReflection.h"
 #include "l3/NetworkBinding.h"
 #include "l3/NetworkDriver.h"
+#include "third_party/httplib.h"
+#include <json/json.h>
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <sstream>
 #include <string>
+#include <thread>
 
 using namespace ailee;
 using namespace ailee::l3;
@@ -113,3 +120,88 @@ TEST(NetworkIntegrationTests, DriverProducesEnvelopes) {
         EXPECT_EQ(summary.sequence.envelopes[i].context.mesh_coherence_score, 4); // Dummy active_connections=4 -> score=4
     }
 }
+
+TEST(NetworkIntegrationTests, DriverBatchesRpcOverOneConnection) {
+    // Stub bitcoind: answers JSON-RPC batches, reversing the reply order to
+    // check replies are matched by id.
+    httplib::Server server;
+    std::atomic<int> posts{0};
+    std::mutex ports_mutex;
+    std::set<int> client_ports;
+
+    server.Post("/", [&](const httplib::Request& req, httplib::Response& res) {
+        posts++;
+        {
+            std::lock_guard<std::mutex> lock(ports_mutex);
+            client_ports.insert(req.remote_port);
+        }
+
+        Json::Value batch;
+        Json::CharReaderBuilder reader;
+        std::string errs;
+        std::istringstream in(req.body);
+        ASSERT_TRUE(Json::parseFromStream(reader, in, &batch, &errs));
+        ASSERT_TRUE(batch.isArray());
+
+        Json::Value replies(Json::arrayValue);
+        for (Json::ArrayIndex i = batch.size(); i-- > 0;) {
+            const Json::Value& call = batch[i];
+            const std::string method = call["method"].asString();
+            Json::Value reply(Json::objectValue);
+            reply["id"] = call["id"];
+            reply["error"] = Json::Value();
+            if (method == "getblockhash") {
+                reply["result"] = "00000000000000000000000000000000000000000000000000000000000000" +
+                                  std::string(call["params"][0].asUInt() % 2 ? "ff" : "0f");
+            } else if (method == "getblock") {
+                Json::Value block(Json::objectValue);
+                block["hash"] = call["params"][0];
+                block["height"] = 700000;
+                block["nTx"] = 10;
+                reply["result"] = block;
+            } else if (method == "getmempoolinfo") {
+                Json::Value mempool(Json::objectValue);
+                mempool["size"] = 42;
+                reply["result"] = mempool;
+            } else {
+                Json::Value peers(Json::arrayValue);
+                Json::Value peer(Json::objectValue);
+                peer["connection_type"] = "outbound";
+                peers.append(peer);
+                peers.append(peer);
+                reply["result"] = peers;
+            }
+            replies.append(reply);
+        }
+        res.set_content(Json::writeString(Json::StreamWriterBuilder(), replies), "application/json");
+    });
+
+    server.set_keep_alive_max_count(100);
+    const int port = server.bind_to_any_port("127.0.0.1");
+    ASSERT_TRUE(port > 0);
+    std::thread server_thread([&]() { server.listen_after_bind(); });
+    server.wait_until_ready();
+
+    NetworkConfig config;
+    config.rpc_url = "http://127.0.0.1:" + std::to_string(port) + "/";
+    config.rpc_user = "user";
+    config.rpc_password = "pass";
+    config.max_steps = 10;
+    config.prefetch_window = 4;
+
+    identity::NodeId node_id = {};
+    NetworkRunSummary summary = NetworkDriver::run_offline(config, node_id, 1);
+
+    server.stop();
+    server_thread.join();
+
+    EXPECT_EQ(summary.envelopes_produced, 10u);
+    EXPECT_EQ(summary.final_network_height, 700000u);
+    for (const auto& envelope : summary.sequence.envelopes) {
+        EXPECT_EQ(envelope.context.mesh_coherence_score, 2); // two outbound peers
+    }
+
+    // Windows of 4, 4 and 2 steps, two batches each, on one connection.
+    EXPECT_EQ(posts.load(), 6);
+    EXPECT_EQ(client_ports.size(), 1u);
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include "ZKVerifier.h"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ailee::zk;
+
+TEST(NonceManagerTest, SlidingWindowRejectsReplaysAndStaleNonces) {
+    NonceManager nonces;
+    const uint64_t W = NonceManager::kWindowBits;
+
+    EXPECT_FALSE(nonces.hasNonce(10, "w1"));
+    EXPECT_TRUE(nonces.checkAndMark(10, "w1"));
+    EXPECT_TRUE(nonces.hasNonce(10, "w1"));
+    EXPECT_FALSE(nonces.hasNonce(10, "w2"));
+    EXPECT_FALSE(nonces.checkAndMark(10, "w1"));
+
+    // Out-of-order nonces inside the window are accepted once.
+    EXPECT_TRUE(nonces.checkAndMark(500, "w1"));
+    EXPECT_TRUE(nonces.checkAndMark(499, "w1"));
+    EXPECT_TRUE(nonces.checkAndMark(500 - W + 1, "w1"));
+    EXPECT_FALSE(nonces.checkAndMark(499, "w1"));
+    // Below the window is indistinguishable from a replay.
+    EXPECT_TRUE(nonces.hasNonce(500 - W, "w1"));
+    EXPECT_FALSE(nonces.checkAndMark(500 - W, "w1"));
+    // 10 fell out of the window when the high-water mark moved to 500.
+    EXPECT_TRUE(nonces.hasNonce(10, "w1"));
+
+    // Sliding by less than a word keeps bits across word boundaries.
+    EXPECT_TRUE(nonces.checkAndMark(563, "w1"));
+    EXPECT_TRUE(nonces.hasNonce(500, "w1"));
+    EXPECT_TRUE(nonces.hasNonce(499, "w1"));
+    EXPECT_FALSE(nonces.hasNonce(498, "w1"));
+    EXPECT_FALSE(nonces.hasNonce(563 - W + 1, "w1"));
+
+    nonces.markNonceUsed(563, "w1");
+    auto stats = nonces.getStats();
+    EXPECT_EQ(stats.uniqueWorkers, 1u);
+    EXPECT_EQ(stats.replayAttempts, 4u);
+    EXPECT_EQ(stats.totalTracked, 3u); // 499, 500, 563
+}
+
+TEST(NonceManagerTest, CleanupAndCapacityDropLeastRecentWorkers) {
+    // Room for one window per shard. Nonces rise with the worker index so
+    // no worker starts below a floor folded from an earlier one.
+    NonceManager nonces(16 * NonceManager::kWindowBits);
+    for (int i = 0; i < 200; ++i) {
+        nonces.markNonceUsed(i + 1, "worker-" + std::to_string(i));
+    }
+    auto stats = nonces.getStats();
+    EXPECT_TRUE(stats.uniqueWorkers <= 16u);
+    EXPECT_EQ(stats.totalTracked, stats.uniqueWorkers);
+    // The most recent worker always survives.
+    EXPECT_TRUE(nonces.hasNonce(200, "worker-199"));
+    // Evicted workers keep their high-water mark, so replays stay rejected.
+    EXPECT_TRUE(nonces.hasNonce(1, "worker-0"));
+    const bool replayedEvicted = nonces.checkAndMark(1, "worker-0");
+    EXPECT_FALSE(replayedEvicted);
+    const bool freshEvicted = nonces.checkAndMark(1000, "worker-0");
+    EXPECT_TRUE(freshEvicted);
+
+    nonces.cleanupOldNonces(std::chrono::seconds(3600));
+    stats = nonces.getStats();
+    EXPECT_TRUE(stats.uniqueWorkers > 0u);
+    nonces.cleanupOldNonces(std::chrono::seconds(0));
+    stats = nonces.getStats();
+    EXPECT_EQ(stats.uniqueWorkers, 0u);
+    EXPECT_EQ(stats.totalTracked, 0u);
+    EXPECT_TRUE(nonces.hasNonce(200, "worker-199"));
+    const bool replayedExpired = nonces.checkAndMark(200, "worker-199");
+    EXPECT_FALSE(replayedExpired);
+    const bool replayedBelow = nonces.checkAndMark(999, "worker-0");
+    EXPECT_FALSE(replayedBelow);
+    const bool freshExpired = nonces.checkAndMark(2000, "worker-199");
+    EXPECT_TRUE(freshExpired);
+}
+
+TEST(NonceManagerTest, RetiredFloorsStayBoundedUnderWorkerChurn) {
+    // One window per shard, so at most four retired floors per shard.
+    NonceManager nonces(16 * NonceManager::kWindowBits);
+    for (int i = 0; i < 10000; ++i) {
+        nonces.markNonceUsed(100 + i, "worker-" + std::to_string(i));
+    }
+    auto stats = nonces.getStats();
+    EXPECT_TRUE(stats.uniqueWorkers <= 16u);
+    EXPECT_TRUE(stats.retiredWorkers <= 16u * 4u);
+
+    // worker-0's own floor was folded away; the shard floor still covers it.
+    EXPECT_TRUE(nonces.hasNonce(100, "worker-0"));
+    const bool replayed = nonces.checkAndMark(100, "worker-0");
+    EXPECT_FALSE(replayed);
+    // The cost: an unseen worker's low nonces are rejected too.
+    EXPECT_TRUE(nonces.hasNonce(100, "worker-new"));
+    const bool fresh = nonces.checkAndMark(20000, "worker-new");
+    EXPECT_TRUE(fresh);
+
+    nonces.cleanupOldNonces(std::chrono::seconds(0));
+    stats = nonces.getStats();
+    EXPECT_EQ(stats.uniqueWorkers, 0u);
+    EXPECT_TRUE(stats.retiredWorkers <= 16u * 4u);
+}
+
+TEST(NonceManagerTest, ConcurrentMarksAcceptEachNonceOnce) {
+    NonceManager nonces(1 << 20);
+    std::atomic<int> accepted{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&] {
+            for (uint64_t n = 0; n < 2000; ++n) {
+                if (nonces.checkAndMark(n, "worker-" + std::to_string(n % 4))) {
+                    ++accepted;
+                }
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    EXPECT_EQ(accepted.load(), 2000);
+    EXPECT_EQ(nonces.getStats().replayAttempts, 7u * 2000u);
+}
@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+#include "Orchestrator.h"
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ailee::sched;
+
+namespace {
+
+NodeMetrics makeWorker(const std::string& id, const std::string& region,
+                       double capacityScore, uint32_t maxTasks, uint32_t active = 0) {
+    NodeMetrics node;
+    node.peerId = id;
+    node.region = region;
+    node.bandwidthMbps = 100.0;
+    node.latencyMs = 20.0;
+    node.capacityScore = capacityScore;
+    node.maxConcurrentTasks = maxTasks;
+    node.activeTaskCount = active;
+    node.capabilities.cpuCores = 8;
+    node.capabilities.memoryGB = 16;
+    node.capabilities.storageGB = 100;
+    return node;
+}
+
+TaskPayload makeTask(const std::string& id) {
+    TaskPayload task;
+    task.taskId = id;
+    return task;
+}
+
+// Records which threads read latencies and how often.
+class RecordingLatencyMap final : public ILatencyMap {
+public:
+    std::optional<double> getLatencyMs(const std::string& peerId) const override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        reads_++;
+        readers_.insert(std::this_thread::get_id());
+        return inner_.getLatencyMs(peerId);
+    }
+    void updateLatency(const std::string& peerId, double latencyMs) override {
+        inner_.updateLatency(peerId, latencyMs);
+    }
+    std::optional<double> getBandwidthMbps(const std::string& peerId) const override {
+        return inner_.getBandwidthMbps(peerId);
+    }
+    std::optional<double> getJitterMs(const std::string& peerId) const override {
+        return inner_.getJitterMs(peerId);
+    }
+    std::optional<double> probeLatency(const std::string& peerId) override {
+        return inner_.probeLatency(peerId);
+    }
+    std::optional<double> getDistanceKm(const std::string& peerId) const override {
+        return inner_.getDistanceKm(peerId);
+    }
+    std::unordered_map<std::string, double> getAllLatencies() const override {
+        return inner_.getAllLatencies();
+    }
+    void cleanupStale(std::chrono::seconds maxAge) override { inner_.cleanupStale(maxAge); }
+
+    std::size_t reads() const { return reads_; }
+    std::set<std::thread::id> readers() const { return readers_; }
+
+private:
+    LatencyMap inner_;
+    mutable std::mutex mutex_;
+    mutable std::size_t reads_ = 0;
+    mutable std::set<std::thread::id> readers_;
+};
+
+} // namespace
+
+TEST(OrchestratorTest, BatchRespectsWorkerCapacity) {
+    ReputationLedger rep;
+    LatencyMap lat;
+    WeightedOrchestrator orch(rep, lat);
+
+    std::vector<NodeMetrics> workers = {
+        makeWorker("top", "eu", 1.0, 5, 2),   // 3 free slots
+        makeWorker("mid", "eu", 0.6, 4),
+        makeWorker("low", "us", 0.2, 10),
+        makeWorker("full", "eu", 2.0, 3, 3),  // no free slots
+    };
+
+    std::vector<TaskPayload> tasks;
+    for (int i = 0; i < 12; ++i) {
+        tasks.push_back(makeTask("t" + std::to_string(i)));
+    }
+
+    auto assignments = orch.scheduleBatch(tasks, workers);
+    ASSERT_EQ(assignments.size(), tasks.size());
+
+    std::map<std::string, int> load;
+    for (const auto& a : assignments) {
+        ASSERT_TRUE(a.assigned);
+        load[a.workerPeerId]++;
+    }
+    EXPECT_EQ(load["top"], 3);
+    EXPECT_EQ(load["mid"], 4);
+    EXPECT_EQ(load["low"], 5);
+    EXPECT_EQ(load.count("full"), 0u);
+}
+
+TEST(OrchestratorTest, BatchAppliesBucketsBlacklistAndReportsExhaustion) {
+    ReputationLedger rep;
+    LatencyMap lat;
+    WeightedOrchestrator orch(rep, lat);
+
+    std::vector<NodeMetrics> workers = {
+        makeWorker("eu-1", "eu", 1.0, 1),
+        makeWorker("eu-2", "eu", 0.5, 1),
+        makeWorker("gpu-1", "asia", 0.1, 2),
+        makeWorker("us-1", "us", 0.9, 0),  // no declared limit
+    };
+    workers[2].capabilities.hasGPU = true;
+
+    TaskPayload gpu = makeTask("gpu");
+    gpu.requirements.requiresGPU = true;
+    TaskPayload no_us = makeTask("no-us");
+    no_us.preferredRegion = "asia";
+    no_us.blacklistedNodes = {"us-1"};
+    TaskPayload mars = makeTask("mars");
+    mars.preferredRegion = "mars";
+
+    std::vector<TaskPayload> tasks = {gpu, no_us, mars};
+    for (int i = 0; i < 3; ++i) {
+        TaskPayload eu = makeTask("eu" + std::to_string(i));
+        eu.preferredRegion = "eu";
+        tasks.push_back(eu);
+    }
+
+    auto assignments = orch.assignParallel(tasks, workers);
+    ASSERT_EQ(assignments.size(), 6u);
+    EXPECT_EQ(assignments[0].workerPeerId, "gpu-1");
+    EXPECT_EQ(assignments[1].workerPeerId, "gpu-1");
+    EXPECT_FALSE(assignments[2].assigned);
+    EXPECT_EQ(assignments[2].reason, "no viable candidates");
+
+    // Three eu tasks for two eu slots: one of them is left over.
+    int on_eu1 = 0, on_eu2 = 0, left = 0;
+    for (size_t i = 3; i < 6; ++i) {
+        if (!assignments[i].assigned) {
+            EXPECT_EQ(assignments[i].reason, "no worker capacity");
+            left++;
+        } else if (assignments[i].workerPeerId == "eu-1") {
+            on_eu1++;
+        } else if (assignments[i].workerPeerId == "eu-2") {
+            on_eu2++;
+        }
+    }
+    EXPECT_EQ(on_eu1, 1);
+    EXPECT_EQ(on_eu2, 1);
+    EXPECT_EQ(left, 1);
+
+    std::vector<TaskPayload> free_tasks;
+    for (int i = 0; i < 6; ++i) {
+        free_tasks.push_back(makeTask("free" + std::to_string(i)));
+    }
+    free_tasks[0].blacklistedNodes = {"us-1"};
+    auto moved = orch.rebalanceTasks(free_tasks, workers);
+    EXPECT_EQ(moved.size(), 6u);
+    int on_us = 0;
+    for (const auto& [task, worker] : moved) {
+        if (worker == "us-1") {
+            EXPECT_TRUE(task != "free0");
+            on_us++;
+        }
+    }
+    // us-1 has no limit and outscores everything but eu-1's single slot,
+    // which goes to the task that cannot use us-1.
+    EXPECT_EQ(on_us, 5);
+}
+
+TEST(OrchestratorTest, BatchSnapshotsLatencyOnCallingThread) {
+    ReputationLedger rep;
+    RecordingLatencyMap lat;
+    WeightedOrchestrator orch(rep, lat);
+
+    std::vector<NodeMetrics> workers;
+    for (int i = 0; i < 512; ++i) {
+        workers.push_back(makeWorker("w" + std::to_string(i), "eu", 0.5, 2));
+        lat.updateLatency(workers.back().peerId, 10.0 + i);
+    }
+    lat.updateLatency("w0", 0.5);  // fastest by far
+
+    std::vector<TaskPayload> tasks;
+    for (int i = 0; i < 8; ++i) {
+        tasks.push_back(makeTask("t" + std::to_string(i)));
+    }
+
+    auto assignments = orch.assignParallel(tasks, workers);
+    ASSERT_EQ(assignments.size(), tasks.size());
+    int on_w0 = 0;
+    for (const auto& a : assignments) {
+        ASSERT_TRUE(a.assigned);
+        if (a.workerPeerId == "w0") on_w0++;
+    }
+    EXPECT_EQ(on_w0, 2);
+    EXPECT_EQ(lat.reads(), workers.size());
+    const auto readers = lat.readers();
+    ASSERT_EQ(readers.size(), 1u);
+    EXPECT_TRUE(*readers.begin() == std::this_thread::get_id());
+}
@@ -0,0 +1,219 @@
+#include <gtest/gtest.h>
+#include "ProofCodec.h"
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace ailee::zk;
+
+namespace {
+
+std::chrono::system_clock::time_point atMicros(std::int64_t micros) {
+    return std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::microseconds(micros)));
+}
+
+ProofBundle makeBundle() {
+    ProofBundle b;
+    b.proofBytes = std::vector<uint8_t>(4096, 0x5A);
+    b.publicInputs = {1, 2, 3};
+    b.modelHash = "model";
+    b.inputHash = "input";
+    b.outputHash = "output";
+    b.executionHash = "exec";
+    b.taskId = "task-1";
+    b.workerId = "worker-7";
+    b.circuitId = "circuit";
+    b.proofSystem = ProofSystem::HALO2;
+    b.protocolVersion = 3;
+    b.timestamp = atMicros(1760000000123456);
+    b.nonce = 42;
+    b.proverSignature = std::vector<uint8_t>{9, 8, 7};
+    b.proverPubkey = "02abcdef";
+    b.proofGenTime = std::chrono::milliseconds(1500);
+    b.proofSizeBytes = 4096;
+    b.gasConsumed = 77;
+    return b;
+}
+
+// Overwrites the big-endian int64 at `offset`.
+void putInt64(std::vector<uint8_t>& wire, std::size_t offset, std::int64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        wire[offset + i] = static_cast<uint8_t>(static_cast<std::uint64_t>(value) >> (56 - 8 * i));
+    }
+}
+
+} // namespace
+
+TEST(ProofCodecTest, BundleRoundTripsThroughViewWithoutCopying) {
+    const ProofBundle original = makeBundle();
+    const auto wire = utils::serializeProofBundle(original);
+    // Framing overhead is small and fixed; the proof dominates.
+    EXPECT_TRUE(wire.size() < original.proofBytes.size() + 256);
+
+    auto view = ProofBundleView::parse(wire);
+    ASSERT_TRUE(view.has_value());
+    EXPECT_EQ(view->proofBytes().size, original.proofBytes.size());
+    EXPECT_TRUE(view->proofBytes().data >= wire.data() && view->proofBytes().end() <= wire.data() + wire.size());
+    EXPECT_EQ(std::string(view->taskId()), "task-1");
+    EXPECT_EQ(std::string(*view->proverPubkey()), "02abcdef");
+    EXPECT_EQ(*view->nonce(), 42u);
+    EXPECT_EQ(view->proofSystem(), ProofSystem::HALO2);
+
+    auto decoded = utils::deserializeProofBundle(wire);
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(decoded->proofBytes, original.proofBytes);
+    EXPECT_EQ(decoded->publicInputs, original.publicInputs);
+    EXPECT_EQ(decoded->executionHash, original.executionHash);
+    EXPECT_EQ(decoded->workerId, original.workerId);
+    EXPECT_TRUE(decoded->timestamp == original.timestamp);
+    EXPECT_EQ(*decoded->proverSignature, *original.proverSignature);
+    EXPECT_EQ(decoded->proofGenTime->count(), 1500);
+    EXPECT_EQ(*decoded->gasConsumed, 77u);
+    EXPECT_EQ(utils::serializeProofBundle(*decoded), wire);
+
+    // Absent optionals stay absent.
+    ProofBundle minimal;
+    minimal.proofBytes = {1};
+    minimal.taskId = "t";
+    auto small = utils::deserializeProofBundle(utils::serializeProofBundle(minimal));
+    ASSERT_TRUE(small.has_value());
+    EXPECT_FALSE(small->nonce.has_value());
+    EXPECT_FALSE(small->proverPubkey.has_value());
+    EXPECT_FALSE(small->gasConsumed.has_value());
+}
+
+TEST(ProofCodecTest, RejectsMalformedEncodings) {
+    const auto wire = utils::serializeProofBundle(makeBundle());
+
+    // Every truncation fails, as does trailing data.
+    for (std::size_t len = 0; len < wire.size(); ++len) {
+        EXPECT_FALSE(ProofBundleView::parse(wire.data(), len).has_value());
+    }
+    auto padded = wire;
+    padded.push_back(0);
+    EXPECT_FALSE(ProofBundleView::parse(padded).has_value());
+
+    auto badMagic = wire;
+    badMagic[0] = 'X';
+    EXPECT_FALSE(ProofBundleView::parse(badMagic).has_value());
+    auto badVersion = wire;
+    badVersion[3] = 99;
+    EXPECT_FALSE(ProofBundleView::parse(badVersion).has_value());
+    auto badSystem = wire;
+    badSystem[4] = 200;
+    EXPECT_FALSE(ProofBundleView::parse(badSystem).has_value());
+    auto badFlags = wire;
+    badFlags[5] |= 0x80;
+    EXPECT_FALSE(ProofBundleView::parse(badFlags).has_value());
+    // A length prefix pointing past the end is caught before any copy.
+    auto hugeLength = wire;
+    hugeLength[18] = 0xFF;
+    EXPECT_FALSE(ProofBundleView::parse(hugeLength).has_value());
+    EXPECT_FALSE(utils::deserializeProofBundle(hugeLength).has_value());
+
+    // A key encoding is not a bundle.
+    VerificationKey vk;
+    vk.id = "k";
+    vk.proofSystem = ProofSystem::GROTH16;
+    EXPECT_FALSE(ProofBundleView::parse(utils::serializeVerificationKey(vk)).has_value());
+
+    auto view = ProofBundleView::parse(wire);
+    ASSERT_TRUE(view.has_value());
+    bool threw = false;
+    try {
+        view->publicInputs().at(3);
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    EXPECT_TRUE(threw);
+}
+
+TEST(ProofCodecTest, VerificationKeyRoundTrip) {
+    VerificationKey vk;
+    vk.id = "model-v1.2.3";
+    vk.data = std::vector<uint8_t>(512, 0x11);
+    vk.proofSystem = ProofSystem::PLONK;
+    vk.hashFunction = HashFunction::POSEIDON;
+    vk.vkHash = "vkhash";
+    vk.circuitCommitment = "commit";
+    vk.createdAt = atMicros(1700000000000001);
+    vk.expiresAt = atMicros(1800000000000002);
+    vk.isTrustedSetup = true;
+    vk.securityBits = 256;
+
+    const auto wire = utils::serializeVerificationKey(vk);
+    auto view = VerificationKeyView::parse(wire);
+    ASSERT_TRUE(view.has_value());
+    EXPECT_EQ(std::string(view->id()), vk.id);
+    EXPECT_EQ(view->data().size, 512u);
+    EXPECT_FALSE(view->setupCeremonyHash().has_value());
+
+    auto decoded = utils::deserializeVerificationKey(wire);
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(decoded->data, vk.data);
+    EXPECT_EQ(decoded->hashFunction, HashFunction::POSEIDON);
+    EXPECT_EQ(*decoded->circuitCommitment, "commit");
+    EXPECT_TRUE(decoded->createdAt == vk.createdAt);
+    EXPECT_TRUE(*decoded->expiresAt == *vk.expiresAt);
+    EXPECT_TRUE(decoded->isTrustedSetup);
+    EXPECT_EQ(decoded->securityBits, 256u);
+
+    auto truncated = wire;
+    truncated.pop_back();
+    EXPECT_FALSE(utils::deserializeVerificationKey(truncated).has_value());
+}
+
+TEST(ProofCodecTest, RejectsTimestampsOutsideClockRange) {
+    constexpr std::int64_t kTooLate = std::numeric_limits<std::int64_t>::max() / 1000 + 1;
+    constexpr std::int64_t kTooEarly = std::numeric_limits<std::int64_t>::min() / 1000 - 1;
+
+    // Bundle: magic, version, system, flags, protocolVersion, then timestamp.
+    const auto bundleWire = utils::serializeProofBundle(makeBundle());
+    for (std::int64_t micros : {kTooLate, kTooEarly}) {
+        auto wire = bundleWire;
+        putInt64(wire, 10, micros);
+        EXPECT_FALSE(ProofBundleView::parse(wire).has_value());
+        EXPECT_FALSE(utils::deserializeProofBundle(wire).has_value());
+    }
+    auto farFuture = bundleWire;
+    putInt64(farFuture, 10, std::numeric_limits<std::int64_t>::max() / 1000);
+    EXPECT_TRUE(ProofBundleView::parse(farFuture).has_value());
+
+    VerificationKey vk;
+    vk.id = "k";
+    vk.proofSystem = ProofSystem::GROTH16;
+    vk.createdAt = atMicros(1700000000000001);
+    vk.expiresAt = atMicros(1800000000000002);
+    const auto keyWire = utils::serializeVerificationKey(vk);
+    // Key: magic, version, system, hash, flags, securityBits, then createdAt.
+    auto badCreated = keyWire;
+    putInt64(badCreated, 11, kTooLate);
+    EXPECT_FALSE(VerificationKeyView::parse(badCreated).has_value());
+    // expiresAt follows the three length-prefixed strings.
+    const std::size_t expiryOffset = 19 + (4 + vk.id.size()) + (4 + vk.data.size()) + (4 + vk.vkHash.size());
+    auto badExpiry = keyWire;
+    putInt64(badExpiry, expiryOffset, kTooEarly);
+    EXPECT_FALSE(VerificationKeyView::parse(badExpiry).has_value());
+    EXPECT_TRUE(VerificationKeyView::parse(keyWire).has_value());
+}
+
+TEST(ProofCodecTest, WellFormedProofChecks) {
+    ProofBundle b = makeBundle();
+    EXPECT_TRUE(utils::isWellFormedProof(b));
+
+    ProofBundle noProof = b;
+    noProof.proofBytes.clear();
+    EXPECT_FALSE(utils::isWellFormedProof(noProof));
+
+    ProofBundle sizeMismatch = b;
+    sizeMismatch.proofSizeBytes = 1;
+    EXPECT_FALSE(utils::isWellFormedProof(sizeMismatch));
+
+    ProofBundle unsignedKey = b;
+    unsignedKey.proverPubkey.reset();
+    EXPECT_FALSE(utils::isWellFormedProof(unsignedKey));
+}
@@ -0,0 +1,497 @@
+#include "ProverSwarm.h"
+#include "SwarmHttpServer.h"
+#include "ZKVerifier.h"
+#include "third_party/httplib.h"
+#include "nlohmann/json.hpp"
+#include "gtest/gtest.h"
+
+#include <secp256k1.h>
+
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ailee::orchestration;
+using json = nlohmann::json;
+
+namespace {
+
+std::string getTestDbPath() {
+    return "/tmp/ailee_swarm_http_test_" + std::to_string(
+        std::chrono::system_clock::now().time_since_epoch().count());
+}
+
+std::string toHex(const unsigned char* data, std::size_t len) {
+    static const char* kHex = "0123456789abcdef";
+    std::string out;
+    for (std::size_t i = 0; i < len; ++i) {
+        out.push_back(kHex[data[i] >> 4]);
+        out.push_back(kHex[data[i] & 0x0F]);
+    }
+    return out;
+}
+
+std::string toHex(const std::string& bytes) {
+    return toHex(reinterpret_cast<const unsigned char*>(bytes.data()), bytes.size());
+}
+
+secp256k1_context* signContext() {
+    static secp256k1_context* ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
+    return ctx;
+}
+
+// A prover key pair that signs requests with increasing nonces.
+class TestProver {
+public:
+    explicit TestProver(std::uint8_t seed) {
+        secret_.fill(seed);
+        secret_[0] = 0x01;
+        secp256k1_pubkey pub;
+        EXPECT_EQ(secp256k1_ec_pubkey_create(signContext(), &pub, secret_.data()), 1);
+        unsigned char out[33];
+        std::size_t len = sizeof(out);
+        secp256k1_ec_pubkey_serialize(signContext(), out, &len, &pub, SECP256K1_EC_COMPRESSED);
+        pubkey_ = toHex(out, len);
+    }
+
+    const std::string& pubkey() const { return pubkey_; }
+
+    std::string sign(const std::string& route, std::uint64_t nonce,
+                     const std::vector<std::string>& fields = {}) const {
+        const auto digest = SwarmHttpServer::signingDigest(route, pubkey_, nonce, fields);
+        secp256k1_ecdsa_signature sig;
+        EXPECT_EQ(secp256k1_ecdsa_sign(signContext(), &sig, digest.data(), secret_.data(), nullptr, nullptr), 1);
+        unsigned char der[72];
+        std::size_t len = sizeof(der);
+        secp256k1_ecdsa_signature_serialize_der(signContext(), der, &len, &sig);
+        return toHex(der, len);
+    }
+
+    // Fields common to lease and results requests.
+    json signedBody(const std::string& route, const std::vector<std::string>& fields = {}) {
+        json body;
+        const std::uint64_t nonce = ++nonce_;
+        body["pubkey"] = pubkey_;
+        body["nonce"] = static_cast<double>(nonce);
+        body["signature"] = sign(route, nonce, fields);
+        return body;
+    }
+
+    json heartbeat() {
+        json entry;
+        const std::uint64_t nonce = ++nonce_;
+        entry["pubkey"] = pubkey_;
+        entry["nonce"] = static_cast<double>(nonce);
+        entry["signature"] = sign("/prover/heartbeat", nonce);
+        return entry;
+    }
+
+    std::string lease(std::size_t max_jobs, std::uint64_t wait_ms = 0) {
+        json body = signedBody("/prover/jobs/lease");
+        body["max_jobs"] = static_cast<double>(max_jobs);
+        body["wait_ms"] = static_cast<double>(wait_ms);
+        return body.dump();
+    }
+
+    struct Result {
+        std::string job_id;
+        bool success;
+        std::string proof;     // Raw bytes; sent hex-encoded
+        double latency_ms = 10.0;
+    };
+
+    std::string results(const std::vector<Result>& entries) {
+        std::vector<std::string> fields;
+        json arr = json::array();
+        for (const auto& r : entries) {
+            json entry;
+            entry["job_id"] = r.job_id;
+            entry["success"] = r.success;
+            entry["latency_ms"] = r.latency_ms;
+            if (!r.proof.empty()) entry["proof"] = toHex(r.proof);
+            arr.push_back(std::move(entry));
+            fields.push_back(r.job_id);
+            fields.push_back(r.success ? "1" : "0");
+            fields.push_back(r.proof.empty() ? "" : toHex(r.proof));
+        }
+        json body = signedBody("/prover/results", fields);
+        body["results"] = arr;
+        return body.dump();
+    }
+
+private:
+    std::array<unsigned char, 32> secret_{};
+    std::string pubkey_;
+    std::uint64_t nonce_ = 0;
+};
+
+// Accepts a proof when it repeats the job payload it was leased for.
+class PayloadEchoVerifier : public ailee::zk::IVerifier {
+public:
+    using VerifyResult = ailee::zk::VerifyResult;
+    using ProofBundle = ailee::zk::ProofBundle;
+
+    bool loadKey(const ailee::zk::VerificationKey&, std::string*) override { return true; }
+    VerifyResult verify(const ProofBundle& bundle) const override {
+        VerifyResult r;
+        r.verified = !bundle.proofBytes.empty() && bundle.proofBytes == bundle.publicInputs;
+        return r;
+    }
+    std::vector<VerifyResult> verifyBatch(const std::vector<ProofBundle>& bundles) const override {
+        std::vector<VerifyResult> out;
+        for (const auto& b : bundles) out.push_back(verify(b));
+        return out;
+    }
+    bool unloadKey(const std::string&) override { return true; }
+    bool hasKey(const std::string&) const override { return true; }
+    std::vector<std::string> getLoadedKeys() const override { return {}; }
+    bool validateKey(const ailee::zk::VerificationKey&, std::string*) const override { return true; }
+    bool precompileCircuit(const std::string&, std::string*) override { return true; }
+    uint64_t estimateVerificationCost(const ProofBundle&) const override { return 1; }
+    bool supportsProofSystem(ailee::zk::ProofSystem) const override { return true; }
+    std::vector<ailee::zk::ProofSystem> getSupportedSystems() const override { return {ailee::zk::ProofSystem::HALO2}; }
+    bool verifyExecutionHash(const ProofBundle&) const override { return true; }
+    bool verifyProverSignature(const ProofBundle&) const override { return true; }
+    bool verifyTimestamp(const ProofBundle&, std::chrono::seconds) const override { return true; }
+    bool verifyNonce(const ProofBundle&) override { return true; }
+    void enableCache(bool, std::size_t) override {}
+    void clearCache() override {}
+    CacheStats getCacheStats() const override { return {}; }
+    VerificationMetrics getMetrics() const override { return {}; }
+    void resetMetrics() override {}
+    void setEventCallback(EventCallback) override {}
+    void setStrictMode(bool) override {}
+    void setTimestampTolerance(std::chrono::seconds) override {}
+    std::vector<std::string> exportAuditLog() const override { return {}; }
+    std::string getImplementationInfo() const override { return "payload-echo"; }
+};
+
+// A swarm served on an ephemeral loopback port, with proofs checked by
+// PayloadEchoVerifier.
+class SwarmHttpHarness {
+public:
+    explicit SwarmHttpHarness(SwarmHttpConfig config = defaultConfig())
+        : path_(getTestDbPath()), swarm_(makeConfig(path_)),
+          pool_(2, [] { return std::make_unique<PayloadEchoVerifier>(); }) {
+        std::string err;
+        initialized_ = swarm_.initialize(&err);
+        auto vk = std::make_shared<ailee::zk::VerificationKey>();
+        vk->id = "swarm-test";
+        vk->data = {1};
+        vk->proofSystem = ailee::zk::ProofSystem::HALO2;
+        config.verifier = &pool_;
+        config.verification_key = vk;
+        SwarmHttpServer::attach(swarm_, server_, config);
+        port_ = server_.bind_to_any_port("127.0.0.1");
+        thread_ = std::thread([this] { server_.listen_after_bind(); });
+        server_.wait_until_ready();
+    }
+
+    ~SwarmHttpHarness() {
+        server_.stop();
+        thread_.join();
+        pool_.shutdown();
+        swarm_.close();
+        std::filesystem::remove_all(path_);
+    }
+
+    static SwarmHttpConfig defaultConfig() {
+        SwarmHttpConfig config;
+        config.max_batch = 8;
+        return config;
+    }
+
+    json post(const std::string& route, const std::string& body, int* status = nullptr) {
+        httplib::Client client("127.0.0.1", port_);
+        client.set_read_timeout(5, 0);
+        auto res = client.Post(route, body, "application/json");
+        if (!res) {
+            if (status) *status = 0;
+            return json();
+        }
+        if (status) *status = res->status;
+        return json::parse(res->body);
+    }
+
+    // Registers each prover and returns how many were accepted.
+    std::size_t registerAll(const std::vector<const TestProver*>& provers) {
+        json arr = json::array();
+        for (const auto* p : provers) {
+            json entry;
+            entry["pubkey"] = p->pubkey();
+            arr.push_back(std::move(entry));
+        }
+        json body;
+        body["provers"] = arr;
+        return post("/prover/register", body.dump())["accepted"].get<std::size_t>();
+    }
+
+    bool initialized() const { return initialized_; }
+    ProverSwarm& swarm() { return swarm_; }
+
+private:
+    static ProverSwarmConfig makeConfig(const std::string& path) {
+        ProverSwarmConfig config;
+        config.db_path = path;
+        return config;
+    }
+
+    std::string path_;
+    ProverSwarm swarm_;
+    ailee::zk::VerificationPool pool_;
+    bool initialized_ = false;
+    httplib::Server server_;
+    int port_ = 0;
+    std::thread thread_;
+};
+
+std::size_t count(const json& arr) {
+    std::size_t n = 0;
+    for (auto it = arr.begin(); it != arr.end(); ++it) ++n;
+    return n;
+}
+
+} // namespace
+
+TEST(ProverSwarmHttp, BatchedRegisterLeaseAndSubmit) {
+    SwarmHttpHarness h;
+    ASSERT_TRUE(h.initialized());
+    TestProver p1(3), p2(4);
+
+    json provers = json::array();
+    for (const std::string& key : {p1.pubkey(), p2.pubkey(), p1.pubkey(), std::string("not-a-key")}) {
+        json entry;
+        entry["pubkey"] = key;
+        provers.push_back(std::move(entry));
+    }
+    json body;
+    body["provers"] = provers;
+    auto reg = h.post("/prover/register", body.dump());
+    EXPECT_EQ(reg["accepted"].get<std::size_t>(), 2u);
+    EXPECT_EQ(count(reg["rejected"]), 2u);
+    EXPECT_EQ(h.swarm().getMetrics().active_provers, 2u);
+
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(h.swarm().submitJob("job-" + std::to_string(i), "payload-" + std::to_string(i)));
+    }
+
+    auto first = h.post("/prover/jobs/lease", p1.lease(4));
+    ASSERT_EQ(count(first["jobs"]), 4u);
+    EXPECT_EQ(first["jobs"][0]["job_id"].get<std::string>(), "job-0");
+    // max_jobs is capped at one batch.
+    auto second = h.post("/prover/jobs/lease", p2.lease(100));
+    EXPECT_EQ(count(second["jobs"]), 6u);
+    auto none = h.post("/prover/jobs/lease", p1.lease(4));
+    EXPECT_EQ(count(none["jobs"]), 0u);
+
+    auto results = h.post("/prover/results", p1.results({
+        {"job-0", true, "payload-0", 20},
+        {"job-1", true, "payload-1", 40},
+        {"job-2", true, "payload-2", 30},
+        {"job-3", false, ""},
+        {"job-4", true, "payload-4"},
+        {"job-0", true, "payload-0"}}));
+    EXPECT_EQ(results["accepted"].get<std::size_t>(), 4u);
+    ASSERT_EQ(count(results["rejected"]), 2u);
+    EXPECT_EQ(results["rejected"][0]["id"].get<std::string>(), "job-4");
+
+    auto metrics = h.swarm().getMetrics();
+    EXPECT_EQ(metrics.completed_jobs, 3u);
+    EXPECT_EQ(metrics.failed_jobs, 1u);
+    EXPECT_EQ(metrics.queue_depth, 7u);
+    EXPECT_EQ(h.swarm().getQueueOrder().front(), "job-3");
+    EXPECT_TRUE(h.swarm().getJob("job-1")->completed);
+
+    // The failed job is leasable again.
+    auto retry = h.post("/prover/jobs/lease", p2.lease(8));
+    ASSERT_EQ(count(retry["jobs"]), 1u);
+    EXPECT_EQ(retry["jobs"][0]["job_id"].get<std::string>(), "job-3");
+    EXPECT_EQ(retry["jobs"][0]["retry_count"].get<std::uint32_t>(), 2u);
+}
+
+TEST(ProverSwarmHttp, LongPollLeaseWakesOnNewJob) {
+    SwarmHttpHarness h;
+    ASSERT_TRUE(h.initialized());
+    TestProver p1(3);
+    ASSERT_EQ(h.registerAll({&p1}), 1u);
+
+    std::thread producer([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        h.swarm().submitJob("late-job", "{}");
+    });
+    const auto start = std::chrono::steady_clock::now();
+    auto lease = h.post("/prover/jobs/lease", p1.lease(4, 4000));
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    producer.join();
+
+    ASSERT_EQ(count(lease["jobs"]), 1u);
+    EXPECT_EQ(lease["jobs"][0]["job_id"].get<std::string>(), "late-job");
+    EXPECT_TRUE(elapsed < std::chrono::milliseconds(3000));
+
+    // Nothing queued: the wait runs out and the lease comes back empty.
+    auto empty = h.post("/prover/jobs/lease", p1.lease(1, 50));
+    EXPECT_EQ(count(empty["jobs"]), 0u);
+}
+
+TEST(ProverSwarmHttp, LongPollsBeyondCapReturnImmediately) {
+    SwarmHttpConfig config = SwarmHttpHarness::defaultConfig();
+    config.max_long_polls = 1;
+    SwarmHttpHarness h(config);
+    ASSERT_TRUE(h.initialized());
+    TestProver p1(3), p2(4);
+    ASSERT_EQ(h.registerAll({&p1, &p2}), 2u);
+
+    const std::string waiting = p1.lease(1, 1500);
+    std::thread holder([&] { h.post("/prover/jobs/lease", waiting); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    const auto start = std::chrono::steady_clock::now();
+    auto lease = h.post("/prover/jobs/lease", p2.lease(1, 1500));
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    holder.join();
+    EXPECT_EQ(count(lease["jobs"]), 0u);
+    EXPECT_TRUE(elapsed < std::chrono::milliseconds(1000));
+}
+
+TEST(ProverSwarmHttp, RegistrationIgnoresClientTrustFields) {
+    SwarmHttpHarness h;
+    ASSERT_TRUE(h.initialized());
+    TestProver p1(3);
+
+    json entry;
+    entry["pubkey"] = p1.pubkey();
+    entry["endpoint"] = "https://prover.example:8443";
+    entry["reputation"] = 1.0;
+    entry["capacity"] = 1000.0;
+    entry["banned"] = false;
+    json body;
+    body["provers"] = json::array({entry});
+    auto reg = h.post("/prover/register", body.dump());
+    EXPECT_EQ(reg["accepted"].get<std::size_t>(), 1u);
+
+    auto prover = h.swarm().getProver(p1.pubkey());
+    ASSERT_TRUE(prover.has_value());
+    EXPECT_EQ(prover->endpoint, "https://prover.example:8443");
+    EXPECT_TRUE(prover->reputation == ProverIdentity{}.reputation);
+    EXPECT_TRUE(prover->capacity == ProverIdentity{}.capacity);
+
+    // Re-registering cannot lift a ban.
+    ASSERT_TRUE(h.swarm().hardBanProver(p1.pubkey(), "test"));
+    h.post("/prover/register", body.dump());
+    EXPECT_TRUE(h.swarm().getProver(p1.pubkey())->banned);
+}
+
+TEST(ProverSwarmHttp, RequestsMustBeSignedWithFreshNonces) {
+    SwarmHttpHarness h;
+    ASSERT_TRUE(h.initialized());
+    TestProver p1(3), mallory(9);
+    ASSERT_EQ(h.registerAll({&p1}), 1u);
+    ASSERT_TRUE(h.swarm().submitJob("job-0", "payload-0"));
+
+    int status = 0;
+    // Signed by another key.
+    json forged = mallory.signedBody("/prover/jobs/lease");
+    forged["pubkey"] = p1.pubkey();
+    h.post("/prover/jobs/lease", forged.dump(), &status);
+    EXPECT_EQ(status, 401);
+    // A heartbeat signature does not authorize a lease.
+    json crossRoute = p1.heartbeat();
+    h.post("/prover/jobs/lease", crossRoute.dump(), &status);
+    EXPECT_EQ(status, 401);
+    json unsigned_;
+    unsigned_["pubkey"] = p1.pubkey();
+    unsigned_["nonce"] = 1.0;
+    h.post("/prover/jobs/lease", unsigned_.dump(), &status);
+    EXPECT_EQ(status, 400);
+
+    const std::string lease = p1.lease(1);
+    auto leased = h.post("/prover/jobs/lease", lease, &status);
+    EXPECT_EQ(status, 200);
+    EXPECT_EQ(count(leased["jobs"]), 1u);
+    h.post("/prover/jobs/lease", lease, &status);
+    EXPECT_EQ(status, 401);
+
+    // Tampering with a signed result invalidates it.
+    json results = json::parse(p1.results({{"job-0", false, ""}}));
+    results["results"][0]["success"] = true;
+    results["results"][0]["proof"] = toHex(std::string("payload-0"));
+    h.post("/prover/results", results.dump(), &status);
+    EXPECT_EQ(status, 401);
+    EXPECT_FALSE(h.swarm().getJob("job-0")->completed);
+
+    for (const char* bad : {"-1", "1.5", "\"4\""}) {
+        json body = json::parse(p1.lease(1));
+        body["max_jobs"] = json::parse(bad);
+        h.post("/prover/jobs/lease", body.dump(), &status);
+        EXPECT_EQ(status, 400);
+    }
+}
+
+TEST(ProverSwarmHttp, ResultsRequireVerifiedProofs) {
+    SwarmHttpHarness h;
+    ASSERT_TRUE(h.initialized());
+    TestProver p1(3);
+    ASSERT_EQ(h.registerAll({&p1}), 1u);
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(h.swarm().submitJob("job-" + std::to_string(i), "payload-" + std::to_string(i)));
+    }
+    auto leased = h.post("/prover/jobs/lease", p1.lease(4));
+    ASSERT_EQ(count(leased["jobs"]), 4u);
+
+    auto out = h.post("/prover/results", p1.results({
+        {"job-0", true, ""},                       // no proof
+        {"job-1", true, "payload-0"},              // proof for another job
+        {"job-2", true, "payload-2", -5.0},        // negative latency
+        {"job-3", true, "payload-3", 1e12}}));     // clamped latency
+    EXPECT_EQ(out["accepted"].get<std::size_t>(), 1u);
+    std::map<std::string, std::string> reasons;
+    for (const auto& r : out["rejected"]) {
+        reasons[r["id"].get<std::string>()] = r["reason"].get<std::string>();
+    }
+    EXPECT_EQ(reasons["job-0"], "Missing proof.");
+    EXPECT_EQ(reasons["job-1"], "Proof failed verification.");
+    EXPECT_EQ(reasons["job-2"], "Invalid latency.");
+
+    EXPECT_FALSE(h.swarm().getJob("job-1")->completed);
+    EXPECT_EQ(h.swarm().getJob("job-1")->assigned_prover, p1.pubkey());
+    EXPECT_TRUE(h.swarm().getJob("job-3")->completed);
+    EXPECT_TRUE(h.swarm().getMetrics().avg_proof_latency_ms <= SwarmHttpConfig{}.max_latency_ms);
+}
+
+TEST(ProverSwarmHttp, HeartbeatsAndRequestValidation) {
+    SwarmHttpHarness h;
+    ASSERT_TRUE(h.initialized());
+    TestProver p1(3), p2(4), ghost(5);
+    ASSERT_EQ(h.registerAll({&p1, &p2}), 2u);
+    ASSERT_TRUE(h.swarm().hardBanProver(p2.pubkey(), "test"));
+
+    json replayed = p1.heartbeat();
+    json heartbeats = json::array({p1.heartbeat(), p2.heartbeat(), ghost.heartbeat(), replayed});
+    json body;
+    body["heartbeats"] = heartbeats;
+    auto first = h.post("/prover/heartbeat", body.dump());
+    EXPECT_EQ(first["accepted"].get<std::size_t>(), 2u);
+    body["heartbeats"] = json::array({replayed});
+    auto hb = h.post("/prover/heartbeat", body.dump());
+    EXPECT_EQ(hb["accepted"].get<std::size_t>(), 0u);
+    EXPECT_EQ(hb["rejected"][0]["reason"].get<std::string>(), "Replayed nonce.");
+    EXPECT_TRUE(h.swarm().lastHeartbeat(p1.pubkey()).has_value());
+    EXPECT_FALSE(h.swarm().lastHeartbeat(ghost.pubkey()).has_value());
+
+    int status = 0;
+    h.post("/prover/heartbeat", "{not json", &status);
+    EXPECT_EQ(status, 400);
+    h.post("/prover/register", R"({"provers": {}})", &status);
+    EXPECT_EQ(status, 400);
+    h.post("/prover/heartbeat", R"({"heartbeats": [1,2,3,4,5,6,7,8,9]})", &status);
+    EXPECT_EQ(status, 413);
+    h.post("/prover/jobs/lease", ghost.lease(1), &status);
+    EXPECT_EQ(status, 403);
+    h.post("/prover/jobs/lease", p2.lease(1), &status);
+    EXPECT_EQ(status, 403);
+}
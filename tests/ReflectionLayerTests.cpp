@@ -17,6 +17,9 @@ public:
     std::vector<uint8_t> reorg_data;
 
     bool return_success = true;
+    bool has_sequence = false;
+    uint64_t sequence = 0;
+    mutable int height_reads = 0;
 
     uint64_t get_latest_l1_height() const override { return 0; }
 
@@ -41,8 +44,69 @@ public:
     }
 
     bool get_raw_block_height_slice(rocksdb::Slice& out_slice) const override {
+        height_reads++;
         if (!return_success || block_height_data.empty()) return false;
         out_slice = rocksdb::Slice(reinterpret_cast<const char*>(block_height_data.data()), block_height_data.size());
         return true;
     }
+
+    bool latest_sequence_number(uint64_t& out_sequence) const override {
+        out_sequence = sequence;
+        return has_sequence;
+    }
 };
+
+static void set_height(MockRocksDbHandle& db, uint64_t height) {
+    db.block_height_data.resize(sizeof(uint64_t));
+    std::memcpy(db.block_height_data.data(), &height, sizeof(uint64_t));
+}
+
+TEST(ReflectionLayerTest, SnapshotDecodesCompactValuesFromOneRead) {
+    MockRocksDbHandle db;
+    set_height(db, 840000);
+    db.anchor_data.assign(40, 0xAB);
+    uint64_t anchor_height = 839990;
+    std::memcpy(db.anchor_data.data() + 32, &anchor_height, sizeof(uint64_t));
+
+    ReflectionSnapshot snap = build_reflection_snapshot(db);
+    EXPECT_EQ(reflection_get_height(snap), 840000u);
+    EXPECT_EQ(reflection_get_anchor_height(snap), 839990u);
+    EXPECT_EQ(reflection_get_anchor_hash(snap)[31], 0xAB);
+    EXPECT_EQ(snap.reorg.new_height, 0u);
+    EXPECT_EQ(db.height_reads, 1);
+
+    db.return_success = false;
+    snap = build_reflection_snapshot(db);
+    EXPECT_EQ(reflection_get_height(snap), 0u);
+}
+
+TEST(ReflectionLayerTest, RefreshSkipsUntilSequenceAdvances) {
+    MockRocksDbHandle db;
+    db.has_sequence = true;
+    db.sequence = 7;
+    set_height(db, 100);
+
+    ReflectionSnapshot snap = {};
+    ReflectionCursor cursor = {0, false};
+    EXPECT_TRUE(refresh_reflection_snapshot(db, snap, cursor));
+    EXPECT_EQ(reflection_get_height(snap), 100u);
+    EXPECT_TRUE(cursor.valid);
+    EXPECT_EQ(cursor.sequence, 7u);
+
+    // Same sequence: nothing is read even though the backing bytes changed.
+    set_height(db, 101);
+    EXPECT_FALSE(refresh_reflection_snapshot(db, snap, cursor));
+    EXPECT_EQ(reflection_get_height(snap), 100u);
+    EXPECT_EQ(db.height_reads, 1);
+
+    db.sequence = 8;
+    EXPECT_TRUE(refresh_reflection_snapshot(db, snap, cursor));
+    EXPECT_EQ(reflection_get_height(snap), 101u);
+
+    // Handles without sequence numbers are re-read every time.
+    db.has_sequence = false;
+    EXPECT_TRUE(refresh_reflection_snapshot(db, snap, cursor));
+    EXPECT_FALSE(cursor.valid);
+    EXPECT_TRUE(refresh_reflection_snapshot(db, snap, cursor));
+    EXPECT_EQ(db.height_reads, 4);
+}
@@ -1,8 +1,11 @@
 #include <gtest/gtest.h>
 #include "SettlementIngestion.h"
+#include "RocksDbReflectionHandle.h"
+#include "ReflectionLayer.h"
 #include <rocksdb/db.h>
 #include <filesystem>
 #include <memory>
+#include <thread>
 
 using namespace ailee::l1;
 
@@ -104,3 +107,82 @@ TEST(SettlementIngestion, IngestionLogic) {
 
     cleanupTestDb(dbPath);
 }
+
+TEST(RocksDbReflectionHandle, SnapshotReadAndChangeDetection) {
+    std::string dbPath = getTestDbPath();
+    rocksdb::Options options;
+    options.create_if_missing = true;
+
+    rocksdb::DB* rawDb = nullptr;
+    ASSERT_TRUE(rocksdb::DB::Open(options, dbPath, &rawDb).ok());
+    std::shared_ptr<rocksdb::DB> db(rawDb);
+    ailee::RocksDbReflectionHandle handle(db);
+
+    uint64_t height = 850000;
+    ailee::ReflectionKeys keys;
+    ASSERT_TRUE(db->Put(rocksdb::WriteOptions(), keys.block_height,
+                        rocksdb::Slice(reinterpret_cast<const char*>(&height), sizeof(height))).ok());
+
+    ailee::ReflectionRead read;
+    ASSERT_TRUE(handle.read_reflection(read));
+    EXPECT_TRUE(read.has_block_height);
+    EXPECT_FALSE(read.has_anchor);
+    EXPECT_FALSE(read.has_reorg);
+    EXPECT_TRUE(read.has_sequence);
+    EXPECT_EQ(handle.get_latest_l1_height(), 850000u);
+
+    ailee::reflection::ReflectionSnapshot snap = {};
+    ailee::reflection::ReflectionCursor cursor = {0, false};
+    EXPECT_TRUE(ailee::reflection::refresh_reflection_snapshot(handle, snap, cursor));
+    EXPECT_EQ(ailee::reflection::reflection_get_height(snap), 850000u);
+    EXPECT_FALSE(ailee::reflection::refresh_reflection_snapshot(handle, snap, cursor));
+
+    height = 850001;
+    ASSERT_TRUE(db->Put(rocksdb::WriteOptions(), keys.block_height,
+                        rocksdb::Slice(reinterpret_cast<const char*>(&height), sizeof(height))).ok());
+    EXPECT_TRUE(ailee::reflection::refresh_reflection_snapshot(handle, snap, cursor));
+    EXPECT_EQ(ailee::reflection::reflection_get_height(snap), 850001u);
+
+    db.reset();
+    cleanupTestDb(dbPath);
+}
+
+TEST(RocksDbReflectionHandle, RawSlicesArePerThread) {
+    std::string dbPath = getTestDbPath();
+    rocksdb::Options options;
+    options.create_if_missing = true;
+
+    rocksdb::DB* rawDb = nullptr;
+    ASSERT_TRUE(rocksdb::DB::Open(options, dbPath, &rawDb).ok());
+    std::shared_ptr<rocksdb::DB> db(rawDb);
+    ailee::RocksDbReflectionHandle handle(db);
+    ailee::ReflectionKeys keys;
+
+    ASSERT_TRUE(db->Put(rocksdb::WriteOptions(), keys.anchor, std::string(32, 'a')).ok());
+    rocksdb::Slice mine;
+    ASSERT_TRUE(handle.get_raw_anchor_slice(mine));
+
+    // Another thread re-reading the same key must not repoint our slice.
+    ASSERT_TRUE(db->Put(rocksdb::WriteOptions(), keys.anchor, std::string(32, 'b')).ok());
+    std::string theirs;
+    std::thread other([&]() {
+        rocksdb::Slice slice;
+        if (handle.get_raw_anchor_slice(slice)) {
+            theirs = slice.ToString();
+        }
+    });
+    other.join();
+
+    EXPECT_EQ(theirs, std::string(32, 'b'));
+    EXPECT_EQ(mine.ToString(), std::string(32, 'a'));
+    // The other thread's pins went with it.
+    EXPECT_EQ(handle.pinned_thread_count(), 1u);
+
+    uint8_t anchor[32];
+    handle.get_latest_confirmed_anchor(anchor);
+    EXPECT_EQ(anchor[0], 'b');
+    EXPECT_EQ(mine.ToString(), std::string(32, 'a'));
+
+    db.reset();
+    cleanupTestDb(dbPath);
+}
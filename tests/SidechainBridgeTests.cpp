@@ -0,0 +1,641 @@
+#include <gtest/gtest.h>
+#include "ailee_sidechain_bridge.h"
+#include "L2State.h"
+#include "PersistentStorage.h"
+#include "zk_proofs.h"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace ailee;
+
+namespace {
+
+std::string getTestDbPath() {
+    return "/tmp/ailee_bridge_test_" + std::to_string(
+        std::chrono::system_clock::now().time_since_epoch().count());
+}
+
+void cleanupTestDb(const std::string& path) {
+    if (std::filesystem::exists(path)) {
+        std::filesystem::remove_all(path);
+    }
+}
+
+secp256k1_context* signContext() {
+    static secp256k1_context* ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
+    return ctx;
+}
+
+std::array<uint8_t, 32> secretFor(uint8_t seed) {
+    std::array<uint8_t, 32> key{};
+    key.fill(seed);
+    key[0] = 0x01;
+    return key;
+}
+
+std::string pubKeyHexFor(uint8_t seed) {
+    const auto secret = secretFor(seed);
+    secp256k1_pubkey pub;
+    EXPECT_EQ(secp256k1_ec_pubkey_create(signContext(), &pub, secret.data()), 1);
+    unsigned char out[33];
+    size_t len = sizeof(out);
+    secp256k1_ec_pubkey_serialize(signContext(), out, &len, &pub, SECP256K1_EC_COMPRESSED);
+    static const char* digits = "0123456789abcdef";
+    std::string hex;
+    for (size_t i = 0; i < len; ++i) {
+        hex += digits[out[i] >> 4];
+        hex += digits[out[i] & 0x0F];
+    }
+    return hex;
+}
+
+std::vector<uint8_t> signDigest(const PegOutDigest& digest, uint8_t seed) {
+    const auto secret = secretFor(seed);
+    secp256k1_ecdsa_signature sig;
+    EXPECT_EQ(secp256k1_ecdsa_sign(signContext(), &sig, digest.data(), secret.data(), nullptr, nullptr), 1);
+    std::vector<uint8_t> compact(64);
+    secp256k1_ecdsa_signature_serialize_compact(signContext(), compact.data(), &sig);
+    return compact;
+}
+
+std::string signerId(uint8_t seed) {
+    return "signer-" + std::to_string(seed);
+}
+
+// Full federation of signers seeded 1..FEDERATION_SIZE.
+void addFederation(SidechainBridge& bridge) {
+    for (size_t i = 1; i <= FEDERATION_SIZE; ++i) {
+        const auto seed = static_cast<uint8_t>(i);
+        ASSERT_TRUE(bridge.addFederationSigner(signerId(seed), pubKeyHexFor(seed), "bc1q", 1000));
+    }
+}
+
+BridgeArchive::Hash chainRoot(const BridgeArchive::Hash& root, const BridgeArchive::Hash& hash) {
+    unsigned char chained[2 * SHA256_DIGEST_LENGTH];
+    std::copy(root.begin(), root.end(), chained);
+    std::copy(hash.begin(), hash.end(), chained + SHA256_DIGEST_LENGTH);
+    BridgeArchive::Hash next;
+    SHA256(chained, sizeof(chained), next.data());
+    return next;
+}
+
+// Starts a peg-in for `btcTxId`:0 and attaches an SPV proof for a block at
+// `blockHeight`; a non-zero height queues it for confirmations.
+std::string provePegIn(SidechainBridge& bridge, const std::string& btcTxId, uint64_t blockHeight) {
+    SPVProof::ProofData proof;
+    proof.transaction = {1, 2, 3};
+    proof.blockHeight = blockHeight;
+    unsigned char once[32], twice[32];
+    SHA256(proof.transaction.data(), proof.transaction.size(), once);
+    SHA256(once, sizeof(once), twice);
+    std::vector<uint8_t> header(80, 0);
+    std::copy(twice, twice + 32, header.begin() + 36);
+
+    const std::string pegId = bridge.initiatePegIn(btcTxId, 0, 50000, "btc-src", "ailee-dest");
+    EXPECT_FALSE(pegId.empty());
+    EXPECT_TRUE(bridge.submitSPVProof(pegId, proof, header));
+    return pegId;
+}
+
+// Mints a peg-in for `btcTxId`:0 through the SPV and confirmation steps.
+std::string mintPegIn(SidechainBridge& bridge, const std::string& btcTxId) {
+    const std::string pegId = provePegIn(bridge, btcTxId, 0);
+    EXPECT_TRUE(bridge.updatePegInConfirmations(pegId, 100, 100 + MIN_CONFIRMATIONS_PEGIN));
+    EXPECT_TRUE(bridge.completePegInMint(pegId));
+    return pegId;
+}
+
+bool throwsRuntimeError(ailee::storage::PersistentStorage& storage) {
+    try {
+        SidechainBridge bridge(&storage);
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+// Registers an anchor and moves a fresh peg-out to PENDING_PEGOUT.
+std::string pendingPegOut(SidechainBridge& bridge) {
+    global_seven::AnchorCommitment anchor;
+    anchor.l2StateRoot = "root";
+    anchor.payload = "payload";
+    anchor.hash = zk::sha256Hex(anchor.payload);
+    EXPECT_TRUE(bridge.registerAnchorCommitment(anchor, "root"));
+
+    const std::string pegId = bridge.initiatePegOut("ailee-src", "bc1q-dest", 50000, anchor.hash);
+    EXPECT_FALSE(pegId.empty());
+    EXPECT_TRUE(bridge.updatePegOutConfirmations(pegId, 10, 10 + MIN_CONFIRMATIONS_PEGOUT));
+    return pegId;
+}
+
+} // namespace
+
+TEST(SidechainBridgeTest, PubKeyHexRejectsMalformedInput) {
+    secp256k1_pubkey key;
+    const std::string good = pubKeyHexFor(3);
+    EXPECT_TRUE(parseBridgePubKeyHex(good, key));
+    EXPECT_FALSE(parseBridgePubKeyHex("", key));
+    EXPECT_FALSE(parseBridgePubKeyHex(good.substr(0, good.size() - 1), key)); // odd length
+    std::string nonHex = good;
+    nonHex[10] = 'g';
+    EXPECT_FALSE(parseBridgePubKeyHex(nonHex, key));
+    nonHex[10] = ' ';
+    EXPECT_FALSE(parseBridgePubKeyHex(nonHex, key));
+    EXPECT_FALSE(parseBridgePubKeyHex(std::string(66, '0'), key)); // not a curve point
+}
+
+TEST(SidechainBridgeTest, ParsedKeyCacheFollowsSignerSet) {
+    FederationManager federation;
+    federation.addSigner(std::make_shared<FederationSigner>("a", pubKeyHexFor(1), "bc1q", 1));
+    federation.addSigner(std::make_shared<FederationSigner>("b", "zz", "bc1q", 1));
+    ASSERT_TRUE(federation.getParsedPubKey("a") != nullptr);
+    EXPECT_TRUE(federation.getParsedPubKey("b") == nullptr);
+    EXPECT_TRUE(federation.getParsedPubKey("c") == nullptr);
+
+    // The cached key is the one verifyBridgeSignature accepts.
+    PegOutDigest digest{};
+    digest.fill(0x42);
+    EXPECT_TRUE(verifyBridgeSignature(digest, *federation.getParsedPubKey("a"), signDigest(digest, 1)));
+    EXPECT_FALSE(verifyBridgeSignature(digest, *federation.getParsedPubKey("a"), signDigest(digest, 2)));
+
+    // Re-adding with a bad key drops the stale cache entry.
+    federation.addSigner(std::make_shared<FederationSigner>("a", "abc", "bc1q", 1));
+    EXPECT_TRUE(federation.getParsedPubKey("a") == nullptr);
+
+    federation.addSigner(std::make_shared<FederationSigner>("a", pubKeyHexFor(1), "bc1q", 1));
+    EXPECT_TRUE(federation.removeSigner("a"));
+    EXPECT_TRUE(federation.getParsedPubKey("a") == nullptr);
+}
+
+TEST(SidechainBridgeTest, ParallelVerificationMatchesSequential) {
+    std::vector<PegOutDigest> digests(300);
+    std::vector<secp256k1_pubkey> keys(4);
+    for (size_t k = 0; k < keys.size(); ++k) {
+        ASSERT_TRUE(parseBridgePubKeyHex(pubKeyHexFor(static_cast<uint8_t>(k + 1)), keys[k]));
+    }
+    std::vector<std::vector<uint8_t>> signatures;
+    for (size_t i = 0; i < digests.size(); ++i) {
+        digests[i].fill(static_cast<unsigned char>(i));
+        digests[i][0] = static_cast<unsigned char>(i >> 8);
+        // Every seventh is signed by the wrong key.
+        const auto seed = static_cast<uint8_t>(i % keys.size() + (i % 7 == 0 ? 2 : 1));
+        signatures.push_back(signDigest(digests[i], seed));
+    }
+    signatures[11].resize(10);
+
+    std::vector<BridgeSignatureCheck> checks;
+    for (size_t i = 0; i < digests.size(); ++i) {
+        checks.push_back({&digests[i], &keys[i % keys.size()], &signatures[i], false});
+    }
+    checks[20].pubkey = nullptr;
+    verifyBridgeSignatures(checks);
+
+    size_t valid = 0;
+    for (size_t i = 0; i < checks.size(); ++i) {
+        const bool expected = checks[i].pubkey &&
+                              verifyBridgeSignature(digests[i], *checks[i].pubkey, signatures[i]);
+        EXPECT_EQ(checks[i].valid, expected);
+        valid += checks[i].valid;
+    }
+    EXPECT_TRUE(valid > 0 && valid < checks.size());
+}
+
+TEST(SidechainBridgeTest, QuorumCountsOnlyValidSignaturesFromActiveSigners) {
+    SidechainBridge bridge;
+    addFederation(bridge);
+    const std::string pegId = pendingPegOut(bridge);
+    const auto& digest = bridge.getPegOut(pegId)->getSigningDigest();
+
+    // A signature from the wrong key is refused up front.
+    EXPECT_FALSE(bridge.signPegOut(pegId, signerId(1), signDigest(digest, 2)));
+
+    for (uint8_t seed = 1; seed <= FEDERATION_THRESHOLD; ++seed) {
+        ASSERT_TRUE(bridge.signPegOut(pegId, signerId(seed), signDigest(digest, seed)));
+    }
+
+    // A signer that goes inactive after signing no longer counts.
+    auto dropped = bridge.getFederation()->getSigner(signerId(1));
+    for (int i = 0; i < 10; ++i) dropped->recordMissedSignature();
+    ASSERT_TRUE(!dropped->isActive());
+    EXPECT_FALSE(bridge.completePegOut(pegId, "btc-tx"));
+
+    const auto extra = static_cast<uint8_t>(FEDERATION_THRESHOLD + 1);
+    ASSERT_TRUE(bridge.signPegOut(pegId, signerId(extra), signDigest(digest, extra)));
+    EXPECT_TRUE(bridge.completePegOut(pegId, "btc-tx"));
+    EXPECT_TRUE(bridge.getPegOut(pegId) == nullptr);
+}
+
+TEST(SidechainBridgeTest, RecoveryDropsOnlySignaturesThatFailAgainstALoadedKey) {
+    const std::string dbPath = getTestDbPath();
+    ailee::storage::PersistentStorage::Config config;
+    config.dbPath = dbPath;
+    std::string pegId;
+    {
+        ailee::storage::PersistentStorage storage(config);
+        SidechainBridge bridge(&storage);
+        addFederation(bridge);
+
+        PegOutTransaction pegout("ailee-src", "bc1q-dest", 50000, "anchor");
+        pegout.updateConfirmations(10, 10 + MIN_CONFIRMATIONS_PEGOUT);
+        pegId = pegout.getData().pegId;
+        const auto& digest = pegout.getSigningDigest();
+        pegout.addSignature(signerId(1), signDigest(digest, 1));
+        pegout.addSignature(signerId(2), signDigest(digest, 3));   // wrong key
+        pegout.addSignature(signerId(3), signDigest(digest, 3));
+        pegout.addSignature(signerId(4), signDigest(digest, 4));
+        pegout.addSignature("not-a-signer", signDigest(digest, 4));
+
+        // An inactive signer is still reloaded and keeps its signature.
+        auto inactive = bridge.getFederation()->getSigner(signerId(4));
+        for (int i = 0; i < 10; ++i) inactive->recordMissedSignature();
+        bridge.persistSigners({signerId(4)});
+
+        nlohmann::json index = nlohmann::json::array_t{};
+        index.push_back(pegId);
+        ASSERT_TRUE(storage.put("bridge/pegout_index", index.dump()));
+        ASSERT_TRUE(storage.put("bridge/pegout/" + pegId, pegout.to_json().dump()));
+    }
+    {
+        ailee::storage::PersistentStorage storage(config);
+        SidechainBridge bridge(&storage);
+        auto pegout = bridge.getPegOut(pegId);
+        ASSERT_TRUE(pegout != nullptr);
+        EXPECT_TRUE(!bridge.getFederation()->isActiveSigner(signerId(4)));
+        EXPECT_TRUE(bridge.getFederation()->getParsedPubKey(signerId(4)) != nullptr);
+
+        // Only signer-2's wrong-key signature goes; the unknown signer's
+        // cannot be checked and is kept.
+        const auto& signatures = pegout->getData().signatures;
+        EXPECT_EQ(signatures.size(), 4u);
+        EXPECT_EQ(signatures.count(signerId(1)), 1u);
+        EXPECT_EQ(signatures.count(signerId(2)), 0u);
+        EXPECT_EQ(signatures.count(signerId(3)), 1u);
+        EXPECT_EQ(signatures.count(signerId(4)), 1u);
+        EXPECT_EQ(signatures.count("not-a-signer"), 1u);
+
+        auto stored = storage.get("bridge/pegout/" + pegId);
+        ASSERT_TRUE(stored.has_value());
+        PegOutTransaction reloaded("", "", 0, "");
+        reloaded.from_json(nlohmann::json::parse(*stored));
+        EXPECT_EQ(reloaded.getData().signatures.size(), 4u);
+        EXPECT_EQ(reloaded.getData().signatures.count(signerId(2)), 0u);
+    }
+    cleanupTestDb(dbPath);
+}
+
+TEST(SidechainBridgeTest, ArchiveChainsRootAndFindsEntriesByIdAndHash) {
+    BridgeArchive archive;
+    BridgeArchive::BatchOps ops;
+    EXPECT_EQ(archive.rootHex(), "");
+    ASSERT_TRUE(archive.append(BridgeArchive::Kind::PEGIN, "p1", "record-1", ops));
+    ASSERT_TRUE(archive.append(BridgeArchive::Kind::SWAP, "s1", "record-2", ops));
+    // Ids are scoped by kind; the same id and kind is never archived twice.
+    EXPECT_TRUE(archive.append(BridgeArchive::Kind::PEGOUT, "p1", "record-3", ops));
+    EXPECT_FALSE(archive.append(BridgeArchive::Kind::PEGIN, "p1", "record-4", ops));
+    EXPECT_TRUE(ops.empty());
+    EXPECT_EQ(archive.size(), 3u);
+
+    BridgeArchive::Hash expected{};
+    expected = chainRoot(expected, BridgeArchive::hashRecord(BridgeArchive::Kind::PEGIN, "record-1"));
+    expected = chainRoot(expected, BridgeArchive::hashRecord(BridgeArchive::Kind::SWAP, "record-2"));
+    expected = chainRoot(expected, BridgeArchive::hashRecord(BridgeArchive::Kind::PEGOUT, "record-3"));
+    EXPECT_TRUE(archive.root() == expected);
+    EXPECT_EQ(archive.rootHex(), BridgeArchive::toHex(expected.data(), expected.size()));
+
+    auto byId = archive.find(BridgeArchive::Kind::SWAP, "s1");
+    ASSERT_TRUE(byId.has_value());
+    EXPECT_EQ(byId->record, "record-2");
+    auto byHash = archive.findByHash(byId->hash);
+    ASSERT_TRUE(byHash.has_value());
+    EXPECT_EQ(byHash->id, "s1");
+    EXPECT_FALSE(archive.find(BridgeArchive::Kind::SWAP, "p1").has_value());
+    EXPECT_FALSE(archive.findByHash(BridgeArchive::Hash{}).has_value());
+}
+
+TEST(SidechainBridgeTest, StoredArchiveServesLookupsFromStorage) {
+    const std::string dbPath = getTestDbPath();
+    ailee::storage::PersistentStorage::Config config;
+    config.dbPath = dbPath;
+    ailee::storage::PersistentStorage storage(config);
+
+    BridgeArchive archive(&storage);
+    BridgeArchive::BatchOps ops;
+    ASSERT_TRUE(archive.append(BridgeArchive::Kind::PEGIN, "p1", "record-1", ops));
+    ASSERT_TRUE(archive.append(BridgeArchive::Kind::ANCHOR, "a1", "record-2", ops));
+    // Nothing is visible until the caller commits the batch.
+    EXPECT_FALSE(archive.find(BridgeArchive::Kind::PEGIN, "p1").has_value());
+    EXPECT_EQ(archive.size(), 0u);
+    ASSERT_TRUE(storage.executeBatch(ops));
+    archive.commit();
+    EXPECT_EQ(archive.size(), 2u);
+
+    auto entry = archive.find(BridgeArchive::Kind::ANCHOR, "a1");
+    ASSERT_TRUE(entry.has_value());
+    EXPECT_EQ(entry->record, "record-2");
+    EXPECT_TRUE(archive.contains(BridgeArchive::Kind::PEGIN, "p1"));
+    auto byHash = archive.findByHash(BridgeArchive::hashRecord(BridgeArchive::Kind::PEGIN, "record-1"));
+    ASSERT_TRUE(byHash.has_value());
+    EXPECT_EQ(byHash->id, "p1");
+
+    BridgeArchive reopened(&storage);
+    reopened.recover();
+    EXPECT_EQ(reopened.size(), 2u);
+    EXPECT_EQ(reopened.rootHex(), archive.rootHex());
+    EXPECT_TRUE(reopened.find(BridgeArchive::Kind::PEGIN, "p1").has_value());
+    cleanupTestDb(dbPath);
+}
+
+TEST(SidechainBridgeTest, RolledBackAppendLeavesNoHoleInTheArchive) {
+    const std::string dbPath = getTestDbPath();
+    ailee::storage::PersistentStorage::Config config;
+    config.dbPath = dbPath;
+    ailee::storage::PersistentStorage storage(config);
+
+    BridgeArchive archive(&storage);
+    BridgeArchive::BatchOps lost;
+    ASSERT_TRUE(archive.append(BridgeArchive::Kind::PEGIN, "p1", "record-1", lost));
+    // The batch is never written.
+    archive.rollback();
+    EXPECT_EQ(archive.size(), 0u);
+    EXPECT_EQ(archive.rootHex(), "");
+
+    BridgeArchive::BatchOps ops;
+    ASSERT_TRUE(archive.append(BridgeArchive::Kind::PEGIN, "p2", "record-2", ops));
+    ASSERT_TRUE(storage.executeBatch(ops));
+    archive.commit();
+    EXPECT_EQ(archive.size(), 1u);
+
+    BridgeArchive reopened(&storage);
+    reopened.recover();
+    EXPECT_EQ(reopened.size(), 1u);
+    EXPECT_EQ(reopened.rootHex(), archive.rootHex());
+    EXPECT_TRUE(reopened.find(BridgeArchive::Kind::PEGIN, "p2").has_value());
+    EXPECT_FALSE(reopened.contains(BridgeArchive::Kind::PEGIN, "p1"));
+    cleanupTestDb(dbPath);
+}
+
+TEST(SidechainBridgeTest, MintedPegInIsArchivedAndCannotBeReplayed) {
+    SidechainBridge bridge;
+    const std::string pegId = mintPegIn(bridge, "btc-tx-1");
+    EXPECT_TRUE(bridge.getPegIn(pegId) == nullptr);
+
+    auto entry = bridge.getArchive().find(BridgeArchive::Kind::PEGIN, pegId);
+    ASSERT_TRUE(entry.has_value());
+    // Length-prefixed fields: "<len>:<value>" for each, starting with the id.
+    EXPECT_EQ(entry->record.rfind(std::to_string(pegId.size()) + ":" + pegId + "8:btc-tx-1", 0), 0u);
+
+    EXPECT_EQ(bridge.initiatePegIn("btc-tx-1", 0, 50000, "btc-src", "ailee-dest"), "");
+    EXPECT_FALSE(bridge.initiatePegIn("btc-tx-1", 1, 50000, "btc-src", "ailee-dest").empty());
+
+    auto snapshot = bridge.snapshotBridgeState();
+    EXPECT_EQ(snapshot.archivedCount, 1u);
+    EXPECT_EQ(snapshot.archiveRoot, bridge.getArchive().rootHex());
+    EXPECT_EQ(snapshot.pegins.size(), 1u);
+}
+
+TEST(SidechainBridgeTest, RecoveryMigratesCompletedPegOutsAndChecksTheArchive) {
+    const std::string dbPath = getTestDbPath();
+    ailee::storage::PersistentStorage::Config config;
+    config.dbPath = dbPath;
+    ailee::storage::PersistentStorage storage(config);
+
+    // An older store that kept a completed peg-out live.
+    PegOutTransaction completed("ailee-a", "bc1q-a", 50000, "anchor");
+    completed.updateConfirmations(10, 10 + MIN_CONFIRMATIONS_PEGOUT);
+    ASSERT_TRUE(completed.completeRelease("btc-release"));
+    PegOutTransaction pending("ailee-b", "bc1q-b", 60000, "anchor");
+    nlohmann::json index = nlohmann::json::array_t{};
+    index.push_back(completed.getData().pegId);
+    index.push_back(pending.getData().pegId);
+    ASSERT_TRUE(storage.put("bridge/pegout_index", index.dump()));
+    ASSERT_TRUE(storage.put("bridge/pegout/" + completed.getData().pegId, completed.to_json().dump()));
+    ASSERT_TRUE(storage.put("bridge/pegout/" + pending.getData().pegId, pending.to_json().dump()));
+
+    std::string root;
+    {
+        SidechainBridge bridge(&storage);
+        EXPECT_TRUE(bridge.getPegOut(completed.getData().pegId) == nullptr);
+        EXPECT_TRUE(bridge.getPegOut(pending.getData().pegId) != nullptr);
+        EXPECT_TRUE(bridge.getArchive().contains(BridgeArchive::Kind::PEGOUT, completed.getData().pegId));
+        EXPECT_FALSE(storage.exists("bridge/pegout/" + completed.getData().pegId));
+        std::vector<std::string> storedIndex;
+        for (const auto& id : nlohmann::json::parse(*storage.get("bridge/pegout_index"))) {
+            storedIndex.push_back(id.get<std::string>());
+        }
+        ASSERT_EQ(storedIndex.size(), 1u);
+        EXPECT_EQ(storedIndex[0], pending.getData().pegId);
+        root = bridge.getArchive().rootHex();
+        EXPECT_FALSE(root.empty());
+    }
+    {
+        SidechainBridge bridge(&storage);
+        EXPECT_EQ(bridge.getArchive().size(), 1u);
+        EXPECT_EQ(bridge.getArchive().rootHex(), root);
+        auto entry = bridge.getArchive().find(BridgeArchive::Kind::PEGOUT, completed.getData().pegId);
+        ASSERT_TRUE(entry.has_value());
+        EXPECT_TRUE(bridge.getArchive().findByHash(entry->hash).has_value());
+    }
+
+    // A missing entry or a head that disagrees with the entries is fatal.
+    const std::string entry = *storage.get("bridge/archive/entry/0");
+    ASSERT_TRUE(storage.remove("bridge/archive/entry/0"));
+    EXPECT_TRUE(throwsRuntimeError(storage));
+    ASSERT_TRUE(storage.put("bridge/archive/entry/0", entry));
+
+    const std::string head = *storage.get("bridge/archive/head");
+    nlohmann::json tampered = nlohmann::json::parse(head);
+    tampered["root"] = std::string(64, '0');
+    ASSERT_TRUE(storage.put("bridge/archive/head", tampered.dump()));
+    EXPECT_TRUE(throwsRuntimeError(storage));
+    ASSERT_TRUE(storage.put("bridge/archive/head", head));
+    EXPECT_FALSE(throwsRuntimeError(storage));
+    cleanupTestDb(dbPath);
+}
+
+TEST(SidechainBridgeTest, SnapshotFileCarriesTheArchiveLine) {
+    const std::string path = getTestDbPath() + ".snap";
+    ailee::l2::L2StateSnapshot snapshot;
+    snapshot.snapshotTimestampMs = 1234;
+    snapshot.bridge.archivedCount = 3;
+    snapshot.bridge.archiveRoot = std::string(64, 'a');
+
+    std::string err;
+    ASSERT_TRUE(ailee::l2::appendSnapshotToFile(snapshot, path, &err));
+    auto loaded = ailee::l2::loadLatestSnapshotFromFile(path, &err);
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(loaded->bridge.archivedCount, 3u);
+    EXPECT_EQ(loaded->bridge.archiveRoot, snapshot.bridge.archiveRoot);
+    EXPECT_EQ(ailee::l2::computeL2StateRoot(*loaded), ailee::l2::computeL2StateRoot(snapshot));
+
+    // Nothing archived: no archive line, and the root ignores the field.
+    ailee::l2::L2StateSnapshot empty;
+    empty.snapshotTimestampMs = 1235;
+    ASSERT_TRUE(ailee::l2::appendSnapshotToFile(empty, path, &err));
+    loaded = ailee::l2::loadLatestSnapshotFromFile(path, &err);
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(loaded->snapshotTimestampMs, 1235u);
+    EXPECT_EQ(loaded->bridge.archivedCount, 0u);
+    EXPECT_EQ(loaded->bridge.archiveRoot, "");
+    EXPECT_TRUE(ailee::l2::computeL2StateRoot(snapshot) != ailee::l2::computeL2StateRoot(empty));
+    std::filesystem::remove(path);
+}
+
+TEST(PegMaturityQueueTest, PopsOnlyMaturedBuckets) {
+    PegMaturityQueue queue(6);
+    queue.track("a", 100);
+    queue.track("b", 101);
+    EXPECT_EQ(queue.maturityHeight(100), 106u);
+    EXPECT_TRUE(queue.popMatured(105).empty());
+
+    auto matured = queue.popMatured(106);
+    ASSERT_EQ(matured.size(), 1u);
+    EXPECT_EQ(matured[0].first, "a");
+    EXPECT_EQ(matured[0].second, 100u);
+    EXPECT_FALSE(queue.contains("a"));
+    EXPECT_TRUE(queue.contains("b"));
+    EXPECT_EQ(queue.size(), 1u);
+}
+
+TEST(PegMaturityQueueTest, TrackingAgainMovesThePegToItsNewBucket) {
+    PegMaturityQueue queue(6);
+    queue.track("a", 100);
+    queue.track("b", 100);
+    queue.track("a", 110);
+    EXPECT_EQ(queue.size(), 2u);
+
+    auto matured = queue.popMatured(106);
+    ASSERT_EQ(matured.size(), 1u);
+    EXPECT_EQ(matured[0].first, "b");
+    matured = queue.popMatured(116);
+    ASSERT_EQ(matured.size(), 1u);
+    EXPECT_EQ(matured[0].first, "a");
+    EXPECT_EQ(matured[0].second, 110u);
+    EXPECT_FALSE(queue.untrack("a"));
+}
+
+TEST(PegMaturityQueueTest, RewindDropsPegsIncludedAboveTheFork) {
+    PegMaturityQueue queue(6);
+    queue.track("kept", 103);
+    queue.track("orphan", 104);
+    auto orphaned = queue.rewind(103);
+    ASSERT_EQ(orphaned.size(), 1u);
+    EXPECT_EQ(orphaned[0], "orphan");
+    EXPECT_TRUE(queue.contains("kept"));
+    EXPECT_EQ(queue.size(), 1u);
+}
+
+TEST(PegMaturityQueueTest, BridgePromotesOnTipAndWhenTrackedBehindTheTip) {
+    SidechainBridge bridge;
+    const std::string early = provePegIn(bridge, "btc-early", 100);
+    EXPECT_EQ(bridge.getMaturingPegInCount(), 1u);
+    EXPECT_TRUE(bridge.onNewBitcoinTip(100 + MIN_CONFIRMATIONS_PEGIN - 1).empty());
+
+    auto promoted = bridge.onNewBitcoinTip(100 + MIN_CONFIRMATIONS_PEGIN);
+    ASSERT_EQ(promoted.size(), 1u);
+    EXPECT_EQ(promoted[0], early);
+    EXPECT_TRUE(bridge.getPegIn(early)->getStatus() == PegStatus::BTC_CONFIRMED);
+
+    // Included deep enough below the known tip: promoted without queueing.
+    bridge.onNewBitcoinTip(200);
+    const std::string late = provePegIn(bridge, "btc-late", 150);
+    EXPECT_EQ(bridge.getMaturingPegInCount(), 0u);
+    EXPECT_TRUE(bridge.getPegIn(late)->getStatus() == PegStatus::BTC_CONFIRMED);
+
+    // Re-tracking a queued peg-in moves it to its new maturity height.
+    const std::string moved = provePegIn(bridge, "btc-moved", 198);
+    EXPECT_TRUE(bridge.trackPegInInclusion(moved, 199));
+    EXPECT_TRUE(bridge.onNewBitcoinTip(198 + MIN_CONFIRMATIONS_PEGIN).empty());
+    promoted = bridge.onNewBitcoinTip(199 + MIN_CONFIRMATIONS_PEGIN);
+    ASSERT_EQ(promoted.size(), 1u);
+    EXPECT_EQ(promoted[0], moved);
+}
+
+TEST(PegMaturityQueueTest, ReorgRevertsPromotionsAboveTheFork) {
+    const uint64_t conf = MIN_CONFIRMATIONS_PEGIN;
+    const uint64_t fork = 100 + conf - 2;
+    // New chain shorter than, as long as, and longer than the old one.
+    for (uint64_t newTip : {fork + 1, 100 + conf + 4, 100 + conf + 9}) {
+        SidechainBridge bridge;
+        const std::string settled = provePegIn(bridge, "btc-settled", 90);
+        const std::string confirmed = provePegIn(bridge, "btc-confirmed", 100);
+        const std::string orphan = provePegIn(bridge, "btc-orphan", fork + 1);
+        bridge.onNewBitcoinTip(100 + conf + 4);
+        ASSERT_TRUE(bridge.getPegIn(confirmed)->getStatus() == PegStatus::BTC_CONFIRMED);
+        ASSERT_EQ(bridge.getMaturingPegInCount(), 1u);
+
+        auto orphaned = bridge.onBitcoinReorg(fork);
+        ASSERT_EQ(orphaned.size(), 1u);
+        EXPECT_EQ(orphaned[0], orphan);
+        EXPECT_TRUE(bridge.getPegIn(settled)->getStatus() == PegStatus::BTC_CONFIRMED);
+        EXPECT_TRUE(bridge.getPegIn(confirmed)->getStatus() == PegStatus::PENDING_BTC_CONF);
+        EXPECT_EQ(bridge.getMaturingPegInCount(), 1u);
+
+        auto promoted = bridge.onNewBitcoinTip(newTip);
+        const bool deepEnough = newTip >= 100 + conf;
+        EXPECT_EQ(promoted.size(), deepEnough ? 1u : 0u);
+        EXPECT_TRUE(bridge.getPegIn(confirmed)->getStatus() ==
+                    (deepEnough ? PegStatus::BTC_CONFIRMED : PegStatus::PENDING_BTC_CONF));
+        EXPECT_TRUE(bridge.getPegIn(orphan)->getStatus() == PegStatus::PENDING_BTC_CONF);
+
+        // The orphan matures again once re-included on the new chain.
+        EXPECT_TRUE(bridge.trackPegInInclusion(orphan, fork + 2));
+        bridge.onNewBitcoinTip(std::max(newTip, fork + 2 + conf));
+        EXPECT_TRUE(bridge.getPegIn(orphan)->getStatus() == PegStatus::BTC_CONFIRMED);
+    }
+}
+
+TEST(PegMaturityQueueTest, AileeReorgRevertsPegOutPromotions) {
+    SidechainBridge bridge;
+    const std::string pegId = pendingPegOut(bridge);  // burned at 10, promoted by pull
+    ASSERT_TRUE(bridge.getPegOut(pegId)->getStatus() == PegStatus::PENDING_PEGOUT);
+
+    EXPECT_TRUE(bridge.onAileeReorg(10 + MIN_CONFIRMATIONS_PEGOUT - 1).empty());
+    EXPECT_TRUE(bridge.getPegOut(pegId)->getStatus() == PegStatus::BURN_INITIATED);
+    EXPECT_EQ(bridge.getMaturingPegOutCount(), 1u);
+    auto promoted = bridge.onNewAileeTip(10 + MIN_CONFIRMATIONS_PEGOUT);
+    ASSERT_EQ(promoted.size(), 1u);
+
+    // Burn block itself reorged out: returned and left for re-tracking.
+    auto orphaned = bridge.onAileeReorg(9);
+    ASSERT_EQ(orphaned.size(), 1u);
+    EXPECT_EQ(orphaned[0], pegId);
+    EXPECT_EQ(bridge.getMaturingPegOutCount(), 0u);
+    EXPECT_TRUE(bridge.getPegOut(pegId)->getStatus() == PegStatus::BURN_INITIATED);
+}
+
+TEST(PegMaturityQueueTest, TrackedBurnIsRequeuedAfterRestart) {
+    const std::string dbPath = getTestDbPath();
+    ailee::storage::PersistentStorage::Config config;
+    config.dbPath = dbPath;
+    ailee::storage::PersistentStorage storage(config);
+
+    std::string pegId;
+    {
+        SidechainBridge bridge(&storage);
+        global_seven::AnchorCommitment anchor;
+        anchor.l2StateRoot = "root";
+        anchor.payload = "payload";
+        anchor.hash = zk::sha256Hex(anchor.payload);
+        ASSERT_TRUE(bridge.registerAnchorCommitment(anchor, "root"));
+        pegId = bridge.initiatePegOut("ailee-src", "bc1q-dest", 50000, anchor.hash);
+        ASSERT_TRUE(!pegId.empty());
+        EXPECT_TRUE(bridge.trackPegOutBurn(pegId, 10));
+        EXPECT_EQ(bridge.getPegOut(pegId)->getData().aileeBurnTxHeight, 10u);
+        EXPECT_EQ(bridge.getMaturingPegOutCount(), 1u);
+    }
+
+    SidechainBridge bridge(&storage);
+    ASSERT_TRUE(bridge.getPegOut(pegId) != nullptr);
+    EXPECT_EQ(bridge.getMaturingPegOutCount(), 1u);
+    EXPECT_TRUE(bridge.onNewAileeTip(10 + MIN_CONFIRMATIONS_PEGOUT - 1).empty());
+    auto promoted = bridge.onNewAileeTip(10 + MIN_CONFIRMATIONS_PEGOUT);
+    ASSERT_EQ(promoted.size(), 1u);
+    EXPECT_EQ(promoted[0], pegId);
+    EXPECT_TRUE(bridge.getPegOut(pegId)->getStatus() == PegStatus::PENDING_PEGOUT);
+    cleanupTestDb(dbPath);
+}
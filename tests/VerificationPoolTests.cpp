@@ -0,0 +1,245 @@
+#include <gtest/gtest.h>
+#include "ZKVerifier.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ailee::zk;
+
+namespace {
+
+// Counters and a gate shared by every MockVerifier a pool creates.
+struct MockShared {
+    std::atomic<int> loads{0};
+    std::atomic<int> batchCalls{0};
+    std::atomic<std::size_t> largestBatch{0};
+    std::atomic<int> verified{0};
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool gateOpen = true;
+
+    void closeGate() {
+        std::lock_guard<std::mutex> lock(mutex);
+        gateOpen = false;
+    }
+    void openGate() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            gateOpen = true;
+        }
+        cv.notify_all();
+    }
+    void waitGate() {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&] { return gateOpen; });
+    }
+};
+
+// Accepts proofs whose taskId does not start with "bad"; echoes the taskId
+// in the reason so callers can check ordering.
+class MockVerifier : public IVerifier {
+public:
+    explicit MockVerifier(std::shared_ptr<MockShared> shared) : shared_(std::move(shared)) {}
+
+    bool loadKey(const VerificationKey& vk, std::string* err) override {
+        if (vk.data.empty()) {
+            if (err) *err = "empty key";
+            return false;
+        }
+        ++shared_->loads;
+        keys_.push_back(vk.id);
+        return true;
+    }
+
+    VerifyResult verify(const ProofBundle& bundle) const override {
+        shared_->waitGate();
+        ++shared_->verified;
+        VerifyResult r;
+        r.verified = bundle.taskId.rfind("bad", 0) != 0;
+        r.reason = bundle.taskId;
+        return r;
+    }
+
+    std::vector<VerifyResult> verifyBatch(const std::vector<ProofBundle>& bundles) const override {
+        ++shared_->batchCalls;
+        std::size_t prev = shared_->largestBatch.load();
+        while (bundles.size() > prev && !shared_->largestBatch.compare_exchange_weak(prev, bundles.size())) {
+        }
+        std::vector<VerifyResult> out;
+        for (const auto& b : bundles) out.push_back(verify(b));
+        return out;
+    }
+
+    bool unloadKey(const std::string&) override { return true; }
+    bool hasKey(const std::string& keyId) const override {
+        for (const auto& k : keys_) if (k == keyId) return true;
+        return false;
+    }
+    std::vector<std::string> getLoadedKeys() const override { return keys_; }
+    bool validateKey(const VerificationKey&, std::string*) const override { return true; }
+    bool precompileCircuit(const std::string&, std::string*) override { return true; }
+    uint64_t estimateVerificationCost(const ProofBundle&) const override { return 1; }
+    bool supportsProofSystem(ProofSystem) const override { return true; }
+    std::vector<ProofSystem> getSupportedSystems() const override { return {ProofSystem::HALO2}; }
+    bool verifyExecutionHash(const ProofBundle&) const override { return true; }
+    bool verifyProverSignature(const ProofBundle&) const override { return true; }
+    bool verifyTimestamp(const ProofBundle&, std::chrono::seconds) const override { return true; }
+    bool verifyNonce(const ProofBundle&) override { return true; }
+    void enableCache(bool, std::size_t) override {}
+    void clearCache() override {}
+    CacheStats getCacheStats() const override { return {}; }
+    VerificationMetrics getMetrics() const override { return {}; }
+    void resetMetrics() override {}
+    void setEventCallback(EventCallback) override {}
+    void setStrictMode(bool) override {}
+    void setTimestampTolerance(std::chrono::seconds) override {}
+    std::vector<std::string> exportAuditLog() const override { return {}; }
+    std::string getImplementationInfo() const override { return "mock"; }
+
+private:
+    std::shared_ptr<MockShared> shared_;
+    std::vector<std::string> keys_;
+};
+
+VerifierFactory::VerifierConstructor mockFactory(const std::shared_ptr<MockShared>& shared) {
+    return [shared] { return std::make_unique<MockVerifier>(shared); };
+}
+
+VerificationKey makeKey(const std::string& id) {
+    VerificationKey vk;
+    vk.id = id;
+    vk.data = {1, 2, 3};
+    vk.proofSystem = ProofSystem::HALO2;
+    vk.vkHash = "hash-" + id;
+    return vk;
+}
+
+ProofBundle makeBundle(const std::string& taskId) {
+    ProofBundle b;
+    b.taskId = taskId;
+    b.proofBytes = {0xAA};
+    return b;
+}
+
+} // namespace
+
+TEST(VerificationPoolTest, BatchesSplitAcrossWorkersWithWarmKeys) {
+    auto shared = std::make_shared<MockShared>();
+    VerificationPool pool(4, mockFactory(shared));
+    const auto vk = makeKey("model-v1");
+    std::string err;
+    ASSERT_TRUE(pool.preloadKey(vk, &err));
+    EXPECT_EQ(shared->loads.load(), 4);
+
+    std::vector<ProofBundle> bundles;
+    for (int i = 0; i < 1000; ++i) {
+        bundles.push_back(makeBundle((i % 10 == 3 ? "bad-" : "task-") + std::to_string(i)));
+    }
+    std::promise<std::vector<VerifyResult>> done;
+    pool.submitBatchAsync(bundles, vk, [&](std::vector<VerifyResult> results) {
+        done.set_value(std::move(results));
+    });
+    auto results = done.get_future().get();
+
+    ASSERT_EQ(results.size(), bundles.size());
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        EXPECT_EQ(results[i].reason, bundles[i].taskId);
+        EXPECT_EQ(results[i].verified, i % 10 != 3);
+    }
+    EXPECT_TRUE(shared->batchCalls.load() >= 4);
+    EXPECT_TRUE(shared->largestBatch.load() <= 250u);
+    // Submissions with the same key reuse what preloadKey loaded.
+    EXPECT_EQ(shared->loads.load(), 4);
+
+    auto stats = pool.getStats();
+    EXPECT_EQ(stats.totalVerifications, 1000u);
+    EXPECT_EQ(stats.failedVerifications, 100u);
+    EXPECT_EQ(stats.queuedTasks, 0u);
+    EXPECT_TRUE(stats.p50VerificationTime <= stats.p99VerificationTime);
+}
+
+TEST(VerificationPoolTest, BoundedQueueAppliesBackpressure) {
+    auto shared = std::make_shared<MockShared>();
+    VerificationPool pool(1, mockFactory(shared), 2);
+    const auto vk = makeKey("model-v1");
+
+    shared->closeGate();
+    std::atomic<int> completed{0};
+    auto count = [&](VerifyResult) { ++completed; };
+    pool.submitAsync(makeBundle("task-0"), vk, count);
+    // Wait for the worker to pick it up and block on the gate.
+    for (int i = 0; i < 200 && pool.getStats().activeWorkers == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ASSERT_EQ(pool.getStats().activeWorkers, 1u);
+
+    EXPECT_TRUE(pool.trySubmitAsync(makeBundle("task-1"), vk, count));
+    EXPECT_TRUE(pool.trySubmitAsync(makeBundle("task-2"), vk, count));
+    EXPECT_FALSE(pool.trySubmitAsync(makeBundle("task-3"), vk, count));
+    EXPECT_EQ(pool.getStats().queuedTasks, 2u);
+
+    // A blocking submit waits for room instead of failing.
+    std::thread producer([&] { pool.submitAsync(makeBundle("task-4"), vk, count); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(completed.load(), 0);
+    shared->openGate();
+    producer.join();
+
+    pool.shutdown();
+    EXPECT_EQ(completed.load(), 4);
+    EXPECT_EQ(shared->loads.load(), 1);
+}
+
+TEST(VerificationPoolTest, SyncVerifyKeyFailuresAndShutdown) {
+    auto shared = std::make_shared<MockShared>();
+    VerificationPool pool(2, mockFactory(shared));
+
+    EXPECT_TRUE(pool.verifySync(makeBundle("task-1"), makeKey("k1")).verified);
+    EXPECT_FALSE(pool.verifySync(makeBundle("bad-1"), makeKey("k1")).verified);
+
+    VerificationKey broken = makeKey("broken");
+    broken.data.clear();
+    auto failed = pool.verifySync(makeBundle("task-2"), broken);
+    EXPECT_FALSE(failed.verified);
+    ASSERT_TRUE(failed.errorCode.has_value());
+    EXPECT_EQ(*failed.errorCode, static_cast<uint32_t>(VerificationError::VK_NOT_LOADED));
+
+    // verifySync from a callback runs inline rather than queueing.
+    std::promise<bool> nested;
+    pool.submitAsync(makeBundle("task-3"), makeKey("k1"), [&](VerifyResult) {
+        nested.set_value(pool.verifySync(makeBundle("task-4"), makeKey("k1")).verified);
+    });
+    EXPECT_TRUE(nested.get_future().get());
+
+    pool.shutdown();
+    auto rejected = pool.verifySync(makeBundle("task-5"), makeKey("k1"));
+    EXPECT_FALSE(rejected.verified);
+    EXPECT_FALSE(pool.trySubmitAsync(makeBundle("task-6"), makeKey("k1"), [](VerifyResult) {}));
+    EXPECT_EQ(pool.getStats().totalVerifications, 5u);
+}
+
+TEST(VerificationPoolTest, SystemConstructorUsesRegisteredVerifier) {
+    auto shared = std::make_shared<MockShared>();
+    VerifierFactory::registerVerifier(ProofSystem::CUSTOM_ZKML, mockFactory(shared));
+    {
+        VerificationPool pool(2, ProofSystem::CUSTOM_ZKML);
+        EXPECT_TRUE(pool.verifySync(makeBundle("task-1"), makeKey("k1")).verified);
+    }
+    VerifierFactory::registerVerifier(ProofSystem::CUSTOM_ZKML, nullptr);
+
+    bool threw = false;
+    try {
+        VerificationPool pool(2, ProofSystem::CUSTOM_ZKML);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    EXPECT_TRUE(threw);
+}
@@ -30,8 +30,8 @@ public:
         sample2.inconsistent_state_root_nodes = 0;
         sample2.global_coherence_score = 100;
 
-        buffer.samples.push_back(sample1);
-        buffer.samples.push_back(sample2);
+        buffer.record(sample1);
+        buffer.record(sample2);
     }
 
     TelemetrySample sample1;
@@ -99,3 +99,25 @@ TEST_F(DeterministicDashboardTest, NoNondeterministicFields) {
     // We expect our simple expected_json not to have random data
     ASSERT_EQ(snap.json.find('.'), std::string::npos);
 }
+
+TEST_F(DeterministicDashboardTest, TickRangeSnapshot) {
+    DashboardSnapshot snap = builder.build_snapshot(buffer, 2, 2);
+
+    std::string expected_json = "{ \"telemetry\": ["
+        "{\"tick\":2,\"epoch\":10,\"total_nodes\":5,\"in_sync_nodes\":5,"
+        "\"consistent_state_root_nodes\":5,\"inconsistent_state_root_nodes\":0,\"global_coherence_score\":100}"
+        "] }";
+    ASSERT_EQ(snap.json, expected_json);
+    ASSERT_EQ(builder.build_snapshot(buffer, 3, 10).json, std::string("{ \"telemetry\": [] }"));
+}
+
+TEST_F(DeterministicDashboardTest, RollupSnapshotCoversRecordedSamples) {
+    std::string json = builder.build_rollup_snapshot(buffer).json;
+
+    std::string epoch = "{ \"epochs\": [{\"key\":10,\"first_tick\":1,\"last_tick\":2,\"samples\":2,";
+    ASSERT_EQ(json.compare(0, epoch.size(), epoch), 0);
+    ASSERT_TRUE(json.find("\"global_coherence_score\":{\"min\":80,\"max\":100,\"mean\":90}")
+                != std::string::npos);
+    ASSERT_TRUE(json.find("\"blocks\": [{\"key\":0,\"first_tick\":1,\"last_tick\":2,\"samples\":2,")
+                != std::string::npos);
+}
@@ -3,6 +3,7 @@
 #include "l4/ReplayBuffer.h"
 #include "l4/ReplayEngine.h"
 #include <cstdio>
+#include <cstring>
 #include <iostream>
 #include <fstream>
 #include <vector>
@@ -99,3 +100,121 @@ TEST_F(DeterministicReplayTest, DeterministicAcrossRuns) {
 
     std::remove("web/replay1.bin");
 }
+
+TEST_F(DeterministicReplayTest, DigestChainSurvivesFileRoundTrip) {
+    std::vector<ClusterNodeState> initial_nodes(3);
+    std::vector<std::pair<size_t, size_t>> gossip_schedule = {{0, 1}, {1, 2}, {2, 0}};
+    run_cluster_simulation(initial_nodes, gossip_schedule, 4);
+
+    ReplayEngine engine;
+    engine.load_replay_file("web/replay.bin");
+    ASSERT_EQ(engine.buffer.tick_digests.size(), 4u);
+
+    std::vector<ReplayTickDigest> stored = engine.buffer.tick_digests;
+    engine.buffer.rebuild_digests();
+    for (size_t i = 0; i < stored.size(); ++i) {
+        EXPECT_EQ(std::memcmp(&stored[i], &engine.buffer.tick_digests[i], sizeof(ReplayTickDigest)), 0);
+    }
+
+    run_cluster_simulation(initial_nodes, gossip_schedule, 4);
+    std::rename("web/replay.bin", "web/replay2.bin");
+    run_cluster_simulation(initial_nodes, gossip_schedule, 4);
+    ReplayDivergence same = ReplayEngine::find_divergence("web/replay.bin", "web/replay2.bin");
+    EXPECT_FALSE(same.diverged);
+    EXPECT_EQ(same.component, ReplayComponent::NONE);
+}
+
+TEST_F(DeterministicReplayTest, FindDivergencePinpointsTickComponentAndNode) {
+    std::vector<ClusterNodeState> initial_nodes(3);
+    std::vector<std::pair<size_t, size_t>> gossip_schedule = {{0, 1}, {1, 2}, {2, 0}};
+    run_cluster_simulation(initial_nodes, gossip_schedule, 2);
+
+    ReplayEngine engine;
+    engine.load_replay_file("web/replay.bin");
+    ASSERT_EQ(engine.buffer.scheduler_snapshots.size(), 2u);
+
+    // Stretch the run to 1024 ticks so the search has something to bisect.
+    ReplayBuffer a;
+    for (size_t i = 0; i < 1024; ++i) {
+        a.scheduler_snapshots.push_back(engine.buffer.scheduler_snapshots[i % 2]);
+        a.view_snapshots.push_back(engine.buffer.view_snapshots[i % 2]);
+        a.telemetry_snapshots.push_back(engine.buffer.telemetry_snapshots[i % 2]);
+    }
+    a.rebuild_digests();
+
+    ReplayBuffer b = a;
+    b.view_snapshots[700].nodes[2].peer_sync_states.emplace_back();
+    b.rebuild_digests();
+
+    ReplayDivergence node_div = ReplayEngine::find_divergence(a, b);
+    EXPECT_TRUE(node_div.diverged);
+    EXPECT_EQ(node_div.tick, 700u);
+    EXPECT_EQ(node_div.component, ReplayComponent::NODES);
+    EXPECT_EQ(node_div.node_index, 2u);
+    EXPECT_EQ(node_div.node_id_hash, a.view_snapshots[700].nodes[2].node_id_hash);
+    EXPECT_LE(node_div.chain_comparisons, 12u);
+
+    ReplayBuffer c = a;
+    c.telemetry_snapshots[3].tick_count ^= 1;
+    c.rebuild_digests();
+    ReplayDivergence telemetry_div = ReplayEngine::find_divergence(a, c);
+    EXPECT_EQ(telemetry_div.tick, 3u);
+    EXPECT_EQ(telemetry_div.component, ReplayComponent::TELEMETRY);
+
+    ReplayBuffer shorter = a;
+    shorter.scheduler_snapshots.resize(1000);
+    shorter.view_snapshots.resize(1000);
+    shorter.telemetry_snapshots.resize(1000);
+    shorter.tick_digests.resize(1000);
+    ReplayDivergence length_div = ReplayEngine::find_divergence(a, shorter);
+    EXPECT_TRUE(length_div.diverged);
+    EXPECT_EQ(length_div.tick, 1000u);
+    EXPECT_EQ(length_div.component, ReplayComponent::TICK_COUNT);
+}
+
+TEST_F(DeterministicReplayTest, FindDivergenceRehashesMissingOrStaleDigests) {
+    std::vector<ClusterNodeState> initial_nodes(3);
+    std::vector<std::pair<size_t, size_t>> gossip_schedule = {{0, 1}, {1, 2}, {2, 0}};
+    run_cluster_simulation(initial_nodes, gossip_schedule, 2);
+
+    ReplayEngine engine;
+    engine.load_replay_file("web/replay.bin");
+
+    ReplayBuffer a;
+    for (size_t i = 0; i < 64; ++i) {
+        a.scheduler_snapshots.push_back(engine.buffer.scheduler_snapshots[i % 2]);
+        a.view_snapshots.push_back(engine.buffer.view_snapshots[i % 2]);
+        a.telemetry_snapshots.push_back(engine.buffer.telemetry_snapshots[i % 2]);
+    }
+    a.rebuild_digests();
+
+    // No digests at all: compared on tick data instead of reported equal.
+    ReplayBuffer bare = a;
+    bare.tick_digests.clear();
+    bare.telemetry_snapshots[10].tick_count ^= 1;
+    ReplayDivergence bare_div = ReplayEngine::find_divergence(a, bare);
+    EXPECT_TRUE(bare_div.diverged);
+    EXPECT_TRUE(bare_div.digests_rebuilt);
+    EXPECT_EQ(bare_div.tick, 10u);
+    EXPECT_EQ(bare_div.component, ReplayComponent::TELEMETRY);
+
+    // Last tick edited after its digest was recorded.
+    ReplayBuffer stale = a;
+    stale.telemetry_snapshots[63].tick_count ^= 1;
+    ReplayDivergence stale_div = ReplayEngine::find_divergence(a, stale);
+    EXPECT_TRUE(stale_div.diverged);
+    EXPECT_EQ(stale_div.tick, 63u);
+
+    // An earlier edit is only caught when the caller asks for a rehash.
+    ReplayBuffer older = a;
+    older.telemetry_snapshots[20].tick_count ^= 1;
+    EXPECT_FALSE(ReplayEngine::find_divergence(a, older).diverged);
+    ReplayDivergence forced = ReplayEngine::find_divergence(a, older, true);
+    EXPECT_TRUE(forced.diverged);
+    EXPECT_EQ(forced.tick, 20u);
+    EXPECT_TRUE(forced.digests_rebuilt);
+
+    ReplayDivergence clean = ReplayEngine::find_divergence(a, a);
+    EXPECT_FALSE(clean.diverged);
+    EXPECT_FALSE(clean.digests_rebuilt);
+}
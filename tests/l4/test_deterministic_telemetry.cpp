@@ -28,8 +28,8 @@ TEST_F(DeterministicTelemetryTest, RecordTelemetrySample) {
     TelemetryBuffer buffer;
     record_telemetry_sample(view, state, buffer);
 
-    ASSERT_EQ(buffer.samples.size(), 1);
-    const auto& sample = buffer.samples.back();
+    ASSERT_EQ(buffer.samples().size(), 1);
+    const auto& sample = buffer.samples().back();
 
     EXPECT_EQ(sample.tick_count, 42);
     EXPECT_EQ(sample.epoch_height, 10);
@@ -82,13 +82,13 @@ TEST_F(DeterministicTelemetryTest, FullSchedulerIntegration_Reproducibility) {
     }
 
     // Both should have 5 full steps -> 5 samples (1 sample per COHERENCE_UPDATE which happens every 9th sub-tick)
-    ASSERT_EQ(scheduler1.telemetry.samples.size(), 5);
-    ASSERT_EQ(scheduler2.telemetry.samples.size(), 5);
+    ASSERT_EQ(scheduler1.telemetry.samples().size(), 5);
+    ASSERT_EQ(scheduler2.telemetry.samples().size(), 5);
 
     // Byte-for-byte reproducibility
-    for (size_t i = 0; i < scheduler1.telemetry.samples.size(); ++i) {
-        const auto& s1 = scheduler1.telemetry.samples[i];
-        const auto& s2 = scheduler2.telemetry.samples[i];
+    for (size_t i = 0; i < scheduler1.telemetry.samples().size(); ++i) {
+        const auto& s1 = scheduler1.telemetry.samples()[i];
+        const auto& s2 = scheduler2.telemetry.samples()[i];
         EXPECT_EQ(std::memcmp(&s1, &s2, sizeof(TelemetrySample)), 0);
     }
 }
@@ -119,10 +119,10 @@ TEST_F(DeterministicTelemetryTest, EpochTickCorrelationAndCoherenceTracking) {
         scheduler.run_tick(view, schedule, engines);
     }
 
-    ASSERT_EQ(scheduler.telemetry.samples.size(), max_steps);
+    ASSERT_EQ(scheduler.telemetry.samples().size(), max_steps);
 
-    for (size_t i = 0; i < scheduler.telemetry.samples.size(); ++i) {
-        const auto& sample = scheduler.telemetry.samples[i];
+    for (size_t i = 0; i < scheduler.telemetry.samples().size(); ++i) {
+        const auto& sample = scheduler.telemetry.samples()[i];
 
         // Assert tick count correlation.
         // A COHERENCE_UPDATE tick happens at phase 8 (which means it's the 9th sub-tick of the cycle).
@@ -137,7 +137,7 @@ TEST_F(DeterministicTelemetryTest, EpochTickCorrelationAndCoherenceTracking) {
         // So by phase 8, sample.epoch_height should exactly match scheduler.state.epoch_height.
         // Note: It's hard to predict exact epoch_height without running it, but we can check monotonic increasing
         if (i > 0) {
-            EXPECT_TRUE(sample.epoch_height >= scheduler.telemetry.samples[i-1].epoch_height);
+            EXPECT_TRUE(sample.epoch_height >= scheduler.telemetry.samples()[i-1].epoch_height);
         }
 
         // Node metrics
@@ -148,11 +148,105 @@ TEST_F(DeterministicTelemetryTest, EpochTickCorrelationAndCoherenceTracking) {
     }
 
     // Check coherence tracking: Over 10 steps of fully connected gossip, they should eventually converge.
-    const auto& first_sample = scheduler.telemetry.samples.front();
-    const auto& last_sample = scheduler.telemetry.samples.back();
+    const auto& first_sample = scheduler.telemetry.samples().front();
+    const auto& last_sample = scheduler.telemetry.samples().back();
 
     EXPECT_TRUE(last_sample.consistent_state_root_nodes >= first_sample.consistent_state_root_nodes);
     EXPECT_TRUE(last_sample.inconsistent_state_root_nodes <= first_sample.inconsistent_state_root_nodes);
     EXPECT_TRUE(last_sample.in_sync_nodes >= first_sample.in_sync_nodes);
     EXPECT_TRUE(last_sample.global_coherence_score >= first_sample.global_coherence_score);
 }
+
+TEST_F(DeterministicTelemetryTest, RingStaysBoundedAndRangeQueriesSurviveWrap) {
+    TelemetryBuffer buffer(100);
+
+    // Ticks 0, 3, 6, ...; ten ticks per epoch.
+    for (uint64_t i = 0; i < 250; ++i) {
+        TelemetrySample sample = {};
+        sample.tick_count = i * 3;
+        sample.epoch_height = (i * 3) / 10;
+        sample.total_nodes = 4;
+        sample.global_coherence_score = i % 101;
+        buffer.record(sample);
+    }
+
+    ASSERT_EQ(buffer.samples().size(), 100u);
+    EXPECT_EQ(buffer.samples().evicted(), 150u);
+    EXPECT_EQ(buffer.samples().front().tick_count, 450u);
+    EXPECT_EQ(buffer.samples().back().tick_count, 747u);
+    for (size_t i = 1; i < buffer.samples().size(); ++i) {
+        EXPECT_EQ(buffer.samples()[i].tick_count, buffer.samples()[i - 1].tick_count + 3);
+    }
+
+    // 600..610 covers ticks 600, 603, 606, 609.
+    TelemetryRange ticks = buffer.samples().tick_range(600, 610);
+    ASSERT_EQ(ticks.size(), 4u);
+    EXPECT_EQ(buffer.samples()[ticks.begin].tick_count, 600u);
+    EXPECT_EQ(buffer.samples()[ticks.end - 1].tick_count, 609u);
+
+    EXPECT_TRUE(buffer.samples().tick_range(0, 400).empty());
+    EXPECT_EQ(buffer.samples().tick_range(700, UINT64_MAX).size(), 16u);
+
+    TelemetryRange epochs = buffer.samples().epoch_range(60, 61);
+    ASSERT_EQ(epochs.size(), 7u);
+    EXPECT_EQ(buffer.samples()[epochs.begin].tick_count, 600u);
+    EXPECT_EQ(buffer.samples()[epochs.end - 1].tick_count, 618u);
+
+    TelemetrySample found = {};
+    EXPECT_TRUE(buffer.samples().find_tick(603, found));
+    EXPECT_EQ(found.global_coherence_score, 201u % 101);
+    EXPECT_FALSE(buffer.samples().find_tick(604, found));
+    EXPECT_FALSE(buffer.samples().find_tick(3, found));
+}
+
+TEST_F(DeterministicTelemetryTest, RollupsTrackMinMaxMeanPerEpochAndBlock) {
+    TelemetryBuffer buffer;
+    for (uint64_t tick = 0; tick < 2500; ++tick) {
+        TelemetrySample sample = {};
+        sample.tick_count = tick;
+        sample.epoch_height = tick / 100;
+        sample.total_nodes = 8;
+        sample.in_sync_nodes = tick % 9;
+        sample.global_coherence_score = tick % 100;
+        buffer.record(sample);
+    }
+
+    ASSERT_EQ(buffer.epoch_rollups().size(), 25u);
+    ASSERT_EQ(buffer.block_rollups().size(), 3u);
+
+    TelemetryRollup epoch = {};
+    ASSERT_TRUE(buffer.epoch_rollups().find(7, epoch));
+    EXPECT_EQ(epoch.first_tick, 700u);
+    EXPECT_EQ(epoch.last_tick, 799u);
+    EXPECT_EQ(epoch.sample_count, 100u);
+    EXPECT_EQ(epoch.stats[TELEMETRY_GLOBAL_COHERENCE_SCORE].min, 0u);
+    EXPECT_EQ(epoch.stats[TELEMETRY_GLOBAL_COHERENCE_SCORE].max, 99u);
+    EXPECT_EQ(epoch.mean(TELEMETRY_GLOBAL_COHERENCE_SCORE), 49u);
+    EXPECT_EQ(epoch.mean(TELEMETRY_TOTAL_NODES), 8u);
+
+    // The last block is still open with 500 samples.
+    const TelemetryRollup& open = buffer.block_rollups().back();
+    EXPECT_EQ(open.key, 2u);
+    EXPECT_EQ(open.first_tick, 2000u);
+    EXPECT_EQ(open.sample_count, 500u);
+    EXPECT_EQ(open.stats[TELEMETRY_IN_SYNC_NODES].max, 8u);
+
+    TelemetryRange blocks = buffer.block_rollups().range(1, 5);
+    EXPECT_EQ(blocks.begin, 1u);
+    EXPECT_EQ(blocks.end, 3u);
+
+    // Rollups are plain integers: two identical runs compare byte-for-byte.
+    TelemetryBuffer replay;
+    for (uint64_t tick = 0; tick < 2500; ++tick) {
+        TelemetrySample sample = {};
+        sample.tick_count = tick;
+        sample.epoch_height = tick / 100;
+        sample.total_nodes = 8;
+        sample.in_sync_nodes = tick % 9;
+        sample.global_coherence_score = tick % 100;
+        replay.record(sample);
+    }
+    for (size_t i = 0; i < buffer.epoch_rollups().size(); ++i) {
+        EXPECT_EQ(std::memcmp(&buffer.epoch_rollups()[i], &replay.epoch_rollups()[i], sizeof(TelemetryRollup)), 0);
+    }
+}
@@ -117,3 +117,66 @@ TEST_F(MeshAnchorTest, ComputeMeshCoherenceScore) {
     score = compute_mesh_coherence_score(anchor);
     EXPECT_EQ(score, 0);
 }
+
+TEST_F(MeshAnchorTest, InclusionProofsVerifyAgainstAnchor) {
+    ClusterView view = create_mock_view(13);
+    std::swap(view.nodes[0], view.nodes[7]);
+    MeshEpoch epoch = build_mesh_epoch(view);
+    MeshAnchor anchor = build_mesh_anchor(epoch, view);
+
+    MeshStateTree tree;
+    tree.build(view);
+    uint8_t root[32];
+    tree.root(root);
+    EXPECT_EQ(std::memcmp(root, epoch.mesh_state_root, 32), 0);
+
+    for (const auto& node : view.nodes) {
+        MeshInclusionProof proof;
+        ASSERT_TRUE(tree.prove(node.node_id_hash, proof));
+        EXPECT_LE(proof.sibling_count, 4u); // ceil(log2(13))
+        EXPECT_TRUE(verify_mesh_inclusion(proof, anchor));
+    }
+
+    MeshInclusionProof proof;
+    ASSERT_TRUE(tree.prove(view.nodes[3].node_id_hash, proof));
+    MeshInclusionProof forged = proof;
+    forged.state_root[0] ^= 0xFF;
+    EXPECT_FALSE(verify_mesh_inclusion(forged, anchor));
+    forged = proof;
+    forged.node_id_hash += 1;
+    EXPECT_FALSE(verify_mesh_inclusion(forged, anchor));
+    forged = proof;
+    forged.siblings[0][5] ^= 0x01;
+    EXPECT_FALSE(verify_mesh_inclusion(forged, anchor));
+    forged = proof;
+    forged.sibling_count -= 1;
+    EXPECT_FALSE(verify_mesh_inclusion(forged, anchor));
+
+    EXPECT_FALSE(tree.prove(99999, proof));
+}
+
+TEST_F(MeshAnchorTest, IncrementalUpdateMatchesRebuild) {
+    ClusterView view = create_mock_view(9);
+    MeshStateTree tree;
+    tree.build(view);
+
+    for (size_t i : {size_t(0), size_t(4), size_t(8)}) {
+        std::memset(view.nodes[i].last_envelope.context.state_root_hash, static_cast<int>(0xC0 + i), 32);
+        ASSERT_TRUE(tree.update(view.nodes[i].node_id_hash, view.nodes[i].last_envelope.context.state_root_hash));
+
+        MeshEpoch rebuilt = build_mesh_epoch(view);
+        uint8_t root[32];
+        tree.root(root);
+        EXPECT_EQ(std::memcmp(root, rebuilt.mesh_state_root, 32), 0);
+    }
+
+    uint8_t unused[32] = {0};
+    EXPECT_FALSE(tree.update(12345678, unused));
+
+    MeshStateTree empty;
+    empty.build(ClusterView{});
+    uint8_t zero_root[32];
+    empty.root(zero_root);
+    uint8_t zeros[32] = {0};
+    EXPECT_EQ(std::memcmp(zero_root, zeros, 32), 0);
+}
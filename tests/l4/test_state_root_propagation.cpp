@@ -148,3 +148,80 @@ TEST(StateRootPropagationTest, UnknownSource) {
     EXPECT_TRUE(validation_results[0].rejected);
     EXPECT_EQ(validation_results[0].reason_code, 3);
 }
+
+TEST(StateRootPropagationTest, SummaryCountsUnknownSourcesAndDuplicates) {
+    ClusterView view = {};
+    view.total_nodes = 4;
+
+    // Nodes deliberately out of hash order.
+    const uint64_t hashes[4] = {400, 100, 300, 200};
+    for (uint64_t h : hashes) {
+        ClusterNodeState node = {};
+        node.node_id_hash = h;
+        node.last_envelope.context.l1_height = 10;
+        for (int j = 0; j < 32; ++j) node.last_envelope.context.state_root_hash[j] = 0xAA;
+        view.nodes.push_back(node);
+    }
+
+    MeshEpoch epoch = build_mesh_epoch(view);
+    epoch.epoch_height = 10;
+    for (int j = 0; j < 32; ++j) epoch.mesh_state_root[j] = 0xAA;
+    MeshAnchor anchor = build_mesh_anchor(epoch, view);
+
+    auto announcements = build_state_root_announcements(view);
+    announcements[2].source_node_id_hash = 999; // node 300 goes missing
+    StateRootAnnouncement late = announcements[0];
+    std::memset(late.state_root, 0xBB, 32);      // second announcement from 100 is ignored
+    announcements.push_back(late);
+    StateRootAnnouncement stray = announcements[1];
+    stray.source_node_id_hash = 50;
+    announcements.push_back(stray);
+
+    StateRootValidationSummary summary;
+    auto results = validate_state_roots(view, anchor, announcements, summary);
+
+    ASSERT_EQ(results.size(), 4u);
+    EXPECT_EQ(results[0].node_id_hash, 100u);
+    EXPECT_TRUE(results[0].accepted);
+    EXPECT_TRUE(results[1].accepted);
+    EXPECT_EQ(results[2].node_id_hash, 300u);
+    EXPECT_EQ(results[2].reason_code, 3);
+    EXPECT_TRUE(results[3].accepted);
+
+    EXPECT_EQ(summary.accepted_count, 3u);
+    EXPECT_EQ(summary.rejected_count, 1u);
+    EXPECT_EQ(summary.missing_count, 1u);
+    EXPECT_EQ(summary.unknown_source_count, 2u);
+}
+
+TEST(StateRootPropagationTest, AnnouncementVerifiesWithInclusionProof) {
+    ClusterView view = {};
+    view.total_nodes = 6;
+    for (int i = 0; i < 6; ++i) {
+        ClusterNodeState node = {};
+        node.node_id_hash = 100 + i;
+        node.last_envelope.context.l1_height = 10;
+        for (int j = 0; j < 32; ++j) node.last_envelope.context.state_root_hash[j] = static_cast<uint8_t>(i * 7 + j);
+        view.nodes.push_back(node);
+    }
+
+    MeshEpoch epoch = build_mesh_epoch(view);
+    MeshAnchor anchor = build_mesh_anchor(epoch, view);
+    MeshStateTree tree;
+    tree.build(view);
+
+    auto announcements = build_state_root_announcements(view);
+    for (const auto& ann : announcements) {
+        MeshInclusionProof proof;
+        ASSERT_TRUE(tree.prove(ann.source_node_id_hash, proof));
+        EXPECT_TRUE(verify_state_root_announcement(ann, proof, anchor));
+    }
+
+    MeshInclusionProof proof;
+    ASSERT_TRUE(tree.prove(announcements[1].source_node_id_hash, proof));
+    EXPECT_FALSE(verify_state_root_announcement(announcements[2], proof, anchor));
+
+    StateRootAnnouncement stale = announcements[1];
+    stale.epoch_height = 9;
+    EXPECT_FALSE(verify_state_root_announcement(stale, proof, anchor));
+}
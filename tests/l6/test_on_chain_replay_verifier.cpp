@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include "l6/OnChainReplayVerifier.h"
 
+#include <random>
+
 namespace ailee {
 namespace l6 {
 
@@ -28,5 +30,173 @@ TEST(OnChainReplayVerifierTest, MatchAnchorHash) {
     EXPECT_EQ(verdict.anchor_hash, "abc");
 }
 
+namespace {
+
+EpochHash hash_for(uint64_t epoch) {
+    EpochHash h{};
+    for (std::size_t i = 0; i < h.size(); ++i) {
+        h[i] = static_cast<uint8_t>((epoch * 131 + i * 7) & 0xFF);
+    }
+    return h;
+}
+
+} // namespace
+
+TEST(OnChainReplayVerifierTest, IndexBuiltFromBlockScripts) {
+    EpochAnchorIndex index;
+    AnchorRecord rec{1, 7, 0, hash_for(7)};
+    std::vector<std::vector<uint8_t>> outputs = {
+        {0x51, 0x20},                                        // not OP_RETURN
+        {0x6a, 0x03, 'f', 'o', 'o'},                         // unrelated OP_RETURN
+        build_epoch_anchor_script(rec),
+    };
+    const std::size_t added = index.scan_block(800000, outputs);
+    EXPECT_EQ(added, 1u);
+    ASSERT_TRUE(index.find(7).has_value());
+    EXPECT_EQ(*index.find(7), hash_for(7));
+    EXPECT_EQ(*index.anchor_height(7), 800000u);
+    EXPECT_FALSE(index.find(8).has_value());
+
+    // Repeating the same hash is harmless.
+    EXPECT_EQ(index.scan_block(800001, {build_epoch_anchor_script(rec)}), 0u);
+    EXPECT_EQ(index.conflicts(), 0u);
+    EXPECT_EQ(*index.find(7), hash_for(7));
+
+    // A conflicting re-anchor disputes the epoch rather than losing to the first.
+    AnchorRecord conflicting{1, 7, 0, hash_for(99)};
+    const std::size_t readded = index.scan_block(800002, {build_epoch_anchor_script(conflicting)});
+    EXPECT_EQ(readded, 0u);
+    EXPECT_EQ(index.conflicts(), 1u);
+    EXPECT_TRUE(index.disputed(7));
+    EXPECT_FALSE(index.find(7).has_value());
+
+    // Out-of-order anchors keep the index sorted.
+    EXPECT_TRUE(index.insert(3, hash_for(3)));
+    EXPECT_EQ(index.epochs().front(), 3u);
+}
+
+TEST(OnChainReplayVerifierTest, RangeReconciliationReportsRuns) {
+    EpochAnchorIndex index;
+    for (uint64_t e = 100; e < 300; ++e) {
+        if (e >= 150 && e < 160) continue; // unanchored gap
+        index.insert(e, hash_for(e));
+    }
+    std::vector<EpochHash> local;
+    for (uint64_t e = 90; e < 310; ++e) {
+        local.push_back(hash_for(e));
+    }
+    local[200 - 90][0] ^= 1;
+    local[201 - 90][5] ^= 1;
+
+    auto report = reconcile_epoch_range(90, local, index);
+    ASSERT_EQ(report.runs.size(), 7u);
+    EXPECT_EQ(report.runs[0].status, ReplayStatus::MISSING_ANCHOR);
+    EXPECT_EQ(report.runs[0].first_epoch, 90u);
+    EXPECT_EQ(report.runs[0].last_epoch, 99u);
+    EXPECT_EQ(report.runs[1].status, ReplayStatus::OK);
+    EXPECT_EQ(report.runs[1].last_epoch, 149u);
+    EXPECT_EQ(report.runs[2].status, ReplayStatus::MISSING_ANCHOR);
+    EXPECT_EQ(report.runs[2].last_epoch, 159u);
+    EXPECT_EQ(report.runs[3].status, ReplayStatus::OK);
+    EXPECT_EQ(report.runs[3].last_epoch, 199u);
+    EXPECT_EQ(report.runs[4].status, ReplayStatus::MISMATCH);
+    EXPECT_EQ(report.runs[4].first_epoch, 200u);
+    EXPECT_EQ(report.runs[4].last_epoch, 201u);
+    EXPECT_EQ(report.runs[5].status, ReplayStatus::OK);
+    EXPECT_EQ(report.runs[5].last_epoch, 299u);
+    EXPECT_EQ(report.runs[6].status, ReplayStatus::MISSING_ANCHOR);
+    EXPECT_EQ(report.runs[6].last_epoch, 309u);
+    EXPECT_EQ(report.ok_epochs, 188u);
+    EXPECT_EQ(report.mismatched_epochs, 2u);
+    EXPECT_EQ(report.missing_epochs, 30u);
+    EXPECT_FALSE(report.clean());
+
+    EXPECT_TRUE(reconcile_epoch_range(0, {}, index).runs.empty());
+}
+
+TEST(OnChainReplayVerifierTest, RangeReconciliationMatchesPerEpochChecks) {
+    std::mt19937_64 rng(7);
+    EpochAnchorIndex index;
+    std::vector<EpochHash> local;
+    const uint64_t first = 1000;
+    for (uint64_t e = first; e < first + 5000; ++e) {
+        if (rng() % 10 != 0) index.insert(e, hash_for(e));
+        EpochHash h = hash_for(e);
+        if (rng() % 50 == 0) h[31] ^= 0xFF;
+        local.push_back(h);
+    }
+
+    auto report = reconcile_epoch_range(first, local, index);
+    std::vector<ReplayStatus> expanded;
+    for (const auto& run : report.runs) {
+        for (uint64_t e = run.first_epoch; e <= run.last_epoch; ++e) expanded.push_back(run.status);
+    }
+    ASSERT_EQ(expanded.size(), local.size());
+    for (std::size_t i = 0; i < local.size(); ++i) {
+        auto anchored = index.find(first + i);
+        ReplayStatus expected = index.disputed(first + i) ? ReplayStatus::CONFLICTING_ANCHOR
+            : !anchored ? ReplayStatus::MISSING_ANCHOR
+            : (*anchored == local[i] ? ReplayStatus::OK : ReplayStatus::MISMATCH);
+        EXPECT_EQ(expanded[i], expected);
+    }
+}
+
+TEST(OnChainReplayVerifierTest, RangeReconciliationReportsConflictingAnchors) {
+    EpochAnchorIndex index;
+    std::vector<EpochHash> local;
+    for (uint64_t e = 0; e < 200; ++e) {
+        index.insert(e, hash_for(e), 10);
+        local.push_back(hash_for(e));
+    }
+    // Local agrees with the first anchor; that alone must not make it OK.
+    index.insert(70, hash_for(1000), 11);
+    index.insert(71, hash_for(1001), 11);
+
+    auto report = reconcile_epoch_range(0, local, index);
+    ASSERT_EQ(report.runs.size(), 3u);
+    EXPECT_EQ(report.runs[1].status, ReplayStatus::CONFLICTING_ANCHOR);
+    EXPECT_EQ(report.runs[1].first_epoch, 70u);
+    EXPECT_EQ(report.runs[1].last_epoch, 71u);
+    EXPECT_EQ(report.ok_epochs, 198u);
+    EXPECT_EQ(report.conflicting_epochs, 2u);
+    EXPECT_FALSE(report.clean());
+}
+
+TEST(OnChainReplayVerifierTest, UnscanRollsBackReorgedAnchors) {
+    EpochAnchorIndex index;
+    index.scan_block(100, {build_epoch_anchor_script(AnchorRecord{1, 7, 0, hash_for(7)}),
+                           build_epoch_anchor_script(AnchorRecord{1, 8, 0, hash_for(8)})});
+    index.scan_block(101, {build_epoch_anchor_script(AnchorRecord{1, 7, 0, hash_for(99)}),
+                           build_epoch_anchor_script(AnchorRecord{1, 9, 0, hash_for(9)})});
+    index.scan_block(102, {build_epoch_anchor_script(AnchorRecord{1, 8, 0, hash_for(8)})});
+    ASSERT_TRUE(index.disputed(7));
+
+    // Reorging out the conflicting block settles epoch 7 on the first anchor.
+    const std::size_t dropped = index.unscan_from(101);
+    EXPECT_EQ(dropped, 3u);
+    EXPECT_EQ(index.conflicts(), 0u);
+    EXPECT_FALSE(index.disputed(7));
+    EXPECT_EQ(*index.find(7), hash_for(7));
+    EXPECT_FALSE(index.find(9).has_value());
+    EXPECT_EQ(index.size(), 2u);
+
+    // Blocks backfilled out of height order: when the first-seen anchor is
+    // reorged out, the surviving lower one takes over.
+    EXPECT_TRUE(index.insert(20, hash_for(20), 105));
+    EXPECT_FALSE(index.insert(20, hash_for(21), 95));
+    ASSERT_TRUE(index.disputed(20));
+    const std::size_t reorged = index.unscan_from(101);
+    EXPECT_EQ(reorged, 1u);
+    EXPECT_EQ(index.size(), 3u);
+    EXPECT_FALSE(index.disputed(20));
+    EXPECT_EQ(*index.find(20), hash_for(21));
+    EXPECT_EQ(*index.anchor_height(20), 95u);
+
+    const std::size_t cleared = index.unscan_from(0);
+    EXPECT_EQ(cleared, 3u);
+    EXPECT_EQ(index.size(), 0u);
+    EXPECT_FALSE(index.find(8).has_value());
+}
+
 } // namespace l6
 } // namespace ailee